@@ -83,8 +83,16 @@ ClassicTableInterface::problemSetup( const ProblemSpecP& db )
   db_classic->require( "inputfile", tableFileName );
   db_classic->getWithDefault( "cold_flow", d_coldflow, false);
 
+  // one copy of the table per node, optionally loaded from (or saved to) its binary form
+  bool nodeShared = false;
+  string binaryFileName;
+  db_classic->getWithDefault( "node_shared_table", nodeShared, false );
+  if ( nodeShared ){
+    db_classic->getWithDefault( "binary_table", binaryFileName, "" );
+  }
+
    //READ TABLE:
-  ND_interp=SCINEW_ClassicTable(tableFileName); // requires a delete on ND_interp object by host class
+  ND_interp=SCINEW_ClassicTable(tableFileName, {}, nodeShared, binaryFileName); // requires a delete on ND_interp object by host class
 
   d_allDepVarNames=ND_interp->tableInfo.d_savedDep_var;
   d_allIndepVarNames=ND_interp->tableInfo.d_allIndepVarNames;
@@ -491,31 +499,36 @@ ClassicTableInterface::getState( const ProcessorGroup* pc,
    }
 
 
-    Uintah::parallel_for(range,  [&]( int i,  int j, int k){
+    // one row (in x) at a time, so the IV vector is not allocated for every cell
+    Uintah::BlockRange rows(domLo, IntVector(domLo.x()+1, domHi.y(), domHi.z()));
+    Uintah::parallel_for(rows,  [&]( int i0,  int j, int k){
 
-    std::vector<double> iv1(nIndVars);
-    int ixxx=0;
-    for ( std::vector<constCCVariable<double> >::iterator iter = indep_storage.begin(); iter != indep_storage.end(); ++iter ) {
+      std::vector<double> iv1(nIndVars);
+      for ( int i = i0; i < domHi.x(); i++ ){
 
-      iv1[ixxx]=(*iter)(i,j,k);
-      ixxx++;
-    }
+        int ixxx=0;
+        for ( std::vector<constCCVariable<double> >::iterator iter = indep_storage.begin(); iter != indep_storage.end(); ++iter ) {
 
+          iv1[ixxx]=(*iter)(i,j,k);
+          ixxx++;
+        }
 
-    double total_inert_f = 0.0;
-    for (StringToCCVar::iterator inert_iter = inert_mixture_fractions.begin();
-        inert_iter != inert_mixture_fractions.end(); inert_iter++ ){
-        double inert_f = inert_iter->second.var(i,j,k);
-        total_inert_f += inert_f;
-    }
 
-    _iv_transform->transform( iv1, total_inert_f );
+        double total_inert_f = 0.0;
+        for (StringToCCVar::iterator inert_iter = inert_mixture_fractions.begin();
+            inert_iter != inert_mixture_fractions.end(); inert_iter++ ){
+            double inert_f = inert_iter->second.var(i,j,k);
+            total_inert_f += inert_f;
+        }
+
+        _iv_transform->transform( iv1, total_inert_f );
 
 
-    for (int  ix = 0; ix< nIndVars; ix++){
-      IVs_transformed[ix](i,j,k)=iv1[ix];
-    }
+        for (int  ix = 0; ix< nIndVars; ix++){
+          IVs_transformed[ix](i,j,k)=iv1[ix];
+        }
 
+      }
     });
 
 
@@ -29,8 +29,11 @@
 
 
 #include <CCA/Components/Arches/Task/TaskInterface.h>
+#include <Core/Parallel/UintahMPI.h>
 #include <sci_defs/kokkos_defs.h>
 
+#include <algorithm>
+#include <cmath>
 
 
 /**
@@ -59,10 +62,38 @@ namespace Uintah {
 typedef Kokkos::View<double**,  Kokkos::LayoutLeft,Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::RandomAccess> > tempTableContainer;
 typedef Kokkos::View<const double**,   Kokkos::LayoutLeft,Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::RandomAccess>  > tableContainer ;
 #else
-typedef std::vector<std::vector<double> > tempTableContainer;
-typedef const std::vector<std::vector<double> > &tableContainer ;
+/** @brief The dependent variable values of a table, one variable after another.  Either owns them
+ *         or refers to values in memory owned by someone else (e.g. a node shared window). */
+class ClassicTableData {
+public:
+  ClassicTableData( int nVars, size_t size ) : m_values(nVars*size, 0.0), m_data(m_values.data()), m_size(size) {}
+  ClassicTableData( const double* data, size_t size ) : m_data(data), m_size(size) {}
+
+  ClassicTableData( const ClassicTableData& )            = delete;
+  ClassicTableData& operator=( const ClassicTableData& ) = delete;
+
+  double*       operator[]( int var )       { return m_values.data() + var*m_size; }
+  const double* operator[]( int var ) const { return m_data + var*m_size; }
+
+private:
+  std::vector<double> m_values;
+  const double*       m_data;
+  size_t              m_size;
+};
+
+typedef ClassicTableData tempTableContainer;
+typedef const ClassicTableData &tableContainer ;
 #endif
 
+/** @brief Position of value i of dependent variable var in the storage of tempTableContainer */
+inline size_t classicTableOffset( int var, size_t i, int nVars, size_t size ){
+#ifdef UINTAH_ENABLE_KOKKOS
+  return var + i*nVars;   // LayoutLeft
+#else
+  return var*size + i;
+#endif
+}
+
 struct ClassicTableInfo {
 
  const std::vector<std::vector<double> > &indep_headers;
@@ -102,9 +133,14 @@ struct ClassicTableInfo {
                   const std::vector<std::vector<double> >& ind_1in,
                   const ClassicTableInfo &cti )
       : table2(table), d_allIndepVarNo(IndepVarNo), indep(indepin), ind_1(ind_1in), tableInfo(cti)
-    {}
+    {
+      setupBatchLookup();
+    }
 
            ~Interp_class() {
+            if ( d_sharedWindow != MPI_WIN_NULL ){
+              Uintah::MPI::Win_free( &d_sharedWindow );
+            }
             delete &ind_1;
             delete &d_allIndepVarNo;
             delete &indep;
@@ -121,11 +157,6 @@ struct ClassicTableInfo {
                  std::vector<std::string> requestedInd_var,
                  const Patch* patch, const std::vector<int> depVar_indices={} ){
 
-    std::vector<int>     index_map (indep_storage.size());
-    for (unsigned int ix = 0 ; ix<indep_storage.size(); ix++){
-      index_map[ix]=ix;
-    }
-
     //assume all variables are being read in from table data structure ( i would rather prune the dat structure then use a map)
     std::vector<int> depVarIndexes;
     if (depVar_indices.size()>0){
@@ -137,30 +168,73 @@ struct ClassicTableInfo {
       }
     }
 
-    // Go through the patch and populate the requested state variables
-    Uintah::BlockRange range(patch->getCellLowIndex(),patch->getCellHighIndex());
-    Uintah::parallel_for(range,  [&]( int i,  int j, int k){
+    const int nDim = d_nDim;
+    const IntVector lo = patch->getCellLowIndex();
+    const IntVector hi = patch->getCellHighIndex();
 
-        std::vector<double> one_cell_iv1(indep_storage.size());
-        // fill independent variables
-        for (unsigned int ix = 0 ; ix<indep_storage.size(); ix++) {
-        one_cell_iv1[ix]=indep_storage[index_map[ix]](i,j,k);
-        }
+    if ( nDim > MAX_BATCH_DIMS ){
+      // Go through the patch and populate the requested state variables, one cell at a time
+      Uintah::BlockRange range(lo,hi);
+      Uintah::parallel_for(range,  [&]( int i,  int j, int k){
 
-        std::vector<double> depVarValues;
-        //get all the needed varaible values from table with only one search
-        depVarValues = find_val(one_cell_iv1, depVarIndexes );// would it be faster to pass by reference?  ~12 dependent variables for coal in 1-2017
+          std::vector<double> one_cell_iv1(indep_storage.size());
+          // fill independent variables
+          for (unsigned int ix = 0 ; ix<indep_storage.size(); ix++) {
+          one_cell_iv1[ix]=indep_storage[ix](i,j,k);
+          }
 
-        for (unsigned int ix = 0 ; ix<dep_storage.size(); ix++) {
-        dep_storage[ix](i,j,k) = depVarValues[ix];
-        }
+          std::vector<double> depVarValues;
+          //get all the needed varaible values from table with only one search
+          depVarValues = find_val(one_cell_iv1, depVarIndexes );
+
+          for (unsigned int ix = 0 ; ix<dep_storage.size(); ix++) {
+          dep_storage[ix](i,j,k) = depVarValues[ix];
+          }
+          });
+      return;
+    }
 
+    // Go through the patch a row (in x) at a time, BATCH_SIZE cells at once: one search
+    // for all the dependent variables, and no allocation.
+    const int nx = hi.x() - lo.x();
+    Uintah::BlockRange rows(lo, IntVector(lo.x()+1, hi.y(), hi.z()));
+    Uintah::parallel_for(rows,  [&]( int i,  int j, int k){
 
+        Stencil stencil;
+        const double* iv[MAX_BATCH_DIMS];
 
+        for (int c0 = 0; c0 < nx; c0 += BATCH_SIZE) {
+          stencil.nCells = std::min(nx - c0, static_cast<int>(BATCH_SIZE));
+
+          for (int ix = 0; ix < nDim; ix++) {
+            iv[ix] = &indep_storage[ix](i+c0,j,k);
+          }
+          findStencils(iv, stencil);
+
+          for (unsigned int ix = 0; ix < dep_storage.size(); ix++) {
+            interpolate(stencil, depVarIndexes[ix], &dep_storage[ix](i+c0,j,k));
+          }
+        }
         });
     }
 
 
+    /** @brief Value i of dependent variable var */
+    inline double tableValue( const int var, const size_t i ) const {
+#ifdef UINTAH_ENABLE_KOKKOS
+      return table2(var, i);
+#else
+      return table2[var][i];
+#endif
+    }
+
+    /** @brief The first independent variable, one row for each value of the last one */
+    const std::vector< std::vector<double> >& getInd1() const { return ind_1; }
+
+    /** @brief Hands over the (node shared) window holding the table values, freed with the table.
+     *         Freeing it is collective over the ranks sharing it. */
+    void setSharedWindow( MPI_Win window ) { d_sharedWindow = window; }
+
     enum HighLow { iLow, iHigh};
 
 
@@ -283,6 +357,189 @@ struct ClassicTableInfo {
 
 
 
+  private:
+
+    static const int BATCH_SIZE     = 16;  ///< cells interpolated together by getState
+    static const int MAX_BATCH_DIMS = 8;   ///< most independent variables getState batches
+
+    /** @brief Interpolation stencil of up to BATCH_SIZE cells, stored [corner or weight][cell] */
+    struct Stencil {
+      int    nCells;
+      int    index [(1 << MAX_BATCH_DIMS) * BATCH_SIZE];  ///< table index of each corner
+      double weight[(MAX_BATCH_DIMS + 1)  * BATCH_SIZE];  ///< distal_val of find_val
+    };
+
+    /** @brief Precomputed bracket search data for one axis of the table */
+    struct Axis {
+      bool   uniform;  ///< evenly spaced, so the bracket is found by a division
+      double x0;
+      double inv_dx;
+    };
+
+    static Axis makeAxis( const std::vector<double>& x, const int n ){
+      Axis axis{false, 0.0, 0.0};
+      if ( n < 2 || !(x[n-1] > x[0]) ){
+        return axis;
+      }
+      const double dx = (x[n-1] - x[0]) / (n - 1);
+      for (int i = 1; i < n-1; i++){
+        if ( std::abs(x[i] - (x[0] + i*dx)) > 0.01*dx ){
+          return axis;
+        }
+      }
+      axis.uniform = true;
+      axis.x0      = x[0];
+      axis.inv_dx  = 1.0/dx;
+      return axis;
+    }
+
+    /** @brief Same bracket as the linear search of find_val: the first i in [1,n-1] with x[i] >= v, else n-1 */
+    static inline int bracket( const double* x, const int n, const Axis& axis, const double v ){
+      if ( !(v < x[n-1]) ){
+        return n-1;
+      }
+      int i;
+      if ( axis.uniform ){
+        const double t = (v - axis.x0) * axis.inv_dx;
+        i = (t > 0.0 ? (t < n-2 ? static_cast<int>(t) : n-2) : 0) + 1;
+        while ( i > 1 && x[i-1] >= v ){
+          i--;
+        }
+        while ( i < n-1 && x[i] < v ){
+          i++;
+        }
+      }else{
+        i = std::lower_bound(x+1, x+n-1, v) - x;
+      }
+      return i;
+    }
+
+    void setupBatchLookup(){
+      d_nDim = d_allIndepVarNo.size();
+      d_npts = 1 << d_nDim;
+
+      d_dliniate.resize(d_nDim);
+      d_dliniate[0] = 1;
+      for (int i = 1; i < d_nDim; i++){
+        d_dliniate[i] = d_dliniate[i-1]*d_allIndepVarNo[i-1];
+      }
+
+      for (int j = 0; j < d_nDim-1; j++){
+        d_indepAxes.push_back( makeAxis(indep[j], d_allIndepVarNo[j+1]) );
+      }
+      for (unsigned int row = 0; row < ind_1.size(); row++){
+        d_ind1Axes.push_back( makeAxis(ind_1[row], d_allIndepVarNo[0]) );
+      }
+
+      // high or low bracket of dimensions 1..nDim-1 for each of the first npts/2 corners,
+      // ordered as in find_val; entry 0 is the last one, which picks the special IV row
+      d_cornerBits.assign( d_npts/2 * d_nDim, 0 );
+      for (int j = 0; j < d_npts/2; j++){
+        int base2 = d_npts/4;
+        int high_or_low = 0;
+        for (int i = 1; i < d_nDim; i++){
+          high_or_low = j / base2 % 2;
+          d_cornerBits[j*d_nDim + i] = high_or_low;
+          base2 /= 2;
+        }
+        d_cornerBits[j*d_nDim] = high_or_low;
+      }
+    }
+
+    /** @brief The bracket search of find_val for stencil.nCells cells, iv[d][c] is IV d of cell c */
+    void findStencils( const double* const* iv, Stencil& stencil ) const {
+      const int nDim  = d_nDim;
+      const int n     = stencil.nCells;
+      const int half  = d_npts/2;
+      const int nSpec = nDim == 1 ? 1 : 2;
+
+      int high   [MAX_BATCH_DIMS][BATCH_SIZE];  // high bracket of dimensions 1..nDim-1
+      int special[2][BATCH_SIZE];               // low bracket of the special IV, low and high rows
+
+      for (int j = 0; j < nDim-1; j++){
+        const double* x = indep[j].data();
+        const int     nx = d_allIndepVarNo[j+1];
+        double*       w = &stencil.weight[(j+2)*BATCH_SIZE];
+        for (int c = 0; c < n; c++){
+          const int h = bracket(x, nx, d_indepAxes[j], iv[j+1][c]);
+          high[j][c] = h;
+          w[c] = (iv[j+1][c]-x[h-1])/(x[h]-x[h-1]);
+        }
+      }
+
+      const int nx0 = d_allIndepVarNo[0];
+      for (int iSp = 0; iSp < nSpec; iSp++){
+        double* w = &stencil.weight[iSp*BATCH_SIZE];
+        for (int c = 0; c < n; c++){
+          const int     row = nDim == 1 ? 0 : high[nDim-2][c] - 1 + iSp;
+          const double* x   = ind_1[row].data();
+          const int     h   = bracket(x, nx0, d_ind1Axes[row], iv[0][c]);
+          special[iSp][c] = h-1;
+          w[c] = (iv[0][c]-x[h-1])/(x[h]-x[h-1]);
+        }
+      }
+
+      for (int j = 0; j < half; j++){
+        const int* bits = &d_cornerBits[j*nDim];
+        int* lowCorner  = &stencil.index[j*BATCH_SIZE];
+        int* highCorner = &stencil.index[(half+j)*BATCH_SIZE];
+        for (int c = 0; c < n; c++){
+          int table_index = 0;
+          for (int i = 1; i < nDim; i++){
+            table_index += d_dliniate[i]*(high[i-1][c] - 1 + bits[i]);
+          }
+          lowCorner[c]  = table_index + special[bits[0]][c];
+          highCorner[c] = lowCorner[c] + 1;
+        }
+      }
+    }
+
+    /** @brief The interpolation of find_val, for one dependent variable and all the cells of the stencil */
+    void interpolate( const Stencil& stencil, const int var_index, double* out ) const {
+      const int n = stencil.nCells;
+      double table_vals[(1 << MAX_BATCH_DIMS) * BATCH_SIZE];
+
+      for (int j = 0; j < d_npts; j++){
+        const int* idx  = &stencil.index[j*BATCH_SIZE];
+        double*    vals = &table_vals[j*BATCH_SIZE];
+        for (int c = 0; c < n; c++){
+#ifdef UINTAH_ENABLE_KOKKOS
+          vals[c] = table2(var_index, idx[c]);
+#else
+          vals[c] = table2[var_index][idx[c]];
+#endif
+        }
+      }
+
+      // special interpolation for the first IV
+      int remaining_points = d_npts/2;
+      for (int i = 0; i < remaining_points; i++){
+        const double* distl = &stencil.weight[(i % 2)*BATCH_SIZE];
+        double*       lo    = &table_vals[i*BATCH_SIZE];
+        const double* hi    = &table_vals[(i+remaining_points)*BATCH_SIZE];
+        for (int c = 0; c < n; c++){
+          lo[c] = lo[c]*(1. - distl[c]) + hi[c]*distl[c];
+        }
+      }
+
+      // interpolation for all other IVs
+      for (int j = 0; j < d_nDim-1; j++){
+        remaining_points /= 2;
+        const double* distl = &stencil.weight[(j+2)*BATCH_SIZE];
+        for (int i = 0; i < remaining_points; i++){
+          double*       lo = &table_vals[i*BATCH_SIZE];
+          const double* hi = &table_vals[(i+remaining_points)*BATCH_SIZE];
+          for (int c = 0; c < n; c++){
+            lo[c] = lo[c]*(1. - distl[c]) + hi[c]*distl[c];
+          }
+        }
+      }
+
+      for (int c = 0; c < n; c++){
+        out[c] = table_vals[c];
+      }
+    }
+
   protected:
 
     tableContainer  table2;  // All dependent variables
@@ -292,6 +549,18 @@ struct ClassicTableInfo {
   public:   // avoids re-order warning
     const ClassicTableInfo tableInfo; // variable names, units, and table keys
 
+  private:
+
+    // constant search and interpolation data of the batched lookup, see setupBatchLookup
+    int                 d_nDim{0};
+    int                 d_npts{0};
+    std::vector<int>    d_dliniate;
+    std::vector<int>    d_cornerBits;
+    std::vector<Axis>   d_indepAxes;
+    std::vector<Axis>   d_ind1Axes;
+
+    MPI_Win             d_sharedWindow{MPI_WIN_NULL};  // see setSharedWindow
+
   };
 }
 #endif
@@ -44,8 +44,20 @@
 
 #include <CCA/Components/Arches/ChemMixV2/ClassicTable.h>
 #include <Core/IO/UintahZlibUtil.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Parallel/ProcessorGroup.h>
+#include <Core/Parallel/UintahMPI.h>
 #include <sci_defs/kokkos_defs.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+#include <sys/stat.h>
+
 
 namespace Uintah {
 template<class fileTYPE>
@@ -149,7 +161,7 @@ loadMixingTable(fileTYPE &fp, const std::string & inputfile,  std::vector<std::s
 #ifdef UINTAH_ENABLE_KOKKOS
     tempTableContainer table("ClassicMixingTable",loadAll ? d_varscount : d_savedDep_var.size(),size);
 #else
-    tempTableContainer* table=new tempTableContainer(loadAll ? d_varscount : d_savedDep_var.size() , std::vector<double> (size,0.0));
+    tempTableContainer* table=new tempTableContainer(loadAll ? d_varscount : d_savedDep_var.size() , size);
 #endif
 
   int size2 = size/(*d_allIndepVarNum)[d_indepvarscount-1];
@@ -341,8 +353,480 @@ checkForConstants(std::stringstream &table_stream,
 }
 #endif
 
+//______________________________________________________________________
+// Node shared tables
+//
+// With a node shared table one rank per node (the node leader) loads the table into an MPI-3
+// shared memory window, and all the ranks of the node interpolate from it.  The table is loaded
+// either from the classic text table or from its binary form, which is written the first time
+// the text table is loaded.  The binary form is a ClassicTableBinaryPrelude, the ClassicTableHeader
+// and the values of each dependent variable, as doubles in the byte order of the machine that
+// wrote it.  The prelude records that byte order and the size and modification time of the text
+// table, and a binary form that does not match them is written again from the text table.
+
+/** @brief Everything in a table but the dependent variable values */
+struct ClassicTableHeader {
+  std::vector<std::string>           indepNames;
+  std::vector<int>                   indepNum;
+  std::vector<std::string>           depNames;      ///< the dependent variables of the table, in order
+  std::vector<std::string>           depUnits;      ///< units of all the dependent variables of the file
+  std::map<std::string, double>      constants;
+  std::vector<std::vector<double> >  indepHeaders;  ///< independent variables 2 to N
+  std::vector<std::vector<double> >  ind1;          ///< independent variable 1, a row for each value of N
+
+  size_t tableSize() const {
+    size_t size = 1;
+    for (unsigned int i = 0; i < indepNum.size(); i++){
+      size *= indepNum[i];
+    }
+    return size;
+  }
+};
+
+static const char     classicTableBinaryMagic[8]  = {'U','C','T','A','B','L','E','2'};
+static const uint32_t classicTableByteOrderMark    = 0x01020304;
+
+/** @brief Starts a binary table */
+struct ClassicTableBinaryPrelude {
+  char     magic[8];
+  uint32_t byteOrder;       ///< classicTableByteOrderMark as written
+  uint32_t unused;
+  uint64_t sourceSize;      ///< size of the text table it was written from
+  int64_t  sourceMtime;     ///< modification time of the text table
+  uint64_t headerBytes;     ///< size of the packed ClassicTableHeader that follows
+};
+
+static
+void
+packClassicTableHeader( const ClassicTableHeader & header, std::string & out )
+{
+  auto putInt    = [&]( int64_t v ){ out.append( reinterpret_cast<const char*>(&v), sizeof(v) ); };
+  auto putDouble = [&]( double v  ){ out.append( reinterpret_cast<const char*>(&v), sizeof(v) ); };
+  auto putString = [&]( const std::string & v ){ putInt( v.size() ); out.append( v ); };
+  auto putStrings = [&]( const std::vector<std::string> & v ){
+    putInt( v.size() );
+    for (unsigned int i = 0; i < v.size(); i++){ putString( v[i] ); }
+  };
+  auto putDoubles = [&]( const std::vector<std::vector<double> > & v ){
+    putInt( v.size() );
+    for (unsigned int i = 0; i < v.size(); i++){
+      putInt( v[i].size() );
+      for (unsigned int j = 0; j < v[i].size(); j++){ putDouble( v[i][j] ); }
+    }
+  };
+
+  out.clear();
+  putStrings( header.indepNames );
+  putInt( header.indepNum.size() );
+  for (unsigned int i = 0; i < header.indepNum.size(); i++){ putInt( header.indepNum[i] ); }
+  putStrings( header.depNames );
+  putStrings( header.depUnits );
+  putInt( header.constants.size() );
+  for (auto iter = header.constants.begin(); iter != header.constants.end(); ++iter){
+    putString( iter->first );
+    putDouble( iter->second );
+  }
+  putDoubles( header.indepHeaders );
+  putDoubles( header.ind1 );
+}
+
+static
+void
+unpackClassicTableHeader( const std::string & in, ClassicTableHeader & header )
+{
+  size_t pos = 0;
+  auto get = [&]( void * v, size_t n ){
+    if ( pos + n > in.size() ){
+      throw ProblemSetupException( "Corrupt classic table header", __FILE__, __LINE__ );
+    }
+    memcpy( v, in.data() + pos, n );
+    pos += n;
+  };
+  auto getInt    = [&](){ int64_t v; get( &v, sizeof(v) ); return v; };
+  auto getDouble = [&](){ double  v; get( &v, sizeof(v) ); return v; };
+  // a count can not be more than the bytes left
+  auto getCount  = [&](){
+    int64_t v = getInt();
+    if ( v < 0 || static_cast<uint64_t>(v) > in.size() - pos ){
+      throw ProblemSetupException( "Corrupt classic table header", __FILE__, __LINE__ );
+    }
+    return static_cast<size_t>(v);
+  };
+  auto getString = [&](){
+    std::string v( getCount(), ' ' );
+    if ( !v.empty() ){ get( &v[0], v.size() ); }
+    return v;
+  };
+  auto getStrings = [&]( std::vector<std::string> & v ){
+    v.resize( getCount() );
+    for (unsigned int i = 0; i < v.size(); i++){ v[i] = getString(); }
+  };
+  auto getDoubles = [&]( std::vector<std::vector<double> > & v ){
+    v.resize( getCount() );
+    for (unsigned int i = 0; i < v.size(); i++){
+      v[i].resize( getInt() );
+      for (unsigned int j = 0; j < v[i].size(); j++){ v[i][j] = getDouble(); }
+    }
+  };
+
+  getStrings( header.indepNames );
+  header.indepNum.resize( getCount() );
+  for (unsigned int i = 0; i < header.indepNum.size(); i++){ header.indepNum[i] = getInt(); }
+  getStrings( header.depNames );
+  getStrings( header.depUnits );
+  header.constants.clear();
+  for (size_t n = getCount(); n > 0; n--){
+    std::string name = getString();
+    header.constants[name] = getDouble();
+  }
+  getDoubles( header.indepHeaders );
+  getDoubles( header.ind1 );
+}
+
+/** @brief Offset of the first dependent variable value in a binary table with a header of headerBytes */
+static inline
+size_t
+classicTableBinaryDataOffset( size_t headerBytes )
+{
+  return ( sizeof(ClassicTableBinaryPrelude) + headerBytes + 7 ) / 8 * 8;
+}
+
+/** @brief Sets size and mtime to those of the text table tableFileName, returns false if it can not be found */
+static
+bool
+statClassicTableSource( const std::string & tableFileName, uint64_t & size, int64_t & mtime )
+{
+  struct stat st;
+  if ( stat( tableFileName.c_str(), &st ) != 0 ){
+    return false;
+  }
+  size  = st.st_size;
+  mtime = st.st_mtime;
+  return true;
+}
+
+/** @brief Reads the prelude of the binary table open in fp and checks it against this machine and the
+ *         text table tableFileName.  Returns false, with the reason in 'problem', if it can not be used. */
 static
-Interp_class* SCINEW_ClassicTable(std::string tableFileName, std::vector<std::string> requested_depVar_names={} ){
+bool
+checkClassicTableBinary( FILE * fp, const std::string & tableFileName, ClassicTableBinaryPrelude & prelude, std::string & problem )
+{
+  struct stat st;
+  if ( fstat( fileno( fp ), &st ) != 0 ||
+       fread( &prelude, sizeof(prelude), 1, fp ) != 1 ||
+       memcmp( prelude.magic, classicTableBinaryMagic, sizeof(prelude.magic) ) != 0 ){
+    problem = "it is not a binary classic table";
+    return false;
+  }
+  if ( prelude.byteOrder != classicTableByteOrderMark ){
+    problem = "it was written on a machine of another byte order";
+    return false;
+  }
+  // the header size is checked before it is used to allocate anything
+  if ( prelude.headerBytes > static_cast<uint64_t>(st.st_size) - sizeof(prelude) ){
+    problem = "it is truncated";
+    return false;
+  }
+
+  // without the text table the binary form is used as it is
+  uint64_t sourceSize;
+  int64_t  sourceMtime;
+  if ( statClassicTableSource( tableFileName, sourceSize, sourceMtime ) &&
+       ( sourceSize != prelude.sourceSize || sourceMtime != prelude.sourceMtime ) ){
+    problem = "it was not written from the current " + tableFileName;
+    return false;
+  }
+  return true;
+}
+
+static
+void
+readClassicTableBinaryHeader( FILE * fp, const std::string & fileName, const std::string & tableFileName,
+                              ClassicTableHeader & header, size_t & dataOffset )
+{
+  ClassicTableBinaryPrelude prelude;
+  std::string               problem;
+  if ( !checkClassicTableBinary( fp, tableFileName, prelude, problem ) ){
+    throw ProblemSetupException( "Unable to use the binary classic table " + fileName + ": " + problem, __FILE__, __LINE__ );
+  }
+
+  std::string packed( prelude.headerBytes, ' ' );
+  if ( prelude.headerBytes > 0 && fread( &packed[0], prelude.headerBytes, 1, fp ) != 1 ){
+    throw ProblemSetupException( "Unable to read the binary classic table: " + fileName, __FILE__, __LINE__ );
+  }
+  unpackClassicTableHeader( packed, header );
+  dataOffset = classicTableBinaryDataOffset( prelude.headerBytes );
+
+  struct stat st;
+  if ( fstat( fileno( fp ), &st ) != 0 ||
+       dataOffset + header.depNames.size() * header.tableSize() * sizeof(double) > static_cast<uint64_t>(st.st_size) ){
+    throw ProblemSetupException( "Unable to use the binary classic table " + fileName + ": it is truncated", __FILE__, __LINE__ );
+  }
+}
+
+static
+void
+writeClassicTableBinary( const std::string & fileName, const std::string & tableFileName,
+                         const ClassicTableHeader & header, const double * values )
+{
+  ClassicTableBinaryPrelude prelude = {};
+  memcpy( prelude.magic, classicTableBinaryMagic, sizeof(prelude.magic) );
+  prelude.byteOrder = classicTableByteOrderMark;
+  if ( !statClassicTableSource( tableFileName, prelude.sourceSize, prelude.sourceMtime ) ){
+    proc0cout << "WARNING: unable to write the binary classic table " << fileName << ", " << tableFileName << " not found\n";
+    return;
+  }
+
+  FILE* fp = fopen( fileName.c_str(), "wb" );
+  if ( fp == nullptr ){
+    proc0cout << "WARNING: unable to write the binary classic table " << fileName << "\n";
+    return;
+  }
+
+  std::string packed;
+  packClassicTableHeader( header, packed );
+  prelude.headerBytes = packed.size();
+
+  const int    nVars = header.depNames.size();
+  const size_t size  = header.tableSize();
+  const size_t pad   = classicTableBinaryDataOffset( packed.size() ) - sizeof(prelude) - packed.size();
+  const char   zeros[8] = {0};
+
+  bool ok = fwrite( &prelude, sizeof(prelude), 1, fp ) == 1 &&
+            fwrite( packed.data(), 1, packed.size(), fp ) == packed.size() &&
+            fwrite( zeros, 1, pad, fp ) == pad;
+
+  std::vector<double> chunk( std::min( size, static_cast<size_t>(1 << 20) ) );
+  for (int var = 0; ok && var < nVars; var++){
+    for (size_t i0 = 0; ok && i0 < size; i0 += chunk.size()){
+      const size_t n = std::min( chunk.size(), size - i0 );
+      for (size_t i = 0; i < n; i++){
+        chunk[i] = values[ classicTableOffset( var, i0 + i, nVars, size ) ];
+      }
+      ok = fwrite( chunk.data(), sizeof(double), n, fp ) == n;
+    }
+  }
+
+  if ( fclose( fp ) != 0 || !ok ){
+    proc0cout << "WARNING: unable to write the binary classic table " << fileName << "\n";
+    remove( fileName.c_str() );
+    return;
+  }
+  proc0cout << "Wrote the binary form of the table to " << fileName << "\n";
+}
+
+static
+Interp_class* SCINEW_NodeSharedClassicTable( const std::string & tableFileName,
+                                             std::vector<std::string> requested_depVar_names,
+                                             const std::string & binaryFileName ){
+
+  MPI_Comm world = Parallel::getRootProcessorGroup()->getComm();
+  int      rank  = Parallel::getMPIRank();
+
+  // The node leader is the lowest rank on a node
+  MPI_Comm nodeComm = MPI_COMM_NULL;
+  int      ok       = MPI_Comm_split_type( world, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm ) == MPI_SUCCESS;
+  Uintah::MPI::Allreduce( MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, world );
+  if ( !ok ){
+    if ( nodeComm != MPI_COMM_NULL ){
+      Uintah::MPI::Comm_free( &nodeComm );
+    }
+    proc0cout << "WARNING: MPI_Comm_split_type failed, every rank loads its own copy of the table\n";
+    return nullptr;
+  }
+  int nodeRank;
+  Uintah::MPI::Comm_rank( nodeComm, &nodeRank );
+
+  MPI_Comm leaderComm;
+  Uintah::MPI::Comm_split( world, nodeRank == 0 ? 0 : MPI_UNDEFINED, rank, &leaderComm );
+
+  // A binary form that does not match the text table is written again
+  int haveBinary = 0;
+  if ( rank == 0 && !binaryFileName.empty() ){
+    FILE* fp = fopen( binaryFileName.c_str(), "rb" );
+    if ( fp != nullptr ){
+      ClassicTableBinaryPrelude prelude;
+      std::string               problem;
+      haveBinary = checkClassicTableBinary( fp, tableFileName, prelude, problem );
+      if ( !haveBinary ){
+        proc0cout << "WARNING: replacing the binary classic table " << binaryFileName << ", " << problem << "\n";
+      }
+      fclose( fp );
+    }
+  }
+  Uintah::MPI::Bcast( &haveBinary, 1, MPI_INT, 0, world );
+
+  // The leaders load the header (and the text table)
+  ClassicTableHeader header;
+  Interp_class     * textTable = nullptr;
+  FILE             * binaryFp  = nullptr;
+  size_t             dataOffset = 0;
+  std::vector<int>   fileVars;      // position of each table variable in the binary file
+
+  if ( nodeRank == 0 ){
+    if ( haveBinary ){
+      proc0cout << " Loading the binary form of the table: " << binaryFileName << "\n";
+      binaryFp = fopen( binaryFileName.c_str(), "rb" );
+      if ( binaryFp == nullptr ){
+        throw ProblemSetupException( "Unable to open the binary classic table: " + binaryFileName, __FILE__, __LINE__ );
+      }
+      readClassicTableBinaryHeader( binaryFp, binaryFileName, tableFileName, header, dataOffset );
+
+      if ( requested_depVar_names.size() == 0 ){
+        requested_depVar_names = header.depNames;
+      }
+      for (unsigned int ix = 0; ix < requested_depVar_names.size(); ix++){
+        auto iter = std::find( header.depNames.begin(), header.depNames.end(), requested_depVar_names[ix] );
+        if ( iter == header.depNames.end() ){
+          throw ProblemSetupException( "requested dependent variable " + requested_depVar_names[ix] +
+                                       " not found in the binary table " + binaryFileName +
+                                       ". Remove it to have it written again from the text table.", __FILE__, __LINE__ );
+        }
+        fileVars.push_back( iter - header.depNames.begin() );
+      }
+      header.depNames = requested_depVar_names;
+    }
+    else {
+      std::string uncomp_table_contents;
+      int table_size = 0;
+      if ( rank == 0 ){
+        try {
+          table_size = gzipInflate( tableFileName, uncomp_table_contents );
+        }
+        catch( Exception & e ) {
+          throw ProblemSetupException( std::string("Call to gzipInflate() failed: ") + e.message(), __FILE__, __LINE__ );
+        }
+        proc0cout << tableFileName << " is " << table_size << " bytes" << std::endl;
+      }
+      Uintah::MPI::Bcast( &table_size, 1, MPI_INT, 0, leaderComm );
+      uncomp_table_contents.resize( table_size );
+      Uintah::MPI::Bcast( &uncomp_table_contents[0], table_size, MPI_CHAR, 0, leaderComm );
+
+      std::stringstream table_contents_stream;
+      table_contents_stream << uncomp_table_contents;
+      std::string().swap( uncomp_table_contents );
+
+      std::map<std::string, double> constants;
+      checkForConstants( table_contents_stream, tableFileName, constants );
+      table_contents_stream.seekg(0);
+      textTable = loadMixingTable( table_contents_stream, tableFileName, requested_depVar_names, constants );
+
+      header.indepNames   = textTable->tableInfo.d_allIndepVarNames;
+      header.indepNum     = textTable->tableInfo.d_allIndepVarNum;
+      header.depNames     = textTable->tableInfo.d_savedDep_var;
+      header.depUnits     = textTable->tableInfo.d_allDepVarUnits;
+      header.constants    = textTable->tableInfo.d_constants;
+      header.indepHeaders = textTable->tableInfo.indep_headers;
+      header.ind1         = textTable->getInd1();
+    }
+  }
+
+  // The header goes to the other ranks of the node
+  std::string packed;
+  if ( nodeRank == 0 ){
+    packClassicTableHeader( header, packed );
+  }
+  int64_t packedBytes = packed.size();
+  Uintah::MPI::Bcast( &packedBytes, 1, MPI_INT64_T, 0, nodeComm );
+  packed.resize( packedBytes );
+  Uintah::MPI::Bcast( &packed[0], packedBytes, MPI_CHAR, 0, nodeComm );
+  if ( nodeRank != 0 ){
+    unpackClassicTableHeader( packed, header );
+  }
+
+  // The leader fills the window
+  const int    nVars = header.depNames.size();
+  const size_t size  = header.tableSize();
+
+  double * values = nullptr;
+  MPI_Win  window = MPI_WIN_NULL;
+  ok = MPI_Win_allocate_shared( nodeRank == 0 ? nVars*size*sizeof(double) : 0, sizeof(double), MPI_INFO_NULL, nodeComm, &values, &window ) == MPI_SUCCESS;
+  Uintah::MPI::Allreduce( MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, world );
+  if ( !ok ){
+    if ( window != MPI_WIN_NULL ){
+      MPI_Win_free( &window );
+    }
+    delete textTable;
+    if ( binaryFp ){
+      fclose( binaryFp );
+    }
+    Uintah::MPI::Comm_free( &nodeComm );
+    if ( leaderComm != MPI_COMM_NULL ){
+      Uintah::MPI::Comm_free( &leaderComm );
+    }
+    proc0cout << "WARNING: MPI_Win_allocate_shared failed, every rank loads its own copy of the table\n";
+    return nullptr;
+  }
+  if ( nodeRank != 0 ){
+    MPI_Aint bytes;
+    int      dispUnit;
+    MPI_Win_shared_query( window, 0, &bytes, &dispUnit, &values );
+  }
+
+  MPI_Win_fence( 0, window );
+  if ( textTable ){
+    for (int var = 0; var < nVars; var++){
+      for (size_t i = 0; i < size; i++){
+        values[ classicTableOffset( var, i, nVars, size ) ] = textTable->tableValue( var, i );
+      }
+    }
+    delete textTable;
+  }
+  else if ( binaryFp ){
+    std::vector<double> chunk( std::min( size, static_cast<size_t>(1 << 20) ) );
+    for (int var = 0; var < nVars; var++){
+      if ( fseeko( binaryFp, dataOffset + fileVars[var]*size*sizeof(double), SEEK_SET ) != 0 ){
+        throw ProblemSetupException( "Unable to read the binary classic table: " + binaryFileName, __FILE__, __LINE__ );
+      }
+      for (size_t i0 = 0; i0 < size; i0 += chunk.size()){
+        const size_t n = std::min( chunk.size(), size - i0 );
+        if ( fread( chunk.data(), sizeof(double), n, binaryFp ) != n ){
+          throw ProblemSetupException( "Unable to read the binary classic table: " + binaryFileName, __FILE__, __LINE__ );
+        }
+        for (size_t i = 0; i < n; i++){
+          values[ classicTableOffset( var, i0 + i, nVars, size ) ] = chunk[i];
+        }
+      }
+    }
+    fclose( binaryFp );
+  }
+  MPI_Win_fence( 0, window );
+
+  if ( rank == 0 && !haveBinary && !binaryFileName.empty() ){
+    writeClassicTableBinary( binaryFileName, tableFileName, header, values );
+  }
+
+  Uintah::MPI::Comm_free( &nodeComm );
+  if ( leaderComm != MPI_COMM_NULL ){
+    Uintah::MPI::Comm_free( &leaderComm );
+  }
+
+  std::vector<int>                  * d_allIndepVarNum = scinew std::vector<int>( header.indepNum );
+  std::vector<std::vector<double> > * indep_headers    = scinew std::vector<std::vector<double> >( header.indepHeaders );
+  std::vector<std::vector<double> > * i1               = scinew std::vector<std::vector<double> >( header.ind1 );
+
+  ClassicTableInfo infoStruct( *indep_headers, *d_allIndepVarNum, header.indepNames, header.depNames, header.depUnits, header.constants );
+
+#ifdef UINTAH_ENABLE_KOKKOS
+  tableContainer table( values, nVars, size );
+  Interp_class * return_pointer = scinew Interp_class( table, *d_allIndepVarNum, *indep_headers, *i1, infoStruct );
+#else
+  Interp_class * return_pointer = scinew Interp_class( *(new tempTableContainer( values, size )), *d_allIndepVarNum, *indep_headers, *i1, infoStruct );
+#endif
+  return_pointer->setSharedWindow( window );
+
+  proc0cout << "Table shared by the ranks of each node: " << nVars*size*sizeof(double)/(1024*1024) << " MB per node" << std::endl;
+  proc0cout << "---------------------------------------------------------------  " << std::endl;
+
+  return return_pointer;
+}
+
+/** @brief Loads a classic table.  With nodeShared, one rank per node loads it into node shared
+ *         memory (see SCINEW_NodeSharedClassicTable), using the binary form binaryFileName if given,
+ *         and every rank loads its own copy if the node shared memory can not be set up. */
+static
+Interp_class* SCINEW_ClassicTable(std::string tableFileName, std::vector<std::string> requested_depVar_names={},
+                                  bool nodeShared=false, std::string binaryFileName="" ){
   // Create sub-ProblemSpecP object
   //
   // Obtain object parameters
@@ -353,6 +837,15 @@ Interp_class* SCINEW_ClassicTable(std::string tableFileName, std::vector<std::st
   // READ TABLE:
   proc0cout << "--------------- Classic Arches Table Information---------------  " << std::endl;
 
+#ifndef OLD_TABLE
+  if ( nodeShared ){
+    Interp_class * table = SCINEW_NodeSharedClassicTable( tableFileName, requested_depVar_names, binaryFileName );
+    if ( table ){
+      return table;
+    }
+  }
+#endif
+
   std::string uncomp_table_contents;
 
   int mpi_rank = Parallel::getMPIRank();
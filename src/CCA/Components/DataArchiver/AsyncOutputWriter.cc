@@ -0,0 +1,257 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <CCA/Components/DataArchiver/AsyncOutputWriter.h>
+
+#include <Core/Exceptions/ErrnoException.h>
+#include <Core/Exceptions/Exception.h>
+#include <Core/Parallel/Parallel.h>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+using namespace Uintah;
+
+//______________________________________________________________________
+// Opens (creates/truncates) a data file for writing.
+//
+// Note: At least one time on a BGQ machine (Vulcan@LLNL), with 160K
+// patches, a single checkpoint file failed to open, and it 'crashed'
+// the simulation.  As the other processes on the node successfully
+// opened their file, it is possible that a second open call would
+// have succeeded.  (The original error no was 71.)  Therefore a
+// while loop is used, counting the 'tries'.
+int
+Uintah::openDataFile( const std::string & dataFilename )
+{
+  int tries = 1;
+  int flags = O_WRONLY|O_CREAT|O_TRUNC;       // file-opening flags
+
+  int fd = open( dataFilename.c_str(), flags, 0666 );
+
+  while( fd == -1 ) {
+
+    if( tries >= 50 ) {
+      std::ostringstream msg;
+
+      msg << "DataArchiver::output(): Failed to open file '"
+          << dataFilename << "' (after 50 tries).";
+      throw ErrnoException( msg.str(), errno, __FILE__, __LINE__ );
+    }
+
+    fd = open( dataFilename.c_str(), flags, 0666 );
+    tries++;
+  }
+
+  if( tries > 1 ) {
+    proc0cout << "WARNING: There was a glitch in trying to open the "
+              << "checkpoint file: " << dataFilename << ". "
+              << "It took " << tries << " tries to successfully open it.";
+  }
+  return fd;
+}
+
+//______________________________________________________________________
+//
+AsyncOutputWriter::AsyncOutputWriter( int numThreads, size_t maxStagedBytes )
+  : m_maxStagedBytes( maxStagedBytes )
+{
+  for( int i = 0; i < numThreads; ++i ) {
+    m_threads.emplace_back( &AsyncOutputWriter::run, this );
+  }
+}
+
+//______________________________________________________________________
+//
+AsyncOutputWriter::~AsyncOutputWriter()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_doneCV.wait( lock, [this]{ return m_jobs.empty() && m_busy == 0; } );
+    m_shutdown = true;
+  }
+  m_workCV.notify_all();
+
+  for( auto & t : m_threads ) {
+    t.join();
+  }
+
+  if( m_error ) {
+    try {
+      std::rethrow_exception( m_error );
+    }
+    catch( const Exception & e ) {
+      std::cerr << "AsyncOutputWriter: " << e.message() << "\n";
+    }
+    catch( const std::exception & e ) {
+      std::cerr << "AsyncOutputWriter: " << e.what() << "\n";
+    }
+    catch( ... ) {
+      std::cerr << "AsyncOutputWriter: unknown exception while writing\n";
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::enqueue( const std::string & dataFilename
+                          ,       std::string & data
+                          , const std::string & xmlFilename
+                          ,       std::string & xml
+                          )
+{
+  Job job;
+  job.m_dataFilename = dataFilename;
+  job.m_data.swap( data );
+  job.m_xmlFilename  = xmlFilename;
+  job.m_xml.swap( xml );
+
+  const size_t bytes = job.bytes();
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    // Back-pressure: wait for room, but never for a job larger than the
+    // whole staging budget once everything ahead of it has been written.
+    m_doneCV.wait( lock, [this, bytes]{ return m_error ||
+                                               m_stagedBytes == 0 ||
+                                               m_stagedBytes + bytes <= m_maxStagedBytes; } );
+    throwIfFailed();
+
+    m_stagedBytes += bytes;
+    m_jobs.push_back( std::move( job ) );
+  }
+  m_workCV.notify_one();
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::flush()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_doneCV.wait( lock, [this]{ return m_jobs.empty() && m_busy == 0; } );
+  throwIfFailed();
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::throwIfFailed()
+{
+  if( m_error ) {
+    std::exception_ptr error = m_error;
+    m_error = nullptr;
+    std::rethrow_exception( error );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::run()
+{
+  while( true ) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_workCV.wait( lock, [this]{ return m_shutdown || !m_jobs.empty(); } );
+
+      if( m_jobs.empty() ) {    // shutdown
+        return;
+      }
+      job = std::move( m_jobs.front() );
+      m_jobs.pop_front();
+      ++m_busy;
+    }
+
+    const size_t bytes = job.bytes();
+    std::exception_ptr error;
+
+    // Anything thrown here is handed to the main thread by flush() or
+    // enqueue(); letting it escape would terminate the program.
+    try {
+      write( job );
+    }
+    catch( ... ) {
+      error = std::current_exception();
+    }
+
+    // release the staged memory before reporting completion
+    job = Job();
+
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      --m_busy;
+      m_stagedBytes -= bytes;
+      if( error && !m_error ) {
+        m_error = error;
+      }
+    }
+    m_doneCV.notify_all();
+  }
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::write( Job & job )
+{
+  writeFile( job.m_dataFilename, job.m_data );
+
+  // The xml is written last so it never refers to data that is not on disk yet.
+  writeFile( job.m_xmlFilename, job.m_xml );
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::writeFile( const std::string & filename, const std::string & contents )
+{
+  int fd = openDataFile( filename );
+
+  const char* buffer = contents.c_str();
+  size_t      left   = contents.size();
+
+  while( left > 0 ) {
+    ssize_t s = ::write( fd, buffer, left );
+    if( s == -1 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+      int err = errno;
+      close( fd );
+      throw ErrnoException( "AsyncOutputWriter::write (write call) " + filename, err, __FILE__, __LINE__ );
+    }
+    buffer += s;
+    left   -= s;
+  }
+
+  if( close( fd ) == -1 ) {
+    throw ErrnoException( "AsyncOutputWriter::write (close call) " + filename, errno, __FILE__, __LINE__ );
+  }
+}
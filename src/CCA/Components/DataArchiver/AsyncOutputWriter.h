@@ -0,0 +1,114 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CCA_COMPONENTS_DATAARCHIVER_ASYNCOUTPUTWRITER_H
+#define CCA_COMPONENTS_DATAARCHIVER_ASYNCOUTPUTWRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Uintah {
+
+//______________________________________________________________________
+//
+//  Background writer for the DataArchiver's per-rank .data/.xml pairs.
+//
+//  The output task serializes (stages) every variable of a data file into
+//  memory and hands the bytes, together with the file's xml index, to
+//  this class; dedicated I/O threads write them to disk while the
+//  simulation continues.  The xml is serialized by the
+//  caller because the libxml DOM is not thread-safe, so the I/O threads
+//  only ever see strings.  The amount of staged data is bounded:
+//  enqueue() blocks until enough earlier files have been written.
+//  flush() waits until everything queued is on disk and re-throws the
+//  first exception, of any type, thrown on an I/O thread.
+
+class AsyncOutputWriter {
+
+public:
+
+  AsyncOutputWriter( int numThreads, size_t maxStagedBytes );
+
+  // Flushes and joins the I/O threads (write errors are only reported)
+  ~AsyncOutputWriter();
+
+  // The contents of data and xml are moved
+  void enqueue( const std::string & dataFilename
+              ,       std::string & data
+              , const std::string & xmlFilename
+              ,       std::string & xml
+              );
+
+  void flush();
+
+private:
+
+  struct Job {
+    std::string m_dataFilename;
+    std::string m_data;
+    std::string m_xmlFilename;
+    std::string m_xml;
+
+    size_t bytes() const { return m_data.size() + m_xml.size(); }
+  };
+
+  void run();
+  void write( Job & job );
+  void writeFile( const std::string & filename, const std::string & contents );
+  void throwIfFailed();   // m_mutex must be held
+
+  // eliminate copy, assignment and move
+  AsyncOutputWriter( const AsyncOutputWriter & )            = delete;
+  AsyncOutputWriter& operator=( const AsyncOutputWriter & ) = delete;
+  AsyncOutputWriter( AsyncOutputWriter && )                 = delete;
+  AsyncOutputWriter& operator=( AsyncOutputWriter && )      = delete;
+
+  const size_t             m_maxStagedBytes;
+
+  std::vector<std::thread> m_threads;
+  std::deque<Job>          m_jobs;
+  size_t                   m_stagedBytes {0};   // queued plus being written
+  int                      m_busy {0};          // jobs being written
+  bool                     m_shutdown {false};
+  std::exception_ptr       m_error;             // first failure, if any
+
+  std::mutex               m_mutex;
+  std::condition_variable  m_workCV;            // signaled on enqueue and shutdown
+  std::condition_variable  m_doneCV;            // signaled when a job completes
+};
+
+//______________________________________________________________________
+//  Opens (creates/truncates) a data file for writing, retrying a failed
+//  open up to 50 times.  Used by both the DataArchiver's synchronous
+//  output and the I/O threads above.
+int openDataFile( const std::string & dataFilename );
+
+} // namespace Uintah
+
+#endif // CCA_COMPONENTS_DATAARCHIVER_ASYNCOUTPUTWRITER_H
@@ -35,6 +35,7 @@
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/DataArchive/DataArchive.h>
+#include <Core/DataArchive/UdaIndex.h>
 #include <Core/GeometryPiece/GeometryPieceFactory.h>
 #include <Core/Grid/Box.h>
 #include <Core/Grid/Grid.h>
@@ -44,6 +45,7 @@
 #include <Core/Parallel/Parallel.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
+#include <Core/Util/Compression.h>
 #include <Core/Util/DebugStream.h>
 #include <Core/Util/DOUT.hpp>
 #include <Core/Util/Endian.h>
@@ -56,6 +58,7 @@
 #include <sci_defs/visit_defs.h>
 
 #include <cerrno>
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -94,6 +97,51 @@ namespace {
 #ifdef HAVE_PIDX
   DebugStream dbgPIDX ("DataArchiverPIDX", "DataArchiver", "Data archiver PIDX debug stream", false);
 #endif
+
+  // Largest message used when moving staged output between ranks.
+  const size_t AGGREGATE_CHUNK = 1L << 30;
+
+  //______________________________________________________________________
+  // Writes all of 'bytes' to fd, retrying after partial writes.
+  void
+  writeDataFile( int fd, const string & bytes, const string & dataFilename )
+  {
+    size_t pos = 0;
+    while( pos < bytes.size() ) {
+      ssize_t n = write( fd, bytes.data() + pos, bytes.size() - pos );
+      if( n == -1 && errno == EINTR ) {
+        continue;
+      }
+      if( n <= 0 ) {
+        cerr << "Error writing to file: " << dataFilename
+             << ", errno=" << errno << '\n';
+        SCI_THROW(ErrnoException("DataArchiver::output (write call)",
+                                 errno, __FILE__, __LINE__));
+      }
+      pos += n;
+    }
+  }
+
+  //______________________________________________________________________
+  // Sends/receives a (possibly > 2GB) byte string in chunks.
+  void
+  sendBytes( const string & bytes, int dest, int tag, MPI_Comm comm )
+  {
+    for( size_t pos = 0; pos < bytes.size(); pos += AGGREGATE_CHUNK ) {
+      int count = (int) min( AGGREGATE_CHUNK, bytes.size() - pos );
+      Uintah::MPI::Send( bytes.data() + pos, count, MPI_BYTE, dest, tag, comm );
+    }
+  }
+
+  void
+  recvBytes( string & bytes, size_t size, int source, int tag, MPI_Comm comm )
+  {
+    bytes.resize( size );
+    for( size_t pos = 0; pos < size; pos += AGGREGATE_CHUNK ) {
+      int count = (int) min( AGGREGATE_CHUNK, size - pos );
+      Uintah::MPI::Recv( &bytes[pos], count, MPI_BYTE, source, tag, comm, MPI_STATUS_IGNORE );
+    }
+  }
 }
 
 //______________________________________________________________________
@@ -134,6 +182,13 @@ DataArchiver::DataArchiver(const ProcessorGroup* myworld, int udaSuffix)
 
 DataArchiver::~DataArchiver()
 {
+  // Waits for any outstanding asynchronous writes
+  delete m_asyncWriter;
+
+  if( m_aggregateComm != MPI_COMM_NULL ) {
+    Uintah::MPI::Comm_free( &m_aggregateComm );
+  }
+
   VarLabel::destroy( m_sync_io_label );
 
   if(m_tmpMatSubset && m_tmpMatSubset->removeReference()) {
@@ -235,6 +290,43 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
 
   m_outputDoubleAsFloat = p->findBlock("outputDoubleAsFloat") != nullptr;
 
+  // Asynchronous output - stage the data files in memory and let
+  // background threads write them while the simulation continues.
+  ProblemSpecP async_ps = p->findBlock("asyncOutput");
+  if( async_ps != nullptr && m_asyncWriter == nullptr ) {
+    int threads   = 1;
+    int stagingMB = 1024;
+    async_ps->getAttribute( "threads",   threads );
+    async_ps->getAttribute( "stagingMB", stagingMB );
+
+    if( threads < 1 || stagingMB < 1 ) {
+      throw ProblemSetupException( "DataArchiver: <asyncOutput> threads and stagingMB must be positive", __FILE__, __LINE__ );
+    }
+    if( m_outputFileFormat != UDA ) {
+      throw ProblemSetupException( "DataArchiver: <asyncOutput> is only supported for the UDA output format", __FILE__, __LINE__ );
+    }
+    m_asyncWriter = scinew AsyncOutputWriter( threads, (size_t) stagingMB * 1024 * 1024 );
+
+    proc0cout << "DataArchiver: asynchronous output with " << threads
+              << " I/O thread(s) and " << stagingMB << " MB of staging\n";
+  }
+
+  // Aggregated output - a subset of the ranks gather the per-level
+  // data of their group and write one (larger) file per group.
+  ProblemSpecP aggregate_ps = p->findBlock("aggregateOutput");
+  if( aggregate_ps != nullptr && m_aggregateComm == MPI_COMM_NULL ) {
+    int ranksPerFile = 0;   // 0 == one file per node
+    aggregate_ps->getAttribute( "ranksPerFile", ranksPerFile );
+
+    if( ranksPerFile < 0 ) {
+      throw ProblemSetupException( "DataArchiver: <aggregateOutput> ranksPerFile must be positive (or 0 for one file per node)", __FILE__, __LINE__ );
+    }
+    if( m_outputFileFormat != UDA ) {
+      throw ProblemSetupException( "DataArchiver: <aggregateOutput> is only supported for the UDA output format", __FILE__, __LINE__ );
+    }
+    setupAggregateOutput( ranksPerFile );
+  }
+
   // For outputing the sim time and/or time step with the global vars
   p->get("timeStep", m_outputGlobalVarsTimeStep); // default false
   p->get("simTime",  m_outputGlobalVarsSimTime);  // default true
@@ -294,10 +386,20 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     m_outputLastTimeStep = false; // default
   }
 
-  // set default compression mode - can be "gzip" or ""
+  // set default compression mode - can be "gzip", "lz", "shuffle-lz",
+  // "shuffle-gzip" or ""
   string defaultCompressionMode = "";
   if (p->get("compression", defaultCompressionMode)) {
     VarLabel::setDefaultCompressionMode(defaultCompressionMode);
+
+    // Threads used to compress the blocks of each variable
+    int threads = 1;
+    if( p->findBlock("compression")->getAttribute( "threads", threads ) ) {
+      if( threads < 1 ) {
+        throw ProblemSetupException( "DataArchiver: <compression> threads must be positive", __FILE__, __LINE__ );
+      }
+      setCompressionThreads( threads );
+    }
   }
 
   if (params->findBlock("ParticlePosition")) {
@@ -326,6 +428,17 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     save->getAttributes(attributes);
     saveItem.labelName       = attributes["label"];
     saveItem.compressionMode = attributes["compression"];
+
+    // error bounds for lossy compression of the output (not checkpoints)
+    saveItem.lossyAbsTolerance = 0.0;
+    saveItem.lossyRelTolerance = 0.0;
+    save->getAttribute( "lossyAbsTolerance", saveItem.lossyAbsTolerance );
+    save->getAttribute( "lossyRelTolerance", saveItem.lossyRelTolerance );
+
+    if( saveItem.lossyAbsTolerance < 0.0 || saveItem.lossyRelTolerance < 0.0 ) {
+      throw ProblemSetupException( "The lossy compression tolerances for saving '" + saveItem.labelName +
+                                   "' must not be negative", __FILE__, __LINE__ );
+    }
     
     try {
       saveItem.matls = ConsecutiveRangeSet(attributes["material"]);
@@ -552,6 +665,15 @@ DataArchiver::initializeOutput( const ProblemSpecP & params, const GridP& grid )
     return;
   }
 
+  if( m_aggregateComm != MPI_COMM_NULL ) {
+    if( m_loadBalancer->getNthRank() > 1 ) {
+      throw ProblemSetupException( "DataArchiver: <aggregateOutput> can not be combined with the load balancer's <outputNthProc>", __FILE__, __LINE__ );
+    }
+    if( getUseLocalFileSystems() ) {
+      throw ProblemSetupException( "DataArchiver: <aggregateOutput> requires a shared file system", __FILE__, __LINE__ );
+    }
+  }
+
   if( getUseLocalFileSystems() ) {
     setupLocalFileSystems();
   }
@@ -1261,6 +1383,14 @@ DataArchiver::setCheckpointTimeStep( bool val, const GridP& grid )
     
     // Create the output checkpoint directories
     if( m_isCheckpointTimeStep ) {
+
+      // Every checkpoint was flushed before it was added to index.xml
+      // (see writeto_xml_files()); also flush this rank's output before
+      // the checkpoint below is expired and its directory removed.
+      if( m_asyncWriter ) {
+        m_asyncWriter->flush();
+      }
+
       string timestepDir;
       makeTimeStepDirs( m_checkpointsDir, m_checkpointLabels, grid, &timestepDir );
       m_checkpointTimeStepDirs.push_back( timestepDir );
@@ -1710,12 +1840,38 @@ DataArchiver::writeto_xml_files( const GridP& grid )
             << getTimeStepTopLevel() << " but the grid changed on time step "
             << m_application->getLastRegridTimeStep()
             << ". Not writing the associated XML files." );
+
+      // Drop what the output tasks staged for aggregation so it is not
+      // written into the next output step.
+      m_aggregateStaged.clear();
+      m_timestepIndex.clear();
+
+      // The checkpoint is not published, but its directory may still be
+      // expired (removed) later, so let its files be finished first.
+      if( m_isCheckpointTimeStep && m_asyncWriter ) {
+        m_asyncWriter->flush();
+      }
       return;
     }
 
     simTime -= delT;
   }
 
+  // Write the data staged for aggregation before it is referenced.
+  aggregateOutput( grid );
+
+  // A checkpoint is only referenced in checkpoints/index.xml once every
+  // rank's data files for it are on disk, so a restart never reads a
+  // partially written checkpoint.  (The output tasks of the other ranks
+  // may still be writing in the background or as aggregators.)
+  if( m_isCheckpointTimeStep &&
+      ( m_asyncWriter || m_aggregateComm != MPI_COMM_NULL ) ) {
+    if( m_asyncWriter ) {
+      m_asyncWriter->flush();
+    }
+    Uintah::MPI::Barrier( d_myworld->getComm() );
+  }
+
   Timers::Simple timer;
   timer.start();
   
@@ -1750,6 +1906,9 @@ DataArchiver::writeto_xml_files( const GridP& grid )
     // in checkpoints, there are two types of vars (global and
     // normal)).
     vector< vector<SaveItem>* > savelist; 
+
+    // (Collective.)
+    string indexParts = gatherTimestepIndex( baseDirs[i] == &m_outputDir ? OUTPUT : CHECKPOINT );
     
     // Reference this timestep in index.xml
     if( m_writeMeta ) {
@@ -1947,6 +2106,12 @@ DataArchiver::writeto_xml_files( const GridP& grid )
         string name = baseDirs[i]->getName() + "/" + tname.str() + "/timestep.xml";
         rootElem->output( name.c_str() );
 
+        // The binary index of the data xml files, after (not older than)
+        // timestep.xml.
+        if( !indexParts.empty() ) {
+          UdaIndex::write( indexParts, baseDirs[i]->getName() + "/" + tname.str() + "/timestep.idx" );
+        }
+
         //__________________________________
         // output input.xml & input.xml.orig
 
@@ -2012,6 +2177,8 @@ DataArchiver::writeto_xml_files( const GridP& grid )
     } // end if m_writeMeta
   }  // loop over baseDirs
 
+  m_timestepIndex.clear();
+
   double myTime = timer().seconds();
   (*m_runtimeStats)[XMLIOTime] += myTime;
   (*m_runtimeStats)[TotalIOTime ] += myTime;
@@ -2021,6 +2188,270 @@ DataArchiver::writeto_xml_files( const GridP& grid )
   }
 } // end writeto_xml_files()
 
+//______________________________________________________________________
+//  Called by every rank, for each directory written this time step.
+//  The parts are a few dozen bytes per (variable, material, patch);
+//  should their sum exceed what MPI_Gatherv can address, no
+//  timestep.idx is written and readers parse the xml files.
+string
+DataArchiver::gatherTimestepIndex( int type )
+{
+  string parts;
+  parts.swap( m_timestepIndex[ type ] );
+
+  if( d_myworld->nRanks() == 1 ) {
+    return parts;
+  }
+
+  MPI_Comm  comm = d_myworld->getComm();
+  const int rank = d_myworld->myRank();
+
+  long long         size = parts.size();
+  vector<long long> sizes( rank == 0 ? d_myworld->nRanks() : 0 );
+  Uintah::MPI::Gather( &size, 1, MPI_LONG_LONG, sizes.data(), 1, MPI_LONG_LONG, 0, comm );
+
+  vector<int> counts( sizes.size() );
+  vector<int> displs( sizes.size() );
+  long long   total = 0;
+  for( size_t r = 0; r < sizes.size(); r++ ) {
+    counts[r] = (int) sizes[r];
+    displs[r] = (int) total;
+    total += sizes[r];
+  }
+
+  int fits = ( total <= INT_MAX );
+  Uintah::MPI::Bcast( &fits, 1, MPI_INT, 0, comm );
+  if( !fits ) {
+    proc0cout << "DataArchiver: the index of time step " << getTimeStepTopLevel()
+              << " is too large to gather, not writing timestep.idx\n";
+    return "";
+  }
+
+  string gathered( total, '\0' );
+  Uintah::MPI::Gatherv( &parts[0], (int) size, MPI_BYTE, &gathered[0], counts.data(), displs.data(), MPI_BYTE, 0, comm );
+
+  return gathered;
+}
+
+//______________________________________________________________________
+//
+void
+DataArchiver::setupAggregateOutput( int ranksPerFile )
+{
+  MPI_Comm comm = d_myworld->getComm();
+  int      rank = d_myworld->myRank();
+
+  if( ranksPerFile > 0 ) {
+    Uintah::MPI::Comm_split( comm, rank / ranksPerFile, rank, &m_aggregateComm );
+  }
+  else {
+    if( MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &m_aggregateComm ) != MPI_SUCCESS ) {
+      throw InternalError( "DataArchiver::setupAggregateOutput(): MPI_Comm_split_type failed", __FILE__, __LINE__ );
+    }
+  }
+
+  // The lowest rank of each group (rank 0 of m_aggregateComm) is its aggregator.
+  int aggregator = rank;
+  Uintah::MPI::Bcast( &aggregator, 1, MPI_INT, 0, m_aggregateComm );
+
+  m_aggregatorOf.resize( d_myworld->nRanks() );
+  Uintah::MPI::Allgather( &aggregator, 1, MPI_INT, &m_aggregatorOf[0], 1, MPI_INT, comm );
+
+  m_aggregateGroups.clear();
+  for( int i = 0; i < d_myworld->nRanks(); i++ ) {
+    m_aggregateGroups[ m_aggregatorOf[i] ].addInOrder( i );
+  }
+
+  proc0cout << "DataArchiver: aggregating the output of " << d_myworld->nRanks()
+            << " ranks into " << m_aggregateGroups.size() << " file(s) per level\n";
+}
+
+//______________________________________________________________________
+//
+int
+DataArchiver::outputFileRank( int rank ) const
+{
+  return m_aggregatorOf.empty() ? rank : m_aggregatorOf[ rank ];
+}
+
+//______________________________________________________________________
+//  Called by every rank once the output/checkpoint tasks have run.
+//  All ranks visit the same (type, level) pairs in the same order.
+void
+DataArchiver::aggregateOutput( const GridP & grid )
+{
+  if( m_aggregateComm == MPI_COMM_NULL ) {
+    return;
+  }
+
+  ostringstream tname;
+  tname << "t" << setw(5) << setfill('0') << getTimeStepTopLevel();
+
+  for( int type = OUTPUT; type <= CHECKPOINT; ++type ) {
+    if( ( type == OUTPUT     && !m_isOutputTimeStep ) ||
+        ( type == CHECKPOINT && !m_isCheckpointTimeStep ) ) {
+      continue;
+    }
+
+    Timers::Simple timer;
+    timer.start();
+
+    Dir tdir = ( type == OUTPUT ? m_outputDir : m_checkpointsDir ).getSubdir( tname.str() );
+
+    for( int l = 0; l < grid->numLevels(); ++l ) {
+      ostringstream lname;
+      lname << "l" << l;
+      aggregateLevel( type, tdir.getSubdir( lname.str() ), l );
+    }
+
+    double myTime = timer().seconds();
+
+    (*m_runtimeStats)[ type == OUTPUT ? OutputIOTime : CheckpointIOTime ] += myTime;
+    (*m_runtimeStats)[ TotalIOTime ] += myTime;
+  }
+
+  m_aggregateStaged.clear();
+}
+
+//______________________________________________________________________
+//  Members send their staged data and xml to the aggregator, which
+//  appends them (in rank order, PADSIZE aligned) to lX/pxxxxx.data and
+//  merges the <Variable> entries, shifted by each member's offset,
+//  into lX/pxxxxx.xml.
+void
+DataArchiver::aggregateLevel( int type, const Dir & ldir, int levelIndex )
+{
+  int groupRank;
+  int groupSize;
+  Uintah::MPI::Comm_rank( m_aggregateComm, &groupRank );
+  Uintah::MPI::Comm_size( m_aggregateComm, &groupSize );
+
+  map< pair<int, int>, AggregateStage >::iterator staged = m_aggregateStaged.find( make_pair( type, levelIndex ) );
+
+  // header[0] - 1 if this rank output the level, header[1] - data
+  // bytes, header[2] - xml bytes.
+  if( groupRank != 0 ) {
+    long long header[3] = { 0, 0, 0 };
+    string    xml;
+
+    if( staged != m_aggregateStaged.end() ) {
+      xml = staged->second.doc->outputToString();
+
+      header[0] = 1;
+      header[1] = staged->second.data.size();
+      header[2] = xml.size();
+    }
+
+    Uintah::MPI::Send( header, 3, MPI_LONG_LONG, 0, 0, m_aggregateComm );
+
+    if( header[0] ) {
+      sendBytes( staged->second.data, 0, 1, m_aggregateComm );
+      sendBytes( xml,                 0, 2, m_aggregateComm );
+    }
+    return;
+  }
+
+  ostringstream pname;
+  pname << "p" << setw(5) << setfill('0') << d_myworld->myRank();
+
+  string xmlFilename  = ldir.getName() + "/" + pname.str() + ".xml";
+  string dataFilebase = pname.str() + ".data";
+  string dataFilename = ldir.getName() + "/" + dataFilebase;
+
+  ProblemSpecP doc;
+  string       file;       // the whole data file when writing asynchronously
+  int          fd  = -1;
+  long         cur = 0;
+
+  for( int member = 0; member < groupSize; ++member ) {
+    string       data;
+    ProblemSpecP memberDoc;
+
+    if( member == 0 ) {
+      if( staged == m_aggregateStaged.end() ) {
+        continue;
+      }
+      data.swap( staged->second.data );
+      memberDoc = staged->second.doc;
+    }
+    else {
+      long long header[3];
+      Uintah::MPI::Recv( header, 3, MPI_LONG_LONG, member, 0, m_aggregateComm, MPI_STATUS_IGNORE );
+
+      if( header[0] == 0 ) {
+        continue;
+      }
+
+      string xml;
+      recvBytes( data, header[1], member, 1, m_aggregateComm );
+      recvBytes( xml,  header[2], member, 2, m_aggregateComm );
+      memberDoc = scinew ProblemSpec( xml );
+    }
+
+    if( doc == nullptr ) {
+      doc = ProblemSpec::createDocument( "Uintah_Output" );
+
+      if( !m_asyncWriter ) {
+        fd = openDataFile( dataFilename );
+      }
+    }
+
+    // The member's offsets are PADSIZE aligned relative to its own data.
+    long offset = cur;
+    if( offset % PADSIZE != 0 ) {
+      offset += PADSIZE - offset % PADSIZE;
+    }
+
+    if( m_asyncWriter ) {
+      file.append( offset - cur, '\0' );
+      file.append( data );
+    }
+    else {
+      writeDataFile( fd, string( offset - cur, '\0' ), dataFilename );
+      writeDataFile( fd, data, dataFilename );
+    }
+    cur = offset + data.size();
+
+    for( ProblemSpecP var = memberDoc->findBlock( "Variable" ); var != nullptr; var = var->findNextBlock( "Variable" ) ) {
+      long start;
+      long end;
+      var->get( "start", start );
+      var->get( "end",   end );
+
+      ProblemSpecP entry = doc->importNode( var, true );
+      entry->removeChild( entry->findBlock( "start" ) );
+      entry->removeChild( entry->findBlock( "end" ) );
+      entry->removeChild( entry->findBlock( "filename" ) );
+
+      entry->appendElement( "start",    start + offset );
+      entry->appendElement( "end",      end   + offset );
+      entry->appendElement( "filename", dataFilebase.c_str() );
+
+      doc->appendChild( entry );
+    }
+  }
+
+  if( doc == nullptr ) {
+    return;
+  }
+
+  ostringstream xmlName;
+  xmlName << "l" << levelIndex << "/" << pname.str() << ".xml";
+  m_timestepIndex[ type ] += UdaIndex::part( xmlName.str(), doc );
+
+  if( m_asyncWriter ) {
+    string xml = doc->outputToString();
+    m_asyncWriter->enqueue( dataFilename, file, xmlFilename, xml );
+  }
+  else {
+    if( close( fd ) == -1 ) {
+      cerr << "Error closing file: " << dataFilename << ", errno=" << errno << '\n';
+      throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
+    }
+    doc->output( xmlFilename.c_str() );
+  }
+}
+
 //______________________________________________________________________
 //  Update the xml file index.xml with any in situ modified variables.
 
@@ -2172,7 +2603,7 @@ DataArchiver::writeGridBinary( const bool hasGlobals, const string & grid_path,
       int       rank_id    = m_loadBalancer->getOutputRank( patch );
 
       int proc = m_loadBalancer->getOutputRank( patch );
-      procOnLevel[ lev ][ proc ] = true;
+      procOnLevel[ lev ][ outputFileRank( proc ) ] = true;
 
       IntVector ecliiv  = patch->getExtraCellLowIndex();
       IntVector echiiv = patch->getExtraCellHighIndex();
@@ -2286,7 +2717,7 @@ DataArchiver::writeGridOriginal( const bool hasGlobals, const GridP & grid, Prob
       IntVector hi_EC = patch->getExtraCellHighIndex();
           
       int proc = m_loadBalancer->getOutputRank( patch );
-      procOnLevel[ l ][ proc ] = true;
+      procOnLevel[ l ][ outputFileRank( proc ) ] = true;
 
       Box box = patch->getExtraBox();
       ProblemSpecP patchElem = levelElem->appendChild("Patch");
@@ -2334,6 +2765,11 @@ DataArchiver::writeGridOriginal( const bool hasGlobals, const GridP & grid, Prob
 
       df->setAttribute( "href", pname.str() );
       df->setAttribute( "proc", procID.str() );
+
+      // The ranks whose data was aggregated into this file.
+      if( m_aggregateComm != MPI_COMM_NULL ) {
+        df->setAttribute( "ranks", m_aggregateGroups[ i ].toString() );
+      }
     }
   }
 
@@ -2426,7 +2862,7 @@ DataArchiver::writeGridTextWriter( const bool hasGlobals, const string & grid_pa
       IntVector hi_EC = patch->getExtraCellHighIndex();
           
       int proc = m_loadBalancer->getOutputRank( patch );
-      procOnLevel[ l ][ proc ] = true;
+      procOnLevel[ l ][ outputFileRank( proc ) ] = true;
 
       Box box = patch->getExtraBox();
 
@@ -2514,6 +2950,11 @@ DataArchiver::writeDataTextWriter( const bool hasGlobals, const string & data_pa
       xmlTextWriterWriteAttribute( data_writer, BAD_CAST "href", BAD_CAST pname.str().c_str() );
       xmlTextWriterWriteAttribute( data_writer, BAD_CAST "proc", BAD_CAST procID.str().c_str() );
 
+      // The ranks whose data was aggregated into this file.
+      if( m_aggregateComm != MPI_COMM_NULL ) {
+        xmlTextWriterWriteAttribute( data_writer, BAD_CAST "ranks", BAD_CAST m_aggregateGroups[ i ].toString().c_str() );
+      }
+
       xmlTextWriterEndElement( data_writer ); // Close <Datafile>
     }
   }
@@ -2934,6 +3375,7 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
   Dir ldir;
   
   string xmlFilename;
+  string xmlName;       // relative to tdir, for timestep.idx
   string dataFilebase;
   string dataFilename;
   const Level* level = nullptr;
@@ -2962,11 +3404,13 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
     ostringstream pname;
     pname << "p" << setw(5) << setfill('0') << d_myworld->myRank();
     xmlFilename = ldir.getName() + "/" + pname.str() + ".xml";
+    xmlName = lname.str() + "/" + pname.str() + ".xml";
     dataFilebase = pname.str() + ".data";
     dataFilename = ldir.getName() + "/" + dataFilebase;
   }
   else { // type == CHECKPOINT_GLOBAL
     xmlFilename =  tdir.getName() + "/global.xml";
+    xmlName = "global.xml";
     dataFilebase = "global.data";
     dataFilename = tdir.getName() + "/" + dataFilebase;
   }
@@ -2982,6 +3426,16 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
   // file, but also lock because xerces (DOM..) has thread-safety issues.
 
   if( m_outputFileFormat == UDA || type == CHECKPOINT_GLOBAL ) {
+
+    // Asynchronous and aggregated output: the data file is staged here
+    // and written by m_asyncWriter after the lock is released, or by
+    // the aggregator in writeto_xml_files().
+    const bool aggregating = ( m_aggregateComm != MPI_COMM_NULL && type != CHECKPOINT_GLOBAL );
+    const bool staging     = ( m_asyncWriter != nullptr || aggregating );
+
+    std::string  staged;
+    std::string  stagedXml;
+
     m_outputLock.lock(); 
     {  
       // Make sure doc's constructor is called after the lock.
@@ -3005,40 +3459,12 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
       }
       
       //__________________________________
-      // Open the data file:
-      //
-      // Note: At least one time on a BGQ machine (Vulcan@LLNL), with
-      // 160K patches, a single checkpoint file failed to open, and it
-      // 'crashed' the simulation.  As the other processes on the node
-      // successfully opened their file, it is possible that a second
-      // open call would have succeeded.  (The original error no was
-      // 71.)  Therefore I am using a while loop and counting the
-      // 'tries'.
-      
-      int tries = 1;
-      int flags = O_WRONLY|O_CREAT|O_TRUNC;       // file-opening flags
-      
+      // Open the data file (unless staging it in memory):
       const char* filename = dataFilename.c_str();
-      int fd  = open( filename, flags, 0666 );
-      
-      while( fd == -1 ) {
-
-        if( tries >= 50 ) {
-          ostringstream msg;
-          
-          msg << "DataArchiver::output(): Failed to open file '"
-              << dataFilename << "' (after 50 tries).";
-          throw ErrnoException( msg.str(), errno, __FILE__, __LINE__ );
-        }
+      int fd = -1;
 
-        fd = open( filename, flags, 0666 );
-        tries++;
-      }
-      
-      if( tries > 1 ) {
-        proc0cout << "WARNING: There was a glitch in trying to open the "
-                  << "checkpoint file: " << dataFilename << ". "
-                  << "It took " << tries << " tries to successfully open it.";
+      if( !staging ) {
+        fd = openDataFile( dataFilename );
       }
 
       //__________________________________
@@ -3100,7 +3526,12 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
               pdElem->appendElement("boundaryLayer", var->getBoundaryLayer());
             }
             // Pad appropriately
-            if( cur % PADSIZE != 0 ) {
+            if( cur % PADSIZE != 0 && staging ) {
+              long pad = PADSIZE-cur%PADSIZE;
+              staged.append( pad, '\0' );
+              cur+=pad;
+            }
+            else if( cur % PADSIZE != 0 ) {
               long pad = PADSIZE-cur%PADSIZE;
               char* zero = scinew char[pad];
               memset(zero, 0, pad);
@@ -3119,22 +3550,34 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
             
             // output data to data file
             OutputContext oc(fd, filename, cur, pdElem, m_outputDoubleAsFloat && type != CHECKPOINT);
+            if( staging ) {
+              oc.buffer = &staged;
+            }
+            if( type == OUTPUT ) {
+              oc.lossyAbsTolerance = saveIter->lossyAbsTolerance;
+              oc.lossyRelTolerance = saveIter->lossyRelTolerance;
+            }
             totalBytes += dw->emit(oc, var, matlIndex, patch);
 
             pdElem->appendElement("end", oc.cur);
             pdElem->appendElement("filename", dataFilebase.c_str());
             
 #if SCI_ASSERTION_LEVEL >= 1
-            struct stat st;
-            int s = fstat(fd, &st);
+            if( staging ) {
+              ASSERTEQ(oc.cur, (long) staged.size());
+            }
+            else {
+              struct stat st;
+              int s = fstat(fd, &st);
             
-            if(s == -1) {
-              cerr << "fstat error - file: " << filename
-                   << ", errno=" << errno << '\n';
-              throw ErrnoException("DataArchiver::output (stat call)",
-                                   errno, __FILE__, __LINE__);
+              if(s == -1) {
+                cerr << "fstat error - file: " << filename
+                     << ", errno=" << errno << '\n';
+                throw ErrnoException("DataArchiver::output (stat call)",
+                                     errno, __FILE__, __LINE__);
+              }
+              ASSERTEQ(oc.cur, st.st_size);
             }
-            ASSERTEQ(oc.cur, st.st_size);
 #endif
             cur = oc.cur;
           }  // matls
@@ -3143,18 +3586,38 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
       
       //__________________________________
       // close files and handles 
-      int s = close( fd );
-      if( s == -1 ) {
-        cerr << "Error closing file: " << filename << ", errno=" << errno << '\n';
-        throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
+      if( aggregating ) {
+        AggregateStage & stage = m_aggregateStaged[ make_pair( type, level->getIndex() ) ];
+        stage.data.swap( staged );
+        stage.doc = doc;
       }
+      else {
+        m_timestepIndex[ type == OUTPUT ? OUTPUT : CHECKPOINT ] += UdaIndex::part( xmlName, doc );
+
+        if( staging ) {
+          // Serialized while the lock is held; the I/O threads never see the DOM.
+          stagedXml = doc->outputToString();
+        }
+        else {
+          int s = close( fd );
+          if( s == -1 ) {
+            cerr << "Error closing file: " << filename << ", errno=" << errno << '\n';
+            throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
+          }
       
-      doc->output( xmlFilename.c_str() );
-      //doc->releaseDocument();
+          doc->output( xmlFilename.c_str() );
+          //doc->releaseDocument();
+        }
+      }
 
     } // end output locked section
 
     m_outputLock.unlock(); 
+
+    // May block until enough previously staged data has been written
+    if( m_asyncWriter && !aggregating ) {
+      m_asyncWriter->enqueue( dataFilename, staged, xmlFilename, stagedXml );
+    }
   } // end UDA or Global Var
 
 #if HAVE_PIDX
@@ -3885,6 +4348,26 @@ DataArchiver::initSaveLabels( SchedulerP & sched, bool initTimeStep )
     }
     saveItem.label = var;
     saveItem.matlSet.clear();
+    saveItem.lossyAbsTolerance = (*iter).lossyAbsTolerance;
+    saveItem.lossyRelTolerance = (*iter).lossyRelTolerance;
+
+    //  bullet proofing: lossy compression is only for floating point grid variables
+    if ( saveItem.lossyAbsTolerance > 0.0 || saveItem.lossyRelTolerance > 0.0 ) {
+      const TypeDescription* td = var->typeDescription();
+      const TypeDescription::Type type = td->getType();
+      const TypeDescription::Type subType = td->getSubType() ? td->getSubType()->getType() : TypeDescription::Unknown;
+
+      bool isGridVar = ( type == TypeDescription::CCVariable   || type == TypeDescription::NCVariable ||
+                         type == TypeDescription::SFCXVariable || type == TypeDescription::SFCYVariable ||
+                         type == TypeDescription::SFCZVariable );
+      bool isFloatingPoint = ( subType == TypeDescription::double_type || subType == TypeDescription::float_type ||
+                               subType == TypeDescription::Vector      || subType == TypeDescription::Matrix3 );
+
+      if ( !isGridVar || !isFloatingPoint ) {
+        throw ProblemSetupException( (*iter).labelName + ": lossy compression tolerances can only be used with "
+                                     "floating point grid variables.", __FILE__, __LINE__ );
+      }
+    }
 
     for ( ConsecutiveRangeSet::iterator crs_iter = (*iter).levels.begin(); crs_iter != (*iter).levels.end(); ++crs_iter ) {
 
@@ -25,6 +25,7 @@
 #ifndef UINTAH_HOMEBREW_DataArchiver_H
 #define UINTAH_HOMEBREW_DataArchiver_H
 
+#include <CCA/Components/DataArchiver/AsyncOutputWriter.h>
 #include <CCA/Ports/Output.h>
 #include <CCA/Ports/PIDXOutputContext.h>
 
@@ -272,6 +273,8 @@ class LoadBalancer;
       std::string         compressionMode;
       ConsecutiveRangeSet matls;
       ConsecutiveRangeSet levels;
+      double              lossyAbsTolerance {0.0};
+      double              lossyRelTolerance {0.0};
     };
 
     class SaveItem {
@@ -287,6 +290,10 @@ class LoadBalancer;
 
       const VarLabel* label;
       std::map<int, MaterialSetP> matlSet;
+
+      // lossy compression error bounds (output only, never checkpoints)
+      double lossyAbsTolerance {0.0};
+      double lossyRelTolerance {0.0};
     };
 
   private:
@@ -348,6 +355,28 @@ class LoadBalancer;
                           const GridP& grid,
                                 std::string* pTimeStepDir );
 
+    //__________________________________
+    //         Aggregated output
+    //! Sets up m_aggregateComm, grouping either ranksPerFile consecutive
+    //! ranks or (ranksPerFile == 0) the ranks sharing a node.
+    void setupAggregateOutput( int ranksPerFile );
+
+    //! Gathers the per-level data staged by outputVariables() on each
+    //! member of m_aggregateComm and writes it out on the aggregator
+    //! as a single data and xml file per level.
+    void aggregateOutput( const GridP & grid );
+
+    void aggregateLevel( int type, const Dir & ldir, int levelIndex );
+
+    //! Collects the UdaIndex parts of the data xml files all ranks wrote
+    //! for 'type' (OUTPUT or CHECKPOINT) on rank 0, which writes them as
+    //! the timestep's timestep.idx.  Returns the parts on rank 0.
+    std::string gatherTimestepIndex( int type );
+
+    //! Returns the rank whose lX/pxxxxx.xml file holds the data output
+    //! by 'rank' (the rank itself unless aggregating).
+    int outputFileRank( int rank ) const;
+
     PIDXOutputContext::PIDX_flags m_PIDX_flags; // Contains the knobs & switches
 #if HAVE_PIDX       
 
@@ -656,6 +685,27 @@ class LoadBalancer;
 #endif
     Uintah::MasterLock m_outputLock;
 
+    // Asynchronous output: data files are staged in memory by the output
+    // tasks and written by background I/O threads (nullptr == synchronous).
+    AsyncOutputWriter * m_asyncWriter {nullptr};
+
+    // Aggregated output: members of m_aggregateComm stage each level's
+    // data in memory and the group root (the aggregator) gathers and
+    // writes it in writeto_xml_files() (MPI_COMM_NULL == one file per rank).
+    struct AggregateStage {
+      std::string  data;
+      ProblemSpecP doc;
+    };
+
+    MPI_Comm                                      m_aggregateComm {MPI_COMM_NULL};
+    std::vector<int>                              m_aggregatorOf;    // rank -> aggregator rank
+    std::map<int, ConsecutiveRangeSet>            m_aggregateGroups; // aggregator rank -> member ranks
+    std::map< std::pair<int, int>, AggregateStage > m_aggregateStaged; // (type, level index)
+
+    // UdaIndex parts of the data xml files this rank wrote this time
+    // step, by OUTPUT / CHECKPOINT (which includes global.xml).
+    std::map<int, std::string>                    m_timestepIndex;
+
     DataArchiver(const DataArchiver&);
     DataArchiver& operator=(const DataArchiver&);      
   };
@@ -31,10 +31,12 @@ include $(SCIRUN_SCRIPTS)/smallso_prologue.mk
 
 SRCDIR   := CCA/Components/DataArchiver
 
-SRCS     += $(SRCDIR)/DataArchiver.cc
+SRCS     += $(SRCDIR)/DataArchiver.cc \
+            $(SRCDIR)/AsyncOutputWriter.cc
 
 PSELIBS := \
 	CCA/Ports          \
+	Core/DataArchive   \
 	Core/Parallel      \
 	Core/GeometryPiece \
 	Core/Grid          \
@@ -56,6 +56,20 @@ Advector::~Advector()
 {
 }
 
+//______________________________________________________________________
+//
+void Advector::advectQ(const vector<const CCVariable<double>*>& q_CC,
+                       const vector<string>& desc,
+                       const CCVariable<double>& mass,
+                       vector<CCVariable<double>*>& q_advected,
+                       advectVarBasket* vb)
+{
+  for(unsigned int i = 0; i < q_CC.size(); i++){
+    vb->desc = desc[i];
+    advectQ(*q_CC[i], mass, *q_advected[i], vb);
+  }
+}
+
 
 //______________________________________________________________________
 //  
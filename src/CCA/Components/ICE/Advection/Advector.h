@@ -96,6 +96,15 @@ namespace Uintah {
                          const CCVariable<double>& mass,
                          CCVariable<Vector>& q_advected,
                          advectVarBasket* vb)=0; 
+
+    // Advects several quantities in one sweep over the outflux slabs.
+    // desc[i] is the name of q_CC[i] (for refluxing) and vb->is_Q_massSpecific
+    // applies to all of them.  The default calls advectQ on each one.
+    virtual void advectQ(const std::vector<const CCVariable<double>*>& q_CC,
+                         const std::vector<std::string>& desc,
+                         const CCVariable<double>& mass,
+                         std::vector<CCVariable<double>*>& q_advected,
+                         advectVarBasket* vb);
                          
     virtual void advectMass(const CCVariable<double>& mass,
                            CCVariable<double>& q_advected,
@@ -256,6 +256,23 @@ void FirstOrderAdvector::advectQ(const CCVariable<Vector>& q_CC,
   q_FC_fluxes<Vector>(q_CC, varBasket->desc, varBasket);
 } 
 
+//__________________________________
+//     S E V E R A L   D O U B L E S
+// (int_eng, sp_vol * mass, transported Variables)
+void FirstOrderAdvector::advectQ(const vector<const CCVariable<double>*>& q_CC,
+                                 const vector<string>& desc,
+                                 const CCVariable<double>& /*mass*/,
+                                 vector<CCVariable<double>*>& q_advected,
+                                 advectVarBasket* varBasket)
+{
+  advectSlabs(q_CC, varBasket->patch, q_advected, varBasket);
+
+  // fluxes on faces at the coarse fine interfaces
+  for(unsigned int i = 0; i < q_CC.size(); i++){
+    q_FC_fluxes<double>(*q_CC[i], desc[i], varBasket);
+  }
+}
+
 /*_____________________________________________________________________
  Function~  Advect--  driver program that does the advection  
 _____________________________________________________________________*/
@@ -304,6 +321,47 @@ template <class T, typename F>
     save_q_FC(c, q_XFC, q_YFC, q_ZFC, faceVol, q_face_flux, q_CC); 
   }
 }
+/*_____________________________________________________________________
+ Function~  Advect--  advects several quantities in one sweep.  The slab
+ volumes of a cell are loaded once for all the quantities.
+_____________________________________________________________________*/
+void FirstOrderAdvector::advectSlabs(const vector<const CCVariable<double>*>& q_CC,
+                                     const Patch* patch,
+                                     vector<CCVariable<double>*>& q_advected,
+                                     advectVarBasket* VB)
+{
+  Vector dx = patch->dCell();            
+  double invvol = 1.0/(dx.x() * dx.y() * dx.z());                     
+
+  CCVariable<fflux>& OFS = VB->OFS;  // for brevity
+  const unsigned int nQ = q_CC.size();
+
+  for(CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) { 
+    const IntVector& c = *iter;  
+
+    IntVector ac[6];                 // slab adjacent cells
+    double outfluxVol[6];
+    double influxVol[6];
+
+    for(int f = TOP; f <= BACK; f++ )  {
+      ac[f]         = c + S_ac[f];
+      outfluxVol[f] = OFS[c    ].fflux[OF_slab[f]];
+      influxVol[f]  = OFS[ac[f]].fflux[IF_slab[f]];
+    }
+
+    for(unsigned int i = 0; i < nQ; i++){
+      const CCVariable<double>& q = *q_CC[i];
+      const double q_c = q[c];
+
+      double sum_q_face_flux(0.0);
+      for(int f = TOP; f <= BACK; f++ )  {
+        sum_q_face_flux += q[ac[f]] * influxVol[f] - q_c * outfluxVol[f];
+      }
+      (*q_advected[i])[c] = sum_q_face_flux*invvol;
+    }
+  }
+}
+
 /*_____________________________________________________________________
  Function~ q_FC_operator
  Compute q at the face center.
@@ -74,6 +74,12 @@ namespace Uintah {
                          const CCVariable<double>& mass,
                          CCVariable<Vector>& q_advected,
                          advectVarBasket* vb); 
+
+    virtual void advectQ(const std::vector<const CCVariable<double>*>& q_CC,
+                         const std::vector<std::string>& desc,
+                         const CCVariable<double>& mass,
+                         std::vector<CCVariable<double>*>& q_advected,
+                         advectVarBasket* vb);
                          
     virtual void advectMass(const CCVariable<double>& mass,
                             CCVariable<double>& q_advected,
@@ -94,6 +100,11 @@ namespace Uintah {
                        SFCZVariable<double>& q_ZFC,
                        F function,
                        advectVarBasket* VB); 
+
+      void advectSlabs(const std::vector<const CCVariable<double>*>& q_CC,
+                       const Patch* patch,
+                       std::vector<CCVariable<double>*>& q_advected,
+                       advectVarBasket* VB);
                                                        
     template<class T>
       void q_FC_operator(CellIterator iter, 
@@ -356,6 +356,78 @@ void SecondOrderAdvector::advectQ( const CCVariable<double>& A_CC,
                       
   q_FC_fluxes<double>(q_CC, q_OAFS, varBasket->desc, varBasket);  
 }
+//__________________________________
+//     S E V E R A L   D O U B L E S
+// The quantities are done in groups of up to Q_GROUP_SIZE.  The limited
+// gradients and slab values are found one quantity at a time (reusing the
+// temporaries), then the group is advected in one sweep.  The slab values of
+// a group (six doubles per cell per quantity) are reused by the next group, so
+// the temporaries do not grow with the number of quantities.
+void SecondOrderAdvector::advectQ( const vector<const CCVariable<double>*>& A_CC,
+                                   const vector<string>& desc,
+                                   const CCVariable<double>& mass,
+                                   vector<CCVariable<double>*>& q_advected,
+                                   advectVarBasket* varBasket)
+{
+  // pull variables out of the basket
+  const Patch* patch       = varBasket->patch;
+  DataWarehouse* new_dw    = varBasket->new_dw;
+  bool useCompatibleFluxes = varBasket->useCompatibleFluxes;
+  bool is_Q_massSpecific   = varBasket ->is_Q_massSpecific;
+  
+  d_smokeOnOff = false;
+
+  const unsigned int Q_GROUP_SIZE = 4;
+  const unsigned int nQ = A_CC.size();
+
+  Ghost::GhostType  gac = Ghost::AroundCells;
+  vector<CCVariable<facedata<double> > > q_OAFS( min(Q_GROUP_SIZE, nQ) );
+  CCVariable<vertex<double> > q_vertex;
+  CCVariable<double> q_grad_x, q_grad_y, q_grad_z, q_CC;
+    
+  new_dw->allocateTemporary(q_CC,     patch,gac,2);  
+  new_dw->allocateTemporary(q_grad_x, patch,gac,1);
+  new_dw->allocateTemporary(q_grad_y, patch,gac,1);
+  new_dw->allocateTemporary(q_grad_z, patch,gac,1);
+  new_dw->allocateTemporary(q_vertex, patch,gac,2);
+
+  for(unsigned int g = 0; g < q_OAFS.size(); g++){
+    new_dw->allocateTemporary(q_OAFS[g], patch,gac,1);
+  }
+
+  for(unsigned int i0 = 0; i0 < nQ; i0 += Q_GROUP_SIZE){
+    const unsigned int nGroup = min(Q_GROUP_SIZE, nQ - i0);
+    vector<CCVariable<double>*> q_advected_group(nGroup);
+
+    for(unsigned int g = 0; g < nGroup; g++){
+      const unsigned int i = i0 + g;
+      q_advected_group[g] = q_advected[i];
+
+      // convert from flux to primitive var. if using compatible fluxes
+      bool compatible = 
+       flux_to_primitive<double>(useCompatibleFluxes,is_Q_massSpecific,
+                                 patch, *A_CC[i], mass, q_CC); 
+      
+      // compute the limited gradients of q_CC
+      gradQ<double>(q_CC, patch, q_grad_x, q_grad_y, q_grad_z); 
+      
+      Q_vertex<double>(compatible, q_CC, q_vertex, patch,
+                        q_grad_x, q_grad_y,  q_grad_z); 
+
+      limitedGradient<double>(q_CC, patch, new_dw, q_vertex, 
+                              q_grad_x, q_grad_y,  q_grad_z);
+                                
+      // compute the value of q at the slab q_OAFS
+      qAverageFlux<double>( compatible, q_CC, mass, patch, q_OAFS[g], 
+                            q_grad_x, q_grad_y, q_grad_z);
+
+      q_FC_fluxes<double>(q_CC, q_OAFS[g], desc[i], varBasket);  
+    }
+          
+    advectSlabs(q_OAFS, patch, q_advected_group, varBasket);
+  }
+}
+
 //__________________________________
 //  S P E C I A L I Z E D   D O U B L E 
 //  needed by implicit solve  ( Non-compatible)
@@ -504,6 +576,49 @@ void SecondOrderAdvector::advectSlabs( CCVariable<facedata<T> >& q_OAFS,
     save_q_FC(c, q_XFC, q_YFC, q_ZFC, faceVol, q_face_flux, q_CC);
   }
 }
+/*_____________________________________________________________________
+ Function~  Advect--  advects several quantities in one sweep.  The slab
+ volumes of a cell are loaded once for all the quantities.  q_advected[i]
+ uses the slab values in q_OAFS[i]; q_OAFS may have more entries.
+_____________________________________________________________________*/
+void SecondOrderAdvector::advectSlabs( const vector<CCVariable<facedata<double> > >& q_OAFS,
+                                       const Patch* patch,
+                                       vector<CCVariable<double>*>& q_advected,
+                                       advectVarBasket* VB)
+{
+                                 //  W A R N I N G
+  Vector dx = patch->dCell();    // assumes equal cell spacing             
+  double invVol = 1.0/(dx.x() * dx.y() * dx.z());     
+
+  CCVariable<fflux>& OFS = VB->OFS;  // for brevity
+  const unsigned int nQ = q_advected.size();
+
+  for(CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) { 
+    const IntVector& c = *iter;
+
+    IntVector ac[6];                 // slab adjacent cells
+    double outfluxVol[6];
+    double influxVol[6];
+
+    for(int f = TOP; f <= BACK; f++ )  {
+      ac[f]         = c + S_ac[f];
+      outfluxVol[f] = OFS[c    ].fflux[OF_slab[f]];
+      influxVol[f]  = OFS[ac[f]].fflux[IF_slab[f]];
+    }
+
+    for(unsigned int i = 0; i < nQ; i++){
+      const CCVariable<facedata<double> >& q_slabs = q_OAFS[i];
+      const facedata<double>& q_c = q_slabs[c];
+
+      double sum_q_face_flux(0.0);
+      for(int f = TOP; f <= BACK; f++ )  {
+        sum_q_face_flux += q_slabs[ac[f]].fdata[IF_slab[f]] * influxVol[f]
+                         - q_c.fdata[OF_slab[f]] * outfluxVol[f];
+      }
+      (*q_advected[i])[c] = sum_q_face_flux*invVol;
+    }
+  }
+}
 //______________________________________________________________________
 template <class T>
 void
@@ -77,6 +77,12 @@ namespace Uintah {
                          const CCVariable<double>& mass,
                          CCVariable<Vector>& q_advected,
                          advectVarBasket* vb); 
+
+    virtual void advectQ(const std::vector<const CCVariable<double>*>& q_CC,
+                         const std::vector<std::string>& desc,
+                         const CCVariable<double>& mass,
+                         std::vector<CCVariable<double>*>& q_advected,
+                         advectVarBasket* vb);
                          
     virtual void advectMass(const CCVariable<double>& mass,
                             CCVariable<double>& q_advected,
@@ -106,6 +112,11 @@ namespace Uintah {
                        SFCZVariable<double>& q_ZFC,
                        F save_q_FC,
                        advectVarBasket* varBasket);  // passed in function
+
+      void advectSlabs(const std::vector<CCVariable<facedata<double> > >& q_OAFS,
+                       const Patch* patch,
+                       std::vector<CCVariable<double>*>& q_advected,
+                       advectVarBasket* varBasket);
                        
     template<class T>
       void q_FC_operator(CellIterator iter, 
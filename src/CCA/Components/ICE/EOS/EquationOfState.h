@@ -77,6 +77,23 @@ WARNING
                                   double& press, double& dp_drho, 
                                   double& dp_de) = 0;
 
+    // Blocks of cells
+    //
+    // computePressEOS and computeRhoMicro for the n cells of a block, used
+    // by the equilibration pressure solve.  The defaults call the per cell
+    // versions; models with closed form (or plain Newton) relations override
+    // them with loops over the block.  rhoM may be the same array as rho_guess.
+
+     virtual void computePressEOSBlock(const int n, const double* rhoM,
+                                       const double* gamma, const double* cv,
+                                       const double* Temp, double* press,
+                                       double* dp_drho, double* dp_de);
+
+     virtual void computeRhoMicroBlock(const int n, const double* press,
+                                       const double* gamma, const double* cv,
+                                       const double* Temp,
+                                       const double* rho_guess, double* rhoM);
+
     virtual void computeTempCC(const Patch* patch,
                                const std::string& comp_domain,
                                const CCVariable<double>& press, 
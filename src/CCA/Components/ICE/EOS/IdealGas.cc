@@ -93,6 +93,30 @@ void IdealGas::computePressEOS(double rhoM, double gamma,
   dp_drho = (gamma - 1.0)*cv*Temp;
   dp_de   = (gamma - 1.0)*rhoM;
 }
+
+//__________________________________
+void IdealGas::computePressEOSBlock(const int n, const double* rhoM,
+                                    const double* gamma, const double* cv,
+                                    const double* Temp, double* press,
+                                    double* dp_drho, double* dp_de)
+{
+  for (int i = 0; i < n; i++) {
+    press[i]   = (gamma[i] - 1.0)*rhoM[i]*cv[i]*Temp[i];
+    dp_drho[i] = (gamma[i] - 1.0)*cv[i]*Temp[i];
+    dp_de[i]   = (gamma[i] - 1.0)*rhoM[i];
+  }
+}
+
+//__________________________________
+void IdealGas::computeRhoMicroBlock(const int n, const double* press,
+                                    const double* gamma, const double* cv,
+                                    const double* Temp,
+                                    const double*, double* rhoM)
+{
+  for (int i = 0; i < n; i++) {
+    rhoM[i] = press[i]/((gamma[i] - 1.0)*cv[i]*Temp[i]);
+  }
+}
 //__________________________________
 // Return (1/v)*(dv/dT)  (constant pressure thermal expansivity)
 double IdealGas::getAlpha(double Temp, double , double , double )
@@ -75,6 +75,11 @@ WARNING
                                      double& press, double& dp_drho,
                                      double& dp_de);
 
+        virtual void computePressEOSBlock(const int n, const double* rhoM,
+                                          const double* gamma, const double* cv,
+                                          const double* Temp, double* press,
+                                          double* dp_drho, double* dp_de);
+
         virtual void computeTempCC(const Patch* patch,
                                    const std::string& comp_domain,
                                    const CCVariable<double>& press, 
@@ -213,6 +213,94 @@ void JWLC::computePressEOS(double rhoM, double, double, double,
   dp_de   = 0.0;
 }
 
+//__________________________________
+void JWLC::computePressEOSBlock(const int n, const double* rhoM,
+                                const double*, const double*,
+                                const double*, double* press,
+                                double* dp_drho, double* dp_de)
+{
+  double one_plus_omega = 1.+om;
+
+  for (int i = 0; i < n; i++) {
+    double inv_rho_rat=rho0/rhoM[i];
+    double rho_rat=rhoM[i]/rho0;
+    double A_e_to_the_R1_rho0_over_rhoM=A*exp(-R1*inv_rho_rat);
+    double B_e_to_the_R2_rho0_over_rhoM=B*exp(-R2*inv_rho_rat);
+    double C_rho_rat_tothe_one_plus_omega=C*pow(rho_rat,one_plus_omega);
+
+    press[i]   = A_e_to_the_R1_rho0_over_rhoM +
+                 B_e_to_the_R2_rho0_over_rhoM + C_rho_rat_tothe_one_plus_omega;
+
+    double rho0_rhoMsqrd = rho0/(rhoM[i]*rhoM[i]);
+    dp_drho[i] = R1*rho0_rhoMsqrd*A_e_to_the_R1_rho0_over_rhoM
+               + R2*rho0_rhoMsqrd*B_e_to_the_R2_rho0_over_rhoM
+               + (one_plus_omega/rhoM[i])*C_rho_rat_tothe_one_plus_omega;
+
+    dp_de[i]   = 0.0;
+  }
+}
+
+//__________________________________
+// The Newton iteration of computeRhoMicro on all the cells of the block at
+// once, each cell keeping its value once it has converged.  The (rare) cells
+// that have not converged after 100 iterations are redone by computeRhoMicro.
+void JWLC::computeRhoMicroBlock(const int n, const double* press,
+                                const double* gamma, const double* cv,
+                                const double* Temp,
+                                const double* rho_guess, double* rhoM_out)
+{
+  const int blockSize = 16;
+  double epsilon = 1.e-15;
+  double relfac=.9;
+  double one_plus_omega = 1.+om;
+
+  for (int i0 = 0; i0 < n; i0 += blockSize) {
+    const int nb = min(blockSize, n - i0);
+    double rhoM[blockSize], delta[blockSize];
+
+    for (int i = 0; i < nb; i++) {
+      rhoM[i]  = min(rho_guess[i0+i],rho0);
+      delta[i] = 1.;
+    }
+
+    bool notConverged = true;
+    for (int count = 0; count < 100 && notConverged; count++) {
+      notConverged = false;
+
+      for (int i = 0; i < nb; i++) {
+        bool active = fabs(delta[i]/rhoM[i])>epsilon;
+
+        double inv_rho_rat=rho0/rhoM[i];
+        double rho_rat=rhoM[i]/rho0;
+        double A_e_to_the_R1_rho0_over_rhoM=A*exp(-R1*inv_rho_rat);
+        double B_e_to_the_R2_rho0_over_rhoM=B*exp(-R2*inv_rho_rat);
+        double C_rho_rat_tothe_one_plus_omega=C*pow(rho_rat,one_plus_omega);
+
+        double f = (A_e_to_the_R1_rho0_over_rhoM +
+                    B_e_to_the_R2_rho0_over_rhoM + C_rho_rat_tothe_one_plus_omega) - press[i0+i];
+
+        double rho0_rhoMsqrd = rho0/(rhoM[i]*rhoM[i]);
+        double df_drho = R1*rho0_rhoMsqrd*A_e_to_the_R1_rho0_over_rhoM
+                       + R2*rho0_rhoMsqrd*B_e_to_the_R2_rho0_over_rhoM
+                       + (one_plus_omega/rhoM[i])*C_rho_rat_tothe_one_plus_omega;
+
+        double d = -relfac*(f/df_drho);
+        delta[i] = active ? d : delta[i];
+        rhoM[i]  = active ? fabs(rhoM[i] + d) : rhoM[i];
+        notConverged = notConverged || active;
+      }
+    }
+
+    for (int i = 0; i < nb; i++) {
+      if (fabs(delta[i]/rhoM[i])>epsilon) {
+        rhoM[i] = computeRhoMicro(press[i0+i], gamma[i0+i], cv[i0+i],
+                                  Temp[i0+i], rho_guess[i0+i]);
+      }
+      rhoM_out[i0+i] = rhoM[i];
+    }
+  }
+}
+
 //______________________________________________________________________
 // Update temperature boundary conditions due to hydrostatic pressure gradient
 // call this after set Dirchlet and Neuman BC
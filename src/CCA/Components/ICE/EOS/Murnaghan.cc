@@ -124,6 +124,41 @@ void Murnaghan::computePressEOS(double rhoM, double, double, double,
   dp_de   = 0.0;
 }
 
+//__________________________________
+void Murnaghan::computePressEOSBlock(const int numCells, const double* rhoM,
+                                     const double*, const double*,
+                                     const double*, double* press,
+                                     double* dp_drho, double* dp_de)
+{
+  for (int i = 0; i < numCells; i++) {
+    if(rhoM[i]>=rho0){
+      press[i]   = P0 + (1./(n*K))*(pow(rhoM[i]/rho0,n)-1.);
+      dp_drho[i] = (1./(K*rho0))*pow((rhoM[i]/rho0),n-1.);
+    }
+    else{
+      press[i]   = P0*pow(rhoM[i]/rho0,(1./(K*P0)));
+      dp_drho[i] = (1./(K*rho0))*pow(rhoM[i]/rho0,(1./(K*P0)-1.));
+    }
+    dp_de[i]   = 0.0;
+  }
+}
+
+//__________________________________
+void Murnaghan::computeRhoMicroBlock(const int numCells, const double* press,
+                                     const double*, const double*,
+                                     const double*, const double*,
+                                     double* rhoM)
+{
+  for (int i = 0; i < numCells; i++) {
+    if(press[i]>=P0){
+      rhoM[i] = rho0*pow((n*K*(press[i]-P0)+1.),1./n);
+    }
+    else{
+      rhoM[i] = rho0*pow((press[i]/P0),K*P0);
+    }
+  }
+}
+
 //______________________________________________________________________
 // Update temperature boundary conditions due to hydrostatic pressure gradient
 // call this after set Dirchlet and Neuman BC
@@ -71,6 +71,7 @@
 #include <Core/Math/Expon.h>
 #include <Core/Util/DebugStream.h>
 
+#include <deque>
 #include <vector>
 #include <sstream>
 #include <iostream>
@@ -2511,15 +2512,16 @@ void ICE::computeThermoTransportProperties(const ProcessorGroup*,
  ----------------
     - Compute rho_micro_CC, SpeedSound, vol_frac
 
-    For each cell
-    _ WHILE LOOP(convergence, max_iterations)
+    For each block of cells
+    _ WHILE LOOP(cells left in the block)
         - compute the pressure and dp_drho from the EOS of each material.
         - Compute delta Pressure
         - Compute delta volume fraction and update the 
           volume fraction and the celldensity.
         - Test for convergence of delta pressure and delta volume fraction
+        - converged cells (or at max_iterations) are bulletproofed
+          and leave the block
     - END WHILE LOOP
-    - bulletproofing
     end
 
 Note:  The nomenclature follows the reference.   
@@ -2545,14 +2547,11 @@ void ICE::computeEquilibrationPressure(const ProcessorGroup*,
     
     double    converg_coeff = 15;              
     double    convergence_crit = converg_coeff * DBL_EPSILON;
-    double    sum=0., tmp;
 
     unsigned int       numMatls = m_materialManager->getNumMatls( "ICE" );
     static int n_passes;                  
     n_passes ++; 
 
-    std::vector<double> press_eos(numMatls);
-    std::vector<double> dp_drho(numMatls),dp_de(numMatls);
     std::vector<CCVariable<double> > vol_frac(numMatls);
     std::vector<CCVariable<double> > rho_micro(numMatls);
     std::vector<CCVariable<double> > rho_CC_new(numMatls);
@@ -2613,177 +2612,273 @@ void ICE::computeEquilibrationPressure(const ProcessorGroup*,
     }
 
   //______________________________________________________________________
-  // Done with preliminary calcs, now loop over every cell
-    int count, test_max_iter = 0;
-    for (CellIterator iter=patch->getExtraCellIterator();!iter.done();iter++) {
-      IntVector c = *iter;   
-      double delPress = 0.;
-      bool converged  = false;
-      count           = 0;
-      vector<EqPress_dbg> dbgEqPress;
+  // Done with preliminary calcs, now iterate on blocks of cells.  The cells
+  // of a block are iterated together, through the block versions of the EOS,
+  // and each cell leaves the block once it has converged (or reached the
+  // max. number of iterations).  Block data is stored [m*blockSize + i].
+    const int blockSize = 16;
+
+    std::vector<EquationOfState*> eos(numMatls);
+    for (unsigned int m = 0; m < numMatls; m++) {
+      ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
+      eos[m] = ice_matl->getEOS();
+    }
+
+    std::vector<double> b_rho_micro(numMatls*blockSize), b_vol_frac(numMatls*blockSize);
+    std::vector<double> b_rho_CC(numMatls*blockSize),    b_Temp(numMatls*blockSize);
+    std::vector<double> b_gamma(numMatls*blockSize),     b_cv(numMatls*blockSize);
+    std::vector<double> b_press_eos(numMatls*blockSize);
+    std::vector<double> b_dp_drho(numMatls*blockSize),   b_dp_de(numMatls*blockSize);
+
+    IntVector b_cell[blockSize];
+    double    b_press[blockSize], b_delPress[blockSize], b_sum[blockSize];
+    double    A[blockSize], B[blockSize], C[blockSize];
+    vector<EqPress_dbg> dbgEqPress[blockSize];
+
+    // copy cell j of the block to i
+    auto moveCell = [&]( int j, int i ){
+      b_cell[i]     = b_cell[j];
+      b_press[i]    = b_press[j];
+      b_delPress[i] = b_delPress[j];
+      b_sum[i]      = b_sum[j];
+      dbgEqPress[i].swap( dbgEqPress[j] );
+      for (unsigned int m = 0; m < numMatls; m++) {
+        const int mi = m*blockSize + i, mj = m*blockSize + j;
+        b_rho_micro[mi] = b_rho_micro[mj];
+        b_vol_frac[mi]  = b_vol_frac[mj];
+        b_rho_CC[mi]    = b_rho_CC[mj];
+        b_Temp[mi]      = b_Temp[mj];
+        b_gamma[mi]     = b_gamma[mj];
+        b_cv[mi]        = b_cv[mj];
+        b_press_eos[mi] = b_press_eos[mj];
+        b_dp_drho[mi]   = b_dp_drho[mj];
+        b_dp_de[mi]     = b_dp_de[mj];
+      }
+    };
+
+    int test_max_iter = 0;
+    CellIterator iter=patch->getExtraCellIterator();
+    
+    while( !iter.done() ) {
+      int n = 0;
+      for (; n < blockSize && !iter.done(); n++, iter++) {
+        IntVector c = *iter;
+        b_cell[n]     = c;
+        b_press[n]    = press_new[c];
+        b_delPress[n] = 0.;
+        b_sum[n]      = 0.;
+        dbgEqPress[n].clear();
+        for (unsigned int m = 0; m < numMatls; m++) {
+          const int mi = m*blockSize + n;
+          b_rho_micro[mi] = rho_micro[m][c];
+          b_vol_frac[mi]  = vol_frac[m][c];
+          b_rho_CC[mi]    = rho_CC[m][c];
+          b_Temp[mi]      = Temp[m][c];
+          b_gamma[mi]     = gamma[m][c];
+          b_cv[mi]        = cv[m][c];
+        }
+      }
 
-      while ( count < d_max_iter_equilibration && converged == false) {
+      int count = 0;
+      while ( n > 0 ) {
         count++;
 
         //__________________________________
-        // evaluate press_eos at cell i,j,k
+        // evaluate press_eos at each cell
         for (unsigned int m = 0; m < numMatls; m++)  {
-          ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
-          ice_matl->getEOS()->computePressEOS(rho_micro[m][c],gamma[m][c],
-                                              cv[m][c], Temp[m][c],press_eos[m],
-                                              dp_drho[m], dp_de[m]);
+          const int m0 = m*blockSize;
+          eos[m]->computePressEOSBlock( n, &b_rho_micro[m0], &b_gamma[m0],
+                                        &b_cv[m0], &b_Temp[m0], &b_press_eos[m0],
+                                        &b_dp_drho[m0], &b_dp_de[m0] );
         }
 
         //__________________________________
         // - compute delPress
         // - update press_CC     
-        double A = 0., B = 0., C = 0.;
+        for (int i = 0; i < n; i++) {
+          A[i] = 0.;  B[i] = 0.;  C[i] = 0.;
+        }
         for (unsigned int m = 0; m < numMatls; m++)   {
-          double Q =  press_new[c] - press_eos[m];
-          double div_y =  (vol_frac[m][c] * vol_frac[m][c])
-                        / (dp_drho[m] * rho_CC[m][c] + d_SMALL_NUM);
-          A   +=  vol_frac[m][c];
-          B   +=  Q*div_y;
-          C   +=  div_y;
+          const int m0 = m*blockSize;
+          for (int i = 0; i < n; i++) {
+            double Q =  b_press[i] - b_press_eos[m0+i];
+            double div_y =  (b_vol_frac[m0+i] * b_vol_frac[m0+i])
+                          / (b_dp_drho[m0+i] * b_rho_CC[m0+i] + d_SMALL_NUM);
+            A[i]   +=  b_vol_frac[m0+i];
+            B[i]   +=  Q*div_y;
+            C[i]   +=  div_y;
+          }
         }
         double vol_frac_not_close_packed = 1.0;
-        delPress = (A - vol_frac_not_close_packed - B)/C;
-
-        press_new[c] += delPress;
+        for (int i = 0; i < n; i++) {
+          b_delPress[i] = (A[i] - vol_frac_not_close_packed - B[i])/C[i];
+          b_press[i]   += b_delPress[i];
+        }
 
         //__________________________________
         // backout rho_micro_CC at this new pressure
         for (unsigned int m = 0; m < numMatls; m++) {
-          ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
-          rho_micro[m][c] =
-           ice_matl->getEOS()->computeRhoMicro(press_new[c],gamma[m][c],
-                                          cv[m][c],Temp[m][c],rho_micro[m][c]);
-
-          double div = 1./rho_micro[m][c];
-
-          // - updated volume fractions
-          vol_frac[m][c]   = rho_CC[m][c]*div;
+          const int m0 = m*blockSize;
+          eos[m]->computeRhoMicroBlock( n, b_press, &b_gamma[m0], &b_cv[m0],
+                                        &b_Temp[m0], &b_rho_micro[m0],
+                                        &b_rho_micro[m0] );
+          for (int i = 0; i < n; i++) {
+            double div = 1./b_rho_micro[m0+i];
+
+            // - updated volume fractions
+            b_vol_frac[m0+i] = b_rho_CC[m0+i]*div;
+          }
         }
         //__________________________________
         // - Test for convergence
         //  If sum of vol_frac_CC ~= vol_frac_not_close_packed then converged
-        sum = 0.0;
-        for (unsigned int m = 0; m < numMatls; m++)  {
-          sum += vol_frac[m][c];
+        for (int i = 0; i < n; i++) {
+          b_sum[i] = 0.0;
         }
-        if (fabs(sum-1.0) < convergence_crit){
-          converged = true;
-          //__________________________________
-          // Find the speed of sound based on converged solution
-          for (unsigned int m = 0; m < numMatls; m++) {
-            ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
-            ice_matl->getEOS()->computePressEOS(rho_micro[m][c],gamma[m][c],
-                                            cv[m][c],Temp[m][c],
-                                            press_eos[m],dp_drho[m], dp_de[m]);
-
-            tmp = dp_drho[m]
-                + dp_de[m] * press_eos[m]/(rho_micro[m][c] * rho_micro[m][c]);
-            speedSound_new[m][c] = sqrt(tmp);
+        for (unsigned int m = 0; m < numMatls; m++)  {
+          for (int i = 0; i < n; i++) {
+            b_sum[i] += b_vol_frac[m*blockSize+i];
           }
         }
 
-        // Save iteration data for output in case of crash
-        if(ds_EqPress.active()){
-          EqPress_dbg dbg;
-          dbg.delPress     = delPress;
-          dbg.press_new    = press_new[c];
-          dbg.sumVolFrac   = sum;
-          dbg.count        = count;
+        for (int i = 0; i < n; ) {
+          IntVector c      = b_cell[i];
+          bool converged   = fabs(b_sum[i]-1.0) < convergence_crit;
+          
+          if (converged){
+            //__________________________________
+            // Find the speed of sound based on converged solution
+            for (unsigned int m = 0; m < numMatls; m++) {
+              const int mi = m*blockSize + i;
+              eos[m]->computePressEOS(b_rho_micro[mi],b_gamma[mi],
+                                      b_cv[mi],b_Temp[mi],
+                                      b_press_eos[mi],b_dp_drho[mi], b_dp_de[mi]);
+
+              double tmp = b_dp_drho[mi]
+                         + b_dp_de[mi] * b_press_eos[mi]/(b_rho_micro[mi] * b_rho_micro[mi]);
+              speedSound_new[m][c] = sqrt(tmp);
+            }
+          }
 
-          for (unsigned int m = 0; m < numMatls; m++) {
-            EqPress_dbgMatl dmatl;
-            dmatl.press_eos   = press_eos[m];
-            dmatl.volFrac     = vol_frac[m][c];
-            dmatl.rhoMicro    = rho_micro[m][c];
-            dmatl.rho_CC      = rho_CC[m][c];
-            dmatl.temp_CC     = Temp[m][c];
-            dmatl.mat         = m;
-            dbg.matl.push_back(dmatl);
+          // Save iteration data for output in case of crash
+          if(ds_EqPress.active()){
+            EqPress_dbg dbg;
+            dbg.delPress     = b_delPress[i];
+            dbg.press_new    = b_press[i];
+            dbg.sumVolFrac   = b_sum[i];
+            dbg.count        = count;
+
+            for (unsigned int m = 0; m < numMatls; m++) {
+              const int mi = m*blockSize + i;
+              EqPress_dbgMatl dmatl;
+              dmatl.press_eos   = b_press_eos[mi];
+              dmatl.volFrac     = b_vol_frac[mi];
+              dmatl.rhoMicro    = b_rho_micro[mi];
+              dmatl.rho_CC      = b_rho_CC[mi];
+              dmatl.temp_CC     = b_Temp[mi];
+              dmatl.mat         = m;
+              dbg.matl.push_back(dmatl);
+            }
+            dbgEqPress[i].push_back(dbg);
           }
-          dbgEqPress.push_back(dbg);
-        }
-      }   // end of converged
 
-      test_max_iter = std::max(test_max_iter, count);
+          if ( !converged && count < d_max_iter_equilibration ){
+            i++;
+            continue;
+          }
 
-      //__________________________________
-      //      BULLET PROOFING
-      // ignore BP if a recompute time step has already been requested
-      bool rts = new_dw->recomputeTimeStep();
+          //__________________________________
+          // This cell is done, it leaves the block
+          press_new[c] = b_press[i];
+          for (unsigned int m = 0; m < numMatls; m++) {
+            rho_micro[m][c] = b_rho_micro[m*blockSize + i];
+            vol_frac[m][c]  = b_vol_frac[m*blockSize + i];
+          }
+          double sum = b_sum[i];
 
-      string message;
-      bool allTestsPassed = true;
-      if(test_max_iter == d_max_iter_equilibration && !rts){
-        allTestsPassed = false;
-        message += "Max. iterations reached ";
-      }
+          test_max_iter = std::max(test_max_iter, count);
 
-      for (unsigned int m = 0; m < numMatls; m++) {
-        if(( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0)){
-          message += " ( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0) ";
-        }
-      }
+          //__________________________________
+          //      BULLET PROOFING
+          // ignore BP if a recompute time step has already been requested
+          bool rts = new_dw->recomputeTimeStep();
+
+          string message;
+          bool allTestsPassed = true;
+          if(test_max_iter == d_max_iter_equilibration && !rts){
+            allTestsPassed = false;
+            message += "Max. iterations reached ";
+          }
 
-      if ( fabs(sum - 1.0) > convergence_crit && !rts) {
-        allTestsPassed = false;
-        message += " sum (volumeFractions) != 1 ";
-      }
+          for (unsigned int m = 0; m < numMatls; m++) {
+            if(( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0)){
+              message += " ( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0) ";
+            }
+          }
 
-      if ( press_new[c] < 0.0 && !rts) {
-        allTestsPassed = false;
-        message += " Computed pressure is < 0 ";
-      }
+          if ( fabs(sum - 1.0) > convergence_crit && !rts) {
+            allTestsPassed = false;
+            message += " sum (volumeFractions) != 1 ";
+          }
 
-      for( unsigned int m = 0; m < numMatls; m++ ) {
-        if( (rho_micro[m][c] < 0.0 || vol_frac[m][c] < 0.0) && !rts ) {
-          allTestsPassed = false;
-          message += " rho_micro < 0 || vol_frac < 0";
-        }
-      }
-      if(allTestsPassed != true){  // throw an exception of there's a problem
-        Point pt = patch->getCellPosition(c);
-        
-        ostringstream warn;
-        warn << "\nICE::ComputeEquilibrationPressure: Cell "<< c << " position: " << pt << ", L-"<<L_indx <<"\n"
-             << message
-             <<"\nThis usually means that something much deeper has gone wrong with the simulation. "
-             <<"\nCompute equilibration pressure task is rarely the problem. "
-             << "For more debugging information set the environmental variable:  \n"
-             << "   SCI_DEBUG DBG_EqPress:+\n\n";
-
-        warn << "INPUTS: \n";
-        for (unsigned int m = 0; m < numMatls; m++){
-          warn<< "\n matl: " << m << "\n"
-               << "   rho_CC:     " << rho_CC[m][c] << "\n"
-               << "   Temperature:   "<< Temp[m][c] << "\n";
-        }
-        if(ds_EqPress.active()){
-          warn << "\nDetails on iterations " << endl;
-          vector<EqPress_dbg>::iterator dbg_iter;
-          for( dbg_iter  = dbgEqPress.begin(); dbg_iter != dbgEqPress.end(); dbg_iter++){
-            EqPress_dbg & d = *dbg_iter;
-            warn << "Iteration:   " << d.count
-                 << "  press_new:   " << d.press_new
-                 << "  sumVolFrac:  " << d.sumVolFrac
-                 << "  delPress:    " << d.delPress << "\n";
+          if ( press_new[c] < 0.0 && !rts) {
+            allTestsPassed = false;
+            message += " Computed pressure is < 0 ";
+          }
+
+          for( unsigned int m = 0; m < numMatls; m++ ) {
+            if( (rho_micro[m][c] < 0.0 || vol_frac[m][c] < 0.0) && !rts ) {
+              allTestsPassed = false;
+              message += " rho_micro < 0 || vol_frac < 0";
+            }
+          }
+          if(allTestsPassed != true){  // throw an exception of there's a problem
+            Point pt = patch->getCellPosition(c);
+            
+            ostringstream warn;
+            warn << "\nICE::ComputeEquilibrationPressure: Cell "<< c << " position: " << pt << ", L-"<<L_indx <<"\n"
+                 << message
+                 <<"\nThis usually means that something much deeper has gone wrong with the simulation. "
+                 <<"\nCompute equilibration pressure task is rarely the problem. "
+                 << "For more debugging information set the environmental variable:  \n"
+                 << "   SCI_DEBUG DBG_EqPress:+\n\n";
+
+            warn << "INPUTS: \n";
             for (unsigned int m = 0; m < numMatls; m++){
-              warn << "  matl: " << d.matl[m].mat
-                   << "  press_eos:  " << d.matl[m].press_eos
-                   << "  volFrac:    " << d.matl[m].volFrac
-                   << "  rhoMicro:   " << d.matl[m].rhoMicro
-                   << "  rho_CC:     " << d.matl[m].rho_CC
-                   << "  Temp:       " << d.matl[m].temp_CC << "\n";
+              warn<< "\n matl: " << m << "\n"
+                   << "   rho_CC:     " << rho_CC[m][c] << "\n"
+                   << "   Temperature:   "<< Temp[m][c] << "\n";
             }
+            if(ds_EqPress.active()){
+              warn << "\nDetails on iterations " << endl;
+              vector<EqPress_dbg>::iterator dbg_iter;
+              for( dbg_iter  = dbgEqPress[i].begin(); dbg_iter != dbgEqPress[i].end(); dbg_iter++){
+                EqPress_dbg & d = *dbg_iter;
+                warn << "Iteration:   " << d.count
+                     << "  press_new:   " << d.press_new
+                     << "  sumVolFrac:  " << d.sumVolFrac
+                     << "  delPress:    " << d.delPress << "\n";
+                for (unsigned int m = 0; m < numMatls; m++){
+                  warn << "  matl: " << d.matl[m].mat
+                       << "  press_eos:  " << d.matl[m].press_eos
+                       << "  volFrac:    " << d.matl[m].volFrac
+                       << "  rhoMicro:   " << d.matl[m].rhoMicro
+                       << "  rho_CC:     " << d.matl[m].rho_CC
+                       << "  Temp:       " << d.matl[m].temp_CC << "\n";
+                }
+              }
+            }
+            throw InvalidValue(warn.str(), __FILE__, __LINE__);
+          }
+
+          // the last cell of the block takes its place
+          n--;
+          if ( i != n ){
+            moveCell( n, i );
           }
         }
-        throw InvalidValue(warn.str(), __FILE__, __LINE__);
-      }
-    } // end of cell interator
+      }  // end of block iterations
+    }  // end of blocks
 
     cout_norm << "max. iterations in any cell " << test_max_iter << 
                  " on patch "<<patch->getID()<<endl; 
@@ -4804,25 +4899,25 @@ void ICE::advectAndAdvanceInTime(const ProcessorGroup* /*pg*/,
         mom_adv[c] = (mom_L_ME[c] + qV_advected[c]) ;
       }
       //__________________________________
-      // internal energy
-      varBasket->is_Q_massSpecific = true;
-      varBasket->desc = "int_eng";
-      advector->advectQ(int_eng_L_ME, mass_L, q_advected, varBasket);
+      // internal energy, sp_vol[m] * mass and the variables transported by
+      // the models are advected together, in one sweep
+      std::vector<const CCVariable<double>*> q_L;
+      std::vector<CCVariable<double>*>       q_adv;
+      std::vector<std::string>               q_desc;
+      std::deque<constCCVariable<double> >   trans_L;
+      std::deque<CCVariable<double> >        trans_adv;
 
-      for(CellIterator iter = patch->getCellIterator(); !iter.done();  iter++){
-        IntVector c = *iter;
-        int_eng_adv[c] = (int_eng_L_ME[c] + q_advected[c]) ;
-      }            
-      //__________________________________
-      // sp_vol[m] * mass
-      varBasket->is_Q_massSpecific = true;
-      varBasket->desc = "sp_vol";
-      advector->advectQ(sp_vol_L,mass_L, q_advected, varBasket); 
+      const CCVariable<double>& int_eng_L = int_eng_L_ME;
+      const CCVariable<double>& sp_vol_L_CC = sp_vol_L;
+
+      q_L.push_back( &int_eng_L );
+      q_adv.push_back( &int_eng_adv );
+      q_desc.push_back( "int_eng" );
+
+      q_L.push_back( &sp_vol_L_CC );
+      q_adv.push_back( &sp_vol_adv );
+      q_desc.push_back( "sp_vol" );
 
-      for(CellIterator iter = patch->getCellIterator(); !iter.done();  iter++){
-        IntVector c = *iter;
-        sp_vol_adv[c] = (sp_vol_L[c] + q_advected[c]) ;
-      }
       //__________________________________
       // Model with transported variables.
       if(d_models.size()){
@@ -4837,26 +4932,37 @@ void ICE::advectAndAdvanceInTime(const ProcessorGroup* /*pg*/,
               TransportedVariable* tvar = *t_iter;
               
               if(tvar->matls->contains(indx)){
-                string Labelname = tvar->var->getName();
-                CCVariable<double> q_adv;
-                constCCVariable<double> q_L_CC;
-                new_dw->allocateAndPut(q_adv, tvar->var_adv,     indx, patch);
+                trans_L.emplace_back();
+                trans_adv.emplace_back();
+                constCCVariable<double>& q_L_CC = trans_L.back();
+                CCVariable<double>& q_adv_CC    = trans_adv.back();
+
+                new_dw->allocateAndPut(q_adv_CC, tvar->var_adv,     indx, patch);
                 new_dw->get(q_L_CC,   tvar->var_Lagrangian, indx, patch, gac, 2); 
-                q_adv.initialize(d_EVIL_NUM);
-                
-                varBasket->desc = Labelname;
-                varBasket->is_Q_massSpecific = true;
-                advector->advectQ(q_L_CC,mass_L,q_advected, varBasket);  
+                q_adv_CC.initialize(d_EVIL_NUM);
                 
-                for(CellIterator iter = patch->getCellIterator(); !iter.done();  iter++){
-                  IntVector c = *iter;
-                  q_adv[c] = (q_L_CC[c] + q_advected[c]) ;
-                }
+                const CCVariable<double>& q_L_rep = q_L_CC;
+                q_L.push_back( &q_L_rep );
+                q_adv.push_back( &q_adv_CC );
+                q_desc.push_back( tvar->var->getName() );
               }
             }
           }
         }
       } 
+
+      varBasket->is_Q_massSpecific = true;
+      advector->advectQ(q_L, q_desc, mass_L, q_adv, varBasket);
+
+      for(unsigned int i = 0; i < q_L.size(); i++){
+        const CCVariable<double>& q_L_CC = *q_L[i];
+        CCVariable<double>& q_adv_CC     = *q_adv[i];
+
+        for(CellIterator iter = patch->getCellIterator(); !iter.done();  iter++){
+          IntVector c = *iter;
+          q_adv_CC[c] = (q_L_CC[c] + q_adv_CC[c]) ;
+        }
+      }
  
       delete varBasket;
     }  // ice_matls loop
@@ -46,6 +46,7 @@
 #include <Core/Util/DebugStream.h>
 #include <Core/Util/Timers/Timers.hpp>
 
+#include <algorithm>
 #include <iostream> // debug only
 #include <stack>
 #include <vector>
@@ -372,7 +373,21 @@ DynamicLoadBalancer::assignPatchesFactor( const GridP & grid, bool force )
 
   int num_procs = d_myworld->nRanks();
 
-  getCosts(grid.get_rep(),patch_costs);
+  std::vector<std::vector<int> > num_particles;
+  getCosts(grid.get_rep(),patch_costs,num_particles);
+
+  // Only move the boundaries of the current partition, and only if that
+  // is worth the migration.
+  if( d_incremental && !force && assignPatchesIncremental( grid, patch_costs ) ) {
+    bool doLoadBalancing = migrationPaysOff( grid, patch_costs, num_particles );
+
+    if (d_myworld->myRank() == 0){
+      dbg << " Time to LB (incremental): " << timer().seconds() << std::endl;
+    }
+    doing << d_myworld->myRank() << "   APF END\n";
+
+    return doLoadBalancing;
+  }
 
   int level_offset = 0;
 
@@ -423,7 +438,7 @@ DynamicLoadBalancer::assignPatchesFactor( const GridP & grid, bool force )
         //copy assignment from current load balance
         m_temp_assignment[level_offset+p]=m_processor_assignment[level_offset+p];
         //add assignment to current costs
-        currentProcCosts[m_processor_assignment[level_offset+p]] += patch_costs[l][p];
+        currentProcCosts[rankSlot(m_processor_assignment[level_offset+p])] += patch_costs[l][p];
       }
 
       //compute maximum of current load balance
@@ -475,7 +490,7 @@ DynamicLoadBalancer::assignPatchesFactor( const GridP & grid, bool force )
 
         if ( previousProcCosts[currentProc] + currentProcCosts[currentProc] + patchCost < myMaxCost && takeimb<=notakeimb) {
           // add patch to currentProc
-          temp_assignment[level_offset+index] = currentProc;
+          temp_assignment[level_offset+index] = slotRank(currentProc);
           currentProcCosts[currentProc] += patchCost;
         }
         else {
@@ -497,7 +512,7 @@ DynamicLoadBalancer::assignPatchesFactor( const GridP & grid, bool force )
           }
           
           //assign patch to currentProc
-          temp_assignment[level_offset+index] = currentProc;
+          temp_assignment[level_offset+index] = slotRank(currentProc);
 
           //update average (this ensures we don't over/under fill to much)
           avgCostPerProc = remainingCost / (num_procs-currentProc);
@@ -576,7 +591,7 @@ DynamicLoadBalancer::assignPatchesFactor( const GridP & grid, bool force )
       //loop through the assignments for this level and add costs to previousProcCosts
       for(int p=0;p<num_patches;p++)
       {
-        previousProcCosts[m_temp_assignment[level_offset+p]]+=patch_costs[l][p];
+        previousProcCosts[rankSlot(m_temp_assignment[level_offset+p])]+=patch_costs[l][p];
       }
       previous_total_cost+=total_cost;
     }
@@ -806,6 +821,214 @@ DynamicLoadBalancer::thresholdExceeded( const std::vector< std::vector<double> >
   }
 }
 
+//______________________________________________________________________
+//
+bool
+DynamicLoadBalancer::assignPatchesIncremental( const GridP                               & grid,
+                                               const std::vector< std::vector<double> > & patch_costs )
+{
+  int num_procs = d_myworld->nRanks();
+
+  // The current assignment has to be one for this grid.
+  if( m_processor_assignment.size() != m_temp_assignment.size() ||
+      m_assignment_base_patch != (*grid->getLevel(0)->patchesBegin())->getID() ) {
+    return false;
+  }
+
+  std::vector<double> previousProcCosts(num_procs,0);
+  double previous_total_cost = 0;
+  int    level_offset        = 0;
+
+  for(int l=0;l<grid->numLevels();l++){
+
+    const LevelP& level = grid->getLevel(l);
+    int num_patches = level->numPatches();
+    std::vector<int> order(num_patches);
+
+    if (m_do_space_curve) {
+      useSFC(level, &order[0]);
+    }
+    else {
+      for (int p = 0; p < num_patches; p++) {
+        order[p] = p;
+      }
+    }
+
+    // The processors have to own consecutive pieces of the curve, in order.
+    // oldStart[proc] is the position on the curve where proc's piece starts.
+    std::vector<int> oldStart(num_procs+1,0);
+    int lastProc = 0;
+
+    for (int p = 0; p < num_patches; p++) {
+      int proc = rankSlot(m_processor_assignment[level_offset+order[p]]);
+      if (proc < lastProc) {
+        return false;
+      }
+      lastProc = proc;
+      oldStart[proc+1]++;
+    }
+    for (int proc = 0; proc < num_procs; proc++) {
+      oldStart[proc+1] += oldStart[proc];
+    }
+
+    // Cost along the curve.
+    std::vector<double> prefix(num_patches+1,0);
+    for (int p = 0; p < num_patches; p++) {
+      prefix[p+1] = prefix[p] + patch_costs[l][order[p]];
+    }
+    double total_cost = prefix[num_patches];
+
+    // Where each processor's share of this level ends on the curve.  The
+    // costs already assigned on coarser levels are taken into account
+    // unless the levels are balanced independently.
+    double avgCost = (total_cost+previous_total_cost) / num_procs;
+    std::vector<double> share(num_procs);
+    double totalShare = 0;
+
+    for (int proc = 0; proc < num_procs; proc++) {
+      share[proc] = std::max(avgCost - previousProcCosts[proc], 0.0);
+      totalShare += share[proc];
+    }
+
+    std::vector<double> target(num_procs+1,0);
+    for (int proc = 0; proc < num_procs; proc++) {
+      double myShare = totalShare > 0 ? share[proc] / totalShare : 1.0 / num_procs;
+      target[proc+1] = target[proc] + myShare * total_cost;
+    }
+
+    // Move each boundary the least that puts it within the tolerance of
+    // its target.
+    double slack = 0.5 * d_imbalanceTolerance * total_cost / num_procs;
+    std::vector<int> newStart(num_procs+1,0);
+    newStart[num_procs] = num_patches;
+
+    for (int proc = 1; proc < num_procs; proc++) {
+      int lo = std::lower_bound(prefix.begin(), prefix.end(), target[proc]-slack) - prefix.begin();
+      int hi = std::upper_bound(prefix.begin(), prefix.end(), target[proc]+slack) - prefix.begin() - 1;
+      lo = std::min(lo, num_patches);
+
+      if (lo > hi) {
+        // A single patch covers the whole window, cut on its closer side.
+        lo = hi = (target[proc]-prefix[hi] < prefix[lo]-target[proc]) ? hi : lo;
+      }
+
+      int start = std::min(std::max(oldStart[proc], lo), hi);
+      newStart[proc] = std::max(start, newStart[proc-1]);
+    }
+
+    for (int proc = 0; proc < num_procs; proc++) {
+      for (int p = newStart[proc]; p < newStart[proc+1]; p++) {
+        m_temp_assignment[level_offset+order[p]] = slotRank(proc);
+      }
+    }
+
+    if(!d_levelIndependent)
+    {
+      for(int p=0;p<num_patches;p++)
+      {
+        previousProcCosts[rankSlot(m_temp_assignment[level_offset+p])]+=patch_costs[l][p];
+      }
+      previous_total_cost+=total_cost;
+    }
+
+    level_offset += num_patches;
+  }
+
+  return true;
+}
+
+//______________________________________________________________________
+//
+bool
+DynamicLoadBalancer::migrationPaysOff( const GridP                               & grid,
+                                       const std::vector< std::vector<double> > & patch_costs,
+                                       const std::vector< std::vector<int> >    & num_particles )
+{
+  int num_procs  = d_myworld->nRanks();
+  int num_levels = patch_costs.size();
+
+  // The migration costs are given in the units of the cost model, the
+  // patch costs may come from profiling.  Scale between the two.
+  std::vector<std::vector<double> > model_costs;
+  CostModeler(d_patchCost,d_cellCost,d_extraCellCost,d_particleCost).getWeights(grid.get_rep(),num_particles,model_costs);
+
+  double total_cost = 0, total_model_cost = 0;
+  for (int l = 0; l < num_levels; l++) {
+    for (unsigned p = 0; p < patch_costs[l].size(); p++) {
+      total_cost       += patch_costs[l][p];
+      total_model_cost += model_costs[l][p];
+    }
+  }
+  double scale = total_model_cost > 0 ? total_cost / total_model_cost : 1.0;
+
+  // Cost per timestep of the current and of the new assignment, and the
+  // data each processor has to send or receive to get there.
+  std::vector<std::vector<double> > currentProcCosts(num_levels, std::vector<double>(num_procs,0));
+  std::vector<std::vector<double> > tempProcCosts(num_levels, std::vector<double>(num_procs,0));
+  std::vector<double> migrationCosts(num_procs,0);
+  int num_moved = 0;
+
+  int i = 0;
+  for (int l = 0; l < num_levels; l++) {
+    const LevelP& level = grid->getLevel(l);
+
+    for (int p = 0; p < (int)patch_costs[l].size(); p++, i++) {
+      int oldProc = m_processor_assignment[i];
+      int newProc = m_temp_assignment[i];
+
+      currentProcCosts[l][oldProc] += patch_costs[l][p];
+      tempProcCosts[l][newProc]    += patch_costs[l][p];
+
+      if (oldProc != newProc) {
+        double cost = scale * (level->getPatch(p)->getNumCells() * d_cellMigrationCost +
+                               num_particles[l][p] * d_particleMigrationCost);
+        migrationCosts[oldProc] += cost;
+        migrationCosts[newProc] += cost;
+        num_moved++;
+      }
+    }
+  }
+
+  // The timestep takes as long as the busiest processor (on each level
+  // when they are balanced independently).
+  double max_current = 0, max_temp = 0;
+
+  if (d_levelIndependent) {
+    for (int l = 0; l < num_levels; l++) {
+      max_current += *std::max_element(currentProcCosts[l].begin(), currentProcCosts[l].end());
+      max_temp    += *std::max_element(tempProcCosts[l].begin(), tempProcCosts[l].end());
+    }
+  }
+  else {
+    for (int proc = 0; proc < num_procs; proc++) {
+      double current_cost = 0, temp_cost = 0;
+      for (int l = 0; l < num_levels; l++) {
+        current_cost += currentProcCosts[l][proc];
+        temp_cost    += tempProcCosts[l][proc];
+      }
+      max_current = std::max(max_current, current_cost);
+      max_temp    = std::max(max_temp, temp_cost);
+    }
+  }
+
+  // Nothing to gain without any cost (e.g. no profile data yet).
+  if (max_current <= 0) {
+    return false;
+  }
+
+  // The gain is collected every timestep until the next check.
+  int    interval      = std::max(m_lb_timeStep_interval, 1);
+  double gain          = (max_current - max_temp) * interval;
+  double migrationCost = *std::max_element(migrationCosts.begin(), migrationCosts.end());
+
+  if (d_myworld->myRank() == 0) {
+    stats << "Incremental LB: patches moved: " << num_moved << " maxCur: " << max_current << " maxTemp: " << max_temp
+          << " gain over " << interval << " timesteps: " << gain << " migration cost: " << migrationCost << std::endl;
+  }
+
+  return num_moved > 0 && gain > migrationCost && (max_current - max_temp) / max_current > d_lbThreshold;
+}
+
 //______________________________________________________________________
 //
 bool
@@ -926,11 +1149,11 @@ DynamicLoadBalancer::needRecompile( const GridP & grid )
 //
 // If it is not a regrid the patch information is stored in grid, if it is during a regrid the patch information is stored in patches.
 void
-DynamicLoadBalancer::getCosts( const Grid * grid, std::vector< std::vector<double> > & costs )
+DynamicLoadBalancer::getCosts( const Grid                            * grid,
+                                     std::vector< std::vector<double> > & costs,
+                                     std::vector< std::vector<int> >    & num_particles )
 {
   costs.clear();
-    
-  std::vector<std::vector<int> > num_particles;
 
   DataWarehouse* olddw = m_scheduler->get_dw(0);
   bool on_regrid = olddw != 0 && grid != olddw->getGrid();
@@ -1167,6 +1390,18 @@ DynamicLoadBalancer::problemSetup( ProblemSpecP & pspec, GridP & grid, const Mat
     }
    
     p->getWithDefault("levelIndependent",d_levelIndependent,true);
+
+    p->getWithDefault("incremental",           d_incremental,           false);
+    p->getWithDefault("imbalanceTolerance",    d_imbalanceTolerance,    0.1);
+    p->getWithDefault("cellMigrationCost",     d_cellMigrationCost,     1.0);
+    p->getWithDefault("particleMigrationCost", d_particleMigrationCost, 1.0);
+
+    if( d_imbalanceTolerance < 0 || d_imbalanceTolerance >= 1 ) {
+      throw ProblemSetupException("DynamicLoadBalancer: imbalanceTolerance must be in [0,1)", __FILE__, __LINE__);
+    }
+    if( d_cellMigrationCost < 0 || d_particleMigrationCost < 0 ) {
+      throw ProblemSetupException("DynamicLoadBalancer: the migration costs can not be negative", __FILE__, __LINE__);
+    }
   }
 
 
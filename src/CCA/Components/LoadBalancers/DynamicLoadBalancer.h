@@ -134,8 +134,24 @@ namespace Uintah {
 
     bool thresholdExceeded(const std::vector<std::vector<double> >& patch_costs);
 
+    /// Helpers for the incremental mode of assignPatchesFactor.  Instead of
+    /// partitioning the space-filling curve from scratch, the boundaries of the
+    /// current partition are moved as little as possible to get each
+    /// processor within d_imbalanceTolerance of its share.  Returns false if
+    /// the current assignment is not a partition of the curve (e.g. after a
+    /// regrid).
+    bool assignPatchesIncremental(const GridP& grid, const std::vector<std::vector<double> >& patch_costs);
+
+    /// True if the predicted gain of the temp assignment over the timesteps
+    /// until the next load balance check outweighs the cost of migrating the
+    /// patches (and their particles) that change processors.
+    bool migrationPaysOff(const GridP& grid,
+                          const std::vector<std::vector<double> >& patch_costs,
+                          const std::vector<std::vector<int> >& num_particles);
+
     //Assign costs to a list of patches
-    void getCosts(const Grid* grid, std::vector<std::vector<double> >&costs);
+    void getCosts(const Grid* grid, std::vector<std::vector<double> >&costs,
+                  std::vector<std::vector<int> >& num_particles);
 
     bool   d_levelIndependent;
     
@@ -151,6 +167,11 @@ namespace Uintah {
     
     int  d_dynamicAlgorithm{patch_factor_lb};
     bool d_collectParticles{false};
+
+    bool   d_incremental{false};           //only shift the partition boundaries
+    double d_imbalanceTolerance{0.1};      //allowed excess over a processor's share
+    double d_cellMigrationCost{1.0};       //cost of moving a cell to another processor
+    double d_particleMigrationCost{1.0};   //cost of moving a particle to another processor
   };
 } // End namespace Uintah
 
@@ -42,6 +42,7 @@
 
 #include <sci_defs/visit_defs.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <climits>
 #include <iomanip>
@@ -889,6 +890,11 @@ LoadBalancerCommon::problemSetup(       ProblemSpecP     & pspec
 
   if (p != nullptr) {
     p->getWithDefault("outputNthProc", m_output_Nth_proc, 1);
+    p->getWithDefault("topologyAware", m_topology_aware, false);
+  }
+
+  if (m_topology_aware) {
+    setupTopology();
   }
 
 #ifdef HAVE_VISIT
@@ -914,6 +920,50 @@ LoadBalancerCommon::problemSetup(       ProblemSpecP     & pspec
 #endif
 }
 
+//__________________________________
+//
+void
+LoadBalancerCommon::setupTopology()
+{
+  int numRanks = d_myworld->nRanks();
+  int myRank   = d_myworld->myRank();
+
+  // Each node is identified by the lowest rank on it.
+  MPI_Comm nodeComm;
+  if( MPI_Comm_split_type( d_myworld->getComm(), MPI_COMM_TYPE_SHARED, myRank, MPI_INFO_NULL, &nodeComm ) != MPI_SUCCESS ) {
+    throw InternalError( "LoadBalancerCommon::setupTopology(): MPI_Comm_split_type failed", __FILE__, __LINE__ );
+  }
+
+  int nodeLeader = myRank;
+  Uintah::MPI::Bcast( &nodeLeader, 1, MPI_INT, 0, nodeComm );
+  Uintah::MPI::Comm_free( &nodeComm );
+
+  std::vector<int> nodeLeaders( numRanks );
+  Uintah::MPI::Allgather( &nodeLeader, 1, MPI_INT, &nodeLeaders[0], 1, MPI_INT, d_myworld->getComm() );
+
+  // Number the slots node by node, in rank order within a node.
+  m_slot_rank.resize( numRanks );
+  m_rank_slot.resize( numRanks );
+
+  for (int rank = 0; rank < numRanks; rank++) {
+    m_slot_rank[rank] = rank;
+  }
+  std::stable_sort( m_slot_rank.begin(), m_slot_rank.end(),
+                    [&]( int a, int b ) { return nodeLeaders[a] < nodeLeaders[b]; } );
+
+  int numNodes = 0;
+  for (int slot = 0; slot < numRanks; slot++) {
+    m_rank_slot[m_slot_rank[slot]] = slot;
+    if (slot == 0 || nodeLeaders[m_slot_rank[slot]] != nodeLeaders[m_slot_rank[slot - 1]]) {
+      numNodes++;
+    }
+  }
+
+  proc0cout << "Load balancer: topology aware patch placement on " << numNodes << " node(s)\n";
+
+  DOUT( g_lb_dbg, "Rank-" << myRank << " node leader: " << nodeLeader << ", slot: " << m_rank_slot[myRank] );
+}
+
 //__________________________________
 //
 void
@@ -214,6 +214,18 @@ protected:
   
   // Calls space-filling curve on level, and stores results in pre-allocated output
   void useSFC( const LevelP & level, int * output) ;
+
+  // The load balancers partition the patches into nRanks consecutive
+  // pieces ("slots").  With <topologyAware> the slots are numbered node by
+  // node, so that consecutive pieces, which are neighbors, land on ranks
+  // of the same node: the patches are first split between the nodes and
+  // then between the ranks of each node.  Without it slot == rank.
+  int slotRank( int slot ) const { return m_slot_rank.empty() ? slot : m_slot_rank[slot]; }
+  int rankSlot( int rank ) const { return m_rank_slot.empty() ? rank : m_rank_slot[rank]; }
+
+  // Finds the ranks that share a node (MPI_COMM_TYPE_SHARED) and numbers
+  // the slots accordingly.
+  void setupTopology();
     
   /// Creates a patchset of all patches that have work done on each processor.
   //    - There are two versions of this function.  The first works on a per level
@@ -246,6 +258,10 @@ protected:
   SFC <double> m_sfc;
   bool         m_do_space_curve{false};
 
+  bool             m_topology_aware{false};
+  std::vector<int> m_slot_rank;  ///< rank of each slot, node by node
+  std::vector<int> m_rank_slot;  ///< slot of each rank
+
   MaterialManagerP                    m_materialManager;      ///< to keep track of timesteps
   Scheduler                         * m_scheduler {nullptr};  ///< store the scheduler to not have to keep passing it in
   
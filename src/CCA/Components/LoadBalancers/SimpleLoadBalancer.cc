@@ -41,10 +41,10 @@ SimpleLoadBalancer::getPatchwiseProcessorAssignment( const Patch * patch )
 {
   long long     numProcs  = d_myworld->nRanks();
   const Patch * realPatch = patch->getRealPatch();
-  int           proc      = (realPatch->getLevelIndex() * numProcs) / static_cast<long long>(realPatch->getLevel()->numPatches());
+  int           slot      = (realPatch->getLevelIndex() * numProcs) / static_cast<long long>(realPatch->getLevel()->numPatches());
 
-  ASSERTRANGE(proc, 0, d_myworld->nRanks());
+  ASSERTRANGE(slot, 0, d_myworld->nRanks());
 
-  return proc;
+  return slotRank( slot );
 }
 
@@ -73,6 +73,7 @@ MPMFlags::MPMFlags(const ProcessorGroup* myworld)
   d_doThermalExpansion            =  true;
   d_refineParticles               =  false;
   d_XPIC2                         =  false;
+  d_P2GThreads                    =  1;
   d_artificialDampCoeff           =  0.0;
   d_interpolator                  =  scinew LinearInterpolator();
   d_do_contact_friction           =  false;
@@ -199,6 +200,12 @@ MPMFlags::readMPMFlags(ProblemSpecP& ps, Output* dataArchive)
   mpm_flag_ps->get("artificial_viscosity",     d_artificial_viscosity);
   mpm_flag_ps->get("refine_particles",         d_refineParticles);
   mpm_flag_ps->get("XPIC2",                    d_XPIC2);
+  mpm_flag_ps->get("P2G_threads",              d_P2GThreads);
+  if(d_P2GThreads < 1){
+    ostringstream warn;
+    warn << "ERROR:MPM: P2G_threads must be at least 1." << endl;
+    throw ProblemSetupException(warn.str(), __FILE__, __LINE__ );
+  }
   if(d_artificial_viscosity){
     d_artificial_viscosity_heating=true;
   }
@@ -381,6 +388,7 @@ else{
     dbg << " Artificial Viscosity Coeff2 = " << d_artificialViscCoeff2<< endl;
     dbg << " RefineParticles             = " << d_refineParticles << endl;
     dbg << " XPIC2                       = " << d_XPIC2 << endl;
+    dbg << " P2G threads                 = " << d_P2GThreads << endl;
     dbg << " Use Load Curves             = " << d_useLoadCurves << endl;
     dbg << " Use CBDI boundary condition = " << d_useCBDI << endl;
     dbg << " Use Cohesive Zones          = " << d_useCohesiveZones << endl;
@@ -410,6 +418,7 @@ MPMFlags::outputProblemSpec(ProblemSpecP& ps)
   ps->appendElement("artificial_viscosity_coeff2",        d_artificialViscCoeff2);
   ps->appendElement("refine_particles",                   d_refineParticles);
   ps->appendElement("XPIC2",                              d_XPIC2);
+  ps->appendElement("P2G_threads",                        d_P2GThreads);
   ps->appendElement("use_cohesive_zones",                 d_useCohesiveZones);
   ps->appendElement("use_load_curves",                    d_useLoadCurves);
   ps->appendElement("use_CBDI_boundary_condition",        d_useCBDI);
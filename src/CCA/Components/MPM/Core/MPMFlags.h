@@ -86,6 +86,7 @@ class Output;
     bool        doMPMOnLevel(int level, int numLevels) const;
     bool        d_refineParticles;                             // Refine particles, step toward AMR
     bool        d_XPIC2;                                       // Use Nairn's XPIC2 algorithm
+    int         d_P2GThreads;                                  // Threads for a patch's particle to grid scatter
 
     double      d_artificialDampCoeff;
     double      d_artificialViscCoeff1;                        // Artificial viscosity coefficient 1
@@ -61,6 +61,7 @@
 #include <Core/Grid/Variables/PerPatch.h>
 #include <Core/Grid/Variables/PerPatchVars.h>
 #include <Core/Grid/Variables/VarTypes.h>
+#include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
 #include <Core/Geometry/Vector.h>
@@ -82,6 +83,10 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace Uintah;
 using namespace std;
@@ -92,6 +97,45 @@ static DebugStream cout_convert("MPMConv", false);
 static DebugStream cout_heat("MPMHeat", false);
 static DebugStream amr_doing("AMRMPM", false);
 
+//______________________________________________________________________
+//  Runs f(t) for the chunks t in [0, n), each on its own std::thread (the
+//  first on the calling thread), independent of how Uintah was built.  An
+//  exception thrown by a chunk is rethrown on the calling thread once all
+//  of the chunks are done.
+template <typename Functor>
+static void forEachChunk(int n, const Functor& f)
+{
+  std::exception_ptr error;
+  Uintah::MasterLock error_lock;
+
+  auto chunk = [&](int t) {
+    try {
+      f(t);
+    }
+    catch (...) {
+      std::lock_guard<Uintah::MasterLock> error_guard(error_lock);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  vector<std::thread> threads;
+  for (int t = 1; t < n; t++) {
+    threads.emplace_back(chunk, t);
+  }
+  if (n > 0) {
+    chunk(0);
+  }
+  for (size_t t = 0; t < threads.size(); t++) {
+    threads[t].join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 static Vector face_norm(Patch::FaceType f)
 {
   switch(f) {
@@ -2251,8 +2295,7 @@ void SerialMPM::interpolateParticlesToGrid(const ProcessorGroup*,
 
     unsigned int numMatls = m_materialManager->getNumMatls( "MPM" );
     ParticleInterpolator* interpolator = flags->d_interpolator->clone(patch);
-    vector<IntVector> ni(interpolator->size());
-    vector<double> S(interpolator->size());
+    const int batchSize = ParticleInterpolator::BATCH_SIZE;
 
     ParticleInterpolator* linear_interpolator=scinew LinearInterpolator(patch);
 
@@ -2271,6 +2314,18 @@ void SerialMPM::interpolateParticlesToGrid(const ProcessorGroup*,
     gvelglobal.initialize(Vector(0.0));
     Ghost::GhostType  gan = Ghost::AroundNodes;
 
+    // Grid variables the particle loop accumulates into
+    struct P2GGridVars {
+      NCVariable<double> gmass, gvolume, gTemperature, gSp_vol;
+      NCVariable<Vector> gvelocity, gexternalforce;
+      NCVariable<double> gConcentration, gHydrostaticStress, gExtScalarFlux;
+    };
+
+    // Private copies for the scatter chunks 1..P2G_threads-1, allocated
+    // the first time a material needs them and reused by the others
+    vector<P2GGridVars> partial(flags->d_P2GThreads);
+    int numPartial = 1;
+
     for(unsigned int m = 0; m < numMatls; m++){
       MPMMaterial* mpm_matl = (MPMMaterial*) m_materialManager->getMaterial( "MPM",  m );
       int dwi = mpm_matl->getDWIndex();
@@ -2390,100 +2445,214 @@ void SerialMPM::interpolateParticlesToGrid(const ProcessorGroup*,
       // Vector from the individual mass matrix and velocity vector
       // GridMass * GridVelocity =  S^T*M_D*ParticleVelocity
 
-      Vector total_mom(0.0,0.0,0.0);
       double pSp_vol = 1./mpm_matl->getInitialDensity();
-      //loop over all particles in the patch:
-      for (ParticleSubset::iterator iter = pset->begin();
-           iter != pset->end();
-           iter++){
-        particleIndex idx = *iter;
-        int NN =
-           interpolator->findCellAndWeights(px[idx],ni,S,psize[idx]);
-        Vector pmom = pvelocity[idx]*pmass[idx];
-        double ptemp_ext = pTemperature[idx];
-        total_mom += pmom;
 
-        // Add each particles contribution to the local mass & velocity
-        // Must use the node indices
-        IntVector node;
-        // Iterate through the nodes that receive data from the current particle
-        for(int k = 0; k < NN; k++) {
-          node = ni[k];
-          if(patch->containsNode(node)) {
-            if (flags->d_GEVelProj){
-              Point gpos = patch->getNodePosition(node);
-              Vector distance = px[idx] - gpos;
-              Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
-              pmom = pvel_ext*pmass[idx];
-              ptemp_ext = pTemperature[idx] - Dot(pTempGrad[idx],distance);
+      //__________________________________
+      //  Scatter the particles [pbegin, pend) of pset into the grid
+      //  variables of g
+      auto scatterParticles = [&](int pbegin, int pend, P2GGridVars& g) {
+        NCVariable<double>& gmass              = g.gmass;
+        NCVariable<double>& gvolume            = g.gvolume;
+        NCVariable<double>& gTemperature       = g.gTemperature;
+        NCVariable<double>& gSp_vol            = g.gSp_vol;
+        NCVariable<Vector>& gvelocity          = g.gvelocity;
+        NCVariable<Vector>& gexternalforce     = g.gexternalforce;
+        NCVariable<double>& gConcentration     = g.gConcentration;
+        NCVariable<double>& gHydrostaticStress = g.gHydrostaticStress;
+        NCVariable<double>& gExtScalarFlux     = g.gExtScalarFlux;
+
+        vector<IntVector> ni_batch(batchSize*interpolator->size());
+        vector<double>    S_batch(batchSize*interpolator->size());
+
+        //loop over the particles, a batch at a time:
+        for (int b0 = pbegin; b0 < pend; b0 += batchSize) {
+          const int nbatch = Min(pend - b0, batchSize);
+          const particleIndex* batch = pset->getPointer() + b0;
+          const int NN = interpolator->findCellsAndWeights(batch, nbatch, px, psize,
+                                                  &ni_batch[0], &S_batch[0]);
+          for (int b = 0; b < nbatch; b++) {
+            particleIndex idx = batch[b];
+            const IntVector* ni = &ni_batch[b*NN];
+            const double*    S  = &S_batch[b*NN];
+            Vector pmom = pvelocity[idx]*pmass[idx];
+            double ptemp_ext = pTemperature[idx];
+
+            // Add each particles contribution to the local mass & velocity
+            // Must use the node indices
+            IntVector node;
+            // Iterate through the nodes that receive data from the current particle
+            for(int k = 0; k < NN; k++) {
+              node = ni[k];
+              if(patch->containsNode(node)) {
+                if (flags->d_GEVelProj){
+                  Point gpos = patch->getNodePosition(node);
+                  Vector distance = px[idx] - gpos;
+                  Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
+                  pmom = pvel_ext*pmass[idx];
+                  ptemp_ext = pTemperature[idx] - Dot(pTempGrad[idx],distance);
+                }
+                gmass[node]          += pmass[idx]                     * S[k];
+                gvelocity[node]      += pmom                           * S[k];
+                gvolume[node]        += pvolume[idx]                   * S[k];
+    //            gColor[node]         += pColor[idx]*pmass[idx]         * S[k];
+                if (!flags->d_useCBDI) {
+                  gexternalforce[node] += pexternalforce[idx]          * S[k];
+                }
+                gTemperature[node]   += ptemp_ext * pmass[idx] * S[k];
+                gSp_vol[node]        += pSp_vol   * pmass[idx] * S[k];
+                //gexternalheatrate[node] += pexternalheatrate[idx]      * S[k];
+              }
             }
-            gmass[node]          += pmass[idx]                     * S[k];
-            gvelocity[node]      += pmom                           * S[k];
-            gvolume[node]        += pvolume[idx]                   * S[k];
-//            gColor[node]         += pColor[idx]*pmass[idx]         * S[k];
-            if (!flags->d_useCBDI) {
-              gexternalforce[node] += pexternalforce[idx]          * S[k];
+            if (flags->d_doScalarDiffusion) {
+              double one_third = 1./3.;
+              double pHydroStress = one_third*pStress[idx].Trace();
+              double pConc_Ext = pConcentration[idx];
+              for (int k = 0; k < NN; ++k) {
+                node = ni[k];
+                if (patch->containsNode(node)) {
+                  if (flags->d_GEVelProj) {
+                    Point gpos = patch->getNodePosition(node);
+                    Vector pointOffset = px[idx]-gpos;
+                    pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                  }
+                  double massWeight = pmass[idx]*S[k];
+                  gHydrostaticStress[node]  += pHydroStress             * massWeight;
+                  gConcentration[node]      += pConc_Ext                * massWeight;
+                  gExtScalarFlux[node]      += pExternalScalarFlux[idx] * massWeight;
+                }
+              }
             }
-            gTemperature[node]   += ptemp_ext * pmass[idx] * S[k];
-            gSp_vol[node]        += pSp_vol   * pmass[idx] * S[k];
-            //gexternalheatrate[node] += pexternalheatrate[idx]      * S[k];
-          }
-        }
-        if (flags->d_doScalarDiffusion) {
-          double one_third = 1./3.;
-          double pHydroStress = one_third*pStress[idx].Trace();
-          double pConc_Ext = pConcentration[idx];
-          for (int k = 0; k < NN; ++k) {
-            node = ni[k];
-            if (patch->containsNode(node)) {
-              if (flags->d_GEVelProj) {
-                Point gpos = patch->getNodePosition(node);
-                Vector pointOffset = px[idx]-gpos;
-                pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+            if (flags->d_useCBDI && pLoadCurveID[idx].x()>0) {
+              vector<IntVector> niCorner1(linear_interpolator->size());
+              vector<IntVector> niCorner2(linear_interpolator->size());
+              vector<IntVector> niCorner3(linear_interpolator->size());
+              vector<IntVector> niCorner4(linear_interpolator->size());
+              vector<double> SCorner1(linear_interpolator->size());
+              vector<double> SCorner2(linear_interpolator->size());
+              vector<double> SCorner3(linear_interpolator->size());
+              vector<double> SCorner4(linear_interpolator->size());
+              linear_interpolator->findCellAndWeights(pExternalForceCorner1[idx],
+                                     niCorner1,SCorner1,psize[idx]);
+              linear_interpolator->findCellAndWeights(pExternalForceCorner2[idx],
+                                     niCorner2,SCorner2,psize[idx]);
+              linear_interpolator->findCellAndWeights(pExternalForceCorner3[idx],
+                                     niCorner3,SCorner3,psize[idx]);
+              linear_interpolator->findCellAndWeights(pExternalForceCorner4[idx],
+                                     niCorner4,SCorner4,psize[idx]);
+              for(int k = 0; k < 8; k++) { // Iterates through the nodes which receive information from the current particle
+                node = niCorner1[k];
+                if(patch->containsNode(node)) {
+                  gexternalforce[node] += pexternalforce[idx] * SCorner1[k];
+                }
+                node = niCorner2[k];
+                if(patch->containsNode(node)) {
+                  gexternalforce[node] += pexternalforce[idx] * SCorner2[k];
+                }
+                node = niCorner3[k];
+                if(patch->containsNode(node)) {
+                  gexternalforce[node] += pexternalforce[idx] * SCorner3[k];
+                }
+                node = niCorner4[k];
+                if(patch->containsNode(node)) {
+                  gexternalforce[node] += pexternalforce[idx] * SCorner4[k];
+                }
               }
-              double massWeight = pmass[idx]*S[k];
-              gHydrostaticStress[node]  += pHydroStress             * massWeight;
-              gConcentration[node]      += pConc_Ext                * massWeight;
-              gExtScalarFlux[node]      += pExternalScalarFlux[idx] * massWeight;
             }
           }
         }
-        if (flags->d_useCBDI && pLoadCurveID[idx].x()>0) {
-          vector<IntVector> niCorner1(linear_interpolator->size());
-          vector<IntVector> niCorner2(linear_interpolator->size());
-          vector<IntVector> niCorner3(linear_interpolator->size());
-          vector<IntVector> niCorner4(linear_interpolator->size());
-          vector<double> SCorner1(linear_interpolator->size());
-          vector<double> SCorner2(linear_interpolator->size());
-          vector<double> SCorner3(linear_interpolator->size());
-          vector<double> SCorner4(linear_interpolator->size());
-          linear_interpolator->findCellAndWeights(pExternalForceCorner1[idx],
-                                 niCorner1,SCorner1,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner2[idx],
-                                 niCorner2,SCorner2,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner3[idx],
-                                 niCorner3,SCorner3,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner4[idx],
-                                 niCorner4,SCorner4,psize[idx]);
-          for(int k = 0; k < 8; k++) { // Iterates through the nodes which receive information from the current particle
-            node = niCorner1[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner1[k];
-            }
-            node = niCorner2[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner2[k];
-            }
-            node = niCorner3[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner3[k];
-            }
-            node = niCorner4[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner4[k];
-            }
+      };
+
+      P2GGridVars gridVars;
+      gridVars.gmass.copyPointer(gmass);
+      gridVars.gvolume.copyPointer(gvolume);
+      gridVars.gTemperature.copyPointer(gTemperature);
+      gridVars.gSp_vol.copyPointer(gSp_vol);
+      gridVars.gvelocity.copyPointer(gvelocity);
+      gridVars.gexternalforce.copyPointer(gexternalforce);
+      if (flags->d_doScalarDiffusion) {
+        gridVars.gConcentration.copyPointer(gConcentration);
+        gridVars.gHydrostaticStress.copyPointer(gHydrostaticStress);
+        gridVars.gExtScalarFlux.copyPointer(gExtScalarFlux);
+      }
+
+      const int numParticles = pset->numParticles();
+      const int numChunks    = Max(1, Min(flags->d_P2GThreads,
+                                          numParticles/batchSize));
+      if (numChunks == 1) {
+        scatterParticles(0, numParticles, gridVars);
+      }
+      else {
+        //__________________________________
+        //  The particles are split into contiguous chunks.  Each chunk
+        //  scatters into its own zeroed copy of the grid variables, except
+        //  the first, which scatters directly into gridVars.  The copies
+        //  are then added to gridVars in chunk order, so the result does
+        //  not depend on how the chunks are scheduled.
+        for (; numPartial < numChunks; numPartial++) {
+          P2GGridVars& g = partial[numPartial];
+          new_dw->allocateTemporary(g.gmass,          patch);
+          new_dw->allocateTemporary(g.gvolume,        patch);
+          new_dw->allocateTemporary(g.gTemperature,   patch);
+          new_dw->allocateTemporary(g.gSp_vol,        patch);
+          new_dw->allocateTemporary(g.gvelocity,      patch);
+          new_dw->allocateTemporary(g.gexternalforce, patch);
+          if (flags->d_doScalarDiffusion) {
+            new_dw->allocateTemporary(g.gConcentration,     patch);
+            new_dw->allocateTemporary(g.gHydrostaticStress, patch);
+            new_dw->allocateTemporary(g.gExtScalarFlux,     patch);
           }
         }
+
+        forEachChunk(numChunks, [&](int t) {
+          if (t == 0) {
+            scatterParticles(0, numParticles/numChunks, gridVars);
+            return;
+          }
+          P2GGridVars& g = partial[t];
+          g.gmass.initialize(0.);
+          g.gvolume.initialize(0.);
+          g.gTemperature.initialize(0.);
+          g.gSp_vol.initialize(0.);
+          g.gvelocity.initialize(Vector(0,0,0));
+          g.gexternalforce.initialize(Vector(0,0,0));
+          if (flags->d_doScalarDiffusion) {
+            g.gConcentration.initialize(0.);
+            g.gHydrostaticStress.initialize(0.);
+            g.gExtScalarFlux.initialize(0.);
+          }
+          scatterParticles((t*numParticles)/numChunks,
+                           ((t+1)*numParticles)/numChunks, g);
+        });
+
+        // Add the partial sums, a slab of nodes in z per chunk
+        const IntVector lo = gmass.getLowIndex();
+        const IntVector hi = gmass.getHighIndex();
+        const int nz = hi.z() - lo.z();
+        forEachChunk(numChunks, [&](int t) {
+          const int zlo = lo.z() + (t*nz)/numChunks;
+          const int zhi = lo.z() + ((t+1)*nz)/numChunks;
+          for (int c = 1; c < numChunks; c++) {
+            const P2GGridVars& g = partial[c];
+            for (int z = zlo; z < zhi; z++) {
+              for (int y = lo.y(); y < hi.y(); y++) {
+                for (int x = lo.x(); x < hi.x(); x++) {
+                  const IntVector n(x, y, z);
+                  gmass[n]          += g.gmass[n];
+                  gvolume[n]        += g.gvolume[n];
+                  gTemperature[n]   += g.gTemperature[n];
+                  gSp_vol[n]        += g.gSp_vol[n];
+                  gvelocity[n]      += g.gvelocity[n];
+                  gexternalforce[n] += g.gexternalforce[n];
+                  if (flags->d_doScalarDiffusion) {
+                    gConcentration[n]     += g.gConcentration[n];
+                    gHydrostaticStress[n] += g.gHydrostaticStress[n];
+                    gExtScalarFlux[n]     += g.gExtScalarFlux[n];
+                  }
+                }
+              }
+            }
+          }
+        });
       } // End of particle loop
       for(NodeIterator iter=patch->getExtraNodeIterator();
                        !iter.done();iter++){
@@ -3740,8 +3909,9 @@ void SerialMPM::interpolateToParticlesAndUpdate(const ProcessorGroup*,
               "Doing MPM::interpolateToParticlesAndUpdate");
 
     ParticleInterpolator* interpolator = flags->d_interpolator->clone(patch);
-    vector<IntVector> ni(interpolator->size());
-    vector<double> S(interpolator->size());
+    const int batchSize = ParticleInterpolator::BATCH_SIZE;
+    vector<IntVector> ni_batch(batchSize*interpolator->size());
+    vector<double>    S_batch(batchSize*interpolator->size());
 
     // Performs the interpolation from the cell vertices of the grid
     // acceleration and velocity to the particles to update their
@@ -3885,155 +4055,167 @@ void SerialMPM::interpolateToParticlesAndUpdate(const ProcessorGroup*,
 
 
       if(flags->d_XPIC2){
-        // Loop over particles
-        for(ParticleSubset::iterator iter = pset->begin();
-            iter != pset->end(); iter++){
-          particleIndex idx = *iter;
+        // Loop over particles, a batch at a time
+        const int numParticles = pset->numParticles();
+        for (int b0 = 0; b0 < numParticles; b0 += batchSize) {
+          const int nbatch = Min(numParticles - b0, batchSize);
+          const particleIndex* batch = pset->getPointer() + b0;
 
           // Get the node indices that surround the cell
-          int NN = interpolator->findCellAndWeights(px[idx], ni, S,
-                                                    pcursize[idx]);
-          Vector vel(0.0,0.0,0.0);
-          Vector velSSPSSP(0.0,0.0,0.0);
-          Vector acc(0.0,0.0,0.0);
-          double fricTempRate = 0.0;
-          double tempRate = 0.0;
-          double concRate = 0.0;
-          double burnFraction = 0.0;
-
-          // Accumulate the contribution from each surrounding vertex
-          for (int k = 0; k < NN; k++) {
-            IntVector node = ni[k];
-            vel      += gvelocity_star[node]  * S[k];
-            velSSPSSP+= gvelSPSSP[node]       * S[k];
-            acc      += gacceleration[node]   * S[k];
-
-            fricTempRate = frictionTempRate[node]*flags->d_addFrictionWork;
-            tempRate += (gTemperatureRate[node] + dTdt[node] +
-                         fricTempRate)   * S[k];
-            burnFraction += massBurnFrac[node]     * S[k];
-          }
+          const int NN = interpolator->findCellsAndWeights(batch, nbatch, px,
+                                                  pcursize, &ni_batch[0], &S_batch[0]);
+          for (int b = 0; b < nbatch; b++) {
+            particleIndex idx = batch[b];
+            const IntVector* ni = &ni_batch[b*NN];
+            const double*    S  = &S_batch[b*NN];
+            Vector vel(0.0,0.0,0.0);
+            Vector velSSPSSP(0.0,0.0,0.0);
+            Vector acc(0.0,0.0,0.0);
+            double fricTempRate = 0.0;
+            double tempRate = 0.0;
+            double concRate = 0.0;
+            double burnFraction = 0.0;
+
+            // Accumulate the contribution from each surrounding vertex
+            for (int k = 0; k < NN; k++) {
+              IntVector node = ni[k];
+              vel      += gvelocity_star[node]  * S[k];
+              velSSPSSP+= gvelSPSSP[node]       * S[k];
+              acc      += gacceleration[node]   * S[k];
+
+              fricTempRate = frictionTempRate[node]*flags->d_addFrictionWork;
+              tempRate += (gTemperatureRate[node] + dTdt[node] +
+                           fricTempRate)   * S[k];
+              burnFraction += massBurnFrac[node]     * S[k];
+            }
 
-          // Update particle vel and pos using Nairn's XPIC(2) method
-          pxnew[idx] = px[idx]    + vel*delT
-                     - 0.5*(acc*delT + (pvelocity[idx] - 2.0*pvelSSPlus[idx])
-                                                       + velSSPSSP)*delT;
-          pvelnew[idx]  = 2.0*pvelSSPlus[idx] - velSSPSSP   + acc*delT;
-          pdispnew[idx] = pdisp[idx] + (pxnew[idx]-px[idx]);
+            // Update particle vel and pos using Nairn's XPIC(2) method
+            pxnew[idx] = px[idx]    + vel*delT
+                       - 0.5*(acc*delT + (pvelocity[idx] - 2.0*pvelSSPlus[idx])
+                                                         + velSSPSSP)*delT;
+            pvelnew[idx]  = 2.0*pvelSSPlus[idx] - velSSPSSP   + acc*delT;
+            pdispnew[idx] = pdisp[idx] + (pxnew[idx]-px[idx]);
 #if 0
-          // PIC, or XPIC(1)
-          pxnew[idx]    = px[idx]    + vel*delT
-                     - 0.5*(acc*delT + (pvelocity[idx] - pvelSSPlus[idx]))*delT;
-          pvelnew[idx]   = pvelSSPlus[idx]    + acc*delT;
+            // PIC, or XPIC(1)
+            pxnew[idx]    = px[idx]    + vel*delT
+                       - 0.5*(acc*delT + (pvelocity[idx] - pvelSSPlus[idx]))*delT;
+            pvelnew[idx]   = pvelSSPlus[idx]    + acc*delT;
 #endif
-          pTempNew[idx]    = pTemperature[idx] + tempRate*delT;
-          pTempPreNew[idx] = pTemperature[idx]; // for thermal stress
-          pmassNew[idx]    = Max(pmass[idx]*(1.    - burnFraction),0.);
-          psizeNew[idx]    = (pmassNew[idx]/pmass[idx])*psize[idx];
-
-          if (flags->d_doScalarDiffusion) {
-            for (int k = 0; k < NN; ++k) {
-              IntVector node = ni[k];
-              concRate += gConcentrationRate[node] * S[k];
-            }
+            pTempNew[idx]    = pTemperature[idx] + tempRate*delT;
+            pTempPreNew[idx] = pTemperature[idx]; // for thermal stress
+            pmassNew[idx]    = Max(pmass[idx]*(1.    - burnFraction),0.);
+            psizeNew[idx]    = (pmassNew[idx]/pmass[idx])*psize[idx];
+
+            if (flags->d_doScalarDiffusion) {
+              for (int k = 0; k < NN; ++k) {
+                IntVector node = ni[k];
+                concRate += gConcentrationRate[node] * S[k];
+              }
 
-            pConcentrationNew[idx] = pConcentration[idx] + concRate * delT;
-            if (pConcentrationNew[idx] < sdmMinEffectiveConc) {
-              pConcentrationNew[idx] = sdmMinEffectiveConc;
-            }
-            if (pConcentrationNew[idx] > sdmMaxEffectiveConc) {
-              pConcentrationNew[idx] = sdmMaxEffectiveConc;
-            }
+              pConcentrationNew[idx] = pConcentration[idx] + concRate * delT;
+              if (pConcentrationNew[idx] < sdmMinEffectiveConc) {
+                pConcentrationNew[idx] = sdmMinEffectiveConc;
+              }
+              if (pConcentrationNew[idx] > sdmMaxEffectiveConc) {
+                pConcentrationNew[idx] = sdmMaxEffectiveConc;
+              }
 
-            pConcPreviousNew[idx] = pConcentration[idx];
-            if (mpm_matl->doConcReduction()) {
-              if (flags->d_autoCycleUseMinMax) {
-                if (pConcentrationNew[idx] > maxPatchConc)
-                  maxPatchConc = pConcentrationNew[idx];
-                if (pConcentrationNew[idx] < minPatchConc)
-                  minPatchConc = pConcentrationNew[idx];
-              } else {
-                totalConc += pConcentration[idx];
+              pConcPreviousNew[idx] = pConcentration[idx];
+              if (mpm_matl->doConcReduction()) {
+                if (flags->d_autoCycleUseMinMax) {
+                  if (pConcentrationNew[idx] > maxPatchConc)
+                    maxPatchConc = pConcentrationNew[idx];
+                  if (pConcentrationNew[idx] < minPatchConc)
+                    minPatchConc = pConcentrationNew[idx];
+                } else {
+                  totalConc += pConcentration[idx];
+                }
               }
             }
-          }
 
-          thermal_energy += pTemperature[idx] * pmass[idx] * Cp;
-          ke += .5*pmass[idx]*pvelnew[idx].length2();
-          CMX         = CMX + (pxnew[idx]*pmass[idx]).asVector();
-          totalMom   += pvelnew[idx]*pmass[idx];
-          totalmass  += pmass[idx];
+            thermal_energy += pTemperature[idx] * pmass[idx] * Cp;
+            ke += .5*pmass[idx]*pvelnew[idx].length2();
+            CMX         = CMX + (pxnew[idx]*pmass[idx]).asVector();
+            totalMom   += pvelnew[idx]*pmass[idx];
+            totalmass  += pmass[idx];
+          }
         }
       } else {  // Not XPIC(2)
-        // Loop over particles
-        for(ParticleSubset::iterator iter = pset->begin();
-            iter != pset->end(); iter++){
-          particleIndex idx = *iter;
+        // Loop over particles, a batch at a time
+        const int numParticles = pset->numParticles();
+        for (int b0 = 0; b0 < numParticles; b0 += batchSize) {
+          const int nbatch = Min(numParticles - b0, batchSize);
+          const particleIndex* batch = pset->getPointer() + b0;
 
           // Get the node indices that surround the cell
-          int NN = interpolator->findCellAndWeights(px[idx], ni, S,
-                                                    pcursize[idx]);
-          Vector vel(0.0,0.0,0.0);
-          Vector acc(0.0,0.0,0.0);
-          double fricTempRate = 0.0;
-          double tempRate = 0.0;
-          double concRate = 0.0;
-          double burnFraction = 0.0;
-
-          // Accumulate the contribution from each surrounding vertex
-          for (int k = 0; k < NN; k++) {
-            IntVector node = ni[k];
-            vel      += gvelocity_star[node]  * S[k];
-            acc      += gacceleration[node]   * S[k];
-
-            fricTempRate = frictionTempRate[node]*flags->d_addFrictionWork;
-            tempRate += (gTemperatureRate[node] + dTdt[node] +
-                         fricTempRate)   * S[k];
-            burnFraction += massBurnFrac[node]     * S[k];
-          }
+          const int NN = interpolator->findCellsAndWeights(batch, nbatch, px,
+                                                  pcursize, &ni_batch[0], &S_batch[0]);
+          for (int b = 0; b < nbatch; b++) {
+            particleIndex idx = batch[b];
+            const IntVector* ni = &ni_batch[b*NN];
+            const double*    S  = &S_batch[b*NN];
+            Vector vel(0.0,0.0,0.0);
+            Vector acc(0.0,0.0,0.0);
+            double fricTempRate = 0.0;
+            double tempRate = 0.0;
+            double concRate = 0.0;
+            double burnFraction = 0.0;
+
+            // Accumulate the contribution from each surrounding vertex
+            for (int k = 0; k < NN; k++) {
+              IntVector node = ni[k];
+              vel      += gvelocity_star[node]  * S[k];
+              acc      += gacceleration[node]   * S[k];
 
-          // Update the particle's pos and vel using std "FLIP" method
-          pxnew[idx]   = px[idx]        + vel*delT;
-          pdispnew[idx]= pdisp[idx]     + vel*delT;
-          pvelnew[idx] = pvelocity[idx] + acc*delT;
+              fricTempRate = frictionTempRate[node]*flags->d_addFrictionWork;
+              tempRate += (gTemperatureRate[node] + dTdt[node] +
+                           fricTempRate)   * S[k];
+              burnFraction += massBurnFrac[node]     * S[k];
+            }
 
-          pTempNew[idx]    = pTemperature[idx] + tempRate*delT;
-          pTempPreNew[idx] = pTemperature[idx]; // for thermal stress
-          pmassNew[idx]    = Max(pmass[idx]*(1.    - burnFraction),0.);
-          psizeNew[idx]    = (pmassNew[idx]/pmass[idx])*psize[idx];
+            // Update the particle's pos and vel using std "FLIP" method
+            pxnew[idx]   = px[idx]        + vel*delT;
+            pdispnew[idx]= pdisp[idx]     + vel*delT;
+            pvelnew[idx] = pvelocity[idx] + acc*delT;
 
-          if (flags->d_doScalarDiffusion) {
-            for (int k = 0; k < NN; ++k) {
-              IntVector node = ni[k];
-              concRate += gConcentrationRate[node] * S[k];
-            }
+            pTempNew[idx]    = pTemperature[idx] + tempRate*delT;
+            pTempPreNew[idx] = pTemperature[idx]; // for thermal stress
+            pmassNew[idx]    = Max(pmass[idx]*(1.    - burnFraction),0.);
+            psizeNew[idx]    = (pmassNew[idx]/pmass[idx])*psize[idx];
 
-            pConcentrationNew[idx] = pConcentration[idx] + concRate * delT;
-            if (pConcentrationNew[idx] < sdmMinEffectiveConc) {
-              pConcentrationNew[idx] = sdmMinEffectiveConc;
-            }
-            if (pConcentrationNew[idx] > sdmMaxEffectiveConc) {
-              pConcentrationNew[idx] = sdmMaxEffectiveConc;
-            }
+            if (flags->d_doScalarDiffusion) {
+              for (int k = 0; k < NN; ++k) {
+                IntVector node = ni[k];
+                concRate += gConcentrationRate[node] * S[k];
+              }
 
-            pConcPreviousNew[idx] = pConcentration[idx];
-            if (mpm_matl->doConcReduction()) {
-              if (flags->d_autoCycleUseMinMax) {
-                if (pConcentrationNew[idx] > maxPatchConc)
-                  maxPatchConc = pConcentrationNew[idx];
-                if (pConcentrationNew[idx] < minPatchConc)
-                  minPatchConc = pConcentrationNew[idx];
-              } else {
-                totalConc += pConcentration[idx];
+              pConcentrationNew[idx] = pConcentration[idx] + concRate * delT;
+              if (pConcentrationNew[idx] < sdmMinEffectiveConc) {
+                pConcentrationNew[idx] = sdmMinEffectiveConc;
+              }
+              if (pConcentrationNew[idx] > sdmMaxEffectiveConc) {
+                pConcentrationNew[idx] = sdmMaxEffectiveConc;
+              }
+
+              pConcPreviousNew[idx] = pConcentration[idx];
+              if (mpm_matl->doConcReduction()) {
+                if (flags->d_autoCycleUseMinMax) {
+                  if (pConcentrationNew[idx] > maxPatchConc)
+                    maxPatchConc = pConcentrationNew[idx];
+                  if (pConcentrationNew[idx] < minPatchConc)
+                    minPatchConc = pConcentrationNew[idx];
+                } else {
+                  totalConc += pConcentration[idx];
+                }
               }
             }
-          }
 
-          thermal_energy += pTemperature[idx] * pmass[idx] * Cp;
-          ke += .5*pmass[idx]*pvelnew[idx].length2();
-          CMX         = CMX + (pxnew[idx]*pmass[idx]).asVector();
-          totalMom   += pvelnew[idx]*pmass[idx];
-          totalmass  += pmass[idx];
+            thermal_energy += pTemperature[idx] * pmass[idx] * Cp;
+            ke += .5*pmass[idx]*pvelnew[idx].length2();
+            CMX         = CMX + (pxnew[idx]*pmass[idx]).asVector();
+            totalMom   += pvelnew[idx]*pmass[idx];
+            totalmass  += pmass[idx];
+          }
         }
       } // use XPIC(2) or not
 
@@ -1753,15 +1753,16 @@ void MPMICE::interpolateCCToNC(const ProcessorGroup*,
  ----------------
     - Compute rho_micro_CC, SpeedSound, vol_frac for ALL matls
 
-    For each cell
-    _ WHILE LOOP(convergence, max_iterations)
+    For each block of cells
+    _ WHILE LOOP(cells left in the block)
         - compute the pressure and dp_drho from the EOS of each material.
         - Compute delta Pressure
         - Compute delta volume fraction and update the 
           volume fraction and the celldensity.
         - Test for convergence of delta pressure and delta volume fraction
+        - converged cells (or at max_iterations, after a binary
+          pressure search) are bulletproofed and leave the block
     - END WHILE LOOP
-    - bulletproofing
     end
  
 Note:  The nomenclature follows the reference.
@@ -1903,234 +1904,317 @@ void MPMICE::computeEquilibrationPressure(const ProcessorGroup*,
     }  // cell iterator
 
     //______________________________________________________________________
-    // Done with preliminary calcs, now loop over every cell
-    int count, test_max_iter = 0;
+    // Done with preliminary calcs, now iterate on blocks of cells.  The cells
+    // of a block are iterated together, through the block versions of the ICE
+    // EOS, and each cell leaves the block once it has converged (or reached
+    // the max. number of iterations).  Block data is stored [m*blockSize + i].
+    const int blockSize = 16;
 
-    for (CellIterator iter = patch->getExtraCellIterator();!iter.done();iter++){
-      const IntVector& c = *iter;  
-      double delPress = 0.;
-      bool converged  = false;
-      double sum;
-      count           = 0;
-      vector<EqPress_dbg> dbgEqPress;
-
-      while ( count < d_ice->d_max_iter_equilibration && converged == false) {
+    std::vector<EquationOfState*> eos(numALLMatls, nullptr);
+    for (unsigned int m = 0; m < numALLMatls; m++) {
+      if(ice_matl[m]){
+        eos[m] = ice_matl[m]->getEOS();
+      }
+    }
+
+    std::vector<double> b_rho_micro(numALLMatls*blockSize), b_vol_frac(numALLMatls*blockSize);
+    std::vector<double> b_rho_CC(numALLMatls*blockSize),    b_Temp(numALLMatls*blockSize);
+    std::vector<double> b_gamma(numALLMatls*blockSize),     b_cv(numALLMatls*blockSize);
+    std::vector<double> b_press_eos(numALLMatls*blockSize);
+    std::vector<double> b_dp_drho(numALLMatls*blockSize),   b_dp_de(numALLMatls*blockSize);
+
+    IntVector b_cell[blockSize];
+    double    b_press[blockSize], b_delPress[blockSize], b_sum[blockSize];
+    double    A[blockSize], B[blockSize], C[blockSize];
+    vector<EqPress_dbg> dbgEqPress[blockSize];
+
+    // copy cell j of the block to i
+    auto moveCell = [&]( int j, int i ){
+      b_cell[i]     = b_cell[j];
+      b_press[i]    = b_press[j];
+      b_delPress[i] = b_delPress[j];
+      b_sum[i]      = b_sum[j];
+      dbgEqPress[i].swap( dbgEqPress[j] );
+      for (unsigned int m = 0; m < numALLMatls; m++) {
+        const int mi = m*blockSize + i, mj = m*blockSize + j;
+        b_rho_micro[mi] = b_rho_micro[mj];
+        b_vol_frac[mi]  = b_vol_frac[mj];
+        b_rho_CC[mi]    = b_rho_CC[mj];
+        b_Temp[mi]      = b_Temp[mj];
+        b_gamma[mi]     = b_gamma[mj];
+        b_cv[mi]        = b_cv[mj];
+        b_press_eos[mi] = b_press_eos[mj];
+        b_dp_drho[mi]   = b_dp_drho[mj];
+        b_dp_de[mi]     = b_dp_de[mj];
+      }
+    };
+
+    int test_max_iter = 0;
+    CellIterator iter = patch->getExtraCellIterator();
+
+    while( !iter.done() ){
+      int n = 0;
+      for (; n < blockSize && !iter.done(); n++, iter++) {
+        const IntVector& c = *iter;
+        b_cell[n]     = c;
+        b_press[n]    = press_new[c];
+        b_delPress[n] = 0.;
+        b_sum[n]      = 0.;
+        dbgEqPress[n].clear();
+        for (unsigned int m = 0; m < numALLMatls; m++) {
+          const int mi = m*blockSize + n;
+          b_rho_micro[mi] = rho_micro[m][c];
+          b_vol_frac[mi]  = vol_frac[m][c];
+          b_rho_CC[mi]    = rho_CC_new[m][c];
+          b_Temp[mi]      = Temp[m][c];
+          if(ice_matl[m]){
+            b_gamma[mi]   = gamma[m][c];
+            b_cv[mi]      = cv[m][c];
+          }
+        }
+      }
+
+      int count = 0;
+      while ( n > 0 ) {
         count++;
         //__________________________________
-        // evaluate press_eos at cell i,j,k
+        // evaluate press_eos at each cell
         for (unsigned int m = 0; m < numALLMatls; m++)  {
+          const int m0 = m*blockSize;
           if(ice_matl[m]){    // ICE
-            ice_matl[m]->getEOS()->computePressEOS( rho_micro[m][c], gamma[m][c],
-                                                   cv[m][c], Temp[m][c],
-                                                   press_eos[m],
-                                                   dp_drho[m], dp_de[m] );
+            eos[m]->computePressEOSBlock( n, &b_rho_micro[m0], &b_gamma[m0],
+                                          &b_cv[m0], &b_Temp[m0], &b_press_eos[m0],
+                                          &b_dp_drho[m0], &b_dp_de[m0] );
           } else if(mpm_matl[m]){    // MPM
-            mpm_matl[m]->getConstitutiveModel()->
-              computePressEOSCM( rho_micro[m][c], press_eos[m], press_ref,
-                                dp_drho[m], c_2,mpm_matl[m],Temp[m][c] );
+            for (int i = 0; i < n; i++) {
+              mpm_matl[m]->getConstitutiveModel()->
+                computePressEOSCM( b_rho_micro[m0+i], b_press_eos[m0+i], press_ref,
+                                  b_dp_drho[m0+i], c_2,mpm_matl[m],b_Temp[m0+i] );
+            }
           }
         }
 
         //__________________________________
         // - compute delPress
         // - update press_CC     
-        double A = 0., B = 0., C = 0.;
-
+        for (int i = 0; i < n; i++) {
+          A[i] = 0.;  B[i] = 0.;  C[i] = 0.;
+        }
         for (unsigned int m = 0; m < numALLMatls; m++)   {
-          double Q =  press_new[c] - press_eos[m];
-          double inv_y =  (vol_frac[m][c] * vol_frac[m][c])
-                        / (dp_drho[m] * rho_CC_new[m][c] + d_SMALL_NUM);
-                                 
-          A   +=  vol_frac[m][c];
-          B   +=  Q * inv_y;
-          C   +=  inv_y;
+          const int m0 = m*blockSize;
+          for (int i = 0; i < n; i++) {
+            double Q =  b_press[i] - b_press_eos[m0+i];
+            double inv_y =  (b_vol_frac[m0+i] * b_vol_frac[m0+i])
+                          / (b_dp_drho[m0+i] * b_rho_CC[m0+i] + d_SMALL_NUM);
+                                   
+            A[i]   +=  b_vol_frac[m0+i];
+            B[i]   +=  Q * inv_y;
+            C[i]   +=  inv_y;
+          }
         } 
         double vol_frac_not_close_packed = 1.;
-        delPress = (A - vol_frac_not_close_packed - B)/C;
+        for (int i = 0; i < n; i++) {
+          b_delPress[i] = (A[i] - vol_frac_not_close_packed - B[i])/C[i];
 
-        press_new[c] += delPress;
+          b_press[i] += b_delPress[i];
 
-        if(press_new[c] < convergence_crit ){
-          press_new[c] = fabs(delPress);
+          if(b_press[i] < convergence_crit ){
+            b_press[i] = fabs(b_delPress[i]);
+          }
         }
         
-       //__________________________________
-       // backout rho_micro_CC at this new pressure
-       // - compute the updated volume fractions
-       sum = 0;
-       for (unsigned int m = 0; m < numALLMatls; m++) {
-         if(ice_matl[m]){
-           rho_micro[m][c] = 
-             ice_matl[m]->getEOS()->computeRhoMicro(press_new[c],gamma[m][c],
-                                           cv[m][c],Temp[m][c],rho_micro[m][c]);
-         } if(mpm_matl[m]){
-           rho_micro[m][c] =  
-             mpm_matl[m]->getConstitutiveModel()->computeRhoMicroCM(
-                                          press_new[c],press_ref,mpm_matl[m],Temp[m][c],rho_micro[m][c]);
-         }
-         vol_frac[m][c]   = rho_CC_new[m][c]/rho_micro[m][c];
-         sum += vol_frac[m][c];
-       }
+        //__________________________________
+        // backout rho_micro_CC at this new pressure
+        // - compute the updated volume fractions
+        for (int i = 0; i < n; i++) {
+          b_sum[i] = 0;
+        }
+        for (unsigned int m = 0; m < numALLMatls; m++) {
+          const int m0 = m*blockSize;
+          if(ice_matl[m]){
+            eos[m]->computeRhoMicroBlock( n, b_press, &b_gamma[m0], &b_cv[m0],
+                                          &b_Temp[m0], &b_rho_micro[m0],
+                                          &b_rho_micro[m0] );
+          } if(mpm_matl[m]){
+            for (int i = 0; i < n; i++) {
+              b_rho_micro[m0+i] =  
+                mpm_matl[m]->getConstitutiveModel()->computeRhoMicroCM(
+                                    b_press[i],press_ref,mpm_matl[m],b_Temp[m0+i],b_rho_micro[m0+i]);
+            }
+          }
+          for (int i = 0; i < n; i++) {
+            b_vol_frac[m0+i] = b_rho_CC[m0+i]/b_rho_micro[m0+i];
+            b_sum[i] += b_vol_frac[m0+i];
+          }
+        }
 
-       //__________________________________
-       // - Test for convergence 
-       //  If sum of vol_frac_CC ~= 1.0 then converged 
-       if (fabs(sum-vol_frac_not_close_packed) < convergence_crit){
-         converged = true;
-         
-         //__________________________________
-         // Find the speed of sound based on the converged solution
-         //feclearexcept(FE_ALL_EXCEPT);
-         for (unsigned int m = 0; m < numALLMatls; m++)  {
-           if(ice_matl[m]){
-             ice_matl[m]->getEOS()->computePressEOS(rho_micro[m][c],gamma[m][c],
-                                              cv[m][c],Temp[m][c],press_eos[m],
-                                              dp_drho[m],dp_de[m]);
+        for (int i = 0; i < n; ) {
+          const IntVector c = b_cell[i];
+          //__________________________________
+          // - Test for convergence 
+          //  If sum of vol_frac_CC ~= 1.0 then converged 
+          bool converged = fabs(b_sum[i]-vol_frac_not_close_packed) < convergence_crit;
+
+          if (converged){
+            //__________________________________
+            // Find the speed of sound based on the converged solution
+            for (unsigned int m = 0; m < numALLMatls; m++)  {
+              const int mi = m*blockSize + i;
+              if(ice_matl[m]){
+                eos[m]->computePressEOS(b_rho_micro[mi],b_gamma[mi],
+                                        b_cv[mi],b_Temp[mi],b_press_eos[mi],
+                                        b_dp_drho[mi],b_dp_de[mi]);
+
+                c_2 = b_dp_drho[mi] + b_dp_de[mi] * 
+                           (b_press_eos[mi]/(b_rho_micro[mi]*b_rho_micro[mi]));
+              } else if(mpm_matl[m]){
+                 mpm_matl[m]->getConstitutiveModel()->
+                      computePressEOSCM(b_rho_micro[mi],b_press_eos[mi],press_ref,
+                                        b_dp_drho[mi],c_2,mpm_matl[m],b_Temp[mi]);
+              }
+              speedSound[m][c] = sqrt(c_2);         // Isentropic speed of sound
+            }
+          }
 
-             c_2 = dp_drho[m] + dp_de[m] * 
-                        (press_eos[m]/(rho_micro[m][c]*rho_micro[m][c]));
-           } else if(mpm_matl[m]){
-              mpm_matl[m]->getConstitutiveModel()->
-                   computePressEOSCM(rho_micro[m][c],press_eos[m],press_ref,
-                                     dp_drho[m],c_2,mpm_matl[m],Temp[m][c]);
-           }
-           speedSound[m][c] = sqrt(c_2);         // Isentropic speed of sound
-
-           //____ BB : B U L L E T   P R O O F I N G----
-           // catch inf and nan speed sound values
-           //if (fetestexcept(FE_INVALID) != 0 || c_2 == 0.0) {
-           //  ostringstream warn;
-           //  warn<<"ERROR MPMICE::computeEquilPressure, mat= "<< m << " cell= "
-           //      << c << " sound speed is imaginary.\n";
-           //  warn << "speedSound = " << speedSound[m][c] << " c_2 = " << c_2 
-           //       << " press_eos = " << press_eos[m]
-           //       << " dp_drho = " << dp_drho[m]
-           //       << " dp_de = " << dp_de[m]
-           //       << " rho_micro = " << rho_micro[m][c] << " Temp = " << Temp[m][c] << endl;
-           //  throw ProblemSetupException(warn.str(), __FILE__, __LINE__ );
-           //}
-         }
-       }
-
-       // Save iteration data for output in case of crash
-       if(ds_EqPress.active()){
-         EqPress_dbg dbg;
-         dbg.delPress     = delPress;
-         dbg.press_new    = press_new[c];
-         dbg.sumVolFrac   = sum;
-         dbg.count        = count;
-
-         for (unsigned int m = 0; m < numALLMatls; m++) {
-           EqPress_dbgMatl dmatl;
-           dmatl.press_eos   = press_eos[m];
-           dmatl.volFrac     = vol_frac[m][c];
-           dmatl.rhoMicro    = rho_micro[m][c];
-           dmatl.rho_CC      = rho_CC_new[m][c];
-           dmatl.temp_CC     = Temp[m][c];
-           dmatl.mat         = m;
-           dbg.matl.push_back(dmatl);
-         }
-         dbgEqPress.push_back(dbg);
-       }
-       
-     }   // end of converged
+          // Save iteration data for output in case of crash
+          if(ds_EqPress.active()){
+            EqPress_dbg dbg;
+            dbg.delPress     = b_delPress[i];
+            dbg.press_new    = b_press[i];
+            dbg.sumVolFrac   = b_sum[i];
+            dbg.count        = count;
+
+            for (unsigned int m = 0; m < numALLMatls; m++) {
+              const int mi = m*blockSize + i;
+              EqPress_dbgMatl dmatl;
+              dmatl.press_eos   = b_press_eos[mi];
+              dmatl.volFrac     = b_vol_frac[mi];
+              dmatl.rhoMicro    = b_rho_micro[mi];
+              dmatl.rho_CC      = b_rho_CC[mi];
+              dmatl.temp_CC     = b_Temp[mi];
+              dmatl.mat         = m;
+              dbg.matl.push_back(dmatl);
+            }
+            dbgEqPress[i].push_back(dbg);
+          }
 
-      delPress_tmp[c] = delPress;
+          if ( !converged && count < d_ice->d_max_iter_equilibration ){
+            i++;
+            continue;
+          }
 
-     //__________________________________
-     // If the pressure solution has stalled out 
-     //  then try a binary search.  Keep track ofthe number
-     // of iterations inside of the search.
-     int binaryPressCount = 0;
-     
-     if(count >= d_ice->d_max_iter_equilibration) {
-        //int lev = patch->getLevel()->getIndex();
-        //cout << "WARNING:MPMICE:ComputeEquilibrationPressure "
-        //     << " Cell : " << c << " on level " << lev << " having a difficult time converging. \n"
-        //    << " Now performing a binary pressure search " << endl;
-
-        //int binaryPressCount;
-        binaryPressureSearch( Temp, rho_micro, vol_frac, rho_CC_new,
-                              speedSound,  dp_drho,  dp_de, 
-                              press_eos, press, press_new, press_ref,
-                              cv, gamma, convergence_crit, 
-                              numALLMatls, count, sum, c);
-        binaryPressCount = count;
-     }
-     
-     nIterations[c] = count + binaryPressCount;
-     test_max_iter = std::max(test_max_iter, count);
+          //__________________________________
+          // This cell is done, it leaves the block
+          press_new[c]    = b_press[i];
+          delPress_tmp[c] = b_delPress[i];
+          for (unsigned int m = 0; m < numALLMatls; m++) {
+            rho_micro[m][c] = b_rho_micro[m*blockSize + i];
+            vol_frac[m][c]  = b_vol_frac[m*blockSize + i];
+          }
+          double sum = b_sum[i];
+          int cellCount = count;
+
+          //__________________________________
+          // If the pressure solution has stalled out 
+          //  then try a binary search.  Keep track ofthe number
+          // of iterations inside of the search.
+          int binaryPressCount = 0;
+          
+          if(cellCount >= d_ice->d_max_iter_equilibration) {
+            for (unsigned int m = 0; m < numALLMatls; m++) {
+              press_eos[m] = b_press_eos[m*blockSize + i];
+              dp_drho[m]   = b_dp_drho[m*blockSize + i];
+              dp_de[m]     = b_dp_de[m*blockSize + i];
+            }
+            binaryPressureSearch( Temp, rho_micro, vol_frac, rho_CC_new,
+                                  speedSound,  dp_drho,  dp_de, 
+                                  press_eos, press, press_new, press_ref,
+                                  cv, gamma, convergence_crit, 
+                                  numALLMatls, cellCount, sum, c);
+            binaryPressCount = cellCount;
+          }
+          
+          nIterations[c] = cellCount + binaryPressCount;
+          test_max_iter = std::max(test_max_iter, cellCount);
 
-      //__________________________________
-      //      BULLET PROOFING
-      // ignore BP if time step recompute has already been requested
-      bool rts = new_dw->recomputeTimeStep();
-      
-      string message;
-      bool allTestsPassed = true;
-      if(test_max_iter == d_ice->d_max_iter_equilibration && !rts){
-        allTestsPassed = false;
-        message += "Max. iterations reached ";
-      }
-      
-      for (unsigned int m = 0; m < numALLMatls; m++) {
-        ASSERT(( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0));
-      }
-      
-      if ( fabs(sum - 1.0) > convergence_crit && !rts) {  
-        allTestsPassed = false;
-        message += " sum (volumeFractions) != 1 ";
-      }
-      
-      if ( press_new[c] < 0.0 && !rts) {
-        allTestsPassed = false;
-        message += " Computed pressure is < 0 ";
-      }
-      
-      for (unsigned int m = 0; m < numALLMatls; m++){
-        if ((rho_micro[m][c] < 0.0 || vol_frac[m][c] < 0.0) && !rts) {
-          allTestsPassed = false;
-          message += " rho_micro < 0 || vol_frac < 0";
-        }
-      }
-      if(allTestsPassed != true){  // throw an exception of there's a problem
-        Point pt = patch->getCellPosition(c);
-        
-        ostringstream warn;
-        warn << "\nMPMICE::ComputeEquilibrationPressure: Cell: "<< c << ", position: " << pt << ", L-"<<L_indx <<"\n"
-             << message
-             <<"\nThis usually means that something much deeper has gone wrong with the simulation. "
-             <<"\nCompute equilibration pressure task is rarely the problem. "
-             << "For more debugging information set the environmental variable:  \n"
-             << "   SCI_DEBUG DBG_EqPress:+\n\n";
-             
-        warn << "INPUTS: \n"; 
-        for (unsigned int m = 0; m < numALLMatls; m++){
-          warn<< "\n matl: " << m << "\n"
-               << "   rho_CC:     " << rho_CC_new[m][c] << "\n"
-               << "   Temperature:   "<< Temp[m][c] << "\n";
-        }
-        if(ds_EqPress.active()){
-          warn << "\nDetails on iterations " << endl;
-          vector<EqPress_dbg>::iterator dbg_iter;
-          for( dbg_iter  = dbgEqPress.begin(); dbg_iter != dbgEqPress.end(); dbg_iter++){
-            EqPress_dbg & d = *dbg_iter;
-            warn << "Iteration:   " << d.count
-                 << "  press_new:   " << d.press_new
-                 << "  sumVolFrac:  " << d.sumVolFrac
-                 << "  delPress:    " << d.delPress << "\n";
+          //__________________________________
+          //      BULLET PROOFING
+          // ignore BP if time step recompute has already been requested
+          bool rts = new_dw->recomputeTimeStep();
+          
+          string message;
+          bool allTestsPassed = true;
+          if(test_max_iter == d_ice->d_max_iter_equilibration && !rts){
+            allTestsPassed = false;
+            message += "Max. iterations reached ";
+          }
+          
+          for (unsigned int m = 0; m < numALLMatls; m++) {
+            ASSERT(( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0));
+          }
+          
+          if ( fabs(sum - 1.0) > convergence_crit && !rts) {  
+            allTestsPassed = false;
+            message += " sum (volumeFractions) != 1 ";
+          }
+          
+          if ( press_new[c] < 0.0 && !rts) {
+            allTestsPassed = false;
+            message += " Computed pressure is < 0 ";
+          }
+          
+          for (unsigned int m = 0; m < numALLMatls; m++){
+            if ((rho_micro[m][c] < 0.0 || vol_frac[m][c] < 0.0) && !rts) {
+              allTestsPassed = false;
+              message += " rho_micro < 0 || vol_frac < 0";
+            }
+          }
+          if(allTestsPassed != true){  // throw an exception of there's a problem
+            Point pt = patch->getCellPosition(c);
+            
+            ostringstream warn;
+            warn << "\nMPMICE::ComputeEquilibrationPressure: Cell: "<< c << ", position: " << pt << ", L-"<<L_indx <<"\n"
+                 << message
+                 <<"\nThis usually means that something much deeper has gone wrong with the simulation. "
+                 <<"\nCompute equilibration pressure task is rarely the problem. "
+                 << "For more debugging information set the environmental variable:  \n"
+                 << "   SCI_DEBUG DBG_EqPress:+\n\n";
+                 
+            warn << "INPUTS: \n"; 
             for (unsigned int m = 0; m < numALLMatls; m++){
-              warn << "  matl: " << d.matl[m].mat
-                   << "  press_eos:  " << d.matl[m].press_eos
-                   << "  volFrac:    " << d.matl[m].volFrac
-                   << "  rhoMicro:   " << d.matl[m].rhoMicro
-                   << "  rho_CC:     " << d.matl[m].rho_CC
-                   << "  Temp:       " << d.matl[m].temp_CC << "\n";
+              warn<< "\n matl: " << m << "\n"
+                   << "   rho_CC:     " << rho_CC_new[m][c] << "\n"
+                   << "   Temperature:   "<< Temp[m][c] << "\n";
             }
+            if(ds_EqPress.active()){
+              warn << "\nDetails on iterations " << endl;
+              vector<EqPress_dbg>::iterator dbg_iter;
+              for( dbg_iter  = dbgEqPress[i].begin(); dbg_iter != dbgEqPress[i].end(); dbg_iter++){
+                EqPress_dbg & d = *dbg_iter;
+                warn << "Iteration:   " << d.count
+                     << "  press_new:   " << d.press_new
+                     << "  sumVolFrac:  " << d.sumVolFrac
+                     << "  delPress:    " << d.delPress << "\n";
+                for (unsigned int m = 0; m < numALLMatls; m++){
+                  warn << "  matl: " << d.matl[m].mat
+                       << "  press_eos:  " << d.matl[m].press_eos
+                       << "  volFrac:    " << d.matl[m].volFrac
+                       << "  rhoMicro:   " << d.matl[m].rhoMicro
+                       << "  rho_CC:     " << d.matl[m].rho_CC
+                       << "  Temp:       " << d.matl[m].temp_CC << "\n";
+                }
+              }
+            } 
+          }  // all testsPassed
+
+          // the last cell of the block takes its place
+          n--;
+          if ( i != n ){
+            moveCell( n, i );
           }
-        } 
-      }  // all testsPassed
-    }  // end of cell interator
+        }
+      }  // end of block iterations
+    }  // end of blocks
     if (cout_norm.active())
       cout_norm<<"max number of iterations in any cell \t"<<test_max_iter<<endl;
 
@@ -29,6 +29,7 @@
 #include <Core/Grid/DbgOutput.h>
 #include <Core/Grid/Variables/PerPatch.h>
 #include <Core/Math/MersenneTwister.h>
+#include <Core/Math/PhiloxRand.h>
 #include <Core/Util/DOUT.hpp>
 
 #include <fstream>
@@ -397,8 +398,9 @@ RMCRTCommon::raySignStep(double sign[],
 //______________________________________________________________________
 //  Compute the ray direction
 //______________________________________________________________________
+template< class RNG >
 Vector
-RMCRTCommon::findRayDirection(MTRand& mTwister,
+RMCRTCommon::findRayDirection(RNG& mTwister,
                              const IntVector& origin,
                              const int iRay )
 {
@@ -442,8 +444,9 @@ RMCRTCommon::findRayDirection(MTRand& mTwister,
 //______________________________________________________________________
 //  Compute the physical location of a ray's origin
 //______________________________________________________________________
+template< class RNG >
 void
-RMCRTCommon::ray_Origin( MTRand& mTwister,
+RMCRTCommon::ray_Origin( RNG& mTwister,
                          const Point  CC_pos,
                          const Vector dx,
                          const bool   useCCRays,
@@ -502,10 +505,197 @@ RMCRTCommon::reflect(double& fs,
   //dbg2 << " REFLECTING " << std::endl;
 }
 
+//______________________________________________________________________
+//    Start a ray at ray_origin in the cell origin
+//______________________________________________________________________
+void
+RMCRTCommon::initRay( rayState& ray,
+                      const Level* level,
+                      const IntVector& origin,
+                      const Vector& Dx,
+                      const Vector& ray_direction,
+                      const Vector& ray_origin )
+{
+  ray.cur      = origin;
+  ray.prevCell = origin;
+
+  raySignStep( ray.sign, ray.step, ray_direction );
+
+  rayCrossings( ray, level, Dx, ray_direction, ray_origin );
+
+  ray.dir                  = NONE;
+  ray.in_domain            = true;
+  ray.intensity            = 1.0;
+  ray.fs                   = 1.0;
+  ray.optical_thickness    = 0;
+  ray.expOpticalThick_prev = 1.0;
+  ray.rayLength            = 0.0;
+}
+
+//______________________________________________________________________
+//    Find the distances to the cell faces for a ray at ray_location in
+//    the cell ray.cur
+//______________________________________________________________________
+void
+RMCRTCommon::rayCrossings( rayState& ray,
+                           const Level* level,
+                           const Vector& Dx,
+                           const Vector& ray_direction,
+                           const Vector& ray_location )
+{
+  Vector inv_ray_direction = Vector(1.0)/ray_direction;
+
+  Point CC_pos = level->getCellPosition(ray.cur);
+
+  // rayDx is the distance from bottom, left, back, corner of cell to ray
+  double rayDx[3];
+  rayDx[0] = ray_location.x() - ( CC_pos.x() - 0.5*Dx[0] );
+  rayDx[1] = ray_location.y() - ( CC_pos.y() - 0.5*Dx[1] );
+  rayDx[2] = ray_location.z() - ( CC_pos.z() - 0.5*Dx[2] );
+
+  // tMax is the physical distance from the ray location to each of the respective planes of intersection
+  ray.tMax[0] = (ray.sign[0] * Dx[0] - rayDx[0]) * inv_ray_direction.x();
+  ray.tMax[1] = (ray.sign[1] * Dx[1] - rayDx[1]) * inv_ray_direction.y();
+  ray.tMax[2] = (ray.sign[2] * Dx[2] - rayDx[2]) * inv_ray_direction.z();
+
+  //Length of t to traverse one cell
+  Vector tDelta = Abs(inv_ray_direction) * Dx;
+  ray.tDelta[0] = tDelta[0];
+  ray.tDelta[1] = tDelta[1];
+  ray.tDelta[2] = tDelta[2];
+
+  ray.tMax_prev = 0;
+}
+
+//______________________________________________________________________
+//    Advance the ray into the next cell and add the emission of the
+//    cell it left to sumI.  Returns the length of the step.
+//______________________________________________________________________
+template <class T>
+double
+RMCRTCommon::rayStep( rayState& ray,
+                      const IntVector& origin,
+                      constCCVariable< T >& sigmaT4OverPi,
+                      constCCVariable< T >& abskg,
+                      constCCVariable<int>& celltype,
+                      unsigned long int& nRaySteps,
+                      double& sumI )
+{
+  ray.prevCell = ray.cur;
+  double disMin = -9;          // Represents ray segment length.
+
+  T abskg_prev = abskg[ray.prevCell];  // optimization
+  T sigmaT4OverPi_prev = sigmaT4OverPi[ray.prevCell];
+
+  //__________________________________
+  //  Determine which cell the ray will enter next
+  int dir = NONE;
+  if ( ray.tMax[0] < ray.tMax[1] ){        // X < Y
+    if ( ray.tMax[0] < ray.tMax[2] ){      // X < Z
+      dir = X;
+    } else {
+      dir = Z;
+    }
+  } else {
+    if( ray.tMax[1] < ray.tMax[2] ){       // Y < Z
+      dir = Y;
+    } else {
+      dir = Z;
+    }
+  }
+  ray.dir = dir;
+
+  //__________________________________
+  //  update marching variables
+  ray.cur[dir]   = ray.cur[dir] + ray.step[dir];
+  disMin         = (ray.tMax[dir] - ray.tMax_prev);
+  ray.tMax_prev  = ray.tMax[dir];
+  ray.tMax[dir]  = ray.tMax[dir] + ray.tDelta[dir];
+
+  // occassionally disMin ~ -1e-15ish
+  if( disMin > -FUZZ && disMin < FUZZ){
+    disMin += FUZZ;
+  }
+
+  ray.rayLength += disMin;
+
+  ray.in_domain = (celltype[ray.cur] == d_flowCell);
+
+  ray.optical_thickness += abskg_prev*disMin;
+
+  nRaySteps++;
+
+  //Eqn 3-15(see below reference) while
+  //Third term inside the parentheses is accounted for in Inet. Chi is accounted for in Inet calc.
+#ifdef FAST_EXP
+  double expOpticalThick = d_fastExp.fast_exp(-ray.optical_thickness);
+#else
+  double expOpticalThick = exp(-ray.optical_thickness);
+#endif
+
+  sumI += sigmaT4OverPi_prev * ( ray.expOpticalThick_prev - expOpticalThick ) * ray.fs;
+
+  ray.expOpticalThick_prev = expOpticalThick;
+
+  if( ray.rayLength < 0 || std::isnan(ray.rayLength) || std::isinf(ray.rayLength) ) {
+    std::ostringstream warn;
+    warn<< "ERROR:RMCRTCommon::rayStep   The ray length is non-physical (" << ray.rayLength << ")"
+        << " origin: " << origin << " cur: " << ray.cur << "\n";
+    throw InternalError( warn.str(), __FILE__, __LINE__ );
+  }
+  return disMin;
+}
+
+//______________________________________________________________________
+//    Add the emission of the wall the ray has reached to sumI, then
+//    reflect the ray or end it
+//______________________________________________________________________
+template <class T>
+void
+RMCRTCommon::rayWall( rayState& ray,
+                      const IntVector& origin,
+                      Vector& ray_direction,
+                      constCCVariable< T >& sigmaT4OverPi,
+                      constCCVariable< T >& abskg,
+                      double& sumI )
+{
+  T wallEmissivity = abskg[ray.cur];
+
+  if (wallEmissivity > 1.0){       // Ensure wall emissivity doesn't exceed one.
+    wallEmissivity = 1.0;
+  }
+
+  ray.intensity = exp(-ray.optical_thickness);
+
+  sumI += wallEmissivity * sigmaT4OverPi[ray.cur] * ray.intensity;
+
+  ray.intensity = ray.intensity * ray.fs;
+
+  // when a ray reaches the end of the domain, we force it to terminate.
+  if(!d_allowReflect) ray.intensity = 0;
+
+/*`==========TESTING==========*/
+#if DEBUG  >= 0
+if( isDbgCell( origin)  ){
+   printf( "            cur [%d,%d,%d] intensity: %g expOptThick: %g, fs: %g allowReflect: %i\n",
+          ray.cur.x(), ray.cur.y(), ray.cur.z(), ray.intensity,  exp(-ray.optical_thickness), ray.fs, d_allowReflect );
+
+}
+#endif
+/*===========TESTING==========`*/
+
+  //__________________________________
+  //  Reflections
+  if ( ray.intensity > d_threshold && d_allowReflect ){
+    const int dir = ray.dir;
+    reflect( ray.fs, ray.cur, ray.prevCell, abskg[ray.cur], ray.in_domain, ray.step[dir], ray.sign[dir], ray_direction[dir]);
+  }
+}
+
 //______________________________________________________________________
 //    Integrate the intensity
 //______________________________________________________________________
-template <class T >
+template <class T, class RNG >
 void
 RMCRTCommon::updateSumI (const Level* level,
                          Vector& ray_direction,
@@ -517,17 +707,9 @@ RMCRTCommon::updateSumI (const Level* level,
                          constCCVariable<int>& celltype,
                          unsigned long int& nRaySteps,
                          double& sumI,
-                         MTRand& mTwister)
+                         RNG& mTwister)
 
 {
-  IntVector cur = origin;
-  IntVector prevCell = cur;
-  // Cell stepping direction for ray marching
-  int    step[3];
-  double sign[3];                 //   is 0 for negative ray direction
-
-  Vector inv_ray_direction = Vector(1.0)/ray_direction;
-
 /*`==========TESTING==========*/
 #if DEBUG == 1
   if( isDbgCell(origin) ) {
@@ -536,35 +718,10 @@ RMCRTCommon::updateSumI (const Level* level,
 #endif
 /*===========TESTING==========`*/
 
-  raySignStep(sign, step, ray_direction);
-
-  Point CC_pos = level->getCellPosition(origin);
-
-  // rayDx is the distance from bottom, left, back, corner of cell to ray
-  double rayDx[3];
-  rayDx[0] = ray_origin.x() - ( CC_pos.x() - 0.5*Dx[0] );
-  rayDx[1] = ray_origin.y() - ( CC_pos.y() - 0.5*Dx[1] );
-  rayDx[2] = ray_origin.z() - ( CC_pos.z() - 0.5*Dx[2] );
-
-  // tMax is the physical distance from the ray origin to each of the respective planes of intersection
-  double tMax[3];
-  tMax[0] = (sign[0] * Dx[0] - rayDx[0]) * inv_ray_direction.x();
-  tMax[1] = (sign[1] * Dx[1] - rayDx[1]) * inv_ray_direction.y();
-  tMax[2] = (sign[2] * Dx[2] - rayDx[2]) * inv_ray_direction.z();
-
-  //Length of t to traverse one cell
-  Vector tDelta = Abs(inv_ray_direction) * Dx;
+  rayState ray;
+  initRay( ray, level, origin, Dx, ray_direction, ray_origin );
 
-  //Initializes the following values for each ray
-  bool in_domain     = true;
-  double tMax_prev   = 0;
-  double intensity   = 1.0;
-  double fs          = 1.0;
-  int nReflect       = 0;                 // Number of reflections
-  double optical_thickness      = 0;
-  double expOpticalThick_prev   = 1.0;
   double rayLength_scatter      = 0.0;    // ray length for each scattering event
-  double rayLength              = 0.0;    // total length of the ray
   Vector ray_location           = ray_origin;
 
 
@@ -578,231 +735,146 @@ RMCRTCommon::updateSumI (const Level* level,
 
   //______________________________________________________________________
 
-  while ( intensity > d_threshold && (rayLength < d_maxRayLength) ){
-
-    DIR dir = NONE;
-
-    while ( in_domain && (rayLength < d_maxRayLength) ){
+  while ( ray.intensity > d_threshold && (ray.rayLength < d_maxRayLength) ){
 
+    while ( ray.in_domain && (ray.rayLength < d_maxRayLength) ){
 
-      prevCell = cur;
-      double disMin = -9;          // Represents ray segment length.
-
-      T abskg_prev = abskg[prevCell];  // optimization
-      T sigmaT4OverPi_prev = sigmaT4OverPi[prevCell];
-
-      //__________________________________
-      //  Determine which cell the ray will enter next
-      dir = NONE;
-      if ( tMax[0] < tMax[1] ){        // X < Y
-        if ( tMax[0] < tMax[2] ){      // X < Z
-          dir = X;
-        } else {
-          dir = Z;
-        }
-      } else {
-        if( tMax[1] < tMax[2] ){       // Y < Z
-          dir = Y;
-        } else {
-          dir = Z;
-        }
-      }
-
-      //__________________________________
-      //  update marching variables
-      cur[dir]   = cur[dir] + step[dir];
-      disMin     = (tMax[dir] - tMax_prev);
-      tMax_prev  = tMax[dir];
-      tMax[dir]  = tMax[dir] + tDelta[dir];
-
-      // occassionally disMin ~ -1e-15ish
-      if( disMin > -FUZZ && disMin < FUZZ){
-        disMin += FUZZ;
-      }
+      double disMin = rayStep< T >( ray, origin, sigmaT4OverPi, abskg, celltype, nRaySteps, sumI );
 
-      rayLength += disMin;
       rayLength_scatter += disMin;
 
       ray_location[0] = ray_location[0] + (disMin  * ray_direction[0]);
       ray_location[1] = ray_location[1] + (disMin  * ray_direction[1]);
       ray_location[2] = ray_location[2] + (disMin  * ray_direction[2]);
 
-      in_domain = (celltype[cur] == d_flowCell);
-
-      optical_thickness += abskg_prev*disMin;
-
-      nRaySteps++;
-
  /*`==========TESTING==========*/
 #if ( DEBUG >= 1 )
       if( isDbgCell( origin )){
+         const IntVector& cur      = ray.cur;
+         const IntVector& prevCell = ray.prevCell;
+         const int dir = ray.dir;
          printf( "            cur [%d,%d,%d] prev [%d,%d,%d]", cur.x(), cur.y(), cur.z(), prevCell.x(), prevCell.y(), prevCell.z());
          printf( " dir %d ", dir );
-         printf( "tMax [%g,%g,%g] ",tMax[0],tMax[1], tMax[2]);
+         printf( "tMax [%g,%g,%g] ",ray.tMax[0],ray.tMax[1], ray.tMax[2]);
          printf( "rayLoc [%g,%g,%g] ",ray_location.x(),ray_location.y(), ray_location.z());
-         printf( "distanceTraveled %g tMax[dir]: %g tMax_prev: %g, Dx[dir]: %g\n",disMin, tMax[dir], tMax_prev, Dx[dir]);
-         printf( "            tDelta [%g,%g,%g] \n",tDelta.x(),tDelta.y(), tDelta.z());
+         printf( "distanceTraveled %g tMax[dir]: %g tMax_prev: %g, Dx[dir]: %g\n",disMin, ray.tMax[dir], ray.tMax_prev, Dx[dir]);
+         printf( "            tDelta [%g,%g,%g] \n",ray.tDelta[0],ray.tDelta[1], ray.tDelta[2]);
 
          printf( "            abskg[prev] %g  \t sigmaT4OverPi[prev]: %g \n",abskg[prevCell],  sigmaT4OverPi[prevCell]);
          printf( "            abskg[cur]  %g  \t sigmaT4OverPi[cur]:  %g  \t  cellType: %i\n",abskg[cur], sigmaT4OverPi[cur], celltype[cur]);
-         printf( "            optical_thickkness %g \t rayLength: %g\n", optical_thickness, rayLength);
+         printf( "            optical_thickkness %g \t rayLength: %g\n", ray.optical_thickness, ray.rayLength);
       }
 #endif
 /*===========TESTING==========`*/
 
-      //Eqn 3-15(see below reference) while
-      //Third term inside the parentheses is accounted for in Inet. Chi is accounted for in Inet calc.
-
-
-/*`==========TESTING==========*/
-#ifdef FAST_EXP
-
-      // We need to know the range of optical_thickness before we can select
-      // which implementation to use.
-
-      double expOpticalThick = d_fastExp.fast_exp(-optical_thickness);
-      //double expOpticalThick = exp(-optical_thickness);
-
-      double S_exp    = d_fastExp.Schraudolph_exp(-optical_thickness);
-      double fast_exp = d_fastExp.fast_exp(-optical_thickness);
-      double exp2     = d_fastExp.exp2(-optical_thickness);
-      double exp3     = d_fastExp.exp3(-optical_thickness);
-      double exp5     = d_fastExp.exp5(-optical_thickness);
-      double exp7     = d_fastExp.exp7(-optical_thickness);
-      double exact    = exp(-optical_thickness);
-
-      cout << " X: " << -optical_thickness << endl;
-      cout << " Sch_exp error:    " << ((S_exp    - exact)/exact ) * 100 << " S_exp:   " << S_exp    << " exact: " << exact << endl;
-      cout << " fast_exp error:   " << ((fast_exp - exact)/exact ) * 100 << " fast_exp:" << fast_exp << endl;
-      cout << " exp2 error:       " << ((exp2     - exact)/exact ) * 100 << " exp2:    " << exp2    << endl;
-      cout << " exp3 error:       " << ((exp3     - exact)/exact ) * 100 << " exp3:    " << exp3    << endl;
-      cout << " exp5 error:       " << ((exp5     - exact)/exact ) * 100 << " exp5:    " << exp5    << endl;
-      cout << " exp7 error:       " << ((exp7     - exact)/exact ) * 100 << " exp7:    " << exp7    << endl;
-
-#else
-      double expOpticalThick = exp(-optical_thickness);
-#endif
-/*===========TESTING==========`*/
-
-      sumI += sigmaT4OverPi_prev * ( expOpticalThick_prev - expOpticalThick ) * fs;
-
-      expOpticalThick_prev = expOpticalThick;
-
 #ifdef RAY_SCATTER
-      if (rayLength_scatter > scatLength && in_domain ){
+      if (rayLength_scatter > scatLength && ray.in_domain ){
 
         // get new scatLength for each scattering event
         scatLength = -log(mTwister.randDblExc() ) / scatCoeff;
 
-        ray_direction     =  findRayDirection( mTwister, cur );
-
-        inv_ray_direction = Vector(1.0)/ray_direction;
+        ray_direction     =  findRayDirection( mTwister, ray.cur );
 
         // get new step and sign
-        int stepOld = step[dir];
-        raySignStep( sign, step, ray_direction);
+        const int dir = ray.dir;
+        int stepOld = ray.step[dir];
+        raySignStep( ray.sign, ray.step, ray_direction);
 
         // if sign[dir] changes sign, put ray back into prevCell (back scattering)
         // a sign change only occurs when the product of old and new is negative
-        if( step[dir] * stepOld < 0 ){
-          cur = prevCell;
+        if( ray.step[dir] * stepOld < 0 ){
+          ray.cur = ray.prevCell;
         }
 
-        Point CC_pos = level->getCellPosition(cur);
-        rayDx[0] = ray_location.x() - ( CC_pos.x() - 0.5*Dx[0] );
-        rayDx[1] = ray_location.y() - ( CC_pos.y() - 0.5*Dx[1] );
-        rayDx[2] = ray_location.z() - ( CC_pos.z() - 0.5*Dx[2] );
-
-        tMax[0] = (sign[0] * Dx[0] - rayDx[0]) * inv_ray_direction.x();
-        tMax[1] = (sign[1] * Dx[1] - rayDx[1]) * inv_ray_direction.y();
-        tMax[2] = (sign[2] * Dx[2] - rayDx[2]) * inv_ray_direction.z();
-
-        //Length of t to traverse one cell
-        tDelta = Abs(inv_ray_direction) * Dx;
+        rayCrossings( ray, level, Dx, ray_direction, ray_location );
 /*`==========TESTING==========*/
 #if (DEBUG == 3)
         if( isDbgCell( origin)  ){
-          Vector mytDelta = tDelta / Dx;
+          Vector mytDelta = Vector( ray.tDelta[0], ray.tDelta[1], ray.tDelta[2] ) / Dx;
           Vector myrayLoc = ray_location / Dx;
-          printf( "            Scatter: [%i, %i, %i], rayLength: %g, tmax: %g, %g, %g  tDelta: %g, %g, %g  ray_dir: %g, %g, %g\n",cur.x(), cur.y(), cur.z(),rayLength, tMax[0] / Dx[0], tMax[1] / Dx[1], tMax[2] / Dx[2], mytDelta.x(), mytDelta.y() , mytDelta.z(), ray_direction.x(), ray_direction.y() , ray_direction.z());
-          printf( "                    dir: %i sign: [%g, %g, %g], step [%i, %i, %i] cur: [%i, %i, %i], prevCell: [%i, %i, %i]\n", dir, sign[0], sign[1], sign[2], step[0], step[1], step[2], cur[0], cur[1], cur[2], prevCell[0], prevCell[1], prevCell[2] );
+          printf( "            Scatter: [%i, %i, %i], rayLength: %g, tmax: %g, %g, %g  tDelta: %g, %g, %g  ray_dir: %g, %g, %g\n",ray.cur.x(), ray.cur.y(), ray.cur.z(),ray.rayLength, ray.tMax[0] / Dx[0], ray.tMax[1] / Dx[1], ray.tMax[2] / Dx[2], mytDelta.x(), mytDelta.y() , mytDelta.z(), ray_direction.x(), ray_direction.y() , ray_direction.z());
+          printf( "                    dir: %i sign: [%g, %g, %g], step [%i, %i, %i] cur: [%i, %i, %i], prevCell: [%i, %i, %i]\n", dir, ray.sign[0], ray.sign[1], ray.sign[2], ray.step[0], ray.step[1], ray.step[2], ray.cur[0], ray.cur[1], ray.cur[2], ray.prevCell[0], ray.prevCell[1], ray.prevCell[2] );
           printf( "                    ray_location: [%g, %g, %g]\n", myrayLoc[0], myrayLoc[1], myrayLoc[2] );
-//          printf("                     rayDx         [%g, %g, %g]  CC_pos[%g, %g, %g]\n", rayDx[0], rayDx[1], rayDx[2], CC_pos.x(), CC_pos.y(), CC_pos.z());
         }
 #endif
 /*===========TESTING==========`*/
-        tMax_prev = 0;
         rayLength_scatter = 0;  // allow for multiple scattering events per ray
       }
 #endif
-
-      if( rayLength < 0 || std::isnan(rayLength) || std::isinf(rayLength) ) {
-        std::ostringstream warn;
-        warn<< "ERROR:RMCRTCommon::updateSumI   The ray length is non-physical (" << rayLength << ")"
-            << " origin: " << origin << " cur: " << cur << "\n";
-        throw InternalError( warn.str(), __FILE__, __LINE__ );
-      }
     }  //end domain while loop.  ++++++++++++++
     //______________________________________________________________________
 
+    rayWall< T >( ray, origin, ray_direction, sigmaT4OverPi, abskg, sumI );
 
-    T wallEmissivity = abskg[cur];
+  }  // threshold while loop.
 
-    if (wallEmissivity > 1.0){       // Ensure wall emissivity doesn't exceed one.
-      wallEmissivity = 1.0;
+} // end of updateSumI function
+
+//______________________________________________________________________
+//    Integrate the intensity of a packet of rays that leave the same cell.
+//    The rays are advanced one cell at a time, in lockstep, so the
+//    loads from the CC fields of the different rays are independent of
+//    each other.  Each ray takes the same rayStep()/rayWall() steps as in
+//    updateSumI() so sumI[r] does not depend on the packet size.
+//______________________________________________________________________
+template <class T >
+void
+RMCRTCommon::updateSumI_packet (const Level* level,
+                                const int nRays,
+                                const Vector ray_direction[],
+                                const Vector ray_origin[],
+                                const IntVector& origin,
+                                const Vector& Dx,
+                                constCCVariable< T >& sigmaT4OverPi,
+                                constCCVariable< T >& abskg,
+                                constCCVariable<int>& celltype,
+                                unsigned long int& nRaySteps,
+                                double sumI[] )
+{
+  rayState ray[MAX_RAY_PACKET];
+  Vector   direction[MAX_RAY_PACKET];   // flipped by reflections
+  bool     active[MAX_RAY_PACKET];
+
+  int nActive = 0;
+
+  for( int r = 0; r < nRays; r++ ){
+    direction[r] = ray_direction[r];
+    initRay( ray[r], level, origin, Dx, direction[r], ray_origin[r] );
+    sumI[r] = 0.0;
+
+    active[r] = ( ray[r].intensity > d_threshold && ray[r].rayLength < d_maxRayLength );
+    if( active[r] ){
+      nActive++;
     }
+  }
 
-    intensity = exp(-optical_thickness);
-
-    sumI += wallEmissivity * sigmaT4OverPi[cur] * intensity;
-
-    intensity = intensity * fs;
-//    //__________________________________
-//    //  BULLETPROOFING
-//    if ( std::isinf(sumI) || std::isnan(sumI) ){
-//      printf( "\n\n______________________________________________________________________\n");
-//      std::cout <<  " cur: " << cur << " prevCell: " << prevCell << "\n";
-//      std::cout <<  " dir: " << dir << " sumI: " << sumI << "\n";
-//      std::cout <<  " tMax: " << tMax  << "\n";
-//      std::cout <<  " rayLoc:    " << ray_location << "\n";
-//      std::cout <<  " tMax[dir]: " << tMax[dir] << " tMax_prev: " << tMax_prev << " Dx[dir]: " << Dx[dir] << "\n";
-//      std::cout <<  " tDelta:    " << tDelta << " \n";
-//      std::cout <<  "     abskg[prev]: " << abskg[prevCell] << " \t sigmaT4OverPi[prev]: " << sigmaT4OverPi[prevCell]  << "\n";
-//      std::cout <<  "     abskg[cur]:  " << abskg[cur]      << " \t sigmaT4OverPi[cur]:  " << sigmaT4OverPi[cur] << "\t  cellType: " <<celltype[cur] << "\n";
-//      std::cout <<  "     optical_thickkness: " <<  optical_thickness << " \t rayLength: " << rayLength << "\n";
-//
-//      IntVector l = abskg.getLowIndex();
-//      IntVector h = abskg.getHighIndex();
-//      printf( "     abskg:  [%d,%d,%d]  -> [%d,%d,%d] \n", l.x(), l.y(), l.z() , h.x(), h.y(), h.z() );
-//
-//      std::ostringstream warn;
-//        warn<< "ERROR:RMCRTCommon::updateSumI   sumI is non-physical (" << sumI << ")"
-//            << " origin: " << origin << " cur: " << cur << "\n";
-//        throw InternalError( warn.str(), __FILE__, __LINE__ );
-//    }
+  //______________________________________________________________________
+  //  Each pass advances every active ray by one cell, or handles
+  //  the wall it has reached.
+  while ( nActive > 0 ){
 
-    // when a ray reaches the end of the domain, we force it to terminate.
-    if(!d_allowReflect) intensity = 0;
+    for( int r = 0; r < nRays; r++ ){
 
-/*`==========TESTING==========*/
-#if DEBUG  >= 0
-if( isDbgCell( origin)  ){
-   printf( "            cur [%d,%d,%d] intensity: %g expOptThick: %g, fs: %g allowReflect: %i\n",
-          cur.x(), cur.y(), cur.z(), intensity,  exp(-optical_thickness), fs, d_allowReflect );
+      if( !active[r] ){
+        continue;
+      }
 
-}
-#endif
-/*===========TESTING==========`*/
+      if ( ray[r].in_domain && (ray[r].rayLength < d_maxRayLength) ){
+        rayStep< T >( ray[r], origin, sigmaT4OverPi, abskg, celltype, nRaySteps, sumI[r] );
+        continue;
+      }
 
-    //__________________________________
-    //  Reflections
-    if ( intensity > d_threshold && d_allowReflect ){
-      reflect( fs, cur, prevCell, abskg[cur], in_domain, step[dir], sign[dir], ray_direction[dir]);
-      ++nReflect;
-    }
-  }  // threshold while loop.
+      //__________________________________
+      //  The ray has reached a wall or its maximum length
+      rayWall< T >( ray[r], origin, direction[r], sigmaT4OverPi, abskg, sumI[r] );
 
-} // end of updateSumI function
+      active[r] = ( ray[r].intensity > d_threshold && ray[r].rayLength < d_maxRayLength );
+      if( !active[r] ){
+        nActive--;
+      }
+    }
+  }
+}
 
 //______________________________________________________________________
 //    Move all computed variables from old_dw -> new_dw
@@ -963,9 +1035,10 @@ RMCRTCommon::isDbgCell( const IntVector me)
 //  Latin-Hyper-Cube sampling scheme.  The algorithm used is the
 //  modern fisher-yates shuffle.
 //______________________________________________________________________
+template< class RNG >
 void
 RMCRTCommon::randVector( std::vector <int> &int_array,
-                         MTRand& mTwister,
+                         RNG& mTwister,
                          const IntVector& cell )
 {
   int max= int_array.size();
@@ -1077,3 +1150,33 @@ template void
 template void
   RMCRTCommon::updateSumI ( const Level*, Vector&, Vector&, const IntVector&, const Vector&, constCCVariable< float >&, constCCVariable<float>&, constCCVariable<int>&, unsigned long int&, double&, MTRand&);
 
+template void
+  RMCRTCommon::updateSumI ( const Level*, Vector&, Vector&, const IntVector&, const Vector&, constCCVariable< double >&, constCCVariable<double>&, constCCVariable<int>&, unsigned long int&, double&, PhiloxRand&);
+
+template void
+  RMCRTCommon::updateSumI ( const Level*, Vector&, Vector&, const IntVector&, const Vector&, constCCVariable< float >&, constCCVariable<float>&, constCCVariable<int>&, unsigned long int&, double&, PhiloxRand&);
+
+template void
+  RMCRTCommon::updateSumI_packet ( const Level*, const int, const Vector[], const Vector[], const IntVector&, const Vector&, constCCVariable< double >&, constCCVariable<double>&, constCCVariable<int>&, unsigned long int&, double[]);
+
+template void
+  RMCRTCommon::updateSumI_packet ( const Level*, const int, const Vector[], const Vector[], const IntVector&, const Vector&, constCCVariable< float >&, constCCVariable<float>&, constCCVariable<int>&, unsigned long int&, double[]);
+
+template Vector
+  RMCRTCommon::findRayDirection( MTRand&, const IntVector&, const int );
+
+template Vector
+  RMCRTCommon::findRayDirection( PhiloxRand&, const IntVector&, const int );
+
+template void
+  RMCRTCommon::ray_Origin( MTRand&, const Point, const Vector, const bool, Vector& );
+
+template void
+  RMCRTCommon::ray_Origin( PhiloxRand&, const Point, const Vector, const bool, Vector& );
+
+template void
+  RMCRTCommon::randVector( std::vector<int>&, MTRand&, const IntVector& );
+
+template void
+  RMCRTCommon::randVector( std::vector<int>&, PhiloxRand&, const IntVector& );
+
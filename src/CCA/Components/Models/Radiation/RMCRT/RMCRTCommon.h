@@ -55,6 +55,8 @@ class MTRand;
 
 namespace Uintah{
 
+  class PhiloxRand;
+
   class RMCRTCommon  {
 
     public:
@@ -74,7 +76,7 @@ namespace Uintah{
 
       //__________________________________
       // @brief Update the running total of the incident intensity */
-      template <class T>
+      template <class T, class RNG>
       void  updateSumI ( const Level* level,
                          Vector& ray_direction, // can change if scattering occurs
                          Vector& ray_origin,
@@ -85,7 +87,74 @@ namespace Uintah{
                          constCCVariable<int>& celltype,
                          unsigned long int& size,
                          double& sumI,
-                         MTRand& mTwister);
+                         RNG& mTwister);
+
+      //__________________________________
+      /** @brief Trace a packet of rays leaving the same cell in lockstep.
+                 sumI[r] is the incident intensity of ray r alone.  Scattering is not supported. */
+      template <class T>
+      void  updateSumI_packet ( const Level* level,
+                                const int nRays,
+                                const Vector ray_direction[],
+                                const Vector ray_origin[],
+                                const IntVector& origin,
+                                const Vector& Dx,
+                                constCCVariable< T >& sigmaT4Pi,
+                                constCCVariable< T >& abskg,
+                                constCCVariable<int>& celltype,
+                                unsigned long int& size,
+                                double sumI[] );
+
+      //__________________________________
+      /** @brief The marching state of one ray, shared by updateSumI and updateSumI_packet */
+      struct rayState {
+        IntVector cur;                    // cell the ray is in
+        IntVector prevCell;
+        int       step[3];                // cell stepping direction
+        double    sign[3];                // is 0 for negative ray direction
+        double    tMax[3];                // distance to the next plane of intersection in each direction
+        double    tDelta[3];              // distance to traverse one cell in each direction
+        int       dir;                    // direction of the last step
+        bool      in_domain;
+        double    tMax_prev;
+        double    intensity;
+        double    fs;
+        double    optical_thickness;
+        double    expOpticalThick_prev;
+        double    rayLength;              // total length of the ray
+      };
+
+      void initRay( rayState& ray,
+                    const Level* level,
+                    const IntVector& origin,
+                    const Vector& Dx,
+                    const Vector& ray_direction,
+                    const Vector& ray_origin );
+
+      void rayCrossings( rayState& ray,
+                         const Level* level,
+                         const Vector& Dx,
+                         const Vector& ray_direction,
+                         const Vector& ray_location );
+
+      /** @brief Advance a ray one cell, returns the length of the step */
+      template <class T>
+      double rayStep( rayState& ray,
+                      const IntVector& origin,
+                      constCCVariable< T >& sigmaT4Pi,
+                      constCCVariable< T >& abskg,
+                      constCCVariable<int>& celltype,
+                      unsigned long int& size,
+                      double& sumI );
+
+      /** @brief Add the wall emission and reflect or end a ray that left the flow cells */
+      template <class T>
+      void rayWall( rayState& ray,
+                    const IntVector& origin,
+                    Vector& ray_direction,
+                    constCCVariable< T >& sigmaT4Pi,
+                    constCCVariable< T >& abskg,
+                    double& sumI );
 
       //__________________________________
       /** @brief Schedule compute of blackbody intensity */
@@ -141,7 +210,8 @@ namespace Uintah{
 
       //__________________________________
       //
-      void ray_Origin( MTRand& mTwister,
+      template <class RNG>
+      void ray_Origin( RNG& mTwister,
                        const Point  CC_position,
                        const Vector Dx,
                        const bool useCCRays,
@@ -149,14 +219,16 @@ namespace Uintah{
 
       //__________________________________
       //
-      Vector findRayDirection( MTRand& mTwister,
+      template <class RNG>
+      Vector findRayDirection( RNG& mTwister,
                                const IntVector& = IntVector(-9,-9,-9),
                                const int iRay = -9);
 
       //__________________________________
       /** @brief populates a vector of integers with a stochastic array without replacement from 0 to n-1 */
+      template <class RNG>
       void randVector( std::vector <int> &int_array,
-                       MTRand& mTwister,
+                       RNG& mTwister,
                        const IntVector& cell);
 
 
@@ -246,6 +318,8 @@ namespace Uintah{
       //           -x      +x       -y       +y     -z     +z
       enum FACE {EAST=0, WEST=1, NORTH=2, SOUTH=3, TOP=4, BOT=5, nFACES=6};
 
+      enum RAY_PACKET { MAX_RAY_PACKET = 16 };     // largest number of rays traced in lockstep by updateSumI_packet
+
       enum GRAPH_TYPE {
           TG_CARRY_FORWARD = 0              // carry forward task graph
         , TG_RMCRT         = 1              // rmcrt taskgraph
@@ -36,6 +36,7 @@
 #include <Core/Grid/DbgOutput.h>
 #include <Core/Grid/Variables/PerPatchVars.h>
 #include <Core/Math/MersenneTwister.h>
+#include <Core/Math/PhiloxRand.h>
 #include <Core/Util/DOUT.hpp>
 #include <Core/Util/Timers/Timers.hpp>
 
@@ -158,6 +159,7 @@ Ray::problemSetup( const ProblemSpecP& prob_spec,
 {
   ProblemSpecP rmcrt_ps = rmcrtps;
   string rayDirSampleAlgo;
+  string rayRNG;
 
   rmcrt_ps->getWithDefault( "nDivQRays" ,       d_nDivQRays ,        10 );             // Number of rays per cell used to compute divQ
   rmcrt_ps->getWithDefault( "Threshold" ,       d_threshold ,      0.01 );             // When to terminate a ray
@@ -171,6 +173,8 @@ Ray::problemSetup( const ProblemSpecP& prob_spec,
   rmcrt_ps->getWithDefault( "solveDivQ"      ,  d_solveDivQ,        true );            // Allow for solving of divQ for flow cells.
   rmcrt_ps->getWithDefault( "applyFilter"    ,  d_applyFilter,      false );           // Allow filtering of boundFlux and divQ.
   rmcrt_ps->getWithDefault( "rayDirSampleAlgo", rayDirSampleAlgo,   "naive" );         // Change Monte-Carlo Sampling technique for RayDirection.
+  rmcrt_ps->getWithDefault( "randomNumberGenerator", rayRNG,    "MersenneTwister" );   // random number generator used by the single level ray tracer
+  rmcrt_ps->getWithDefault( "rayPacketSize"  ,  d_rayPacketSize,    8 );               // number of divQ rays traced together (Philox only)
 
   if (rayDirSampleAlgo == "LatinHyperCube" ){
     d_rayDirSampleAlgo = LATIN_HYPER_CUBE;
@@ -179,6 +183,21 @@ Ray::problemSetup( const ProblemSpecP& prob_spec,
     proc0cout << "  - Using traditional Monte-Carlo method for selecting ray directions.\n";
   }
 
+  if ( rayRNG == "Philox" ){
+    d_rayRNG = PHILOX;
+    proc0cout << "  - Using the counter based (Philox) random number generator, rays are traced in packets of " << d_rayPacketSize << ".\n";
+  } else if ( rayRNG != "MersenneTwister" ){
+    std::ostringstream warn;
+    warn << "ERROR:  RMCRT: randomNumberGenerator (" << rayRNG << ") is not valid.  Please choose MersenneTwister or Philox.";
+    throw ProblemSetupException(warn.str(), __FILE__, __LINE__);
+  }
+
+  if ( d_rayPacketSize < 1 || d_rayPacketSize > MAX_RAY_PACKET ){
+    std::ostringstream warn;
+    warn << "ERROR:  RMCRT: rayPacketSize (" << d_rayPacketSize << ") must be between 1 and " << MAX_RAY_PACKET << ".";
+    throw ProblemSetupException(warn.str(), __FILE__, __LINE__);
+  }
+
   //__________________________________
   //  Radiometer setup
   ProblemSpecP rad_ps = rmcrt_ps->findBlock("Radiometer");
@@ -521,6 +540,22 @@ Ray::sched_rayTrace( const LevelP& level,
 
 
 
+//______________________________________________________________________
+//  Position the random number generator at the stream of a ray.  MTRand
+//  has a single stream, its position is the number of numbers drawn so far.
+//______________________________________________________________________
+namespace {
+  inline void setRayStream( MTRand&, const IntVector&, const int, const int ) {}
+
+  inline void setRayStream( PhiloxRand& philox,
+                            const IntVector& cell,
+                            const int iRay,
+                            const int stream )
+  {
+    philox.setStream( cell, iRay, stream );
+  }
+}
+
 //---------------------------------------------------------------------------
 // Method: The actual work of the ray tracer
 //---------------------------------------------------------------------------
@@ -552,6 +587,19 @@ Ray::rayTrace( const ProcessorGroup* pg,
   //
   MTRand mTwister;
 
+  // The counter based generator is keyed by the timestep so each timestep
+  // gets new rays.  At initialization the old DW does not exist.
+  timeStep_vartype timeStep(0);
+
+  if( old_dw && old_dw->exists( m_timeStepLabel ) ){
+    old_dw->get( timeStep, m_timeStepLabel );
+  }
+  else if( new_dw && new_dw->exists( m_timeStepLabel ) ){
+    new_dw->get( timeStep, m_timeStepLabel );
+  }
+
+  PhiloxRand philox( timeStep );                // only used with randomNumberGenerator = Philox
+
   DataWarehouse* abskg_dw    = new_dw->getOtherDataWarehouse(which_abskg_dw);
   DataWarehouse* sigmaT4_dw  = new_dw->getOtherDataWarehouse(which_sigmaT4_dw);
   DataWarehouse* celltype_dw = new_dw->getOtherDataWarehouse(which_celltype_dw);
@@ -658,97 +706,22 @@ Ray::rayTrace( const ProcessorGroup* pg,
     //          B O U N D A R Y F L U X
     //______________________________________________________________________
     if( d_solveBoundaryFlux ) {
-
-      //__________________________________
-      //
-      vector <int> rand_i( d_rayDirSampleAlgo == LATIN_HYPER_CUBE ? d_nFluxRays : 0);  // only needed for LHC scheme
-
-      for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++){
-        IntVector origin = *iter;
-
-        if (celltype[origin] != d_flowCell) {
-          continue;
-        }
- 
-        // A given flow cell may have 0,1,2,3,4,5, or 6 faces that are adjacent to a wall.
-        // boundaryFaces is the vector that contains the list of which faces are adjacent to a wall
-        vector<int> boundaryFaces;
-        boundaryFaces.clear();
-
-        // determine if origin has one or more boundary faces, and if so, populate boundaryFaces vector
-        boundFlux[origin].p = has_a_boundary(origin, celltype, boundaryFaces);
-
-        Point CC_pos = level->getCellPosition(origin);
-        //__________________________________
-        // Loop over boundary faces of the cell and compute incident radiative flux
-        for (vector<int>::iterator it=boundaryFaces.begin() ; it < boundaryFaces.end(); it++ ){
-
-          int RayFace = *it;
-          int UintahFace[6] = {WEST,EAST,SOUTH,NORTH,BOT,TOP};
-
-          double sumI         = 0;
-          double sumProjI     = 0;
-          double sumI_prev    = 0;
-          double sumCosTheta  = 0;    // used to force sumCosTheta/nRays == 0.5 or  sum (d_Omega * cosTheta) == pi
-
-          if (d_rayDirSampleAlgo == LATIN_HYPER_CUBE){
-            randVector(rand_i, mTwister, origin);
-          }
-
-
-          //__________________________________
-          // Flux ray loop
-          for (int iRay=0; iRay < d_nFluxRays; iRay++){
-
-            Vector direction_vector;
-            Vector rayOrigin;
-            double cosTheta;
-
-            if ( d_rayDirSampleAlgo == LATIN_HYPER_CUBE ){        // Latin-Hyper-Cube sampling
-              rayDirectionHyperCube_cellFace( mTwister, origin, d_dirIndexOrder[RayFace], d_dirSignSwap[RayFace], iRay,
-                                              direction_vector, cosTheta, rand_i[iRay],iRay);
-            } else{                                               // Naive Monte-Carlo sampling
-              rayDirection_cellFace( mTwister, origin, d_dirIndexOrder[RayFace], d_dirSignSwap[RayFace], iRay,
-                                     direction_vector, cosTheta );
-            }
-
-            rayLocation_cellFace( mTwister, RayFace, Dx, CC_pos, rayOrigin);
-
-            updateSumI<T>( level, direction_vector, rayOrigin, origin, Dx, sigmaT4OverPi, abskg, celltype, size, sumI, mTwister);
-
-            sumProjI    += cosTheta * (sumI - sumI_prev);              // must subtract sumI_prev, since sumI accumulates intensity
-
-            sumCosTheta += cosTheta;
-
-            sumI_prev    = sumI;
-
-          } // end of flux ray loop
-
-          sumProjI = sumProjI * (double) d_nFluxRays/sumCosTheta/2.0; // This operation corrects for error in the first moment over a half range of the solid angle (Modest Radiative Heat Transfer page 545 1rst edition)
-
-          //__________________________________
-          //  Compute Net Flux to the boundary
-          int face = UintahFace[RayFace];
-          boundFlux[origin][ face ] = sumProjI * 2 *M_PI/ (double) d_nFluxRays;
-
-/*`==========TESTING==========*/
-#if (DEBUG == 2)
-          if( isDbgCell(origin) ) {
-            printf( "\n      [%d, %d, %d]  face: %d sumProjI:  %g BoundaryFlux: %g\n",
-                  origin.x(), origin.y(), origin.z(), face, sumProjI, boundFlux[origin][ face ]);
-          }
-#endif
-/*===========TESTING==========`*/
-
-        } // boundary faces loop
-      }  // end cell iterator
+      if( d_rayRNG == PHILOX ){
+        solveBoundaryFlux< T >( level, patch, philox, sigmaT4OverPi, abskg, celltype, boundFlux, size );
+      } else {
+        solveBoundaryFlux< T >( level, patch, mTwister, sigmaT4OverPi, abskg, celltype, boundFlux, size );
+      }
     }   // end if d_solveBoundaryFlux
 
 
     //______________________________________________________________________
     //         S O L V E   D I V Q
     //______________________________________________________________________
-    if( d_solveDivQ){
+    if( d_solveDivQ && d_rayRNG == PHILOX ){
+
+      solveDivQ_rayPackets< T >( level, patch, philox, sigmaT4OverPi, abskg, celltype, divQ, radiationVolq, size );
+
+    } else if( d_solveDivQ){
 
     //__________________________________
     //
@@ -833,6 +806,204 @@ Ray::rayTrace( const ProcessorGroup* pg,
 }  // end ray trace method
 
 
+//______________________________________________________________________
+//  Incident radiative flux on the wall faces of the flow cells.  With the
+//  counter based generator every face and ray of a cell has its own stream.
+//______________________________________________________________________
+template< class T, class RNG >
+void
+Ray::solveBoundaryFlux( const Level* level,
+                        const Patch* patch,
+                        RNG& mTwister,
+                        constCCVariable< T >& sigmaT4OverPi,
+                        constCCVariable< T >& abskg,
+                        constCCVariable< int >& celltype,
+                        CCVariable< Stencil7 >& boundFlux,
+                        unsigned long int& size )
+{
+  Vector Dx = patch->dCell();                   // cell spacing
+  const int L_stream = level->getIndex() << 4;
+
+  //__________________________________
+  //
+  vector <int> rand_i( d_rayDirSampleAlgo == LATIN_HYPER_CUBE ? d_nFluxRays : 0);  // only needed for LHC scheme
+
+  for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++){
+    IntVector origin = *iter;
+
+    if (celltype[origin] != d_flowCell) {
+      continue;
+    }
+ 
+    // A given flow cell may have 0,1,2,3,4,5, or 6 faces that are adjacent to a wall.
+    // boundaryFaces is the vector that contains the list of which faces are adjacent to a wall
+    vector<int> boundaryFaces;
+    boundaryFaces.clear();
+
+    // determine if origin has one or more boundary faces, and if so, populate boundaryFaces vector
+    boundFlux[origin].p = has_a_boundary(origin, celltype, boundaryFaces);
+
+    Point CC_pos = level->getCellPosition(origin);
+    //__________________________________
+    // Loop over boundary faces of the cell and compute incident radiative flux
+    for (vector<int>::iterator it=boundaryFaces.begin() ; it < boundaryFaces.end(); it++ ){
+
+      int RayFace = *it;
+      int UintahFace[6] = {WEST,EAST,SOUTH,NORTH,BOT,TOP};
+
+      double sumI         = 0;
+      double sumProjI     = 0;
+      double sumI_prev    = 0;
+      double sumCosTheta  = 0;    // used to force sumCosTheta/nRays == 0.5 or  sum (d_Omega * cosTheta) == pi
+
+      if (d_rayDirSampleAlgo == LATIN_HYPER_CUBE){
+        setRayStream( mTwister, origin, 0, L_stream + FLUX_LHC + RayFace );
+        randVector(rand_i, mTwister, origin);
+      }
+
+
+      //__________________________________
+      // Flux ray loop
+      for (int iRay=0; iRay < d_nFluxRays; iRay++){
+
+        Vector direction_vector;
+        Vector rayOrigin;
+        double cosTheta;
+
+        setRayStream( mTwister, origin, iRay, L_stream + FLUX_RAYS + RayFace );
+
+        if ( d_rayDirSampleAlgo == LATIN_HYPER_CUBE ){        // Latin-Hyper-Cube sampling
+          rayDirectionHyperCube_cellFace( mTwister, origin, d_dirIndexOrder[RayFace], d_dirSignSwap[RayFace], iRay,
+                                          direction_vector, cosTheta, rand_i[iRay],iRay);
+        } else{                                               // Naive Monte-Carlo sampling
+          rayDirection_cellFace( mTwister, origin, d_dirIndexOrder[RayFace], d_dirSignSwap[RayFace], iRay,
+                                 direction_vector, cosTheta );
+        }
+
+        rayLocation_cellFace( mTwister, RayFace, Dx, CC_pos, rayOrigin);
+
+        updateSumI<T>( level, direction_vector, rayOrigin, origin, Dx, sigmaT4OverPi, abskg, celltype, size, sumI, mTwister);
+
+        sumProjI    += cosTheta * (sumI - sumI_prev);              // must subtract sumI_prev, since sumI accumulates intensity
+
+        sumCosTheta += cosTheta;
+
+        sumI_prev    = sumI;
+
+      } // end of flux ray loop
+
+      sumProjI = sumProjI * (double) d_nFluxRays/sumCosTheta/2.0; // This operation corrects for error in the first moment over a half range of the solid angle (Modest Radiative Heat Transfer page 545 1rst edition)
+
+      //__________________________________
+      //  Compute Net Flux to the boundary
+      int face = UintahFace[RayFace];
+      boundFlux[origin][ face ] = sumProjI * 2 *M_PI/ (double) d_nFluxRays;
+
+/*`==========TESTING==========*/
+#if (DEBUG == 2)
+      if( isDbgCell(origin) ) {
+        printf( "\n      [%d, %d, %d]  face: %d sumProjI:  %g BoundaryFlux: %g\n",
+              origin.x(), origin.y(), origin.z(), face, sumProjI, boundFlux[origin][ face ]);
+      }
+#endif
+/*===========TESTING==========`*/
+
+    } // boundary faces loop
+  }  // end cell iterator
+}
+
+//______________________________________________________________________
+//  divQ with the counter based generator.  The random numbers of a ray
+//  are a function of the timestep, cell and ray index only and the
+//  intensity of each ray is summed in ray order, so divQ does not depend
+//  on the patch layout, the number of threads/ranks or d_rayPacketSize.
+//______________________________________________________________________
+template< class T >
+void
+Ray::solveDivQ_rayPackets( const Level* level,
+                           const Patch* patch,
+                           PhiloxRand& philox,
+                           constCCVariable< T >& sigmaT4OverPi,
+                           constCCVariable< T >& abskg,
+                           constCCVariable< int >& celltype,
+                           CCVariable< double >& divQ,
+                           CCVariable< double >& radiationVolq,
+                           unsigned long int& size )
+{
+  Vector Dx = patch->dCell();                   // cell spacing
+  const int L_stream = level->getIndex() << 4;
+
+  vector <int> rand_i( d_rayDirSampleAlgo == LATIN_HYPER_CUBE ? d_nDivQRays : 0);  // only needed for LHC scheme
+
+  Vector direction_vector[MAX_RAY_PACKET];
+  Vector rayOrigin[MAX_RAY_PACKET];
+  double sumI_ray[MAX_RAY_PACKET];
+
+  for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++){
+    IntVector origin = *iter;
+
+    // don't compute in intrusions and walls
+    if( celltype[origin] != d_flowCell ){
+      continue;
+    }
+
+    if (d_rayDirSampleAlgo == LATIN_HYPER_CUBE){
+      philox.setStream( origin, 0, L_stream + DIVQ_LHC );
+      randVector(rand_i, philox, origin);
+    }
+    double sumI = 0;
+    Point CC_pos = level->getCellPosition(origin);
+
+    // ray packet loop
+    for (int iRay0 = 0; iRay0 < d_nDivQRays; iRay0 += d_rayPacketSize){
+
+      const int nRays = std::min( d_rayPacketSize, d_nDivQRays - iRay0 );
+
+      for (int r = 0; r < nRays; r++){
+        const int iRay = iRay0 + r;
+        philox.setStream( origin, iRay, L_stream + DIVQ_RAYS );
+
+        if (d_rayDirSampleAlgo == LATIN_HYPER_CUBE){        // Latin-Hyper-Cube sampling
+          direction_vector[r] = findRayDirectionHyperCube( philox, origin, iRay, rand_i[iRay], iRay );
+        }else{                                              // Naive Monte-Carlo sampling
+          direction_vector[r] = findRayDirection( philox, origin, iRay );
+        }
+
+        ray_Origin( philox, CC_pos, Dx, d_CCRays, rayOrigin[r] );
+
+#ifdef RAY_SCATTER
+        // scattering draws more random numbers as the ray is traced
+        sumI_ray[r] = 0;
+        updateSumI< T >( level, direction_vector[r], rayOrigin[r], origin, Dx, sigmaT4OverPi, abskg, celltype, size, sumI_ray[r], philox );
+#endif
+      }
+
+#ifndef RAY_SCATTER
+      updateSumI_packet< T >( level, nRays, direction_vector, rayOrigin, origin, Dx, sigmaT4OverPi, abskg, celltype, size, sumI_ray );
+#endif
+
+      for (int r = 0; r < nRays; r++){
+        sumI += sumI_ray[r];
+      }
+    }  // ray packet loop
+
+    //__________________________________
+    //  Compute divQ
+    divQ[origin] = -4.0 * M_PI * abskg[origin] * ( sigmaT4OverPi[origin] - (sumI/d_nDivQRays) );
+
+    // radiationVolq is the incident energy per cell (W/m^3) and is necessary when particle heat transfer models (i.e. Shaddix) are used
+    radiationVolq[origin] = 4.0 * M_PI * (sumI/d_nDivQRays) ;
+/*`==========TESTING==========*/
+#if DEBUG == 1
+    if( isDbgCell(origin) ) {
+      printf( "\n      [%d, %d, %d]  sumI: %g  divQ: %g radiationVolq: %g  abskg: %g,    sigmaT4: %g \n",
+              origin.x(), origin.y(), origin.z(), sumI,divQ[origin], radiationVolq[origin],abskg[origin], sigmaT4OverPi[origin]);
+    }
+#endif
+/*===========TESTING==========`*/
+  }  // end cell iterator
+}
+
 
 //---------------------------------------------------------------------------
 // Ray tracing using the multilevel data onion scheme
@@ -1401,7 +1572,8 @@ Ray::computeExtents(LevelP level_0,
 
 //______________________________________________________________________
 // Compute the Ray direction from a cell face
-void Ray::rayDirection_cellFace( MTRand& mTwister,
+template< class RNG >
+void Ray::rayDirection_cellFace( RNG& mTwister,
                                  const IntVector& origin,
                                  const IntVector& indexOrder,
                                  const IntVector& signOrder,
@@ -1437,8 +1609,9 @@ void Ray::rayDirection_cellFace( MTRand& mTwister,
 //  generate the Monte-Carlo directions. Samples Uniformly on a hemisphere
 //  and as hence does not include the cosine in the sample.
 //______________________________________________________________________
+template< class RNG >
 void
-Ray::rayDirectionHyperCube_cellFace(MTRand& mTwister,
+Ray::rayDirectionHyperCube_cellFace(RNG& mTwister,
                                  const IntVector& origin,
                                  const IntVector& indexOrder,
                                  const IntVector& signOrder,
@@ -1477,8 +1650,9 @@ Ray::rayDirectionHyperCube_cellFace(MTRand& mTwister,
 //  Uses stochastically selected regions in polar and azimuthal space to
 //  generate the Monte-Carlo directions.  Samples uniformly on a sphere.
 //______________________________________________________________________
+template< class RNG >
 Vector
-Ray::findRayDirectionHyperCube(MTRand& mTwister,
+Ray::findRayDirectionHyperCube(RNG& mTwister,
                                const IntVector& origin,
                                const int iRay,
                                const int bin_i,
@@ -1504,7 +1678,8 @@ Ray::findRayDirectionHyperCube(MTRand& mTwister,
 //______________________________________________________________________
 //
 //  Compute the Ray location on a cell face
-void Ray::rayLocation_cellFace( MTRand& mTwister,
+template< class RNG >
+void Ray::rayLocation_cellFace( RNG& mTwister,
                                  const int face,
                                  const Vector Dx,
                                  const Point CC_pos,
@@ -184,11 +184,24 @@ namespace Uintah{
       bool d_isDbgOn{false};
       bool d_applyFilter{false};                  // Allow for filtering of boundFlux and divQ results
       int  d_rayDirSampleAlgo{NAIVE};             // Ray sampling algorithm
+      int  d_rayRNG{MERSENNE_TWISTER};            // random number generator used by rayTrace
+      int  d_rayPacketSize{8};                    // number of divQ rays traced in lockstep (PHILOX only)
 
       enum rayDirSampleAlgorithm{ NAIVE,          // random sampled ray direction
                                   LATIN_HYPER_CUBE
                                 };
 
+      enum rayRandomNumberGenerator{ MERSENNE_TWISTER,   // one stream per task, rays depend on the traversal order
+                                     PHILOX              // counter based, keyed by timestep, cell and ray
+                                   };
+
+      // PHILOX stream ids, the level index is stored in the upper 4 bits
+      enum rayStream{ DIVQ_RAYS = 0,
+                      DIVQ_LHC  = 1,
+                      FLUX_RAYS = 2,                      // + face
+                      FLUX_LHC  = 8                       // + face
+                    };
+
       enum ROI_algo{ fixed,                // user specifies fixed low and high point for a bounding box
                      dynamic,              // user specifies thresholds that are used to dynamically determine ROI
                      patch_based,          // The patch extents + halo are the ROI
@@ -237,6 +250,32 @@ namespace Uintah{
                      Task::WhichDW which_sigmaT4_dw,
                      Task::WhichDW which_celltype_dw );
 
+      //__________________________________
+      /** @brief Incident radiative flux on the wall faces of the flow cells of a patch */
+      template<class T, class RNG>
+      void solveBoundaryFlux( const Level* level,
+                              const Patch* patch,
+                              RNG& mTwister,
+                              constCCVariable< T >& sigmaT4OverPi,
+                              constCCVariable< T >& abskg,
+                              constCCVariable< int >& celltype,
+                              CCVariable< Stencil7 >& boundFlux,
+                              unsigned long int& size );
+
+      //__________________________________
+      /** @brief divQ of a patch with the counter based generator, the rays
+                 of a cell are traced in packets of d_rayPacketSize */
+      template<class T>
+      void solveDivQ_rayPackets( const Level* level,
+                                 const Patch* patch,
+                                 PhiloxRand& philox,
+                                 constCCVariable< T >& sigmaT4OverPi,
+                                 constCCVariable< T >& abskg,
+                                 constCCVariable< int >& celltype,
+                                 CCVariable< double >& divQ,
+                                 CCVariable< double >& radiationVolq,
+                                 unsigned long int& size );
+
       //__________________________________
       template<class T>
       void rayTraceGPU( DetailedTask* dtask,
@@ -335,7 +374,8 @@ namespace Uintah{
 
       //__________________________________
       /** @brief Adjust the location of a ray origin depending on the cell face */
-      void rayLocation_cellFace( MTRand& mTwister,
+      template<class RNG>
+      void rayLocation_cellFace( RNG& mTwister,
                                  const int face,
                                  const Vector Dx,
                                  const Point CC_pos,
@@ -343,7 +383,8 @@ namespace Uintah{
 
       //__________________________________
       /** @brief Adjust the direction of a ray depending on the cell face */
-      void rayDirection_cellFace( MTRand& mTwister,
+      template<class RNG>
+      void rayDirection_cellFace( RNG& mTwister,
                                   const IntVector& origin,
                                   const IntVector& indexOrder,
                                   const IntVector& signOrder,
@@ -353,7 +394,8 @@ namespace Uintah{
 
       //__________________________________
       /** @brief Sample Rays for directional flux using LHC sampling */
-      void rayDirectionHyperCube_cellFace( MTRand& mTwister,
+      template<class RNG>
+      void rayDirectionHyperCube_cellFace( RNG& mTwister,
                                            const IntVector& origin,
                                            const IntVector& indexOrder,
                                            const IntVector& signOrder,
@@ -364,7 +406,8 @@ namespace Uintah{
                                            const int jbin);
       //__________________________________
       /** @brief Sample Rays for flux divergence using LHC sampling */
-      Vector findRayDirectionHyperCube( MTRand& mTwister,
+      template<class RNG>
+      Vector findRayDirectionHyperCube( RNG& mTwister,
                                         const IntVector& = IntVector(-9,-9,-9),
                                         const int iRay = -9,
                                         const int bin_i = 0,
@@ -0,0 +1,104 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/Schedulers/DWDatabase.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace Uintah;
+
+namespace {
+
+thread_local int t_epoch_slot  { -1 };
+thread_local int t_epoch_depth {  0 };
+
+}
+
+std::atomic<uint64_t> DWReadEpoch::s_epoch{ 1 };
+std::atomic<uint64_t> DWReadEpoch::s_active[MAX_THREADS]{};
+std::atomic<int>      DWReadEpoch::s_num_threads{ 0 };
+
+//______________________________________________________________________
+//
+void
+DWReadEpoch::enter()
+{
+  if (t_epoch_depth++ > 0) {
+    return;
+  }
+
+  if (t_epoch_slot < 0) {
+    t_epoch_slot = s_num_threads.fetch_add(1);
+    if (t_epoch_slot >= MAX_THREADS) {
+      t_epoch_depth = 0;
+      SCI_THROW(InternalError("DWReadEpoch::enter - more than MAX_THREADS reader threads", __FILE__, __LINE__));
+    }
+  }
+
+  s_active[t_epoch_slot].store(s_epoch.load());
+
+  // pairs with the fence in oldestActive(): either the retiring thread sees this
+  // thread's epoch, or this thread's slot loads see the DataItem already taken out
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+//______________________________________________________________________
+//
+void
+DWReadEpoch::leave()
+{
+  if (--t_epoch_depth == 0) {
+    s_active[t_epoch_slot].store(0, std::memory_order_release);
+  }
+}
+
+//______________________________________________________________________
+//
+uint64_t
+DWReadEpoch::advance()
+{
+  return s_epoch.fetch_add(1);
+}
+
+//______________________________________________________________________
+//
+uint64_t
+DWReadEpoch::oldestActive()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  uint64_t oldest = std::numeric_limits<uint64_t>::max();
+
+  const int num_threads = std::min(s_num_threads.load(), MAX_THREADS);
+  for (int i = 0; i < num_threads; ++i) {
+    const uint64_t epoch = s_active[i].load(std::memory_order_acquire);
+    if (epoch != 0 && epoch < oldest) {
+      oldest = epoch;
+    }
+  }
+
+  return oldest;
+}
@@ -39,6 +39,10 @@
 #include <Core/Parallel/Parallel.h>
 #include <Core/Util/FancyAssert.h>
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -67,6 +71,25 @@
 
   DESCRIPTION
 
+    The KeyDatabase maps (label, matl, domain) to a slot in the DWDatabase.
+    Keys are added at task graph compile time (and during initialization and
+    copy data timesteps), all other accesses only touch existing slots. Once a
+    KeyDatabase is frozen it rejects new keys, and the DWDatabase looks up and
+    publishes its slots with atomics instead of taking g_keyDB_lock.
+
+    A frozen get() reads a slot without any lock, so put() and the scrubs may
+    not delete the DataItem they take out of a slot. The task graph already
+    orders a replacing put after the tasks that read the old version, and a
+    scrub after the last task that requires the variable, but that ordering
+    is only as good as each task's declared requires/modifies. So, while
+    frozen, the removed DataItems are retired instead, stamped with the
+    DWReadEpoch they were retired in. The scheduler threads bracket the code
+    that reads variables (initiating, running and receiving for a task) with a
+    DWReadEpoch::Guard, and a retired item is deleted by a later retire() once
+    every thread still inside a guard entered after it was retired. So a
+    scrubbed variable outlives its scrub only by the longest task that was
+    already running at the time. releaseRetired() deletes whatever is left
+    when the scheduler thaws the database after the task graph has executed.
 
 ****************************************/
 
@@ -81,6 +104,47 @@ Uintah::MasterLock g_mvars_lock{};
 namespace Uintah {
 
 
+// Read epochs for the DataItems retired from a frozen DWDatabase. A thread
+// that may hold a DataItem it got from a frozen get() stays inside a Guard
+// until it is done with it.
+class DWReadEpoch {
+
+public:
+
+  class Guard {
+
+  public:
+
+    Guard()  { DWReadEpoch::enter(); }
+    ~Guard() { DWReadEpoch::leave(); }
+
+    // eliminate copy, assignment and move
+    Guard( const Guard & )            = delete;
+    Guard& operator=( const Guard & ) = delete;
+    Guard( Guard && )                 = delete;
+    Guard& operator=( Guard && )      = delete;
+  };
+
+  // Guards nest, only the outermost one publishes the thread's epoch.
+  static void enter();
+  static void leave();
+
+  // Called after the DataItem has been taken out of its slot. Returns the epoch
+  // to stamp the retired item with and starts a new one.
+  static uint64_t advance();
+
+  // The oldest epoch a thread inside a guard entered in. An item retired in an
+  // earlier epoch can no longer be held by any reader.
+  static uint64_t oldestActive();
+
+private:
+
+  static std::atomic<uint64_t> s_epoch;
+  static std::atomic<uint64_t> s_active[MAX_THREADS];   // 0 is outside of a guard
+  static std::atomic<int>      s_num_threads;
+};
+
+
 template<class DomainType>
 class KeyDatabase {
 
@@ -108,12 +172,18 @@ public:
 
   void print( std::ostream & out, int rank ) const;
 
+  // Only change while no tasks are running. While frozen, insert() throws for a new key.
+  void freeze( bool frozen ) { m_frozen = frozen; }
+
+  bool isFrozen() const { return m_frozen; }
+
 private:
 
   using keyDBtype = std::unordered_map<VarLabelMatl<DomainType>, int>;
   keyDBtype m_keys;
 
-  int m_key_count { 0 };
+  int  m_key_count { 0 };
+  bool m_frozen    { false };
 
 };
 
@@ -190,6 +260,10 @@ class DWDatabase {
 
     void cleanForeign();
 
+    // Deletes all DataItems still retired from while the KeyDatabase was frozen.
+    // Only call while no tasks are running.
+    void releaseRetired();
+
     // Scrub counter manipulator functions -- when the scrub count goes to
     // zero, the data is scrubbed.  Return remaining count
 
@@ -257,6 +331,24 @@ class DWDatabase {
                          , const DomainType * dom
                          ) const;
 
+    // g_keyDB_lock is only taken while the KeyDatabase may still grow
+    std::unique_lock<Uintah::MasterLock> keyDBLock() const
+    {
+      if (m_keyDB->isFrozen()) {
+        return std::unique_lock<Uintah::MasterLock>();
+      }
+      return std::unique_lock<Uintah::MasterLock>(g_keyDB_lock);
+    }
+
+    // deletes di now or, if the KeyDatabase is frozen, once no reader can still hold it
+    void retire( DataItem * di );
+
+    // for puts with init, add the key and grow the slot storage to match
+    void insertKey( const VarLabel   * label
+                  ,       int          matlindex
+                  , const DomainType * dom
+                  );
+
     KeyDatabase<DomainType>* m_keyDB { nullptr };
 
     using varDBtype = std::vector<DataItem*>;
@@ -265,6 +357,15 @@ class DWDatabase {
     using scrubDBtype = std::vector<int>;
     scrubDBtype m_scrubs {};
 
+    struct RetiredItem {
+        DataItem * m_item;
+        uint64_t   m_epoch;
+    };
+
+    // in epoch order, retire() stamps and appends under m_retired_lock
+    std::deque<RetiredItem> m_retired      {};
+    Uintah::MasterLock      m_retired_lock {};
+
     // eliminate copy, assignment and move
     DWDatabase( const DWDatabase & )            = delete;
     DWDatabase& operator=( const DWDatabase & ) = delete;
@@ -285,6 +386,8 @@ DWDatabase<DomainType>::~DWDatabase()
 template<class DomainType>
 void DWDatabase<DomainType>::clear()
 {
+  releaseRetired();
+
   for (auto iter = m_vars.begin(); iter != m_vars.end(); ++iter) {
     if (*iter) {
       delete *iter;
@@ -308,6 +411,47 @@ DWDatabase<DomainType>::cleanForeign()
   }
 }
 
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+DWDatabase<DomainType>::retire( DataItem * di )
+{
+  if (di == nullptr) {
+    return;
+  }
+
+  if (m_keyDB == nullptr || !m_keyDB->isFrozen()) {
+    delete di;
+    return;
+  }
+
+  std::lock_guard<Uintah::MasterLock> retire_lock(m_retired_lock);
+
+  m_retired.push_back({di, DWReadEpoch::advance()});
+
+  // the list is in epoch order, so stop at the first item a reader may still hold
+  const uint64_t oldest = DWReadEpoch::oldestActive();
+  while (!m_retired.empty() && m_retired.front().m_epoch < oldest) {
+    delete m_retired.front().m_item;
+    m_retired.pop_front();
+  }
+}
+
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+DWDatabase<DomainType>::releaseRetired()
+{
+  std::lock_guard<Uintah::MasterLock> release_lock(m_retired_lock);
+
+  for (auto iter = m_retired.begin(); iter != m_retired.end(); ++iter) {
+    delete iter->m_item;
+  }
+  m_retired.clear();
+}
+
 //______________________________________________________________________
 //
 template<class DomainType>
@@ -325,20 +469,19 @@ DWDatabase<DomainType>::decrementScrubCount( const VarLabel   * label
 
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> decrement_scrub_count_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> decrement_scrub_count_lock = keyDBLock();
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
     return 0;
   }
-  if (!m_vars[idx]) {
+  if (!__atomic_load_n(&m_vars[idx], __ATOMIC_ACQUIRE)) {
     return 0;
   }
 
   int rt = __sync_sub_and_fetch(&(m_scrubs[idx]), 1);
   if (rt == 0) {
-    delete m_vars[idx];
-    m_vars[idx] = nullptr;
+    retire(__atomic_exchange_n(&m_vars[idx], nullptr, __ATOMIC_ACQ_REL));
   }
 
   return rt;
@@ -354,13 +497,13 @@ DWDatabase<DomainType>::setScrubCount( const VarLabel   * label
                                      ,       int          count
                                      )
 {
-  std::lock_guard<Uintah::MasterLock> set_scrub_count_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> set_scrub_count_lock = keyDBLock();
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
     SCI_THROW(UnknownVariable(label->getName(), -99, dom, matlIndex, "DWDatabase::setScrubCount", __FILE__, __LINE__));
   }
-  m_scrubs[idx] = count;
+  __atomic_store_n(&m_scrubs[idx], count, __ATOMIC_RELEASE);
 }
 
 //______________________________________________________________________
@@ -374,12 +517,11 @@ DWDatabase<DomainType>::scrub( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> scrub_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> scrub_lock = keyDBLock();
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
-  if (idx != -1 && m_vars[idx]) {
-    delete m_vars[idx];
-    m_vars[idx] = nullptr;
+  if (idx != -1) {
+    retire(__atomic_exchange_n(&m_vars[idx], nullptr, __ATOMIC_ACQ_REL));
   }
 }
 
@@ -469,6 +611,9 @@ KeyDatabase<DomainType>::insert( const VarLabel   * label
   VarLabelMatl<DomainType> v(label, matlIndex, getRealDomain(dom));
   typename keyDBtype::const_iterator const_iter = m_keys.find(v);
   if (const_iter == m_keys.end()) {
+    if (m_frozen) {
+      SCI_THROW(InternalError("KeyDatabase::insert - cannot add " + label->getName() + " to a frozen key database", __FILE__, __LINE__));
+    }
     m_keys.insert(std::pair<VarLabelMatl<DomainType>, int>(v, m_key_count++));
   }
 }
@@ -512,6 +657,23 @@ DWDatabase<DomainType>::doReserve( KeyDatabase<DomainType> * keydb )
   m_scrubs.resize(m_keyDB->m_key_count + 1, 0);
 }
 
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+DWDatabase<DomainType>::insertKey( const VarLabel   * label
+                                 ,       int          matlIndex
+                                 , const DomainType * dom
+                                 )
+{
+  m_keyDB->insert(label, matlIndex, dom);
+
+  // a frozen key database has no new keys, so the slots are already there
+  if (!m_keyDB->isFrozen()) {
+    this->doReserve(m_keyDB);
+  }
+}
+
 //______________________________________________________________________
 //
 template<class DomainType>
@@ -521,13 +683,13 @@ DWDatabase<DomainType>::exists( const VarLabel   * label
                               , const DomainType * dom
                               ) const
 {
-  std::lock_guard<Uintah::MasterLock> exists_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> exists_lock = keyDBLock();
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
     return false;
   }
-  if (m_vars[idx] == nullptr) {
+  if (__atomic_load_n(&m_vars[idx], __ATOMIC_ACQUIRE) == nullptr) {
     return false;
   }
   return true;
@@ -547,11 +709,10 @@ DWDatabase<DomainType>::put( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> put_lock = keyDBLock();
 
   if (init) {
-    m_keyDB->insert(label, matlIndex, dom);
-    this->doReserve(m_keyDB);
+    insertKey(label, matlIndex, dom);
   }
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
@@ -559,20 +720,20 @@ DWDatabase<DomainType>::put( const VarLabel   * label
     SCI_THROW(UnknownVariable(label->getName(), -1, dom, matlIndex, "DWDatabase::put", __FILE__, __LINE__));
   }
 
-  if (m_vars[idx]) {
-    if (m_vars[idx]->m_next) {
+  const DataItem* olddi = __atomic_load_n(&m_vars[idx], __ATOMIC_ACQUIRE);
+  if (olddi) {
+    if (olddi->m_next) {
       SCI_THROW(InternalError("More than one vars on this label", __FILE__, __LINE__));
     }
     if (!replace) {
       SCI_THROW(InternalError("Put replacing old vars", __FILE__, __LINE__));
     }
-    ASSERT(m_vars[idx]->m_var != var);
-    delete m_vars[idx];
+    ASSERT(olddi->m_var != var);
   }
 
   DataItem* newdi = new DataItem();
   newdi->m_var = var;
-  m_vars[idx] = newdi;
+  retire(__atomic_exchange_n(&m_vars[idx], newdi, __ATOMIC_ACQ_REL));
 }
 
 //______________________________________________________________________
@@ -588,11 +749,10 @@ DWDatabase<DomainType>::putReduce( const VarLabel              * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_reduce_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> put_reduce_lock = keyDBLock();
 
   if (init) {
-    m_keyDB->insert(label, matlIndex, dom);
-    this->doReserve(m_keyDB);
+    insertKey(label, matlIndex, dom);
   }
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
@@ -631,11 +791,10 @@ DWDatabase<DomainType>::putForeign( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_foreign_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> put_foreign_lock = keyDBLock();
 
   if (init) {
-    m_keyDB->insert(label, matlIndex, dom);
-    this->doReserve(m_keyDB);
+    insertKey(label, matlIndex, dom);
   }
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
@@ -646,7 +805,7 @@ DWDatabase<DomainType>::putForeign( const VarLabel   * label
   DataItem* newdi = new DataItem();
   newdi->m_var = var;
   do {
-    newdi->m_next = m_vars[idx];
+    newdi->m_next = __atomic_load_n(&m_vars[idx], __ATOMIC_ACQUIRE);
   }
   while (!__sync_bool_compare_and_swap(&m_vars[idx], newdi->m_next, newdi));  // vars[iter->second] = newdi;
 }
@@ -666,7 +825,7 @@ DWDatabase<DomainType>::getDataItem( const VarLabel   * label
   if (idx == -1) {
     SCI_THROW(UnknownVariable(label->getName(), -99, dom, matlIndex, "DWDatabase::getDataItem", __FILE__, __LINE__));
   }
-  return m_vars[idx];
+  return __atomic_load_n(&m_vars[idx], __ATOMIC_ACQUIRE);
 }
 
 //______________________________________________________________________
@@ -679,7 +838,7 @@ DWDatabase<DomainType>::get( const VarLabel   * label
                            , const DomainType * dom
                            ) const
 {
-  std::lock_guard<Uintah::MasterLock> get_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> get_lock = keyDBLock();
 
   const DataItem* dataItem = getDataItem(label, matlIndex, dom);
   ASSERT(dataItem != nullptr);          // should have thrown an exception before
@@ -711,7 +870,7 @@ DWDatabase<DomainType>::getlist( const VarLabel               * label
                                ,       std::vector<Variable*> & varlist
                                ) const
 {
-  std::lock_guard<Uintah::MasterLock> get_list_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> get_list_lock = keyDBLock();
 
   for (DataItem* dataItem = getDataItem(label, matlIndex, dom); dataItem != nullptr; dataItem = dataItem->m_next) {
     varlist.push_back(dataItem->m_var);
@@ -788,7 +947,7 @@ template<class DomainType>
 void
 DWDatabase<DomainType>::getVarLabelMatlTriples( std::vector<VarLabelMatl<DomainType> > & v) const
 {
-  std::lock_guard<Uintah::MasterLock> get_var_label_mat_triples_lock(g_keyDB_lock);
+  std::unique_lock<Uintah::MasterLock> get_var_label_mat_triples_lock = keyDBLock();
 
   for (auto keyiter = m_keyDB->m_keys.begin(); keyiter != m_keyDB->m_keys.end(); ++keyiter) {
     const VarLabelMatl<DomainType>& vlm = keyiter->first;
@@ -25,6 +25,7 @@
 #include <CCA/Components/Schedulers/DependencyBatch.h>
 
 #include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/PackBufferInfo.h>
 #include <Core/Util/DOUT.hpp>
 
 #include <sstream>
@@ -65,6 +66,12 @@ DependencyBatch::~DependencyBatch()
     delete dep;
     dep = tmp;
   }
+
+  freePersistentRequest();
+
+  if (m_persistent_buffer && m_persistent_buffer->removeReference()) {
+    delete m_persistent_buffer;
+  }
 }
 
 //_____________________________________________________________________________
@@ -129,6 +136,68 @@ void DependencyBatch::addVar( Variable * var )
   m_to_vars.push_back(var);
 }
 
+//_____________________________________________________________________________
+//
+bool
+DependencyBatch::persistentBufferAvailable() const
+{
+  // the batch holds one reference, a pending send list or receive buffer info holds the other
+  return (m_persistent_buffer == nullptr) || (m_persistent_buffer->getReferenceCount() == 1);
+}
 
-} // namespace Uintah
+//_____________________________________________________________________________
+//
+MPI_Request
+DependencyBatch::startPersistentRequest( bool       send
+                                       , void     * buf
+                                       , int        count
+                                       , int        rank
+                                       , MPI_Comm   comm
+                                       )
+{
+  if (m_persistent_request == MPI_REQUEST_NULL || buf != m_persistent_buf || count != m_persistent_count || m_message_tag != m_persistent_tag) {
+    freePersistentRequest();
+
+    if (send) {
+      Uintah::MPI::Send_init(buf, count, MPI_PACKED, rank, m_message_tag, comm, &m_persistent_request);
+    }
+    else {
+      Uintah::MPI::Recv_init(buf, count, MPI_PACKED, rank, m_message_tag, comm, &m_persistent_request);
+    }
+
+    m_persistent_buf   = buf;
+    m_persistent_count = count;
+    m_persistent_tag   = m_message_tag;
+    m_persistent_send  = send;
+  }
 
+  Uintah::MPI::Start(&m_persistent_request);
+
+  return m_persistent_request;
+}
+
+//_____________________________________________________________________________
+//
+void
+DependencyBatch::freePersistentRequest()
+{
+  if (m_persistent_request == MPI_REQUEST_NULL) {
+    return;
+  }
+
+  // freeing an active request leaves MPI writing to (or reading from) a buffer that is
+  // about to go away, so complete it first: a receive is cancelled, a send has to finish
+  int complete = 0;
+  Uintah::MPI::Request_get_status(m_persistent_request, &complete, MPI_STATUS_IGNORE);
+  if (!complete) {
+    if (!m_persistent_send) {
+      Uintah::MPI::Cancel(&m_persistent_request);
+    }
+    Uintah::MPI::Wait(&m_persistent_request, MPI_STATUS_IGNORE);
+  }
+
+  Uintah::MPI::Request_free(&m_persistent_request);
+}
+
+
+} // namespace Uintah
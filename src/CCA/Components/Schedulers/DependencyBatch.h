@@ -27,6 +27,8 @@
 
 #include <CCA/Components/Schedulers/DetailedTasks.h>
 
+#include <Core/Parallel/UintahMPI.h>
+
 #include <list>
 #include <map>
 #include <vector>
@@ -34,6 +36,7 @@
 namespace Uintah {
 
 class DetailedDep;
+class PackedBuffer;
 class ProcessorGroup;
 class Variable;
 class VarLabel;
@@ -63,6 +66,19 @@ public:
   // Add invalid variables to dep batch. These variables will be marked as valid when MPI completes.
   void addVar( Variable * var );
 
+  // True when the persistent pack buffer is not in use by a send or receive still in flight.
+  bool persistentBufferAvailable() const;
+
+  // Starts the persistent send (or receive) request of this batch on the packed buffer,
+  // first (re)creating it if the buffer, message size or message tag (which changes when a
+  // cached task graph is updated) changed since it was last started.
+  MPI_Request startPersistentRequest( bool       send
+                                    , void     * buf
+                                    , int        count
+                                    , int        rank
+                                    , MPI_Comm   comm
+                                    );
+
   DependencyBatch          * m_comp_next{nullptr};
   DetailedTask             * m_from_task{nullptr};
   DetailedDep              * m_head{nullptr};
@@ -70,6 +86,9 @@ public:
   int                        m_message_tag{-1};
   int                        m_to_rank{-1};
 
+  // contiguous pack buffer reused by the persistent request each time step
+  PackedBuffer             * m_persistent_buffer{nullptr};
+
 
 private:
 
@@ -79,11 +98,20 @@ private:
   DependencyBatch( DependencyBatch && )                 = delete;
   DependencyBatch& operator=( DependencyBatch && )      = delete;
 
+  // completes the persistent request if it is still active, then frees it
+  void freePersistentRequest();
+
   bool m_received{false};
   std::atomic<bool> m_made_mpi_request{false};
 
   std::vector<Variable*> m_to_vars{};
 
+  MPI_Request    m_persistent_request{MPI_REQUEST_NULL};
+  void         * m_persistent_buf{nullptr};
+  int            m_persistent_count{0};
+  int            m_persistent_tag{-1};
+  bool           m_persistent_send{false};
+
 };
 
 } // namespace Uintah
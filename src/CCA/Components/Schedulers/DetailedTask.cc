@@ -410,6 +410,23 @@ DetailedTask::addInternalRequires( DependencyBatch * req )
 void
 DetailedTask::checkExternalDepCount()
 {
+  // With work stealing each thread has its own ready queue; claim the task with a CAS
+  // on m_externally_ready instead of serializing through the shared queue lock.
+  if (m_task_group->usingWorkStealing()) {
+    if ((m_external_dependency_count.load(std::memory_order_acquire) == 0) && m_task_group->m_sched_common->useInternalDeps() &&
+         m_initiated.load(std::memory_order_acquire) && !m_task->usesMPI()) {
+
+      bool expected = false;
+      if (m_externally_ready.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        DOUT(g_external_deps_dbg, "Rank-" << Parallel::getMPIRank() << " Task " << this->getTask()->getName()
+                                          << " MPI requirements satisfied, placing into ready queue " << m_home_queue);
+
+        m_task_group->externalDependenciesSatisfied(this);
+      }
+    }
+    return;
+  }
+
   std::lock_guard<Uintah::MasterLock> external_ready_guard(g_external_ready_mutex);
 
   DOUT(g_external_deps_dbg, "Rank-" << Parallel::getMPIRank() << " Task " << this->getTask()->getName() << " external deps: "
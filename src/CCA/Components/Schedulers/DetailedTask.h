@@ -148,6 +148,10 @@ public:
   void assignStaticOrder( int i )  { m_static_order = i; }
   int  getStaticOrder() const { return m_static_order; }
 
+  // index of the per-thread ready queue this task is placed in when work stealing is enabled
+  void assignHomeQueue( int i ) { m_home_queue = i; }
+  int  getHomeQueue() const { return m_home_queue; }
+
   DetailedTasks* getTaskGroup() const { return m_task_group; }
 
   std::map<DependencyBatch*, DependencyBatch*>& getRequires() { return m_reqs; }
@@ -248,6 +252,7 @@ public:
 protected:
 
   friend class TaskGraph;
+  friend class DetailedTasks;
 
 
 private:
@@ -290,12 +295,23 @@ private:
 
   int m_resource_index { -1 };
   int m_static_order   { -1 };
+  int m_home_queue     {  0 };
 
   // specifies the type of task this is:
   //   * Normal executes on either the patches cells or the patches coarse cells
   //   * Fine   executes on the patches fine cells (for example coarsening)
   ProfileType m_profile_type { Normal };
 
+  // the scrub counts DetailedTasks::possiblyCreateDependency() added for the requires
+  // of this task, so they can be taken back when only this task is recompiled
+  struct ScrubCount {
+    const VarLabel * m_var;
+    int              m_matl;
+    const Patch    * m_patch;
+    int              m_dw;
+  };
+  std::vector<ScrubCount> m_scrub_counts;
+
   RuntimeStats::TaskExecTimer m_exec_timer{this};
   RuntimeStats::TaskWaitTimer m_wait_timer{this};
 
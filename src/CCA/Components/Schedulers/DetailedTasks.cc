@@ -44,9 +44,11 @@
   #include <Core/Parallel/CrowdMonitor.hpp>
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <sstream>
 #include <string>
+#include <tuple>
 
 using namespace Uintah;
 
@@ -146,6 +148,10 @@ DetailedTasks::~DetailedTasks()
     delete m_tasks[i];
   }
 
+  for (size_t i = 0; i < m_steal_queues.size(); i++) {
+    delete m_steal_queues[i];
+  }
+
   delete m_send_old_data;
 }
 
@@ -173,9 +179,39 @@ DetailedTasks::assignMessageTags( unsigned int index )
   // Map for individual task pairs.
   std::map< std::pair< std::string, std::string >, int > taskPairs;
 
-  // Loop through all of the tasks to get the counts.
+  // The tags count the batches between two ranks, so both have to visit
+  // them in the same order.  The order of m_dep_batches is not enough once
+  // a cached task graph was updated (see TaskGraph::updateDetailedTasks()),
+  // as the rebuilt batches are appended, so visit them by their computing
+  // task, which identifies a batch to a given rank on every rank.
+  using BatchKey = std::tuple< int, std::vector<int>, std::vector<int> >;
+  auto batchKey = []( const DependencyBatch * batch ) {
+    const DetailedTask* dtask = batch->m_from_task;
+    BatchKey key( dtask->getTask()->getSortedOrder(), std::vector<int>(), std::vector<int>() );
+    for (int p = 0; dtask->getPatches() && p < dtask->getPatches()->size(); p++) {
+      std::get<1>(key).push_back(dtask->getPatches()->get(p)->getID());
+    }
+    for (int m = 0; dtask->getMaterials() && m < dtask->getMaterials()->size(); m++) {
+      std::get<2>(key).push_back(dtask->getMaterials()->get(m));
+    }
+    return key;
+  };
+
+  std::vector< std::pair<BatchKey, DependencyBatch*> > batches;
   for (size_t i = 0; i < m_dep_batches.size(); i++) {
     DependencyBatch* batch = m_dep_batches[i];
+    if (batch->m_from_task->getAssignedResourceIndex() == me || batch->m_to_rank == me) {
+      batches.emplace_back(batchKey(batch), batch);
+    }
+  }
+  std::sort(batches.begin(), batches.end(), []( const std::pair<BatchKey, DependencyBatch*> & a
+                                              , const std::pair<BatchKey, DependencyBatch*> & b ) {
+    return a.first < b.first || (!(b.first < a.first) && a.second->m_to_rank < b.second->m_to_rank);
+  });
+
+  // Loop through all of the tasks to get the counts.
+  for (size_t i = 0; i < batches.size(); i++) {
+    DependencyBatch* batch = batches[i].second;
 
     int from = batch->m_from_task->getAssignedResourceIndex();
     ASSERTRANGE(from, 0, m_proc_group->nRanks());
@@ -205,7 +241,7 @@ DetailedTasks::assignMessageTags( unsigned int index )
 #endif
       // Start the message tag with one.
       if( from == me ) {
-        m_dep_batches[i]->m_message_tag = ++m_comm_info[allTasks][ to ][CommPTPMsgTo];
+        batch->m_message_tag = ++m_comm_info[allTasks][ to ][CommPTPMsgTo];
 
 #ifdef HAVE_VISIT
         // Individual task comm stats.
@@ -214,7 +250,7 @@ DetailedTasks::assignMessageTags( unsigned int index )
       }
       
       if( to == me ) {
-        m_dep_batches[i]->m_message_tag = ++m_comm_info[allTasks][ from ][CommPTPMsgFrom];
+        batch->m_message_tag = ++m_comm_info[allTasks][ from ][CommPTPMsgFrom];
 
 #ifdef HAVE_VISIT
         // Individual task comm stats.
@@ -348,6 +384,216 @@ DetailedTasks::computeLocalTasks()
   }
 }
 
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::removeDependencies( const std::unordered_set<DetailedTask*> & recompiled )
+{
+  // internal dependencies and scrub counts are recorded with the requiring task
+  for (auto iter = recompiled.begin(); iter != recompiled.end(); ++iter) {
+    DetailedTask* dtask = *iter;
+
+    for (auto dep = dtask->m_internal_dependencies.begin(); dep != dtask->m_internal_dependencies.end(); ++dep) {
+      dep->m_prerequisite_task->m_internal_dependents.erase(dtask);
+    }
+    dtask->m_internal_dependencies.clear();
+    dtask->m_num_pending_internal_dependencies = 0;
+
+    for (auto scrub = dtask->m_scrub_counts.begin(); scrub != dtask->m_scrub_counts.end(); ++scrub) {
+      removeScrubCount(scrub->m_var, scrub->m_matl, scrub->m_patch, scrub->m_dw);
+    }
+    dtask->m_scrub_counts.clear();
+  }
+
+  // take the recompiled tasks off the DetailedDeps, the DetailedDeps (and batches) left
+  // with no requiring task go away.  The remaining DetailedDeps keep their order and
+  // (possibly combined) ranges, which the neighboring rank does the same with.
+  std::vector<DependencyBatch*> batches;
+  for (size_t i = 0; i < m_dep_batches.size(); i++) {
+    DependencyBatch* batch = m_dep_batches[i];
+
+    DetailedDep* parent_dep = nullptr;
+    DetailedDep* dep = batch->m_head;
+    while (dep != nullptr) {
+      DetailedDep* next = dep->m_next;
+      dep->m_to_tasks.remove_if([&recompiled](DetailedTask* dtask) { return recompiled.count(dtask) > 0; });
+      if (dep->m_to_tasks.empty()) {
+        if (parent_dep == nullptr) {
+          batch->m_head = next;
+        }
+        else {
+          parent_dep->m_next = next;
+        }
+        delete dep;
+      }
+      else {
+        parent_dep = dep;
+      }
+      dep = next;
+    }
+
+    if (batch->m_head != nullptr) {
+      batches.push_back(batch);
+      continue;
+    }
+
+    DependencyBatch** link = &batch->m_from_task->m_comp_head;
+    while (*link != batch) {
+      link = &(*link)->m_comp_next;
+    }
+    *link = batch->m_comp_next;
+
+    delete batch;
+  }
+  m_dep_batches.swap(batches);
+
+  // the batches are handed out again by rebuildFromDependencies()
+  for (size_t i = 0; i < m_tasks.size(); i++) {
+    m_tasks[i]->m_reqs.clear();
+  }
+}
+
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::remapPatches( const std::unordered_map<const Patch*, const Patch*> & patch_map )
+{
+  auto remap = [&patch_map]( const Patch * patch ) {
+    auto iter = patch_map.find(patch);
+    ASSERT(iter != patch_map.end());
+    return (iter != patch_map.end()) ? iter->second : patch;
+  };
+
+  for (size_t i = 0; i < m_dep_batches.size(); i++) {
+    for (DetailedDep* dep = m_dep_batches[i]->m_head; dep != nullptr; dep = dep->m_next) {
+      if (dep->m_from_patch) {
+        dep->m_from_patch = remap(dep->m_from_patch);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < m_tasks.size(); i++) {
+    std::vector<DetailedTask::ScrubCount>& scrubs = m_tasks[i]->m_scrub_counts;
+    for (auto scrub = scrubs.begin(); scrub != scrubs.end(); ++scrub) {
+      scrub->m_patch = remap(scrub->m_patch);
+    }
+  }
+
+  // the scrub items hash the patch, so rebuild the table, dropping the counts removeDependencies() took to zero
+  std::vector<ScrubItem*> items;
+  for (FastHashTableIter<ScrubItem> iter(&m_scrub_count_table); iter.ok(); ++iter) {
+    const ScrubItem* item = iter.get_key();
+    if (item->m_count > 0) {
+      ScrubItem* remapped = scinew ScrubItem(item->m_label, item->m_matl, remap(item->m_patch), item->m_dw);
+      remapped->m_count = item->m_count;
+      items.push_back(remapped);
+    }
+  }
+  m_scrub_count_table.remove_all();
+  for (size_t i = 0; i < items.size(); i++) {
+    m_scrub_count_table.insert(items[i]);
+  }
+}
+
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::replaceTasks( const std::vector<DetailedTask*> & tasks
+                           , const std::unordered_set<int>    & neighborhood_processors
+                           )
+{
+  // keep the existing send_old_data tasks, their batches may still be in use
+  std::vector<DetailedTask*> send_old_tasks;
+  for (auto iter = m_send_old_map.begin(); iter != m_send_old_map.end(); ++iter) {
+    send_old_tasks.push_back(m_tasks[iter->second]);
+  }
+
+  for (auto iter = neighborhood_processors.begin(); iter != neighborhood_processors.end(); ++iter) {
+    if (m_send_old_map.find(*iter) == m_send_old_map.end()) {
+      DetailedTask* newtask = scinew DetailedTask( m_send_old_data, nullptr, nullptr, this );
+      newtask->assignResource(*iter);
+      send_old_tasks.push_back(newtask);
+    }
+  }
+
+  m_tasks.clear();
+  m_send_old_map.clear();
+  for (size_t i = 0; i < send_old_tasks.size(); i++) {
+    m_send_old_map[send_old_tasks[i]->getAssignedResourceIndex()] = m_tasks.size();
+    m_tasks.push_back(send_old_tasks[i]);
+  }
+  m_tasks.insert(m_tasks.end(), tasks.begin(), tasks.end());
+
+  m_local_tasks.clear();
+}
+
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::rebuildFromDependencies()
+{
+  int me = m_proc_group->myRank();
+
+  std::unordered_map<const DetailedTask*, size_t> order;
+  for (size_t i = 0; i < m_tasks.size(); i++) {
+    order[m_tasks[i]] = i;
+  }
+  auto before = [&order]( const DetailedTask * a, const DetailedTask * b ) { return order.at(a) < order.at(b); };
+
+  m_particle_sends.clear();
+  m_particle_recvs.clear();
+  m_var_keyDB.clear();
+  m_level_keyDB.clear();
+
+  for (size_t i = 0; i < m_dep_batches.size(); i++) {
+    DependencyBatch* batch = m_dep_batches[i];
+    int fromresource = batch->m_from_task->getAssignedResourceIndex();
+    int toresource   = batch->m_to_rank;
+
+    // as if the batch had been created by the first requiring task compiled, which in threaded
+    // mode is followed by the others (see possiblyCreateDependency())
+    std::vector<DetailedTask*> to_tasks;
+    for (DetailedDep* dep = batch->m_head; dep != nullptr; dep = dep->m_next) {
+      to_tasks.insert(to_tasks.end(), dep->m_to_tasks.begin(), dep->m_to_tasks.end());
+
+      const VarLabel* var = dep->m_req->m_var;
+      if (dep->m_from_patch) {
+        m_var_keyDB.insert(var, dep->m_matl, dep->m_from_patch);
+      }
+
+      if (var->typeDescription()->getType() == TypeDescription::ParticleVariable && dep->m_req->m_whichdw == Task::OldDW) {
+        PSPatchMatlGhostRange pmg(dep->m_from_patch, dep->m_matl, dep->m_low, dep->m_high, (int)dep->m_comm_condition, 1);
+        ParticleExchangeVar& exchange = (fromresource == me) ? m_particle_sends : m_particle_recvs;
+        std::set<PSPatchMatlGhostRange>& ranges = exchange[(fromresource == me) ? toresource : fromresource];
+        auto iter = ranges.find(pmg);
+        if (iter == ranges.end()) {
+          ranges.insert(pmg);
+        }
+        else {
+          iter->count_++;
+        }
+      }
+    }
+    std::sort(to_tasks.begin(), to_tasks.end(), before);
+    to_tasks.erase(std::unique(to_tasks.begin(), to_tasks.end()), to_tasks.end());
+    if (!m_must_consider_internal_deps) {
+      to_tasks.resize(1);
+    }
+
+    batch->m_to_tasks.assign(to_tasks.begin(), to_tasks.end());
+    for (size_t j = 0; j < to_tasks.size(); j++) {
+      to_tasks[j]->addRequires(batch);
+    }
+  }
+
+  computeLocalTasks();
+  makeDWKeyDatabase();
+
+  if (m_num_steal_queues > 0) {
+    assignStealQueues(m_num_steal_queues);
+  }
+}
+
 //_____________________________________________________________________________
 //
 void
@@ -414,6 +660,23 @@ DetailedTasks::addScrubCount( const VarLabel * var
   }
 }
 
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::removeScrubCount( const VarLabel * var
+                               ,       int        matlindex
+                               , const Patch    * patch
+                               ,       int        dw
+                               )
+{
+  ScrubItem key(var, matlindex, patch->getRealPatch(), dw);
+  ScrubItem* result = m_scrub_count_table.lookup(&key);
+  ASSERT(result != nullptr && result->m_count > 0);
+  if (result) {
+    result->m_count--;
+  }
+}
+
 //_____________________________________________________________________________
 //
 void
@@ -685,6 +948,7 @@ DetailedTasks::possiblyCreateDependency(       DetailedTask     * from
       && fromPatch && !req->m_var->typeDescription()->isReductionVariable()) {
     // add scrub counts for local tasks, and not for non-data deps
     addScrubCount(req->m_var, matl, fromPatch, req->m_whichdw);
+    to->m_scrub_counts.push_back({req->m_var, matl, fromPatch->getRealPatch(), req->m_whichdw});
   }
 
   // if the dependency is on the same processor then add an internal dependency
@@ -930,6 +1194,17 @@ DetailedTasks::getOldDWSendTask( int proc )
 void
 DetailedTasks::internalDependenciesSatisfied( DetailedTask * dtask )
 {
+  if (m_num_steal_queues > 0) {
+    StealQueue* queue = m_steal_queues[dtask->getHomeQueue()];
+    {
+      std::lock_guard<Uintah::MasterLock> steal_queue_guard(queue->m_internal_lock);
+      queue->m_internal_tasks.push(dtask);
+    }
+    queue->m_internal_size.fetch_add(1, std::memory_order_release);
+    m_atomic_initial_ready_tasks_size.fetch_add(1, std::memory_order_release);
+    return;
+  }
+
   std::lock_guard<Uintah::MasterLock> internal_deps_satisfied_guard(g_internal_ready_mutex);
 
   m_ready_tasks.push(dtask);
@@ -955,6 +1230,58 @@ DetailedTasks::getNextInternalReadyTask()
   return nextTask;
 }
 
+//_____________________________________________________________________________
+//
+DetailedTask*
+DetailedTasks::popInternalStealQueue( StealQueue * queue, bool wait )
+{
+  if (queue->m_internal_size.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+
+  if (wait) {
+    queue->m_internal_lock.lock();
+  }
+  else if (!queue->m_internal_lock.try_lock()) {
+    return nullptr;
+  }
+
+  DetailedTask* nextTask = nullptr;
+  if (!queue->m_internal_tasks.empty()) {
+    nextTask = queue->m_internal_tasks.front();
+    queue->m_internal_tasks.pop();
+    queue->m_internal_size.fetch_sub(1, std::memory_order_relaxed);
+    m_atomic_initial_ready_tasks_size.fetch_sub(1, std::memory_order_relaxed);
+  }
+  queue->m_internal_lock.unlock();
+
+  return nextTask;
+}
+
+//_____________________________________________________________________________
+//
+DetailedTask*
+DetailedTasks::getNextInternalReadyTask( int thread_id )
+{
+  if (m_num_steal_queues == 0) {
+    return getNextInternalReadyTask();
+  }
+
+  if (m_atomic_initial_ready_tasks_size.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+
+  // own queue first, then walk the neighboring threads' queues without blocking on them
+  const int home = thread_id % m_num_steal_queues;
+  DetailedTask* nextTask = popInternalStealQueue(m_steal_queues[home], true);
+
+  for (int i = 1; nextTask == nullptr && i < m_num_steal_queues; ++i) {
+    nextTask = popInternalStealQueue(m_steal_queues[(home + i) % m_num_steal_queues], false);
+  }
+
+  return nextTask;
+}
+
 //_____________________________________________________________________________
 //
 int
@@ -982,6 +1309,142 @@ DetailedTasks::getNextExternalReadyTask()
   return nextTask;
 }
 
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::externalDependenciesSatisfied( DetailedTask * dtask )
+{
+  StealQueue* queue = m_steal_queues[dtask->getHomeQueue()];
+  {
+    std::lock_guard<Uintah::MasterLock> steal_queue_guard(queue->m_lock);
+    queue->m_tasks.push(dtask);
+  }
+  queue->m_size.fetch_add(1, std::memory_order_release);
+  m_atomic_mpi_completed_tasks_size.fetch_add(1, std::memory_order_release);
+}
+
+//_____________________________________________________________________________
+//
+DetailedTask*
+DetailedTasks::popStealQueue( StealQueue * queue, bool wait )
+{
+  if (queue->m_size.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+
+  if (wait) {
+    queue->m_lock.lock();
+  }
+  else if (!queue->m_lock.try_lock()) {
+    return nullptr;
+  }
+
+  DetailedTask* nextTask = nullptr;
+  if (!queue->m_tasks.empty()) {
+    nextTask = queue->m_tasks.top();
+    queue->m_tasks.pop();
+    queue->m_size.fetch_sub(1, std::memory_order_relaxed);
+    m_atomic_mpi_completed_tasks_size.fetch_sub(1, std::memory_order_relaxed);
+  }
+  queue->m_lock.unlock();
+
+  return nextTask;
+}
+
+//_____________________________________________________________________________
+//
+DetailedTask*
+DetailedTasks::getNextExternalReadyTask( int thread_id )
+{
+  if (m_num_steal_queues == 0) {
+    return getNextExternalReadyTask();
+  }
+
+  if (m_atomic_mpi_completed_tasks_size.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+
+  // own queue first, then walk the neighboring threads' queues without blocking on them
+  const int home = thread_id % m_num_steal_queues;
+  DetailedTask* nextTask = popStealQueue(m_steal_queues[home], true);
+
+  for (int i = 1; nextTask == nullptr && i < m_num_steal_queues; ++i) {
+    nextTask = popStealQueue(m_steal_queues[(home + i) % m_num_steal_queues], false);
+  }
+
+  return nextTask;
+}
+
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::setWorkStealing( int num_queues )
+{
+  num_queues = std::max(num_queues, 0);
+  if (num_queues != m_num_steal_queues) {
+    assignStealQueues(num_queues);
+  }
+
+  // initTimestep() refilled the shared internal-ready queue, deal it out to the home queues
+  if (m_num_steal_queues > 0) {
+    while (!m_ready_tasks.empty()) {
+      DetailedTask* dtask = m_ready_tasks.front();
+      m_ready_tasks.pop();
+
+      StealQueue* queue = m_steal_queues[dtask->getHomeQueue()];
+      queue->m_internal_tasks.push(dtask);
+      queue->m_internal_size.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::assignStealQueues( int num_queues )
+{
+  for (size_t i = 0; i < m_steal_queues.size(); i++) {
+    delete m_steal_queues[i];
+  }
+  m_steal_queues.clear();
+
+  m_num_steal_queues = num_queues;
+  for (int i = 0; i < m_num_steal_queues; i++) {
+    m_steal_queues.push_back(scinew StealQueue);
+  }
+
+  if (m_num_steal_queues == 0) {
+    return;
+  }
+
+  // Give each thread a contiguous block of the local patches, so tasks on the same
+  // (and neighboring) patches tend to execute on the same thread.
+  std::map<int, int> patch_queue;
+  for (size_t i = 0; i < m_local_tasks.size(); i++) {
+    const PatchSubset* patches = m_local_tasks[i]->getPatches();
+    if (patches != nullptr && patches->size() > 0) {
+      patch_queue[patches->get(0)->getID()] = 0;
+    }
+  }
+
+  const int num_patches = patch_queue.size();
+  int count = 0;
+  for (auto iter = patch_queue.begin(); iter != patch_queue.end(); ++iter) {
+    iter->second = (count++ * m_num_steal_queues) / num_patches;
+  }
+
+  // tasks without patches (reductions, send_old_data, ...) are dealt out round-robin
+  for (size_t i = 0; i < m_local_tasks.size(); i++) {
+    const PatchSubset* patches = m_local_tasks[i]->getPatches();
+    if (patches != nullptr && patches->size() > 0) {
+      m_local_tasks[i]->assignHomeQueue(patch_queue[patches->get(0)->getID()]);
+    }
+    else {
+      m_local_tasks[i]->assignHomeQueue(i % m_num_steal_queues);
+    }
+  }
+}
+
 //_____________________________________________________________________________
 //
 int
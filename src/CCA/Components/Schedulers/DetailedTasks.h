@@ -39,6 +39,7 @@
 #include <Core/Grid/Variables/ScrubItem.h>
 
 #include <Core/Lockfree/Lockfree_Pool.hpp>
+#include <Core/Parallel/MasterLock.h>
 
 
 #ifdef HAVE_CUDA
@@ -51,6 +52,8 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <atomic>
 #include <list>
@@ -162,6 +165,25 @@ public:
 
   void computeLocalTasks();
 
+  // The following support TaskGraph::updateDetailedTasks(), which recompiles only some of the tasks.
+
+  // Removes the DetailedDeps, internal dependencies and scrub counts that the recompiled tasks
+  // required, and the DependencyBatches left without any DetailedDep.
+  void removeDependencies( const std::unordered_set<DetailedTask*> & recompiled );
+
+  // Points the DetailedDeps and scrub counts at the patches of the new grid.
+  void remapPatches( const std::unordered_map<const Patch*, const Patch*> & patch_map );
+
+  // Replaces the tasks with the send_old_data tasks, including new ones for any
+  // neighborhood processors that did not have one, followed by tasks.
+  void replaceTasks( const std::vector<DetailedTask*>   & tasks
+                   , const std::unordered_set<int>      & neighborhood_processors
+                   );
+
+  // Rebuilds what is derived from the dependencies once they are recompiled: the receiving
+  // tasks of each batch, the particle exchanges, the key databases and the local tasks.
+  void rebuildFromDependencies();
+
   int numLocalTasks() const
   {
     return static_cast<int>(m_local_tasks.size());
@@ -176,10 +198,18 @@ public:
 
   DetailedTask* getNextInternalReadyTask();
 
+  // When work stealing is enabled, pops from the calling thread's own internal-ready queue
+  // first, then steals from the other threads' queues. Otherwise same as getNextInternalReadyTask().
+  DetailedTask* getNextInternalReadyTask( int thread_id );
+
   int numInternalReadyTasks();
 
   DetailedTask* getNextExternalReadyTask();
 
+  // When work stealing is enabled, pops from the calling thread's own ready queue first,
+  // then steals from the other threads' queues. Otherwise same as getNextExternalReadyTask().
+  DetailedTask* getNextExternalReadyTask( int thread_id );
+
   int numExternalReadyTasks();
 
   void createScrubCounts();
@@ -234,6 +264,15 @@ public:
     return m_task_priority_alg;
   }
 
+  // num_queues == 0 disables work stealing (single shared internal- and external-ready queues).
+  // Must be called after initTimestep(), it moves the initially ready tasks to their home queues.
+  void setWorkStealing( int num_queues );
+
+  bool usingWorkStealing() const
+  {
+    return m_num_steal_queues > 0;
+  }
+
 #ifdef HAVE_CUDA
 
   void addDeviceValidateRequiresCopies( DetailedTask * dtask );
@@ -304,6 +343,9 @@ protected:
 
   void internalDependenciesSatisfied( DetailedTask * dtask );
 
+  // called by DetailedTask::checkExternalDepCount() when work stealing is enabled
+  void externalDependenciesSatisfied( DetailedTask * dtask );
+
   SchedulerCommon* getSchedulerCommon()
   {
     return m_sched_common;
@@ -315,6 +357,16 @@ private:
 
   void incrementDependencyGeneration();
 
+  struct StealQueue;
+
+  // helpers of getNext{External,Internal}ReadyTask( thread_id ), when wait is false give up if the queue is locked
+  DetailedTask* popStealQueue( StealQueue * queue, bool wait );
+
+  DetailedTask* popInternalStealQueue( StealQueue * queue, bool wait );
+
+  // rebuilds the steal queues and assigns each local task its home queue
+  void assignStealQueues( int num_queues );
+
   // helper of possiblyCreateDependency
   DetailedDep* findMatchingDetailedDep(       DependencyBatch  * batch
                                       ,       DetailedTask     * toTask
@@ -334,6 +386,12 @@ private:
                     ,       int        dw
                     );
 
+  void removeScrubCount( const VarLabel * var
+                       ,       int        matlindex
+                       , const Patch    * patch
+                       ,       int        dw
+                       );
+
   bool getScrubCount( const VarLabel * var
                     , int              matlindex
                     , const Patch    * patch
@@ -375,6 +433,22 @@ private:
   std::atomic<int> m_atomic_initial_ready_tasks_size { 0 };
   std::atomic<int> m_atomic_mpi_completed_tasks_size { 0 };
 
+  // Per-thread ready queues, used in place of m_mpi_completed_tasks and m_ready_tasks when
+  // work stealing is enabled. The external-ready queue keeps the DetailedTaskPriorityComparison
+  // ordering, the internal-ready queue is FIFO like m_ready_tasks.
+  struct StealQueue {
+    Uintah::MasterLock m_lock{};
+    TaskPQueue         m_tasks{};
+    std::atomic<int>   m_size{0};
+
+    Uintah::MasterLock m_internal_lock{};
+    TaskQueue          m_internal_tasks{};
+    std::atomic<int>   m_internal_size{0};
+  };
+
+  std::vector<StealQueue*> m_steal_queues;
+  int                      m_num_steal_queues { 0 };
+
   // This "generation" number is to keep track of which InternalDependency
   // links have been satisfied in the current timestep and avoids the
   // need to traverse all InternalDependency links to reset values.
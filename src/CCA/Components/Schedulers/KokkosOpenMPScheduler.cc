@@ -177,6 +177,9 @@ KokkosOpenMPScheduler::execute( int tgnum       /* = 0 */
                               , int iteration   /* = 0 */
                               )
 {
+  // done before the copy data timestep check, which must thaw the DWs' key databases
+  freezeDWKeyDatabases();
+
   // copy data timestep must be single threaded for now and
   //  also needs to run deterministically, in a static order
   if (m_is_copy_data_timestep) {
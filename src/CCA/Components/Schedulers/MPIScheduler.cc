@@ -40,6 +40,7 @@
 #include <Core/Parallel/CommunicationList.hpp>
 #include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/ProcessorGroup.h>
+#include <Core/Parallel/SharedMemoryExchange.h>
 #include <Core/Parallel/UintahMPI.h>
 #include <Core/Util/DOUT.hpp>
 #include <Core/Util/FancyAssert.h>
@@ -249,6 +250,8 @@ void MPIScheduler::initiateTask( DetailedTask * dtask
     return;
   }
 
+  DWReadEpoch::Guard read_epoch;
+
   postMPIRecvs(dtask, only_old_recvs, abort_point, iteration);
 }
 
@@ -275,6 +278,9 @@ MPIScheduler::runTask( DetailedTask * dtask
                      , int            iteration
                      )
 {
+  // the task, its sends and its scrubs may hold variables from frozen DWs
+  DWReadEpoch::Guard read_epoch;
+
   if (m_tracking_vars_print_location & SchedulerCommon::PRINT_BEFORE_EXEC) {
     printTrackedVars(dtask, SchedulerCommon::PRINT_BEFORE_EXEC);
   }
@@ -457,10 +463,25 @@ MPIScheduler::postMPISends( DetailedTask * dtask
       void* buf = nullptr;
       int count;
       MPI_Datatype datatype;
+      bool persistent = false;
+      bool shared = false;
 
 #ifdef USE_PACKING
-      mpibuff.get_type(buf, count, datatype, my_comm);
-      mpibuff.pack(my_comm, count);
+      // same node messages go through the shared memory segment when there is room
+      shared = m_shared_memory_exchange && SharedMemoryExchange::onNode(my_comm, to)
+               && mpibuff.packShared(buf, count, datatype, my_comm);
+
+      if (!shared) {
+        // persistent requests reuse the batch's pack buffer, unless a send from it is still in flight
+        persistent = m_persistent_mpi_requests && batch->persistentBufferAvailable();
+        if (persistent) {
+          mpibuff.get_type(buf, count, datatype, my_comm, batch->m_persistent_buffer);
+        }
+        else {
+          mpibuff.get_type(buf, count, datatype, my_comm);
+        }
+        mpibuff.pack(my_comm, count);
+      }
 #else
       mpibuff.get_type(buf, count, datatype);
 #endif
@@ -468,8 +489,8 @@ MPIScheduler::postMPISends( DetailedTask * dtask
         printf("postMPISends() - ERROR, the send MPI buffer is nullptr\n");
         SCI_THROW( InternalError("The send MPI buffer is null", __FILE__, __LINE__) );
       }
-      DOUT(g_mpi_dbg, "Rank-" << my_rank << " Posting send for message number " << batch->m_message_tag
-                              << " to   rank-" << to << ", length: " << count << " (bytes)");
+      DOUT(g_mpi_dbg, "Rank-" << my_rank << " Posting " << (persistent ? "persistent " : "") << (shared ? "shared memory " : "") << "send for message number "
+                              << batch->m_message_tag << " to   rank-" << to << ", length: " << count << " (bytes)");
 
       m_num_messages++;
       int typeSize;
@@ -485,7 +506,12 @@ MPIScheduler::postMPISends( DetailedTask * dtask
       // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
       //---------------------------------------------------------------------------
       CommRequestPool::iterator comm_sends_iter = m_sends.emplace(new SendHandle(mpibuff.takeSendlist()));
-      Uintah::MPI::Isend(buf, count, datatype, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
+      if (persistent) {
+        *comm_sends_iter->request() = batch->startPersistentRequest(true, buf, count, to, my_comm);
+      }
+      else {
+        Uintah::MPI::Isend(buf, count, datatype, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
+      }
       comm_sends_iter.clear();
       //---------------------------------------------------------------------------
 
@@ -660,9 +686,17 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
         void* buf = nullptr;
         int count;
         MPI_Datatype datatype;
+        bool persistent = false;
 
 #ifdef USE_PACKING
-        mpibuff.get_type(buf, count, datatype, my_comm);
+        // persistent requests reuse the batch's pack buffer, unless it is still being unpacked
+        persistent = m_persistent_mpi_requests && batch->persistentBufferAvailable();
+        if (persistent) {
+          mpibuff.get_type(buf, count, datatype, my_comm, batch->m_persistent_buffer);
+        }
+        else {
+          mpibuff.get_type(buf, count, datatype, my_comm);
+        }
 #else
         mpibuff.get_type(buf, count, datatype);
 #endif
@@ -674,7 +708,7 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
         int from = batch->m_from_task->getAssignedResourceIndex();
         ASSERTRANGE(from, 0, d_myworld->nRanks());
 
-        DOUT(g_mpi_dbg, "Rank-" << my_rank << " Posting recv for message number "
+        DOUT(g_mpi_dbg, "Rank-" << my_rank << " Posting " << (persistent ? "persistent " : "") << "recv for message number "
                                 << batch->m_message_tag << " from rank-" << from
                                 << ", length: " << count << " (bytes)");
 
@@ -682,7 +716,12 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
         // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
         //---------------------------------------------------------------------------
         CommRequestPool::iterator comm_recvs_iter = m_recvs.emplace(new RecvHandle(p_mpibuff, pBatchRecvHandler));
-        Uintah::MPI::Irecv(buf, count, datatype, from, batch->m_message_tag, my_comm, comm_recvs_iter->request());
+        if (persistent) {
+          *comm_recvs_iter->request() = batch->startPersistentRequest(false, buf, count, from, my_comm);
+        }
+        else {
+          Uintah::MPI::Irecv(buf, count, datatype, from, batch->m_message_tag, my_comm, comm_recvs_iter->request());
+        }
         comm_recvs_iter.clear();
         //---------------------------------------------------------------------------
 
@@ -720,6 +759,8 @@ void MPIScheduler::processMPIRecvs( int test_type )
     return;
   }
 
+  DWReadEpoch::Guard read_epoch;
+
   Timers::Simple process_recv_timer;
   process_recv_timer.start();
 
@@ -738,8 +779,7 @@ void MPIScheduler::processMPIRecvs( int test_type )
       RuntimeStats::TestTimer mpi_test_timer;
       comm_iter = m_recvs.find_any(test_request);
       if (comm_iter) {
-        MPI_Status status;
-        comm_iter->finishedCommunication(d_myworld, status);
+        comm_iter->finishedCommunication(d_myworld, comm_iter->status());
         m_recvs.erase(comm_iter);
       }
       break;
@@ -750,8 +790,7 @@ void MPIScheduler::processMPIRecvs( int test_type )
       RuntimeStats::WaitTimer mpi_wait_timer;
       comm_iter = m_recvs.find_any(wait_request);
       if (comm_iter) {
-        MPI_Status status;
-        comm_iter->finishedCommunication(d_myworld, status);
+        comm_iter->finishedCommunication(d_myworld, comm_iter->status());
         m_recvs.erase(comm_iter);
       }
       break;
@@ -763,8 +802,7 @@ void MPIScheduler::processMPIRecvs( int test_type )
       while (m_recvs.size() != 0u) {
         comm_iter = m_recvs.find_any(wait_request);
         if (comm_iter) {
-          MPI_Status status;
-          comm_iter->finishedCommunication(d_myworld, status);
+          comm_iter->finishedCommunication(d_myworld, comm_iter->status());
           m_recvs.erase(comm_iter);
         }
       }
@@ -128,6 +128,15 @@ public:
 
   virtual void doReserve();
 
+  // When frozen, patch variable lookups and puts no longer take the DWDatabase lock.
+  // Only call while no tasks are running, and never for timesteps that add keys.
+  // Also deletes the replaced or scrubbed variables still retired from the frozen window.
+  void freezeKeyDB( bool frozen )
+  {
+    m_var_key_DB.freeze( frozen );
+    m_var_DB.releaseRetired();
+  }
+
   // Returns a (const) pointer to the grid.  This pointer can then be
   // used to (for example) get the number of levels in the grid.
   virtual const Grid * getGrid()
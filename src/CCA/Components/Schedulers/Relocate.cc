@@ -26,9 +26,11 @@
 #include <CCA/Ports/Scheduler.h>
 #include <Core/Containers/Array2.h>
 #include <Core/Grid/DbgOutput.h>
+#include <Core/Grid/Variables/ParticleDataBlock.h>
 #include <Core/Grid/Variables/ParticleVariable.h>
 #include <Core/Util/DebugStream.h>
 #include <Core/Util/DOUT.hpp>
+#include <Core/Util/Handle.h>
 #include <Core/Util/ProgressiveWarning.h>
 
 #include <map>
@@ -46,6 +48,22 @@ namespace {
   Dout g_total_reloc("RELOCATE_SCATTER_DBG", "Schedulers", "prints info on particle scatter ops", false);
 
   DebugStream coutdbg("RELOCATE_DBG", "Schedulers", "prints particle relocation neighbor patches", false);
+
+  // One block holding a column for the position and for each of the relocated
+  // variables. The caller's handle keeps it alive until all of them have gathered,
+  // and frees it if a gather throws before any variable took a reference.
+  Handle<ParticleDataBlock> createDataBlock(       int                                  numParticles
+                                    ,       ParticleVariableBase               * pos
+                                    , const std::vector<ParticleVariableBase*> & vars
+                                    )
+  {
+    size_t bytes = ParticleDataBlock::columnBytes(numParticles, pos->getElementSize());
+    for (auto var : vars) {
+      bytes += ParticleDataBlock::columnBytes(numParticles, var->getElementSize());
+    }
+
+    return Handle<ParticleDataBlock>(scinew ParticleDataBlock(bytes));
+  }
 }
 
 Relocate::~Relocate()
@@ -1210,15 +1228,23 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
           // particle position
           ParticleVariableBase* posvar = new_dw->getParticleVariable(reloc_old_posLabel, orig_pset);
           ParticleVariableBase* newpos = posvar->clone();
+          
+          std::vector<ParticleVariableBase*> vars(numVars);
+          for(int v=0;v<numVars;v++){
+            ParticleVariableBase* var = new_dw->getParticleVariable(reloc_old_labels[m][v], orig_pset);
+            vars[v] = var->clone();
+          }
+          
+          // gather all of the relocated variables into one (structure of arrays) block
+          Handle<ParticleDataBlock> block = createDataBlock(totalParticles, newpos, vars);
+          
+          newpos->setStorageBlock(block.get_rep());
           newpos->gather(newsubset, subsets, invars, fromPatches, numRemote);
           
           //__________________________________
           // other particle variables
-          std::vector<ParticleVariableBase*> vars(numVars);
-          
           for(int v=0;v<numVars;v++){
             const VarLabel* label = reloc_old_labels[m][v];
-            ParticleVariableBase* var = new_dw->getParticleVariable(label, orig_pset);
             
             for(int i=0;i<numOldVariables;i++){
               invars[i]=new_dw->getParticleVariable(label, matl, fromPatches[i]);
@@ -1237,9 +1263,8 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
               invars[subsets.size()-1] = addedVar;
             }
             
-            ParticleVariableBase* newvar = var->clone();
-            newvar->gather(newsubset, subsets, invars, fromPatches, numRemote);
-            vars[v]=newvar;
+            vars[v]->setStorageBlock(block.get_rep());
+            vars[v]->gather(newsubset, subsets, invars, fromPatches, numRemote);
           }  // numVars
           
           //__________________________________
@@ -1643,16 +1668,24 @@ Relocate::relocateParticles(const ProcessorGroup* pg,
           ParticleVariableBase* posvar = 
                      new_dw->getParticleVariable(reloc_old_posLabel, orig_pset);
           ParticleVariableBase* newpos = posvar->clone();
+
+          std::vector<ParticleVariableBase*> vars(numVars);
+          for(int v=0;v<numVars;v++){
+            ParticleVariableBase* var =
+                     new_dw->getParticleVariable(reloc_old_labels[m][v], orig_pset);
+            vars[v] = var->clone();
+          }
+
+          // gather all of the relocated variables into one (structure of arrays) block
+          Handle<ParticleDataBlock> block = createDataBlock(totalParticles, newpos, vars);
+
+          newpos->setStorageBlock(block.get_rep());
           newpos->gather(newsubset, subsets, invars, fromPatches, numRemote);
 
           //__________________________________
           // other particle variables
-          std::vector<ParticleVariableBase*> vars(numVars);
-          
           for(int v=0;v<numVars;v++){
             const VarLabel* label = reloc_old_labels[m][v];
-            ParticleVariableBase* var =
-                                  new_dw->getParticleVariable(label, orig_pset);
             for(int i=0;i<numOldVariables;i++){
               invars[i]=new_dw->getParticleVariable(label,matl,fromPatches[i]);
             }
@@ -1672,9 +1705,8 @@ Relocate::relocateParticles(const ProcessorGroup* pg,
             }
 #endif
 
-            ParticleVariableBase* newvar = var->clone();
-            newvar->gather(newsubset, subsets, invars, fromPatches, numRemote);
-            vars[v]=newvar;
+            vars[v]->setStorageBlock(block.get_rep());
+            vars[v]->gather(newsubset, subsets, invars, fromPatches, numRemote);
           }  // numVars
 
           //__________________________________
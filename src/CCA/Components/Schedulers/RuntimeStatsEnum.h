@@ -57,6 +57,9 @@ namespace Uintah {
     , RegriddingCompilationTime
     , RegriddingCopyDataTime
     , LoadBalancerTime
+
+    // Compilation time avoided by reusing a cached task graph, see <cache_task_graphs>.
+    , TaskGraphCacheSavedTime
     
     // These five enumerators are used in SimulationController::ReportStats to determine task and comm overhead.
     , TaskExecTime
@@ -25,6 +25,7 @@
 #include <CCA/Components/Schedulers/SchedulerCommon.h>
 
 #include <CCA/Components/Schedulers/DetailedTasks.h>
+#include <CCA/Components/Schedulers/MemoryLog.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouseP.h>
 #include <CCA/Components/Schedulers/TaskGraph.h>
@@ -39,6 +40,7 @@
 #include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/Task.h>
+#include <Core/Grid/Variables/Array3DataPool.h>
 #include <Core/Grid/Variables/LocallyComputedPatchVarMap.h>
 #include <Core/Grid/Variables/PerPatch.h>
 #include <Core/Grid/Variables/CellIterator.h>
@@ -49,6 +51,7 @@
 #include <Core/Grid/Variables/SFCZVariable.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Parallel/ProcessorGroup.h>
+#include <Core/Parallel/SharedMemoryExchange.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
 #include <Core/OS/ProcessInfo.h>
 #include <Core/Util/DOUT.hpp>
@@ -57,6 +60,7 @@
 
 #include <sci_defs/visit_defs.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdlib>
 #include <fstream>
@@ -117,6 +121,10 @@ SchedulerCommon::~SchedulerCommon()
     delete m_task_graphs[i];
   }
 
+  for (unsigned i = 0u; i < m_cached_task_graphs.size(); i++) {
+    delete m_cached_task_graphs[i];
+  }
+
   m_label_matls.clear();
 
   if (m_locallyComputedPatchVarMap) {
@@ -366,6 +374,43 @@ SchedulerCommon::problemSetup( const ProblemSpecP     & prob_spec
       proc0cout << "Using large, combined MPI messages\n";
     }
 
+    params->getWithDefault("persistent_mpi_requests", m_persistent_mpi_requests, false);
+    if (m_persistent_mpi_requests) {
+      proc0cout << "Using persistent MPI requests for task graph messages\n";
+    }
+
+    params->getWithDefault("shared_memory_exchange", m_shared_memory_exchange, false);
+    if (m_shared_memory_exchange) {
+      int segment_MB = 64;
+      params->getWithDefault("shared_memory_segment_MB", segment_MB, 64);
+      if (segment_MB <= 0) {
+        throw ProblemSetupException("ERROR: Scheduler: shared_memory_segment_MB must be positive", __FILE__, __LINE__);
+      }
+      SharedMemoryExchange::initialize(d_myworld->getComm(), static_cast<size_t>(segment_MB) * 1024 * 1024);
+      proc0cout << "Sending same node task graph messages through " << segment_MB << " MB shared memory segments\n";
+    }
+
+    bool pool_grid_variables = false;
+    params->getWithDefault("pool_grid_variables", pool_grid_variables, false);
+    Array3DataPool::setEnabled(pool_grid_variables);
+    if (pool_grid_variables) {
+      proc0cout << "Recycling grid variable storage through the Array3DataPool\n";
+    }
+
+    params->getWithDefault("lock_free_dw_lookup", m_lock_free_dw_lookup, false);
+    if (m_lock_free_dw_lookup) {
+      proc0cout << "Using lock-free DataWarehouse variable lookups\n";
+    }
+
+    params->getWithDefault("cache_task_graphs", m_cache_task_graphs, false);
+    if (m_cache_task_graphs) {
+      params->getWithDefault("task_graph_cache_size", m_task_graph_cache_size, 4);
+      if (m_task_graph_cache_size < 1) {
+        throw ProblemSetupException("ERROR: Scheduler: task_graph_cache_size must be at least 1", __FILE__, __LINE__);
+      }
+      proc0cout << "Keeping up to " << m_task_graph_cache_size << " compiled task graphs, recompiling only the parts on changed grid levels\n";
+    }
+
     ProblemSpecP track = params->findBlock("VarTracker");
     if (track) {
       track->require("start_time", m_tracking_start_time);
@@ -1087,7 +1132,18 @@ SchedulerCommon::initialize( int numOldDW /* = 1 */
 
   // clear the taskgraphs, and set the first one
   for (unsigned i = 0; i < m_task_graphs.size(); i++) {
-    delete m_task_graphs[i];
+    // when caching, hold on to the compiled taskgraphs (most recent first) so compile() can reuse them
+    if (m_cache_task_graphs && m_task_graphs[i]->getDetailedTasks() != nullptr) {
+      m_cached_task_graphs.insert(m_cached_task_graphs.begin(), m_task_graphs[i]);
+    }
+    else {
+      delete m_task_graphs[i];
+    }
+  }
+
+  while (m_cached_task_graphs.size() > static_cast<size_t>(m_task_graph_cache_size)) {
+    delete m_cached_task_graphs.back();
+    m_cached_task_graphs.pop_back();
   }
 
   m_task_graphs.clear();
@@ -1188,6 +1244,11 @@ SchedulerCommon::advanceDataWarehouse( const GridP & grid
 
   ASSERT(m_dws.size() >= 2);
 
+  // grid variable buffers not reused over the last DW generation are returned to the system
+  if (Array3DataPool::isEnabled()) {
+    Array3DataPool::newGeneration();
+  }
+
   // TODO: This can cost roughly 1 millisecond of time.  Find a way to reuse data warehouses if possible?  Brad March 6 2018
   // The last becomes last old, and the rest are new
   m_dws[m_num_old_dws - 1] = m_dws[m_dws.size() - 1];
@@ -1343,6 +1404,16 @@ SchedulerCommon::logMemoryUse()
     }
   }
 
+  if (Array3DataPool::isEnabled()) {
+    unsigned long hits, misses, cached_bytes;
+    Array3DataPool::getStats(hits, misses, cached_bytes);
+
+    std::ostringstream elems;
+    elems << "hits:" << hits << ",misses:" << misses << ",hit_rate:"
+          << ((hits + misses) > 0 ? (100.0 * hits) / (hits + misses) : 0.0) << "%";
+    logMemory(*m_mem_logfile, total, "Array3DataPool", "cached", "Array3Data", nullptr, -1, elems.str(), cached_bytes, 0);
+  }
+
   *m_mem_logfile << "Total: " << total << '\n';
   m_mem_logfile->flush();
 }
@@ -1399,12 +1470,69 @@ SchedulerCommon::compile()
       // check if this TG has any tasks with halo requirements > MAX_HALO_DEPTH (determined in public SchedulerCommon::addTask())
       const bool has_distal_reqs = m_task_graphs[i]->getDistalRequires();
 
+      bool is_init = m_is_init_timestep || m_is_restart_init_timestep;
+
+      // reuse the DetailedTasks of a cached TG compiled for the same tasks, recompiling only
+      // those on the levels whose patch layout or assignment changed since
+      if (m_cache_task_graphs) {
+        m_task_graphs[i]->computeSignature( grid, oldGrid, useInternalDeps() );
+
+        // the entry with the most unchanged levels, preferring the most recent one
+        int position  = -1;
+        int unchanged = 0;
+        for (auto j = 0u; j < m_cached_task_graphs.size(); j++) {
+          if (m_cached_task_graphs[j]->getSignature() == m_task_graphs[i]->getSignature()) {
+            const int num_unchanged = m_cached_task_graphs[j]->numUnchangedLevels( m_task_graphs[i] );
+            if (num_unchanged > unchanged) {
+              position  = j;
+              unchanged = num_unchanged;
+            }
+          }
+        }
+
+        if (position >= 0 && !m_cached_task_graphs[position]->planUpdate( m_task_graphs[i], grid, oldGrid, has_distal_reqs )) {
+          position = -1;
+        }
+
+        // the DetailedDeps have to match those of the neighboring ranks, so either all ranks
+        // update the same cache entry or all compile from scratch (the message tags are then
+        // assigned in an order that does not depend on the rank, see assignMessageTags())
+        int agree[2] = { position, -position };
+        int result[2];
+        Uintah::MPI::Allreduce(agree, result, 2, MPI_INT, MPI_MAX, d_myworld->getComm());
+
+        if (result[0] >= 0 && result[0] == -result[1]) {
+          TaskGraph* cached_tg = m_cached_task_graphs[position];
+          m_cached_task_graphs.erase(m_cached_task_graphs.begin() + position);
+
+          cached_tg->updateDetailedTasks( m_task_graphs[i] );
+
+          delete m_task_graphs[i];
+          m_task_graphs[i] = cached_tg;
+
+          const double update_time = tg_compile_timer().seconds();
+          const double saved_time  = std::max(cached_tg->getCompileTime() - update_time, 0.0);
+          if (m_runtimeStats) {
+            (*m_runtimeStats)[TaskGraphCacheSavedTime] += saved_time;
+          }
+
+          DOUT(g_task_graph_compile, "Rank-" << std::left << std::setw(5) << d_myworld->myRank() << " updated cached TG-" << std::setw(4)
+                                             << (is_init ? "init-tg" : std::to_string(cached_tg->getIndex())) << " (" << unchanged
+                                             << " of " << grid->numLevels() << " levels unchanged): saved ~" << saved_time
+                                             << " (sec), update took " << update_time << " (sec)");
+          continue;
+        }
+
+        if (position >= 0) {
+          m_cached_task_graphs[position]->cancelUpdate();
+        }
+      }
+
       // NOTE: this single call is where all the TG compilation complexity arises (dependency analysis for auto MPI mesgs)
       m_task_graphs[i]->createDetailedTasks( useInternalDeps(), grid, oldGrid, has_distal_reqs );
 
       double compile_time = tg_compile_timer().seconds();
-
-      bool is_init = m_is_init_timestep || m_is_restart_init_timestep;
+      m_task_graphs[i]->setCompileTime(compile_time);
 
       DOUT(g_task_graph_compile, "Rank-" << std::left << std::setw(5) << d_myworld->myRank() << " time to compile TG-" << std::setw(4)
                                          << (is_init ? "init-tg" : std::to_string(m_task_graphs[i]->getIndex())) << ": " << compile_time << " (sec)");
@@ -1473,6 +1601,27 @@ SchedulerCommon::finalizeTimestep()
   for (unsigned int i = m_num_old_dws; i < m_dws.size(); i++) {
     m_dws[i]->finalize();
   }
+
+  // the tasks are done, thaw the key databases so the retired variables are deleted
+  for (unsigned int i = 0; i < m_dws.size(); i++) {
+    if (m_dws[i].get_rep()) {
+      m_dws[i]->freezeKeyDB(false);
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+SchedulerCommon::freezeDWKeyDatabases()
+{
+  const bool frozen = m_lock_free_dw_lookup && !copyTimestep();
+
+  for (unsigned int i = 0; i < m_dws.size(); i++) {
+    if (m_dws[i].get_rep()) {
+      m_dws[i]->freezeKeyDB(frozen);
+    }
+  }
 }
 
 //______________________________________________________________________
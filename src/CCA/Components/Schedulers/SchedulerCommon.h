@@ -306,6 +306,10 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
 
     void finalizeTimestep();
 
+    // Freezes (or thaws) the patch variable key databases of all DWs for lock-free lookups,
+    // see <lock_free_dw_lookup>. Init and copy data timesteps add keys, so stay locked.
+    void freezeDWKeyDatabases();
+
     void makeTaskGraphDoc( const DetailedTasks * dtask, int rank = 0 );
 
     void emitNode( const DetailedTask * dtask
@@ -342,6 +346,12 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
     int                                 m_generation{0};
     int                                 m_dwmap[Task::TotalDWs];
 
+    // reuse persistent MPI requests and pack buffers per DependencyBatch, see <persistent_mpi_requests>
+    bool                                m_persistent_mpi_requests{false};
+
+    // send same node messages through a node shared memory segment, see <shared_memory_exchange>
+    bool                                m_shared_memory_exchange{false};
+
     ApplicationInterface * m_application  {nullptr};
     LoadBalancer         * m_loadBalancer {nullptr};
     Output               * m_output       {nullptr};
@@ -350,6 +360,10 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
     std::vector<OnDemandDataWarehouseP> m_dws;
     std::vector<TaskGraph*>             m_task_graphs;
 
+    // compiled task graphs kept by initialize() for reuse by compile(), most recent first and at
+    // most m_task_graph_cache_size of them, see <cache_task_graphs>
+    std::vector<TaskGraph*>             m_cached_task_graphs;
+
     //! These are so we can track certain variables over the taskgraph's execution.
     int                        m_tracking_vars_print_location{0};
     int                        m_tracking_patch_id{-1};
@@ -419,6 +433,9 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
     // whether or not to send a small message (takes more work to organize)
     // or a larger one (more communication time)
     bool m_use_small_messages{true};
+    bool m_lock_free_dw_lookup{false};
+    bool m_cache_task_graphs{false};
+    int  m_task_graph_cache_size{4};
     bool m_emit_task_graph{false};
     int  m_num_task_graphs{1};
     int  m_num_tasks{0};
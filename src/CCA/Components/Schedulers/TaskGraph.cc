@@ -23,6 +23,7 @@
  */
 
 #include <CCA/Components/Schedulers/TaskGraph.h>
+#include <CCA/Components/Schedulers/DependencyBatch.h>
 #include <CCA/Components/Schedulers/DetailedTasks.h>
 #include <CCA/Components/Schedulers/SchedulerCommon.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
@@ -43,10 +44,14 @@
 #include <Core/Util/FancyAssert.h>
 #include <Core/Util/ProgressiveWarning.h>
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <set>
 #include <sstream>
+#include <tuple>
 
 
 using namespace Uintah;
@@ -61,6 +66,116 @@ namespace {
   Dout g_detailed_task_dbg(     "TaskGraphDetailedTasks" , "TaskGraph", "high-level info on creation of DetailedTasks"        , false);
   Dout g_detailed_deps_dbg(     "TaskGraphDetailedDeps"  , "TaskGraph", "detailed dep info for each DetailedTask"             , false);
   Dout g_topological_deps_dbg(  "TopologicalDetailedDeps", "TaskGraph", "topologiocal sort detailed dependnecy info"          , false);
+  Dout g_task_graph_update_dbg( "TaskGraphUpdate"        , "TaskGraph", "DetailedTasks kept and recompiled by a cached TG"    , false);
+
+  inline void hashCombine( size_t & seed, size_t value )
+  {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+  }
+
+  // by level and position in it, patch IDs are not reused when the grid is rebuilt
+  void hashPatchSubset( size_t & seed, const PatchSubset * patches )
+  {
+    hashCombine(seed, patches ? patches->size() : -1);
+    if (patches) {
+      for (int p = 0; p < patches->size(); ++p) {
+        const Patch* patch = patches->get(p)->getRealPatch();
+        hashCombine(seed, patch->getLevel()->getIndex());
+        hashCombine(seed, patch->getLevelIndex());
+      }
+    }
+  }
+
+  void hashIntVector( size_t & seed, const IntVector & v )
+  {
+    for (int d = 0; d < 3; ++d) {
+      hashCombine(seed, v[d]);
+    }
+  }
+
+  bool sameExtents( const Patch * a, const Patch * b )
+  {
+    return (a->getCellLowIndex()       == b->getCellLowIndex()       && a->getCellHighIndex()       == b->getCellHighIndex() &&
+            a->getExtraCellLowIndex()  == b->getExtraCellLowIndex()  && a->getExtraCellHighIndex()  == b->getExtraCellHighIndex());
+  }
+
+  void hashMaterialSubset( size_t & seed, const MaterialSubset * matls )
+  {
+    hashCombine(seed, matls ? matls->size() : -1);
+    if (matls) {
+      for (int m = 0; m < matls->size(); ++m) {
+        hashCombine(seed, matls->get(m));
+      }
+    }
+  }
+
+  void hashDependencies( size_t & seed, const Task::Dependency * dep )
+  {
+    for (; dep != nullptr; dep = dep->m_next) {
+      hashCombine(seed, std::hash<std::string>()(dep->m_var->getName()));
+      hashCombine(seed, dep->m_dep_type);
+      hashCombine(seed, dep->m_whichdw);
+      hashCombine(seed, dep->mapDataWarehouse());
+      hashCombine(seed, dep->m_gtype);
+      hashCombine(seed, dep->m_num_ghost_cells);
+      hashCombine(seed, dep->m_level_offset);
+      hashCombine(seed, dep->m_patches_dom);
+      hashCombine(seed, dep->m_matls_dom);
+      hashCombine(seed, dep->m_look_in_old_tg);
+      hashCombine(seed, dep->m_reduction_level ? dep->m_reduction_level->getIndex() : -1);
+      hashPatchSubset(seed, dep->m_patches);
+      hashMaterialSubset(seed, dep->m_matls);
+    }
+  }
+
+  // swaps the (reference counted) patch or material subset of a DetailedTask
+  template <class Subset>
+  void replaceSubset( const Subset *& subset, const Subset * new_subset )
+  {
+    if (new_subset) {
+      new_subset->addReference();
+    }
+    if (subset && subset->removeReference()) {
+      delete subset;
+    }
+    subset = new_subset;
+  }
+
+  using DependencyMap = std::map<Task::Dependency*, Task::Dependency*>;
+
+  // pairs up the dependencies of two equivalent dependency lists
+  bool mapDependencies( Task::Dependency * old_dep
+                      , Task::Dependency * new_dep
+                      , DependencyMap    & dep_map
+                      )
+  {
+    for (; old_dep != nullptr && new_dep != nullptr; old_dep = old_dep->m_next, new_dep = new_dep->m_next) {
+      if (old_dep->m_var != new_dep->m_var || old_dep->m_dep_type != new_dep->m_dep_type) {
+        return false;
+      }
+      dep_map[old_dep] = new_dep;
+    }
+    return (old_dep == nullptr && new_dep == nullptr);
+  }
+
+  // points the DetailedDeps of a batch list at the paired dependencies
+  void rebindDependencies(       DependencyBatch * batch
+                         , const DependencyMap   & dep_map
+                         )
+  {
+    for (; batch != nullptr; batch = batch->m_comp_next) {
+      for (DetailedDep* dep = batch->m_head; dep != nullptr; dep = dep->m_next) {
+        auto comp = dep_map.find(dep->m_comp);
+        if (comp != dep_map.end()) {
+          dep->m_comp = comp->second;
+        }
+        auto req = dep_map.find(dep->m_req);
+        if (req != dep_map.end()) {
+          dep->m_req = req->second;
+        }
+      }
+    }
+  }
 
 }
 
@@ -198,11 +313,12 @@ TaskGraph::createDetailedTask(       Task           * task
 //______________________________________________________________________
 //
 
-DetailedTasks*
-TaskGraph::createDetailedTasks(       bool    useInternalDeps
-                              , const GridP & grid
-                              , const GridP & oldGrid
-                              , const bool    hasDistalReqs /* = false */
+void
+TaskGraph::selectDetailedTasks( const GridP                         & grid
+                              , const GridP                         & oldGrid
+                              ,       bool                            hasDistalReqs
+                              ,       std::vector<DetailedTaskSpec> & specs
+                              ,       std::unordered_set<int>       & neighborhood_procs
                               )
 {
   std::vector<Task*> sorted_tasks;
@@ -240,7 +356,7 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
   const std::unordered_set<int> local_procs  = m_load_balancer->getNeighborhoodProcessors();
   const std::unordered_set<int> distal_procs = m_load_balancer->getDistalNeighborhoodProcessors();
 
-  m_detailed_tasks = scinew DetailedTasks(m_scheduler, m_proc_group, this, (hasDistalReqs ? distal_procs : local_procs), useInternalDeps );
+  neighborhood_procs = (hasDistalReqs ? distal_procs : local_procs);
  
   // Go through every task, find the max ghost cell associated with each varlabel/matl, and remember that.
   //
@@ -512,7 +628,7 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
           const PatchSubset* pss = ps->getSubset(*p);
           for (int m = 0; m < ms->size(); m++) {
             const MaterialSubset* mss = ms->getSubset(m);
-            createDetailedTask(task, pss, mss);
+            specs.push_back({task, pss, mss, *p, m});
             ++num_detailed_tasks;
             ++tot_opp_tasks;
           }
@@ -529,7 +645,7 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
         if (pss->size() > 0) {
           for (auto m = 0; m < ms->size(); m++) {
             const MaterialSubset* mss = ms->getSubset(m);
-            createDetailedTask(task, pss, mss);
+            specs.push_back({task, pss, mss, handling_rank, m});
             ++num_detailed_tasks;
             ++tot_output_tasks;
           }
@@ -570,7 +686,7 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
               DOUT(g_proc_neighborhood_dbg, "Yes, it was in the neighborhood");
               for (int m = 0; m < ms->size(); m++) {
                 const MaterialSubset* mss = ms->getSubset(m);
-                createDetailedTask(task, pss, mss);
+                specs.push_back({task, pss, mss, ps_index, m});
                 ++num_detailed_tasks;
                 ++tot_normal_tasks;
               }
@@ -588,7 +704,7 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
 
     // these tasks would be, e.g. DataArchiver::outputReductionVars or DataArchiver::outputVariables (CheckpointReduction)
     else if (!ps && !ms) {
-      createDetailedTask(task, nullptr, nullptr);
+      specs.push_back({task, nullptr, nullptr, -1, -1});
       ++num_detailed_tasks;
       ++tot_output_tasks;
     }
@@ -598,7 +714,7 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
       if (task->getType() == Task::Reduction) {
         for (int m = 0; m < ms->size(); m++) {
           const MaterialSubset* mss = ms->getSubset(m);
-          createDetailedTask(task, nullptr, mss);
+          specs.push_back({task, nullptr, mss, -1, m});
           ++num_detailed_tasks;
           ++tot_reduction_tasks;
         }
@@ -617,6 +733,27 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
                                       << "\t" << tot_opp_tasks        << " total OncePerProc tasks\n"
                                       << "\t" << tot_output_tasks     << " total      Output tasks\n"
                                       << "\t" << tot_reduction_tasks  << " total   Reduction tasks\n");
+}
+
+//______________________________________________________________________
+//
+
+DetailedTasks*
+TaskGraph::createDetailedTasks(       bool    useInternalDeps
+                              , const GridP & grid
+                              , const GridP & oldGrid
+                              , const bool    hasDistalReqs /* = false */
+                              )
+{
+  std::vector<DetailedTaskSpec> specs;
+  std::unordered_set<int> neighborhood_procs;
+  selectDetailedTasks(grid, oldGrid, hasDistalReqs, specs, neighborhood_procs);
+
+  m_detailed_tasks = scinew DetailedTasks(m_scheduler, m_proc_group, this, neighborhood_procs, useInternalDeps );
+
+  for (auto iter = specs.begin(); iter != specs.end(); ++iter) {
+    createDetailedTask(iter->m_task, iter->m_patches, iter->m_matls);
+  }
 
   m_load_balancer->assignResources(*m_detailed_tasks);
 
@@ -642,7 +779,7 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
 //______________________________________________________________________
 //
 void
-TaskGraph::createDetailedDependencies()
+TaskGraph::createDetailedDependencies( const std::unordered_set<DetailedTask*> * recompiled /* = nullptr */ )
 {
   int my_rank = m_proc_group->myRank();
 
@@ -701,6 +838,10 @@ TaskGraph::createDetailedDependencies()
   for (int i = 0; i < m_detailed_tasks->numTasks(); i++) {
     DetailedTask* dtask = m_detailed_tasks->getTask(i);
 
+    if (recompiled && recompiled->find(dtask) == recompiled->end()) {
+      continue;
+    }
+
     // debug
     if (g_detailed_deps_dbg && (dtask->m_task->getRequires() != nullptr)) {
       DOUT(true, "Rank-" << my_rank << " Looking at requires of detailed task: " << *dtask);
@@ -1178,6 +1319,11 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
                   if (prevReqTask == dtask) {
                     continue;
                   }
+                  // when only some tasks are recompiled, the tasks compiled after this one already
+                  // require the variable, which they would not in a full compile
+                  if (!m_update_order.empty() && m_update_order.at(prevReqTask) > m_update_order.at(dtask)) {
+                    continue;
+                  }
                   if (prevReqTask->m_task == dtask->m_task) {
                     if (!dtask->m_task->getHasSubScheduler()) {
                     
@@ -1375,6 +1521,471 @@ TaskGraph::getTask( int idx )
   return m_tasks[idx].get();
 }
 
+//______________________________________________________________________
+//
+size_t
+TaskGraph::computeSignature( const GridP & grid
+                           , const GridP & oldGrid
+                           ,       bool    useInternalDeps
+                           )
+{
+  size_t seed = 0;
+
+  hashCombine(seed, m_type);
+  hashCombine(seed, m_index);
+  hashCombine(seed, useInternalDeps);
+  hashCombine(seed, m_has_distal_requires);
+
+  // task set, the patch sets are left to the DetailedTasks they make (see planUpdate())
+  hashCombine(seed, m_tasks.size());
+  for (auto& task : m_tasks) {
+    hashCombine(seed, std::hash<std::string>()(task->getName()));
+    hashCombine(seed, task->getType());
+    hashCombine(seed, task->usesMPI());
+    hashCombine(seed, task->usesDevice());
+
+    for (int dw = 0; dw < Task::TotalDWs; ++dw) {
+      hashCombine(seed, task->mapDataWarehouse(static_cast<Task::WhichDW>(dw)));
+    }
+
+    hashCombine(seed, task->getPatchSet() != nullptr);
+
+    const MaterialSet* ms = task->getMaterialSet();
+    hashCombine(seed, ms ? ms->size() : -1);
+    if (ms) {
+      for (int i = 0; i < ms->size(); ++i) {
+        hashMaterialSubset(seed, ms->getSubset(i));
+      }
+    }
+
+    hashDependencies(seed, task->getRequires());
+    hashDependencies(seed, task->getComputes());
+    hashDependencies(seed, task->getModifies());
+  }
+
+  // level and patch extents and the load balancer's current and previous assignment
+  m_level_signatures.clear();
+  for (int l = 0; l < grid->numLevels(); ++l) {
+    const LevelP level = grid->getLevel(l);
+    size_t level_seed = 0;
+    hashCombine(level_seed, level->numPatches());
+    hashIntVector(level_seed, level->getRefinementRatio());
+    hashIntVector(level_seed, level->getExtraCells());
+    hashIntVector(level_seed, level->getPeriodicBoundaries());
+    for (int p = 0; p < level->numPatches(); ++p) {
+      const Patch* patch = level->getPatch(p);
+      hashIntVector(level_seed, patch->getCellLowIndex());
+      hashIntVector(level_seed, patch->getCellHighIndex());
+      hashIntVector(level_seed, patch->getExtraCellLowIndex());
+      hashIntVector(level_seed, patch->getExtraCellHighIndex());
+      hashCombine(level_seed, m_load_balancer->getPatchwiseProcessorAssignment(patch));
+      hashCombine(level_seed, m_load_balancer->getOldProcessorAssignment(patch));
+    }
+    m_level_signatures.push_back(level_seed);
+  }
+
+  m_signature          = seed;
+  m_signature_grid     = grid;
+  m_signature_old_grid = oldGrid;
+
+  return m_signature;
+}
+
+//______________________________________________________________________
+//
+int
+TaskGraph::numUnchangedLevels( const TaskGraph * tg ) const
+{
+  if (m_level_signatures.size() != tg->m_level_signatures.size()) {
+    return -1;
+  }
+
+  int num_unchanged = 0;
+  for (size_t l = 0; l < m_level_signatures.size(); ++l) {
+    if (m_level_signatures[l] == tg->m_level_signatures[l]) {
+      ++num_unchanged;
+    }
+  }
+  return num_unchanged;
+}
+
+//______________________________________________________________________
+//
+bool
+TaskGraph::reachesChangedLevel( const Task              * task
+                              , const PatchSubset       * patches
+                              , const std::vector<bool> & changed_levels
+                              ,       bool                copies_data
+                              )
+{
+  const int num_levels = changed_levels.size();
+
+  std::set<int> levels;
+  if (patches) {
+    for (int p = 0; p < patches->size(); ++p) {
+      levels.insert(patches->get(p)->getLevel()->getIndex());
+    }
+  }
+
+  for (int pass = 0; pass < 2; ++pass) {
+    const Task::Dependency* dep = (pass == 0) ? task->getRequires() : task->getModifies();
+    for (; dep != nullptr; dep = dep->m_next) {
+      if (m_scheduler->isOldDW(dep->mapDataWarehouse()) && !m_scheduler->isNewDW(dep->mapDataWarehouse() + 1)) {
+        continue;
+      }
+
+      // reductions combine the computes on every level, explicit patches are not tracked
+      const TypeDescription::Type vartype = dep->m_var->typeDescription()->getType();
+      if ((vartype == TypeDescription::ReductionVariable || vartype == TypeDescription::SoleVariable) && m_scheduler->isNewDW(dep->mapDataWarehouse())) {
+        return true;
+      }
+      if (dep->m_patches != nullptr || (dep->m_patches_dom == Task::OtherGridDomain && copies_data)) {
+        return true;
+      }
+
+      for (auto level = levels.begin(); level != levels.end(); ++level) {
+        int low  = *level;
+        int high = *level;
+        if (dep->m_patches_dom == Task::CoarseLevel) {
+          low -= dep->m_level_offset;
+        }
+        else if (dep->m_patches_dom == Task::FineLevel) {
+          high += dep->m_level_offset;
+        }
+        for (int l = std::max(low, 0); l <= std::min(high, num_levels - 1); ++l) {
+          if (changed_levels[l]) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+//______________________________________________________________________
+//
+// The DetailedTasks of this TaskGraph are matched with the ones tg would create by task,
+// material subset and patches (mapped to the new grid).  A matched DetailedTask is kept
+// as is, with the DetailedDeps it requires, unless it has to be recompiled:
+//   - its dependencies reach a changed level (see reachesChangedLevel()),
+//   - it requires something from a DetailedTask that goes away, or
+//   - it modifies a variable (and level) that a new or recompiled DetailedTask requires,
+//     which may add requires-before-modifies dependencies.
+// Recompiling only adds the DetailedDeps of those tasks, in the order a full compile
+// would, so the batches of the kept tasks hold the same DetailedDeps on both ranks.
+struct TaskGraph::UpdatePlan {
+  TaskGraph                                     * m_tg{nullptr};
+  std::vector<DetailedTaskSpec>                   m_specs{};
+  std::vector<DetailedTask*>                      m_kept{};        // per spec, nullptr for a new DetailedTask
+  std::unordered_set<DetailedTask*>               m_recompiled{};  // kept, but recompiled
+  std::vector<DetailedTask*>                      m_removed{};
+  std::unordered_set<int>                         m_neighborhood_procs{};
+  std::unordered_map<const Patch*, const Patch*>  m_patch_map{};
+  DependencyMap                                   m_dep_map{};
+};
+
+//______________________________________________________________________
+//
+bool
+TaskGraph::planUpdate(       TaskGraph * tg
+                     , const GridP     & grid
+                     , const GridP     & oldGrid
+                     ,       bool        hasDistalReqs
+                     )
+{
+  m_update_plan.reset();
+
+  const size_t num_tasks = m_tasks.size();
+  if (m_detailed_tasks == nullptr || tg->m_tasks.size() != num_tasks || numUnchangedLevels(tg) < 0) {
+    return false;
+  }
+
+  std::unique_ptr<UpdatePlan> plan(new UpdatePlan);
+  plan->m_tg = tg;
+
+  // pair up the old and new tasks and their dependencies
+  std::unordered_map<const Task*, int> task_index;
+  for (size_t i = 0; i < num_tasks; ++i) {
+    Task* old_task = m_tasks[i].get();
+    Task* new_task = tg->m_tasks[i].get();
+    if (old_task->getName() != new_task->getName()                                          ||
+        !mapDependencies(old_task->getComputes(), new_task->getComputes(), plan->m_dep_map) ||
+        !mapDependencies(old_task->getRequires(), new_task->getRequires(), plan->m_dep_map) ||
+        !mapDependencies(old_task->getModifies(), new_task->getModifies(), plan->m_dep_map)) {
+      return false;
+    }
+    task_index[old_task] = i;
+    task_index[new_task] = i;
+  }
+
+  // the patches of the unchanged levels, position by position
+  const int num_levels = grid->numLevels();
+  std::vector<bool> changed_levels(num_levels, false);
+  for (int l = 0; l < num_levels; ++l) {
+    const LevelP old_level = m_signature_grid->getLevel(l);
+    const LevelP new_level = grid->getLevel(l);
+    changed_levels[l] = (m_level_signatures[l] != tg->m_level_signatures[l] || old_level->numPatches() != new_level->numPatches());
+    for (int p = 0; !changed_levels[l] && p < new_level->numPatches(); ++p) {
+      if (!sameExtents(old_level->getPatch(p), new_level->getPatch(p))) {
+        changed_levels[l] = true;
+      }
+    }
+    for (int p = 0; !changed_levels[l] && p < new_level->numPatches(); ++p) {
+      plan->m_patch_map[old_level->getPatch(p)] = new_level->getPatch(p);
+    }
+  }
+  const bool any_changed = std::find(changed_levels.begin(), changed_levels.end(), true) != changed_levels.end();
+  const bool copies_data = (oldGrid != nullptr && oldGrid.get_rep() != grid.get_rep()) ||
+                           (m_signature_old_grid != nullptr && m_signature_old_grid.get_rep() != m_signature_grid.get_rep());
+
+  // CUDA internal batches are not tracked
+  for (int i = 0; i < m_detailed_tasks->numTasks(); ++i) {
+    if (m_detailed_tasks->getTask(i)->getInternalComputes() != nullptr) {
+      return false;
+    }
+  }
+
+  // what tg would create
+  tg->selectDetailedTasks(grid, oldGrid, hasDistalReqs, plan->m_specs, plan->m_neighborhood_procs);
+
+  // look up the existing DetailedTasks by task, subset indices (only meaningful for the
+  // per-processor subsets, the others are matched by their patches) and mapped patches
+  using Key = std::tuple<int, int, int, std::vector<const Patch*> >;
+  auto subset_key = []( const Task * task, int patch_subset ) {
+    const Task::TaskType type = task->getType();
+    return (type == Task::OncePerProc || type == Task::Hypre || type == Task::Output) ? patch_subset : -1;
+  };
+
+  std::map<Key, DetailedTask*> existing;
+  std::unordered_set<DetailedTask*> unmatched;
+  for (int i = 0; i < m_detailed_tasks->numTasks(); ++i) {
+    DetailedTask* dtask = m_detailed_tasks->getTask(i);
+    auto task = task_index.find(dtask->m_task);
+    if (task == task_index.end()) {
+      continue;  // send_old_data
+    }
+    unmatched.insert(dtask);
+
+    const PatchSet* ps = dtask->m_task->getPatchSet();
+    int patch_subset = -1;
+    for (int s = 0; ps && dtask->m_patches && s < ps->size(); ++s) {
+      if (ps->getSubset(s) == dtask->m_patches) {
+        patch_subset = s;
+        break;
+      }
+    }
+    const MaterialSet* ms = dtask->m_task->getMaterialSet();
+    int matl_subset = -1;
+    for (int s = 0; ms && dtask->m_matls && s < ms->size(); ++s) {
+      if (ms->getSubset(s) == dtask->m_matls) {
+        matl_subset = s;
+        break;
+      }
+    }
+
+    std::vector<const Patch*> patches;
+    bool mapped = true;
+    for (int p = 0; dtask->m_patches && p < dtask->m_patches->size(); ++p) {
+      auto patch = plan->m_patch_map.find(dtask->m_patches->get(p));
+      if (patch == plan->m_patch_map.end()) {
+        mapped = false;
+        break;
+      }
+      patches.push_back(patch->second);
+    }
+    if (mapped) {
+      existing[Key(task->second, subset_key(dtask->m_task, patch_subset), matl_subset, patches)] = dtask;
+    }
+  }
+
+  plan->m_kept.resize(plan->m_specs.size(), nullptr);
+  for (size_t i = 0; i < plan->m_specs.size(); ++i) {
+    const DetailedTaskSpec& spec = plan->m_specs[i];
+    std::vector<const Patch*> patches;
+    if (spec.m_patches) {
+      patches.assign(spec.m_patches->getVector().begin(), spec.m_patches->getVector().end());
+    }
+    auto match = existing.find(Key(task_index[spec.m_task], subset_key(spec.m_task, spec.m_patch_subset), spec.m_matl_subset, patches));
+    if (match != existing.end() && unmatched.erase(match->second)) {
+      plan->m_kept[i] = match->second;
+      if (any_changed && reachesChangedLevel(spec.m_task, spec.m_patches, changed_levels, copies_data)) {
+        plan->m_recompiled.insert(match->second);
+      }
+    }
+  }
+  plan->m_removed.assign(unmatched.begin(), unmatched.end());
+
+  // the kept DetailedTasks that require something from a removed one are recompiled.  One
+  // on an unchanged level was removed because it left this rank's neighborhood, which the
+  // neighboring ranks do not know about, so it must not matter to a kept one.
+  std::unordered_set<DetailedTask*> removed(plan->m_removed.begin(), plan->m_removed.end());
+  std::unordered_set<DetailedTask*> left_neighborhood;
+  for (auto iter = plan->m_removed.begin(); iter != plan->m_removed.end(); ++iter) {
+    bool on_unchanged_levels = true;
+    for (int p = 0; (*iter)->m_patches && p < (*iter)->m_patches->size(); ++p) {
+      on_unchanged_levels = on_unchanged_levels && (plan->m_patch_map.count((*iter)->m_patches->get(p)) > 0);
+    }
+    if (on_unchanged_levels) {
+      left_neighborhood.insert(*iter);
+    }
+  }
+
+  auto removeRequirement = [&]( DetailedTask * from, DetailedTask * to ) {
+    if (removed.count(from) > 0 && removed.count(to) == 0) {
+      plan->m_recompiled.insert(to);
+      return (left_neighborhood.count(from) == 0);
+    }
+    return (left_neighborhood.count(to) == 0 || removed.count(from) > 0);
+  };
+
+  for (int i = 0; i < m_detailed_tasks->numTasks(); ++i) {
+    DetailedTask* dtask = m_detailed_tasks->getTask(i);
+    for (DependencyBatch* batch = dtask->getComputes(); batch != nullptr; batch = batch->m_comp_next) {
+      for (DetailedDep* dep = batch->m_head; dep != nullptr; dep = dep->m_next) {
+        for (auto to = dep->m_to_tasks.begin(); to != dep->m_to_tasks.end(); ++to) {
+          if (!removeRequirement(dtask, *to)) {
+            return false;
+          }
+        }
+      }
+    }
+    for (auto dep = dtask->m_internal_dependents.begin(); dep != dtask->m_internal_dependents.end(); ++dep) {
+      if (!removeRequirement(dtask, dep->first)) {
+        return false;
+      }
+    }
+  }
+
+  // the variables (and levels) the new and recompiled DetailedTasks require, a kept task
+  // modifying one of them gets recompiled for the requires-before-modifies dependencies
+  using VarLevel = std::pair<std::string, int>;
+  auto forEachVarLevel = [&]( const DetailedTaskSpec & spec, const Task::Dependency * dep, const std::function<void(const VarLevel &)> & f ) {
+    for (; dep != nullptr; dep = dep->m_next) {
+      for (int p = 0; spec.m_patches && p < spec.m_patches->size(); ++p) {
+        int level = spec.m_patches->get(p)->getLevel()->getIndex();
+        if (dep->m_patches_dom == Task::CoarseLevel) {
+          level -= dep->m_level_offset;
+        }
+        else if (dep->m_patches_dom == Task::FineLevel) {
+          level += dep->m_level_offset;
+        }
+        f(VarLevel(dep->m_var->getName(), level));
+      }
+    }
+  };
+
+  std::set<VarLevel> required;
+  auto require = [&required]( const VarLevel & var_level ) { required.insert(var_level); };
+  for (size_t i = 0; i < plan->m_specs.size(); ++i) {
+    if (plan->m_kept[i] == nullptr || plan->m_recompiled.count(plan->m_kept[i]) > 0) {
+      forEachVarLevel(plan->m_specs[i], plan->m_specs[i].m_task->getRequires(), require);
+      forEachVarLevel(plan->m_specs[i], plan->m_specs[i].m_task->getModifies(), require);
+    }
+  }
+  for (size_t i = 0; i < plan->m_specs.size(); ++i) {
+    DetailedTask* dtask = plan->m_kept[i];
+    if (dtask != nullptr && plan->m_recompiled.count(dtask) == 0) {
+      forEachVarLevel(plan->m_specs[i], plan->m_specs[i].m_task->getModifies(), [&]( const VarLevel & var_level ) {
+        if (required.count(var_level) > 0) {
+          plan->m_recompiled.insert(dtask);
+        }
+      });
+    }
+  }
+
+  DOUT(g_task_graph_update_dbg, "Rank-" << m_proc_group->myRank() << " TG[" << m_index << "] update plan: "
+                                        << std::count(changed_levels.begin(), changed_levels.end(), true) << " of " << num_levels << " levels changed, "
+                                        << plan->m_specs.size() << " DetailedTasks, "
+                                        << std::count(plan->m_kept.begin(), plan->m_kept.end(), nullptr) << " new, "
+                                        << plan->m_recompiled.size() << " recompiled, "
+                                        << plan->m_removed.size() << " removed");
+
+  m_update_plan = std::move(plan);
+  return true;
+}
+
+//______________________________________________________________________
+//
+void
+TaskGraph::cancelUpdate()
+{
+  m_update_plan.reset();
+}
+
+//______________________________________________________________________
+//
+void
+TaskGraph::updateDetailedTasks( TaskGraph * tg )
+{
+  ASSERT(m_update_plan != nullptr && m_update_plan->m_tg == tg);
+  std::unique_ptr<UpdatePlan> plan = std::move(m_update_plan);
+
+  std::unordered_set<DetailedTask*> recompiled(plan->m_recompiled);
+  recompiled.insert(plan->m_removed.begin(), plan->m_removed.end());
+  m_detailed_tasks->removeDependencies(recompiled);
+  m_detailed_tasks->remapPatches(plan->m_patch_map);
+
+  for (auto iter = plan->m_removed.begin(); iter != plan->m_removed.end(); ++iter) {
+    recompiled.erase(*iter);
+  }
+
+  // the kept DetailedTasks move over to tg's tasks and subsets, in the order tg would create them
+  std::vector<DetailedTask*> dtasks;
+  for (size_t i = 0; i < plan->m_specs.size(); ++i) {
+    const DetailedTaskSpec& spec = plan->m_specs[i];
+    DetailedTask* dtask = plan->m_kept[i];
+    if (dtask == nullptr) {
+      dtask = scinew DetailedTask(spec.m_task, spec.m_patches, spec.m_matls, m_detailed_tasks);
+      recompiled.insert(dtask);
+    }
+    else {
+      dtask->m_task = spec.m_task;
+      replaceSubset(dtask->m_patches, spec.m_patches);
+      replaceSubset(dtask->m_matls, spec.m_matls);
+      dtask->m_name.clear();
+    }
+    dtasks.push_back(dtask);
+  }
+  m_detailed_tasks->replaceTasks(dtasks, plan->m_neighborhood_procs);
+
+  for (auto iter = plan->m_removed.begin(); iter != plan->m_removed.end(); ++iter) {
+    delete *iter;
+  }
+
+  for (int i = 0; i < m_detailed_tasks->numTasks(); ++i) {
+    rebindDependencies(m_detailed_tasks->getTask(i)->m_comp_head, plan->m_dep_map);
+  }
+
+  m_load_balancer->assignResources(*m_detailed_tasks);
+
+  // recompile in the order of a full compile
+  for (int i = 0; i < m_detailed_tasks->numTasks(); ++i) {
+    m_update_order[m_detailed_tasks->getTask(i)] = i;
+  }
+  createDetailedDependencies(&recompiled);
+  m_update_order.clear();
+
+  m_detailed_tasks->rebuildFromDependencies();
+
+  if (m_proc_group->nRanks() > 1) {
+    m_detailed_tasks->assignMessageTags( m_index );
+  }
+
+  // nothing references the old tasks anymore
+  m_tasks.swap(tg->m_tasks);
+
+  m_signature          = tg->m_signature;
+  m_level_signatures   = tg->m_level_signatures;
+  m_signature_grid     = tg->m_signature_grid;
+  m_signature_old_grid = tg->m_signature_old_grid;
+
+  m_current_iteration = 0;
+
+  DOUT(g_task_graph_update_dbg, "Rank-" << m_proc_group->myRank() << " TG[" << m_index << "] updated: "
+                                        << recompiled.size() << " of " << m_detailed_tasks->numTasks() << " DetailedTasks compiled");
+}
+
 //______________________________________________________________________
 //
 void
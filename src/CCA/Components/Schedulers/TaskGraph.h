@@ -34,6 +34,8 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Uintah {
@@ -214,6 +216,55 @@ class TaskGraph {
                                       , const bool    hasDistalReqs = false
                                       );
 
+    /// Computes the signatures of this (uncompiled) TaskGraph: one of the
+    /// scheduled tasks (names, types, material sets, requires/computes/modifies
+    /// and DW mappings, but not the patches, which change with the grid) and
+    /// one of each grid level (its patch layout and the load balancer's
+    /// current and previous patch assignment).
+    size_t computeSignature( const GridP & grid
+                           , const GridP & oldGrid
+                           ,       bool    useInternalDeps
+                           );
+
+    inline size_t getSignature() const
+    {
+      return m_signature;
+    }
+
+    /// Number of grid levels that have the same signature in tg as in this
+    /// TaskGraph, or -1 if the number of levels differs.
+    int numUnchangedLevels( const TaskGraph * tg ) const;
+
+    /// Plans reusing the DetailedTasks of this compiled TaskGraph for tg, an
+    /// uncompiled TaskGraph with the same task signature: the DetailedTasks
+    /// on the unchanged levels are kept, those whose dependencies reach a
+    /// changed level are recompiled and the rest are created.  Returns false
+    /// if this rank cannot do so.  The DetailedDeps (and message tags) of
+    /// neighboring ranks have to match, so all ranks must succeed before any
+    /// calls updateDetailedTasks(), otherwise tg is compiled from scratch.
+    bool planUpdate(       TaskGraph * tg
+                   , const GridP     & grid
+                   , const GridP     & oldGrid
+                   ,       bool        hasDistalReqs
+                   );
+
+    /// Carries out the plan made by planUpdate() and takes ownership of the
+    /// tasks of tg, leaving this TaskGraph compiled for them.
+    void updateDetailedTasks( TaskGraph * tg );
+
+    /// Drops the plan made by planUpdate().
+    void cancelUpdate();
+
+    inline void setCompileTime( double seconds )
+    {
+      m_compile_time = seconds;
+    }
+
+    inline double getCompileTime() const
+    {
+      return m_compile_time;
+    }
+
     inline DetailedTasks* getDetailedTasks()
     {
       return m_detailed_tasks;
@@ -232,8 +283,9 @@ class TaskGraph {
     /// This will go through the detailed tasks and create the
     /// dependencies needed to communicate data across separate
     /// processors.  Calls the private createDetailedDependencies
-    /// for each task as a helper.
-    void createDetailedDependencies();
+    /// for each task as a helper.  If recompiled is given, only
+    /// the dependencies of those tasks are created.
+    void createDetailedDependencies( const std::unordered_set<DetailedTask*> * recompiled = nullptr );
 
     /// Connects the tasks, but does not sort them.
     /// This routine has the side effect (just like the topological sort)
@@ -315,6 +367,34 @@ class TaskGraph {
                            , const MaterialSubset * matls
                            );
 
+    /// A DetailedTask to be created, with the indices of its patch and
+    /// material subsets in the task's sets (-1 if it has none).
+    struct DetailedTaskSpec {
+      Task                 * m_task;
+      const PatchSubset    * m_patches;
+      const MaterialSubset * m_matls;
+      int                    m_patch_subset;
+      int                    m_matl_subset;
+    };
+
+    /// Sorts the tasks, creates the neighborhoods and selects the DetailedTasks
+    /// within them, in the order createDetailedTasks() creates them.  Also
+    /// returns the processors that get a send_old_data task.
+    void selectDetailedTasks( const GridP                         & grid
+                            , const GridP                         & oldGrid
+                            ,       bool                            hasDistalReqs
+                            ,       std::vector<DetailedTaskSpec> & specs
+                            ,       std::unordered_set<int>       & neighborhood_procs
+                            );
+
+    /// True if a DetailedTask of task on patches has dependencies that reach
+    /// one of the changed levels.
+    bool reachesChangedLevel( const Task              * task
+                            , const PatchSubset       * patches
+                            , const std::vector<bool> & changed_levels
+                            ,       bool                copies_data
+                            );
+
     /// Find the processor that a variable (req) is on given patch and material.
     int findVariableLocation(       Task::Dependency * req
                             , const Patch            * patch
@@ -366,6 +446,24 @@ class TaskGraph {
 
     std::vector<std::shared_ptr<Task> > m_tasks{};
 
+    // signatures of the tasks and of the patch layout and patch assignment of each level
+    // this TG was compiled for, and the grids they were computed against (also keeping
+    // the patches the DetailedTasks point to alive while the TG is cached)
+    size_t              m_signature{0};
+    std::vector<size_t> m_level_signatures{};
+    GridP               m_signature_grid{nullptr};
+    GridP               m_signature_old_grid{nullptr};
+
+    // what updateDetailedTasks() does, see planUpdate()
+    struct UpdatePlan;
+    std::unique_ptr<UpdatePlan> m_update_plan{};
+
+    // compile order of the DetailedTasks while updateDetailedTasks() runs
+    std::unordered_map<const DetailedTask*, int> m_update_order{};
+
+    // time spent in createDetailedTasks for this TG
+    double m_compile_time{0.0};
+
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //
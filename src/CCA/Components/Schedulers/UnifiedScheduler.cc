@@ -372,10 +372,16 @@ UnifiedScheduler::problemSetup( const ProblemSpecP     & prob_spec
     else {
       throw ProblemSetupException("Unknown task ready queue algorithm", __FILE__, __LINE__);
     }
+
+    params->getWithDefault("work_stealing", m_use_work_stealing, false);
   }
 
   proc0cout << "Using \"" << taskQueueAlg << "\" task queue priority algorithm" << std::endl;
 
+  if (m_use_work_stealing) {
+    proc0cout << "Using per-thread task queues with work stealing" << std::endl;
+  }
+
   int num_threads = Uintah::Parallel::getNumThreads() - 1;
 
   if ( (num_threads < 1) &&  Uintah::Parallel::usingDevice() ) {
@@ -485,6 +491,7 @@ UnifiedScheduler::problemSetup( const ProblemSpecP     & prob_spec
     m_thread_info.insert( Affinity  , std::string("Affinity")  , "CPU"     );
     m_thread_info.insert( NumTasks  , std::string("NumTasks")  , "tasks"   );
     m_thread_info.insert( NumPatches, std::string("NumPatches"), "patches" );
+    m_thread_info.insert( NumStolen , std::string("NumStolen") , "tasks"   );
 
     m_thread_info.calculateMinimum(true);
     m_thread_info.calculateStdDev (true);
@@ -519,6 +526,9 @@ UnifiedScheduler::runTask( DetailedTask        * dtask
       const PatchSubset *patches = dtask->getPatches();
       if (patches)
         m_thread_info[thread_id][NumPatches] += patches->size();
+
+      if (m_detailed_tasks->usingWorkStealing() && dtask->getHomeQueue() != thread_id)
+        m_thread_info[thread_id][NumStolen] += 1;
     }
   }
 
@@ -661,6 +671,9 @@ UnifiedScheduler::execute( int tgnum       /* = 0 */
                          , int iteration   /* = 0 */
                          )
 {
+  // done before the copy data timestep check, which must thaw the DWs' key databases
+  freezeDWKeyDatabases();
+
   // copy data timestep must be single threaded for now and
   //  also needs to run deterministically, in a static order
   if (m_is_copy_data_timestep) {
@@ -735,6 +748,7 @@ UnifiedScheduler::execute( int tgnum       /* = 0 */
   m_phase_sync_task.clear();
   m_phase_sync_task.resize(m_num_phases, nullptr);
   m_detailed_tasks->setTaskPriorityAlg(m_task_queue_alg);
+  m_detailed_tasks->setWorkStealing(m_use_work_stealing ? Impl::g_num_threads : 0);
 
   // get the number of tasks in each task phase
   for (int i = 0; i < m_num_tasks; i++) {
@@ -924,6 +938,9 @@ UnifiedScheduler::runTasks( int thread_id )
 
   while( m_num_tasks_done < m_num_tasks ) {
 
+    // covers the GPU copies as well as runTask() and the receives
+    DWReadEpoch::Guard read_epoch;
+
     DetailedTask* readyTask = nullptr;
     DetailedTask* initTask  = nullptr;
 
@@ -980,10 +997,13 @@ UnifiedScheduler::runTasks( int thread_id )
        * ready queue automatically when their receive count hits 0 in DependencyBatch::received,
        * which is called when a MPI message is delivered.
        *
+       * With <work_stealing> each thread pulls from its own queue first and steals from
+       * the other threads' queues when its own is empty.
+       *
        * NOTE: This is also where a GPU-enabled task gets into the GPU initially-ready queue
        *
        */
-      else if ((readyTask = m_detailed_tasks->getNextExternalReadyTask())) {
+      else if ((readyTask = m_detailed_tasks->getNextExternalReadyTask(thread_id))) {
         havework = true;
 #ifdef HAVE_CUDA
         /*
@@ -1027,7 +1047,7 @@ UnifiedScheduler::runTasks( int thread_id )
        * call to task->checkExternalDepCount().
        *
        */
-      else if ((initTask = m_detailed_tasks->getNextInternalReadyTask())) {
+      else if ((initTask = m_detailed_tasks->getNextInternalReadyTask(thread_id))) {
         if (initTask->getTask()->getType() == Task::Reduction || initTask->getTask()->usesMPI()) {
           DOUT(g_task_dbg, myRankThread() <<  " Task internal ready 1 " << *initTask);
           m_phase_sync_task[initTask->getTask()->m_phase] = initTask;
@@ -117,6 +117,7 @@ class UnifiedScheduler : public MPIScheduler  {
       , Affinity
       , NumTasks
       , NumPatches
+      , NumStolen
     };
     
     VectorInfoMapper< ThreadStatsEnum, double > m_thread_info;
@@ -145,6 +146,7 @@ class UnifiedScheduler : public MPIScheduler  {
     DetailedTasks              * m_detailed_tasks{nullptr};
 
     QueueAlg m_task_queue_alg{MostMessages};
+    bool     m_use_work_stealing{false};   // per-thread external-ready queues with stealing
     int      m_curr_iteration{0};
     int      m_num_tasks_done{0};
     int      m_num_tasks{0};
@@ -35,6 +35,7 @@ SRCS += \
         $(SRCDIR)/DetailedDependency.cc       \
         $(SRCDIR)/DetailedTask.cc             \
         $(SRCDIR)/DetailedTasks.cc            \
+        $(SRCDIR)/DWDatabase.cc               \
         $(SRCDIR)/DynamicMPIScheduler.cc      \
         $(SRCDIR)/KokkosOpenMPScheduler.cc    \
         $(SRCDIR)/MemoryLog.cc                \
@@ -125,6 +125,7 @@ SimulationController::SimulationController( const ProcessorGroup * myworld
   m_runtime_stats.insert( RegriddingCompilationTime, std::string("RegriddingCompilation"), timeStr );
   m_runtime_stats.insert( RegriddingCopyDataTime,    std::string("RegriddingCopyData"),    timeStr );
   m_runtime_stats.insert( LoadBalancerTime,          std::string("LoadBalancer"),          timeStr );
+  m_runtime_stats.insert( TaskGraphCacheSavedTime,   std::string("TaskGraphCacheSaved"),   timeStr );
 
   m_runtime_stats.insert( TaskExecTime,              std::string("TaskExec"),              timeStr );
   m_runtime_stats.insert( TaskLocalCommTime,         std::string("TaskLocalComm"),         timeStr );
@@ -24,6 +24,7 @@
 
 #include <CCA/Components/Solvers/CGSolver.h>
 #include <CCA/Components/Solvers/MatrixUtil.h>
+#include <CCA/Components/Solvers/Stencil7BlockMultigrid.h>
 #include <Core/Grid/Variables/CCVariable.h>
 #include <Core/Grid/Grid.h>
 #include <Core/Grid/Level.h>
@@ -38,7 +39,9 @@
 #include <Core/Grid/Variables/VarTypes.h>
 #include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/Exceptions/ConvergenceFailure.h>
+#include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/ProcessorGroup.h>
+#include <Core/Parallel/UintahMPI.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
 #include <CCA/Ports/LoadBalancer.h>
 #include <CCA/Ports/Scheduler.h>
@@ -46,7 +49,11 @@
 #include <Core/Math/MinMax.h>
 #include <Core/Util/DebugStream.h>
 #include <Core/Util/Timers/Timers.hpp>
+#include <atomic>
 #include <iomanip>
+#include <map>
+#include <mutex>
+#include <set>
 
 using namespace std;
 using namespace Uintah;
@@ -279,6 +286,14 @@ public:
 
     tolerance_label = VarLabel::create("tolerance", sum_vartype::getTypeDescription());
 
+    if(params->pipelined){
+      W_label  = VarLabel::create(A->getName()+" W", double_type::getTypeDescription());
+      Z_label  = VarLabel::create(A->getName()+" Z", double_type::getTypeDescription());
+      S_label  = VarLabel::create(A->getName()+" S", double_type::getTypeDescription());
+      P_label  = VarLabel::create(A->getName()+" P", double_type::getTypeDescription());
+      M_label  = VarLabel::create(A->getName()+" M", double_type::getTypeDescription());
+    }
+
     VarLabel* tmp_flop_label = VarLabel::create(A->getName()+" flops", sumlong_vartype::getTypeDescription());
     tmp_flop_label->allowMultipleComputes();
     flop_label = tmp_flop_label;
@@ -314,6 +329,60 @@ public:
       VarLabel::destroy(err_label);
     }
     VarLabel::destroy(aden_label);
+
+    if(params->pipelined){
+      VarLabel::destroy(W_label);
+      VarLabel::destroy(Z_label);
+      VarLabel::destroy(S_label);
+      VarLabel::destroy(P_label);
+      VarLabel::destroy(M_label);
+    }
+
+    for(auto iter = multigrids.begin(); iter != multigrids.end(); ++iter){
+      delete iter->second;
+    }
+  }
+
+//______________________________________________________________________
+//  Drop the preconditioners of patches that are no longer on the level,
+//  e.g. after a regrid, so the map does not keep growing
+  void pruneMultigrids(const Level* level)
+  {
+    std::set<int> patchIDs;
+    for(auto iter = level->patchesBegin(); iter != level->patchesEnd(); ++iter){
+      patchIDs.insert((*iter)->getID());
+    }
+
+    std::lock_guard<Uintah::MasterLock> lock(multigrids_lock);
+    for(auto iter = multigrids.begin(); iter != multigrids.end(); ){
+      if(patchIDs.count(iter->first.first) == 0){
+        delete iter->second;
+        iter = multigrids.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  Q = M^-1 R.  The block multigrid hierarchy of each patch is built in setup()
+  void precondition(const Patch* patch, int matl,
+                    Array3<double>& Q, const Array3<double>& R,
+                    const Array3<double>& diagonal, CellIterator iter,
+                    long64& flops, long64& memrefs)
+  {
+    if(params->precond == CGSolverParams::BlockMultigrid){
+      Stencil7BlockMultigrid* mg;
+      {
+        std::lock_guard<Uintah::MasterLock> lock(multigrids_lock);
+        mg = multigrids[std::make_pair(patch->getID(), matl)];
+      }
+      ASSERT(mg != nullptr);
+      mg->apply(Q, R, flops, memrefs);
+    } else {
+      // Simple Preconditioning...
+      ::Mult(Q, R, diagonal, iter, flops, memrefs);
+    }
   }
 //______________________________________________________________________
 //
@@ -439,8 +508,7 @@ public:
         // R = -a*Q+R
         ::ScMult_Add(Rnew, -a, Q, R, iter, flops, memrefs);
 
-        // Simple Preconditioning...
-        ::Mult(Q, Rnew, diagonal, iter, flops, memrefs);
+        precondition(patch, matl, Q, Rnew, diagonal, iter, flops, memrefs);
 
         // Calculate coefficient bk and direction vectors p and pp
         double dnew = ::Dot(Q, Rnew, iter, flops, memrefs);
@@ -534,6 +602,11 @@ public:
     DataWarehouse* A_dw = new_dw->getOtherDataWarehouse(parent_which_A_dw);
     DataWarehouse* b_dw = new_dw->getOtherDataWarehouse(parent_which_b_dw);
     DataWarehouse* guess_dw = new_dw->getOtherDataWarehouse(parent_which_guess_dw);
+
+    if(params->precond == CGSolverParams::BlockMultigrid && patches->size() > 0){
+      pruneMultigrids(patches->get(0)->getLevel());
+    }
+
     for(int p=0;p<patches->size();p++){
       const Patch* patch = patches->get(p);
       if(cout_doing.active())
@@ -599,7 +672,16 @@ public:
         new_dw->allocateAndPut(D, D_label, matl, patch);
 
         ::InverseDiagonal(diagonal, A, iter, flops, memrefs);
-        ::Mult(D, R, diagonal, iter, flops, memrefs);
+
+        if(params->precond == CGSolverParams::BlockMultigrid){
+          Stencil7BlockMultigrid* mg = scinew Stencil7BlockMultigrid(A, l, h, params->npre, params->npost);
+
+          std::lock_guard<Uintah::MasterLock> lock(multigrids_lock);
+          Stencil7BlockMultigrid*& entry = multigrids[std::make_pair(patch->getID(), matl)];
+          delete entry;
+          entry = mg;
+        }
+        precondition(patch, matl, D, R, diagonal, iter, flops, memrefs);
 
         double dnew = ::Dot(R, D, iter, flops, memrefs);
         new_dw->put(sum_vartype(dnew), d_label);
@@ -635,6 +717,338 @@ public:
     }
   }
 
+  //______________________________________________________________________
+  //  Pipelined CG (Ghysels & Vanroose).  Besides X and R it carries
+  //  U = M^-1 R (D_label), W = A U, M = M^-1 W, N = A M and the direction
+  //  recurrences Z, Q, S, P, so each pass needs a single reduction (gamma,
+  //  delta and the error) instead of two.  The reduction is a non-blocking
+  //  MPI_Iallreduce started by postGammaDelta() once a pass is done; the
+  //  next pass exchanges its ghost cells and computes N = A M, which does
+  //  not depend on it, and only then waits for it in waitGammaDelta().
+  void getRange(const Patch* patch, IntVector& l, IntVector& h,
+                IntVector& ll, IntVector& hh)
+  {
+    typedef typename GridVarType::double_type double_type;
+    Patch::VariableBasis basis = Patch::translateTypeToBasis(double_type::getTypeDescription()->getType(), true);
+
+    if(params->getSolveOnExtraCells())
+    {
+      l = patch->getExtraLowIndex(basis, IntVector(0,0,0));
+      h = patch->getExtraHighIndex(basis, IntVector(0,0,0));
+    }
+    else
+    {
+      l = patch->getLowIndex(basis);
+      h = patch->getHighIndex(basis);
+    }
+
+    ll = l;
+    hh = h;
+    ll -= IntVector(patch->getBCType(Patch::xminus) == Patch::Neighbor?1:0,
+                    patch->getBCType(Patch::yminus) == Patch::Neighbor?1:0,
+                    patch->getBCType(Patch::zminus) == Patch::Neighbor?1:0);
+
+    hh += IntVector(patch->getBCType(Patch::xplus) == Patch::Neighbor?1:0,
+                    patch->getBCType(Patch::yplus) == Patch::Neighbor?1:0,
+                    patch->getBCType(Patch::zplus) == Patch::Neighbor?1:0);
+    hh -= IntVector(1,1,1);
+  }
+
+  //______________________________________________________________________
+  //  Local gamma = (R,U), delta = (W,U) and the error of U for one patch
+  Vector localGammaDelta(const Array3<double>& R, const Array3<double>& U,
+                         const Array3<double>& W, CellIterator iter,
+                         long64& flops, long64& memrefs)
+  {
+    double gamma = 0;
+    double delta = 0;
+    double err   = 0;
+    for(; !iter.done(); ++iter){
+      IntVector idx = *iter;
+      gamma += R[idx]*U[idx];
+      delta += W[idx]*U[idx];
+      switch(params->norm){
+      case CGSolverParams::L1:
+        err += Abs(U[idx]);
+        break;
+      case CGSolverParams::LInfinity:
+        err = Max(err, Abs(U[idx]));
+        break;
+      default:
+        break;
+      }
+    }
+    IntVector diff = iter.end()-iter.begin();
+    flops += 6*diff.x()*diff.y()*diff.z();
+    memrefs += 3L*diff.x()*diff.y()*diff.z()*8L;
+    return Vector(gamma, delta, err);
+  }
+
+  //______________________________________________________________________
+  //  Adds the (gamma, delta, err) of one patch to the sums of this rank
+  void addGammaDelta(const Vector& gd)
+  {
+    std::lock_guard<Uintah::MasterLock> lock(pipe_lock);
+    pipe_local[0] += gd.x();
+    pipe_local[1] += gd.y();
+    if(params->norm == CGSolverParams::LInfinity){
+      pipe_local[2] = Max(pipe_local[2], gd.z());
+    } else {
+      pipe_local[2] += gd.z();
+    }
+  }
+
+  //______________________________________________________________________
+  //  Starts the global reduction of this rank's sums once a pass is done.
+  //  The next pass waits for it after its matrix-vector product.
+  void postGammaDelta()
+  {
+    MPI_Comm comm = world->getComm();
+    int status;
+    if(params->norm == CGSolverParams::LInfinity){
+      status = MPI_Iallreduce(pipe_local, pipe_global, 2, MPI_DOUBLE, MPI_SUM, comm, &pipe_requests[0]);
+      if(status == MPI_SUCCESS){
+        status = MPI_Iallreduce(&pipe_local[2], &pipe_global[2], 1, MPI_DOUBLE, MPI_MAX, comm, &pipe_requests[1]);
+      }
+    } else {
+      status = MPI_Iallreduce(pipe_local, pipe_global, 3, MPI_DOUBLE, MPI_SUM, comm, &pipe_requests[0]);
+    }
+    if(status != MPI_SUCCESS){
+      throw InternalError("CGSolver: MPI_Iallreduce failed", __FILE__, __LINE__);
+    }
+    pipe_reduced = false;
+  }
+
+  //______________________________________________________________________
+  //  Completes the reduction started by postGammaDelta() and turns it into
+  //  the convergence test and the CG scalars of this pass.  The first patch
+  //  to get here does the waiting, the others use its result.
+  void waitGammaDelta(double& alpha, double& beta, bool& converged)
+  {
+    std::lock_guard<Uintah::MasterLock> lock(pipe_lock);
+    if(!pipe_reduced){
+      Uintah::MPI::Waitall(2, pipe_requests, MPI_STATUSES_IGNORE);
+      pipe_reduced = true;
+      pipe_local[0] = pipe_local[1] = pipe_local[2] = 0;
+
+      const double gamma = pipe_global[0];
+      const double delta = pipe_global[1];
+
+      // the error of the first pass comes from setup
+      if(pipe_niter > 0){
+        pipe_e = (params->norm == CGSolverParams::L2) ? gamma : pipe_global[2];
+        if(params->criteria == CGSolverParams::Relative){
+          pipe_e /= pipe_err0;
+        }
+      }
+
+      pipe_converged = !(pipe_niter < params->maxiterations && !(pipe_e < pipe_tolerance));
+      if(pipe_converged){
+        pipe_alpha = 0;
+        pipe_beta  = 0;
+      } else {
+        pipe_niter++;
+        if(pipe_niter == 1){
+          pipe_beta  = 0;
+          pipe_alpha = gamma/delta;
+        } else {
+          pipe_beta  = gamma/pipe_gamma_old;
+          pipe_alpha = gamma/(delta - pipe_beta*gamma/pipe_alpha_old);
+        }
+        pipe_gamma_old = gamma;
+        pipe_alpha_old = pipe_alpha;
+      }
+    }
+    alpha     = pipe_alpha;
+    beta      = pipe_beta;
+    converged = pipe_converged;
+  }
+
+  //______________________________________________________________________
+  //  After setup: W = A U, M = M^-1 W, zero recurrences, local gamma and delta
+  void pipeSetup(const ProcessorGroup *,
+                 const PatchSubset    * patches,
+                 const MaterialSubset * matls,
+                 DataWarehouse        *,
+                 DataWarehouse        * new_dw)
+  {
+    DataWarehouse* A_dw = new_dw->getOtherDataWarehouse(parent_which_A_dw);
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      if(cout_doing.active())
+        cout_doing << "CGSolver::pipeSetup on patch " << patch->getID()<< endl;
+
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+
+        IntVector l, h, ll, hh;
+        getRange(patch, l, h, ll, hh);
+        CellIterator iter(l, h);
+
+        typename GridVarType::matrix_type A;
+        A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::const_double_type R, U, diagonal;
+        new_dw->get(R, R_label, matl, patch, Ghost::None, 0);
+        new_dw->get(U, D_label, matl, patch, Around, 1);
+        new_dw->get(diagonal, diag_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::double_type W, Mv, Z, Q, S, P;
+        new_dw->allocateAndPut(W,  W_label, matl, patch);
+        new_dw->allocateAndPut(Mv, M_label, matl, patch);
+        new_dw->allocateAndPut(Z,  Z_label, matl, patch);
+        new_dw->allocateAndPut(Q,  Q_label, matl, patch);
+        new_dw->allocateAndPut(S,  S_label, matl, patch);
+        new_dw->allocateAndPut(P,  P_label, matl, patch);
+        Z.initialize(0);
+        Q.initialize(0);
+        S.initialize(0);
+        P.initialize(0);
+
+        long64 flops = 0;
+        long64 memrefs = 0;
+
+        // W = A*U
+        ::Mult(W, A, U, iter, ll, hh, flops, memrefs);
+
+        // M = M^-1 W
+        precondition(patch, matl, Mv, W, diagonal, iter, flops, memrefs);
+
+        addGammaDelta(localGammaDelta(R, U, W, iter, flops, memrefs));
+
+        pipe_flops   += flops;
+        pipe_memrefs += memrefs;
+      }
+    }
+  }
+
+  //______________________________________________________________________
+  //  One fused pass: N = A*M (M's halo is the only exchange of a pass) while
+  //  the reduction of the last pass completes, then the recurrences with its
+  //  alpha and beta, M = M^-1 W and the local gamma, delta and error for the
+  //  next pass.  Once converged the pass only carries X over.
+  void pipeStep(const ProcessorGroup *,
+                const PatchSubset    * patches,
+                const MaterialSubset * matls,
+                DataWarehouse        * old_dw,
+                DataWarehouse        * new_dw)
+  {
+    DataWarehouse* A_dw = new_dw->getOtherDataWarehouse(parent_which_A_dw);
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      if(cout_doing.active())
+        cout_doing << "CGSolver::pipeStep on patch " << patch->getID()<< endl;
+
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+
+        IntVector l, h, ll, hh;
+        getRange(patch, l, h, ll, hh);
+        CellIterator iter(l, h);
+
+        typename GridVarType::matrix_type A;
+        A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::const_double_type X, R, U, W, Z, Q, S, P, Mv, diagonal;
+        old_dw->get(X,  X_label, matl, patch, Ghost::None, 0);
+        old_dw->get(R,  R_label, matl, patch, Ghost::None, 0);
+        old_dw->get(U,  D_label, matl, patch, Ghost::None, 0);
+        old_dw->get(W,  W_label, matl, patch, Ghost::None, 0);
+        old_dw->get(Z,  Z_label, matl, patch, Ghost::None, 0);
+        old_dw->get(Q,  Q_label, matl, patch, Ghost::None, 0);
+        old_dw->get(S,  S_label, matl, patch, Ghost::None, 0);
+        old_dw->get(P,  P_label, matl, patch, Ghost::None, 0);
+        old_dw->get(Mv, M_label, matl, patch, Around, 1);
+        old_dw->get(diagonal, diag_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::double_type Xnew, Rnew, Unew, Wnew, Znew, Qnew, Snew, Pnew, Mnew;
+        new_dw->allocateAndPut(Xnew, X_label, matl, patch);
+        new_dw->allocateAndPut(Rnew, R_label, matl, patch);
+        new_dw->allocateAndPut(Unew, D_label, matl, patch);
+        new_dw->allocateAndPut(Wnew, W_label, matl, patch);
+        new_dw->allocateAndPut(Znew, Z_label, matl, patch);
+        new_dw->allocateAndPut(Qnew, Q_label, matl, patch);
+        new_dw->allocateAndPut(Snew, S_label, matl, patch);
+        new_dw->allocateAndPut(Pnew, P_label, matl, patch);
+        new_dw->allocateAndPut(Mnew, M_label, matl, patch);
+
+        long64 flops = 0;
+        long64 memrefs = 0;
+
+        // N = A*M, kept in Znew until beta is known
+        ::Mult(Znew, A, Mv, iter, ll, hh, flops, memrefs);
+
+        double alpha, beta;
+        bool converged;
+        waitGammaDelta(alpha, beta, converged);
+
+        for(CellIterator it(iter); !it.done(); ++it){
+          IntVector idx = *it;
+          double z = Znew[idx] + beta*Z[idx];
+          double q = Mv[idx]   + beta*Q[idx];
+          double s = W[idx]    + beta*S[idx];
+          double pp= U[idx]    + beta*P[idx];
+          Znew[idx] = z;
+          Qnew[idx] = q;
+          Snew[idx] = s;
+          Pnew[idx] = pp;
+          Xnew[idx] = X[idx] + alpha*pp;
+          Rnew[idx] = R[idx] - alpha*s;
+          Unew[idx] = U[idx] - alpha*q;
+          Wnew[idx] = W[idx] - alpha*z;
+        }
+        IntVector diff = h-l;
+        flops   += 16L*diff.x()*diff.y()*diff.z();
+        memrefs += 18L*diff.x()*diff.y()*diff.z()*8L;
+
+        if(converged){
+          Mnew.copy(Mv, l, h);
+        } else {
+          precondition(patch, matl, Mnew, Wnew, diagonal, iter, flops, memrefs);
+
+          addGammaDelta(localGammaDelta(Rnew, Unew, Wnew, iter, flops, memrefs));
+        }
+
+        pipe_flops   += flops;
+        pipe_memrefs += memrefs;
+      }
+    }
+    new_dw->transferFrom(old_dw, diag_label, patches, matls);
+  }
+
+  //______________________________________________________________________
+  //  The whole pipelined pass is one task; its reduction is not a scheduler
+  //  reduction but posted by solve() in between passes
+  void schedulePipelinedStep(SchedulerP& subsched)
+  {
+    if(cout_doing.active())
+      cout_doing << "CGSolver::schedule pipelined step" << endl;
+
+    Task* task = scinew Task("CGSolver:pipeStep", this, &CGStencil7<GridVarType>::pipeStep);
+    task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+    task->requires(Task::OldDW, X_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, R_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, D_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, W_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, Z_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, Q_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, S_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, P_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, M_label,    Around, 1);
+    task->requires(Task::OldDW, diag_label, Ghost::None, 0);
+    task->computes(X_label);
+    task->computes(R_label);
+    task->computes(D_label);
+    task->computes(W_label);
+    task->computes(Z_label);
+    task->computes(Q_label);
+    task->computes(S_label);
+    task->computes(P_label);
+    task->computes(M_label);
+    task->computes(diag_label);
+    subsched->addTask(task, level->eachPatch(), matlset);
+  }
+
   //______________________________________________________________________
   void solve(const ProcessorGroup * pg, 
              const PatchSubset    * patches,
@@ -693,6 +1107,25 @@ public:
     task->computes(flop_label);
     subsched->addTask(task, level->eachPatch(), matlset);
 
+    if(params->pipelined){
+      pipe_flops   = 0;
+      pipe_memrefs = 0;
+      pipe_local[0] = pipe_local[1] = pipe_local[2] = 0;
+
+      task = scinew Task("CGSolver:pipeSetup", this, &CGStencil7<GridVarType>::pipeSetup);
+      task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+      task->requires(Task::NewDW, D_label,    Around, 1);
+      task->requires(Task::NewDW, R_label,    Ghost::None, 0);
+      task->requires(Task::NewDW, diag_label, Ghost::None, 0);
+      task->computes(W_label);
+      task->computes(M_label);
+      task->computes(Z_label);
+      task->computes(Q_label);
+      task->computes(S_label);
+      task->computes(P_label);
+      subsched->addTask(task, level->eachPatch(), matlset);
+    }
+
     subsched->compile();
     
     DataWarehouse* subNewDW = subsched->get_dw(3);
@@ -726,6 +1159,7 @@ public:
       break;
     }
     double err0=e;
+
     sumlong_vartype f;
     subNewDW->get(f, flop_label);
     
@@ -743,65 +1177,84 @@ public:
       subsched->mapDataWarehouse(Task::OldDW, 2);
       subsched->mapDataWarehouse(Task::NewDW, 3);
 
-      //__________________________________
-      // Step 1 - requires A(parent), D(old, 1 ghost) computes aden(new)
-      if(cout_doing.active())
-        cout_doing << "CGSolver::schedule Step 1" << endl;
-      task = scinew Task("CGSolver:step1", this, &CGStencil7<GridVarType>::step1);
-      task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
-      task->requires(Task::OldDW,       D_label, Around, 1);
-      task->computes(aden_label);
-      task->computes(Q_label);
-      task->computes(flop_label);
-      task->computes(memref_label);
-      subsched->addTask(task, level->eachPatch(), matlset);
+      if(params->pipelined){
+        schedulePipelinedStep(subsched);
+      } else {
 
-      //__________________________________
-      // schedule
-      // Step 2 - requires d(old), aden(new) D(old), X(old) R(old)  computes X, R, Q, d
-      if(cout_doing.active())
-        cout_doing << "CGSolver::schedule Step 2" << endl;
-      task = scinew Task("CGSolver:step2", this, &CGStencil7<GridVarType>::step2);
-      task->requires(Task::OldDW, d_label);
-      task->requires(Task::NewDW, aden_label);
-      task->requires(Task::OldDW, D_label,    Ghost::None, 0);
-      task->requires(Task::OldDW, X_label,    Ghost::None, 0);
-      task->requires(Task::OldDW, R_label,    Ghost::None, 0);
-      task->requires(Task::OldDW, diag_label, Ghost::None, 0);
-      task->computes(X_label);
-      task->computes(R_label);
-      task->modifies(Q_label);
-      task->computes(d_label);
-      task->computes(diag_label);
-      task->computes(flop_label);
-      task->modifies(memref_label);
+        //__________________________________
+        // Step 1 - requires A(parent), D(old, 1 ghost) computes aden(new)
+        if(cout_doing.active())
+          cout_doing << "CGSolver::schedule Step 1" << endl;
+        task = scinew Task("CGSolver:step1", this, &CGStencil7<GridVarType>::step1);
+        task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+        task->requires(Task::OldDW,       D_label, Around, 1);
+        task->computes(aden_label);
+        task->computes(Q_label);
+        task->computes(flop_label);
+        task->computes(memref_label);
+        subsched->addTask(task, level->eachPatch(), matlset);
+
+        //__________________________________
+        // schedule
+        // Step 2 - requires d(old), aden(new) D(old), X(old) R(old)  computes X, R, Q, d
+        if(cout_doing.active())
+          cout_doing << "CGSolver::schedule Step 2" << endl;
+        task = scinew Task("CGSolver:step2", this, &CGStencil7<GridVarType>::step2);
+        task->requires(Task::OldDW, d_label);
+        task->requires(Task::NewDW, aden_label);
+        task->requires(Task::OldDW, D_label,    Ghost::None, 0);
+        task->requires(Task::OldDW, X_label,    Ghost::None, 0);
+        task->requires(Task::OldDW, R_label,    Ghost::None, 0);
+        task->requires(Task::OldDW, diag_label, Ghost::None, 0);
+        task->computes(X_label);
+        task->computes(R_label);
+        task->modifies(Q_label);
+        task->computes(d_label);
+        task->computes(diag_label);
+        task->computes(flop_label);
+        task->modifies(memref_label);
       
-      if(params->norm != CGSolverParams::L2) {
-        task->computes(err_label);
-      }
-      subsched->addTask(task, level->eachPatch(), matlset);
+        if(params->norm != CGSolverParams::L2) {
+          task->computes(err_label);
+        }
+        subsched->addTask(task, level->eachPatch(), matlset);
 
 
-      //__________________________________
-      // schedule
-      // Step 3 - requires D(old), Q(new), d(new), d(old), computes D
-      if(cout_doing.active())
-        cout_doing << "CGSolver::schedule Step 3" << endl;
-      task = scinew Task("CGSolver:step3", this, &CGStencil7<GridVarType>::step3);
-      task->requires(Task::OldDW, D_label, Ghost::None, 0);
-      task->requires(Task::NewDW, Q_label, Ghost::None, 0);
-      task->requires(Task::NewDW, d_label);
-      task->requires(Task::OldDW, d_label);
-      task->computes(D_label);
-      task->computes(flop_label);
-      task->modifies(memref_label);
-      subsched->addTask(task, level->eachPatch(), matlset);
+        //__________________________________
+        // schedule
+        // Step 3 - requires D(old), Q(new), d(new), d(old), computes D
+        if(cout_doing.active())
+          cout_doing << "CGSolver::schedule Step 3" << endl;
+        task = scinew Task("CGSolver:step3", this, &CGStencil7<GridVarType>::step3);
+        task->requires(Task::OldDW, D_label, Ghost::None, 0);
+        task->requires(Task::NewDW, Q_label, Ghost::None, 0);
+        task->requires(Task::NewDW, d_label);
+        task->requires(Task::OldDW, d_label);
+        task->computes(D_label);
+        task->computes(flop_label);
+        task->modifies(memref_label);
+        subsched->addTask(task, level->eachPatch(), matlset);
+      }
       subsched->compile();
 
       //__________________________________
       //  Main iteration
-      while(niter < params->maxiterations && !(e < tolerance)){
-        niter++;
+      if(params->pipelined){
+        pipe_niter     = 0;
+        pipe_e         = e;
+        pipe_err0      = err0;
+        pipe_tolerance = tolerance;
+        postGammaDelta();
+      }
+
+      while(true){
+        if(!params->pipelined){
+          if(!(niter < params->maxiterations && !(e < tolerance))){
+            break;
+          }
+          niter++;
+        }
+
         subsched->advanceDataWarehouse(grid);
         DataWarehouse* subOldDW = subsched->get_dw(2);
         DataWarehouse* subNewDW = subsched->get_dw(3);
@@ -812,6 +1265,22 @@ public:
         subsched->execute();
 
         //__________________________________
+        //  the pipelined pass tests convergence itself, a converged
+        //  pass only carried X over.  A rank without patches still
+        //  has to take part in the reduction.
+        if(params->pipelined){
+          double alpha, beta;
+          bool converged;
+          waitGammaDelta(alpha, beta, converged);
+          if(converged){
+            niter = pipe_niter;
+            e     = pipe_e;
+            break;
+          }
+          postGammaDelta();
+          continue;
+        }
+
         switch(params->norm){
         case CGSolverParams::L1:
         case CGSolverParams::L2:
@@ -840,6 +1309,14 @@ public:
       }
     }
 
+    // the pipelined tasks count their work locally, sum it once here
+    if(params->pipelined){
+      long64 counts[2] = { pipe_flops, pipe_memrefs };
+      Uintah::MPI::Allreduce(MPI_IN_PLACE, counts, 2, MPI_INT64_T, MPI_SUM, world->getComm());
+      flops   += counts[0];
+      memrefs += counts[1];
+    }
+
     //__________________________________
     //  Pull the solution out of subsched new DW and put it into our X
     if(modifies_x){
@@ -933,6 +1410,35 @@ private:
 
   const CGSolverParams* params;
   bool modifies_x;
+
+  // pipelined CG: the extra recurrences, this rank's (gamma, delta, err)
+  // sums and their non-blocking reduction, the scalars of the current pass
+  // and locally counted work
+  const VarLabel* W_label  = nullptr;
+  const VarLabel* Z_label  = nullptr;
+  const VarLabel* S_label  = nullptr;
+  const VarLabel* P_label  = nullptr;
+  const VarLabel* M_label  = nullptr;
+  double      pipe_local[3]    = {0, 0, 0};
+  double      pipe_global[3]   = {0, 0, 0};
+  MPI_Request pipe_requests[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+  bool        pipe_reduced     = true;
+  Uintah::MasterLock pipe_lock;
+  int    pipe_niter     = 0;
+  bool   pipe_converged = false;
+  double pipe_e         = 0;
+  double pipe_err0      = 1;
+  double pipe_tolerance = 0;
+  double pipe_alpha     = 0;
+  double pipe_beta      = 0;
+  double pipe_gamma_old = 0;
+  double pipe_alpha_old = 0;
+  std::atomic<long64> pipe_flops{0};
+  std::atomic<long64> pipe_memrefs{0};
+
+  // per (patch, matl) block multigrid preconditioners, rebuilt by each setup()
+  std::map<std::pair<int, int>, Stencil7BlockMultigrid*> multigrids;
+  Uintah::MasterLock multigrids_lock;
 };
 
 //______________________________________________________________________
@@ -987,6 +1493,20 @@ void CGSolver::readParameters(ProblemSpecP& params_ps,
           throw ProblemSetupException("Unknown criteria: "+criteria, __FILE__, __LINE__);
         }
       }
+      // Only mg (the per patch block multigrid) changes the CG preconditioner,
+      // other (hypre) choices keep Jacobi
+      string precond;
+      if(param_ps->get("preconditioner", precond)){
+        if(precond == "MG" || precond == "mg" || precond == "Multigrid" || precond == "multigrid") {
+          m_params->precond = CGSolverParams::BlockMultigrid;
+        }
+      }
+      param_ps->get("pipelined", m_params->pipelined);
+      param_ps->get("npre",  m_params->npre);
+      param_ps->get("npost", m_params->npost);
+      if(m_params->precond == CGSolverParams::BlockMultigrid && (m_params->npre < 1 || m_params->npost < 1)) {
+        throw ProblemSetupException("CGSolver: npre and npost must be >= 1", __FILE__, __LINE__);
+      }
     }
   }
 
@@ -49,12 +49,26 @@ namespace Uintah {
     };
     
     Criteria criteria;
+
+    enum Preconditioner {
+      Jacobi, BlockMultigrid
+    };
+
+    Preconditioner precond;
+    int     npre;                // block multigrid pre and post smoothing sweeps
+    int     npost;
+
+    bool    pipelined;           // one overlapped reduction per iteration
     
     CGSolverParams()
       : tolerance(1.e-8)
       , initial_tolerance(1.e-15)
       , norm(L2)
       , criteria(Relative)
+      , precond(Jacobi)
+      , npre(1)
+      , npost(1)
+      , pipelined(false)
     {}
     
     ~CGSolverParams() {}
@@ -0,0 +1,328 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <CCA/Components/Solvers/Stencil7BlockMultigrid.h>
+
+#include <algorithm>
+
+using namespace Uintah;
+
+namespace {
+
+  // Stop coarsening once a level has this many cells or fewer
+  const int s_coarsestCells  = 8;
+
+  // Symmetric Gauss-Seidel sweeps used as the coarsest level "solve"
+  const int s_coarsestSweeps = 8;
+
+}
+
+//______________________________________________________________________
+//
+Stencil7BlockMultigrid::Stencil7BlockMultigrid( const Array3<Stencil7> & A,
+                                                const IntVector        & low,
+                                                const IntVector        & high,
+                                                      int                npre,
+                                                      int                npost )
+  : m_low(low)
+  , m_high(high)
+  , m_npre( std::max( npre, 1 ) )
+  , m_npost( std::max( npost, 1 ) )
+{
+  m_levels.reserve(16);
+  m_levels.push_back( MGLevel() );
+
+  //  Copy the patch block of A, dropping the couplings to cells outside of it
+  MGLevel& fine = m_levels.back();
+  fine.n = high - low;
+  fine.A.resize( fine.size() );
+
+  const int nx = fine.n.x();
+  const int ny = fine.n.y();
+  const int nz = fine.n.z();
+
+  for (int k = 0; k < nz; k++) {
+    for (int j = 0; j < ny; j++) {
+      for (int i = 0; i < nx; i++) {
+        Stencil7 s = A( low.x() + i, low.y() + j, low.z() + k );
+        if( i == 0 )      s.w = 0.0;
+        if( i == nx - 1 ) s.e = 0.0;
+        if( j == 0 )      s.s = 0.0;
+        if( j == ny - 1 ) s.n = 0.0;
+        if( k == 0 )      s.b = 0.0;
+        if( k == nz - 1 ) s.t = 0.0;
+        fine.A[ fine.index(i, j, k) ] = s;
+      }
+    }
+  }
+  finishLevel( fine );
+
+  while( m_levels.back().size() > s_coarsestCells ) {
+    const IntVector n = m_levels.back().n;
+    if( n.x() == 1 && n.y() == 1 && n.z() == 1 ) {
+      break;
+    }
+
+    MGLevel coarse;
+    coarsen( m_levels.back(), coarse );
+    finishLevel( coarse );
+    m_levels.push_back( coarse );
+  }
+}
+
+//______________________________________________________________________
+//  Galerkin coarse operator for piecewise constant prolongation: couplings
+//  between cells of the same coarse cell fold into the diagonal, the rest
+//  are summed over the shared coarse face.
+void
+Stencil7BlockMultigrid::coarsen( MGLevel & fine,
+                                 MGLevel & coarse ) const
+{
+  const IntVector& fn = fine.n;
+  fine.ratio = IntVector( fn.x() > 1 ? 2 : 1,
+                          fn.y() > 1 ? 2 : 1,
+                          fn.z() > 1 ? 2 : 1 );
+  const IntVector& ratio = fine.ratio;
+
+  coarse.n = IntVector( ( fn.x() + ratio.x() - 1 ) / ratio.x(),
+                        ( fn.y() + ratio.y() - 1 ) / ratio.y(),
+                        ( fn.z() + ratio.z() - 1 ) / ratio.z() );
+  coarse.A.assign( coarse.size(), Stencil7(0.0) );
+
+  for (int k = 0; k < fn.z(); k++) {
+    const int K = k / ratio.z();
+    for (int j = 0; j < fn.y(); j++) {
+      const int J = j / ratio.y();
+      for (int i = 0; i < fn.x(); i++) {
+        const int I = i / ratio.x();
+
+        const Stencil7& s = fine.A[ fine.index(i, j, k) ];
+        Stencil7&       c = coarse.A[ coarse.index(I, J, K) ];
+
+        c.p += s.p;
+
+        // a coupling stays inside the coarse cell when the neighbor has the same parent
+        if( i > 0 )            { ( (i - 1) / ratio.x() == I ? c.p : c.w ) += s.w; }
+        if( i < fn.x() - 1 )   { ( (i + 1) / ratio.x() == I ? c.p : c.e ) += s.e; }
+        if( j > 0 )            { ( (j - 1) / ratio.y() == J ? c.p : c.s ) += s.s; }
+        if( j < fn.y() - 1 )   { ( (j + 1) / ratio.y() == J ? c.p : c.n ) += s.n; }
+        if( k > 0 )            { ( (k - 1) / ratio.z() == K ? c.p : c.b ) += s.b; }
+        if( k < fn.z() - 1 )   { ( (k + 1) / ratio.z() == K ? c.p : c.t ) += s.t; }
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+Stencil7BlockMultigrid::finishLevel( MGLevel & lev ) const
+{
+  const int size = lev.size();
+  lev.ratio = IntVector(1, 1, 1);
+  lev.invDiag.resize( size );
+  for (int c = 0; c < size; c++) {
+    const double p = lev.A[c].p;
+    lev.invDiag[c] = ( p != 0.0 ) ? 1.0 / p : 0.0;
+  }
+  lev.x.assign( size, 0.0 );
+  lev.b.assign( size, 0.0 );
+  lev.r.assign( size, 0.0 );
+}
+
+//______________________________________________________________________
+//  One lexicographic Gauss-Seidel sweep, forward or backward
+void
+Stencil7BlockMultigrid::smooth( MGLevel & lev,
+                                bool      forward,
+                                long64  & flops,
+                                long64  & memrefs ) const
+{
+  const int nx = lev.n.x();
+  const int ny = lev.n.y();
+  const int nz = lev.n.z();
+  const int sy = nx;
+  const int sz = nx * ny;
+
+  double* x = &lev.x[0];
+
+  for (int kk = 0; kk < nz; kk++) {
+    const int k = forward ? kk : nz - 1 - kk;
+    for (int jj = 0; jj < ny; jj++) {
+      const int j = forward ? jj : ny - 1 - jj;
+      for (int ii = 0; ii < nx; ii++) {
+        const int i = forward ? ii : nx - 1 - ii;
+        const int c = lev.index(i, j, k);
+        const Stencil7& s = lev.A[c];
+
+        double sum = lev.b[c];
+        if( i > 0 )      sum -= s.w * x[c - 1];
+        if( i < nx - 1 ) sum -= s.e * x[c + 1];
+        if( j > 0 )      sum -= s.s * x[c - sy];
+        if( j < ny - 1 ) sum -= s.n * x[c + sy];
+        if( k > 0 )      sum -= s.b * x[c - sz];
+        if( k < nz - 1 ) sum -= s.t * x[c + sz];
+
+        x[c] = sum * lev.invDiag[c];
+      }
+    }
+  }
+  flops   += 13L * lev.size();
+  memrefs += 15L * lev.size() * 8L;
+}
+
+//______________________________________________________________________
+//  r = b - A*x
+void
+Stencil7BlockMultigrid::residual( MGLevel & lev,
+                                  long64  & flops,
+                                  long64  & memrefs ) const
+{
+  const int nx = lev.n.x();
+  const int ny = lev.n.y();
+  const int nz = lev.n.z();
+  const int sy = nx;
+  const int sz = nx * ny;
+
+  const double* x = &lev.x[0];
+
+  for (int k = 0; k < nz; k++) {
+    for (int j = 0; j < ny; j++) {
+      for (int i = 0; i < nx; i++) {
+        const int c = lev.index(i, j, k);
+        const Stencil7& s = lev.A[c];
+
+        double sum = lev.b[c] - s.p * x[c];
+        if( i > 0 )      sum -= s.w * x[c - 1];
+        if( i < nx - 1 ) sum -= s.e * x[c + 1];
+        if( j > 0 )      sum -= s.s * x[c - sy];
+        if( j < ny - 1 ) sum -= s.n * x[c + sy];
+        if( k > 0 )      sum -= s.b * x[c - sz];
+        if( k < nz - 1 ) sum -= s.t * x[c + sz];
+
+        lev.r[c] = sum;
+      }
+    }
+  }
+  flops   += 14L * lev.size();
+  memrefs += 16L * lev.size() * 8L;
+}
+
+//______________________________________________________________________
+//
+void
+Stencil7BlockMultigrid::vcycle( int       l,
+                                bool      zeroGuess,
+                                bool      adjoint,
+                                long64  & flops,
+                                long64  & memrefs )
+{
+  MGLevel& fine = m_levels[l];
+  if( zeroGuess ) {
+    std::fill( fine.x.begin(), fine.x.end(), 0.0 );
+  }
+
+  //__________________________________
+  //  coarsest level: symmetric Gauss-Seidel
+  if( l == numLevels() - 1 ) {
+    for (int s = 0; s < s_coarsestSweeps; s++) {
+      smooth( fine, true,  flops, memrefs );
+      smooth( fine, false, flops, memrefs );
+    }
+    return;
+  }
+
+  const int npre  = adjoint ? m_npost : m_npre;
+  const int npost = adjoint ? m_npre  : m_npost;
+
+  for (int s = 0; s < npre; s++) {
+    smooth( fine, true, flops, memrefs );
+  }
+
+  residual( fine, flops, memrefs );
+
+  //__________________________________
+  //  restrict (sum over the children), solve, prolong (inject)
+  MGLevel& coarse = m_levels[l + 1];
+  const IntVector& ratio = fine.ratio;
+
+  std::fill( coarse.b.begin(), coarse.b.end(), 0.0 );
+  for (int k = 0; k < fine.n.z(); k++) {
+    for (int j = 0; j < fine.n.y(); j++) {
+      for (int i = 0; i < fine.n.x(); i++) {
+        coarse.b[ coarse.index( i / ratio.x(), j / ratio.y(), k / ratio.z() ) ] += fine.r[ fine.index(i, j, k) ];
+      }
+    }
+  }
+
+  vcycle( l + 1, true, adjoint, flops, memrefs );
+
+  for (int k = 0; k < fine.n.z(); k++) {
+    for (int j = 0; j < fine.n.y(); j++) {
+      for (int i = 0; i < fine.n.x(); i++) {
+        fine.x[ fine.index(i, j, k) ] += coarse.x[ coarse.index( i / ratio.x(), j / ratio.y(), k / ratio.z() ) ];
+      }
+    }
+  }
+  flops   += 2L * fine.size();
+  memrefs += 4L * fine.size() * 8L;
+
+  for (int s = 0; s < npost; s++) {
+    smooth( fine, false, flops, memrefs );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+Stencil7BlockMultigrid::apply(       Array3<double> & Z,
+                               const Array3<double> & R,
+                                     long64         & flops,
+                                     long64         & memrefs )
+{
+  MGLevel& fine = m_levels[0];
+
+  for (int k = 0; k < fine.n.z(); k++) {
+    for (int j = 0; j < fine.n.y(); j++) {
+      for (int i = 0; i < fine.n.x(); i++) {
+        fine.b[ fine.index(i, j, k) ] = R( m_low.x() + i, m_low.y() + j, m_low.z() + k );
+      }
+    }
+  }
+
+  vcycle( 0, true, false, flops, memrefs );
+
+  //  Z += B^T (R - A Z): symmetric again when the sweep counts differ
+  if( m_npre != m_npost ) {
+    vcycle( 0, false, true, flops, memrefs );
+  }
+
+  for (int k = 0; k < fine.n.z(); k++) {
+    for (int j = 0; j < fine.n.y(); j++) {
+      for (int i = 0; i < fine.n.x(); i++) {
+        Z( m_low.x() + i, m_low.y() + j, m_low.z() + k ) = fine.x[ fine.index(i, j, k) ];
+      }
+    }
+  }
+}
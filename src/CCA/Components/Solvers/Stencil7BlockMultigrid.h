@@ -0,0 +1,111 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef Packages_Uintah_CCA_Components_Solvers_Stencil7BlockMultigrid_h
+#define Packages_Uintah_CCA_Components_Solvers_Stencil7BlockMultigrid_h
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Variables/Stencil7.h>
+
+#include <vector>
+
+#include <Core/Grid/Variables/Array3.h>   // needs <vector> first (BlockRange.hpp)
+
+namespace Uintah {
+
+  //______________________________________________________________________
+  //
+  //  Block preconditioner for a Stencil7 matrix: each patch block of A is
+  //  approximately inverted by a geometric multigrid V-cycle that only
+  //  sees that patch.  Couplings that leave the patch are dropped and the
+  //  hierarchy never crosses patches or ranks, so applied patch by patch
+  //  this is block Jacobi with a multigrid approximation of each block
+  //  inverse, not a global multigrid: the iteration count still grows with
+  //  the number of patches.
+  //
+  //  Coarse levels coarsen by 2 in every direction that still has more
+  //  than one cell and use the Galerkin operator P^T A P with piecewise
+  //  constant prolongation, which keeps them 7 point.  Pre smoothing is
+  //  forward Gauss-Seidel and post smoothing backward Gauss-Seidel.  With
+  //  npre == npost the V-cycle B is a symmetric operator for a symmetric A.
+  //  Otherwise it is followed by its adjoint cycle, which gives the
+  //  symmetric B + B^T - B^T A B, so the preconditioner can always be used
+  //  inside CG.
+
+  class Stencil7BlockMultigrid {
+  public:
+
+    Stencil7BlockMultigrid( const Array3<Stencil7> & A,
+                            const IntVector        & low,
+                            const IntVector        & high,
+                                  int                npre,
+                                  int                npost );
+
+    // Z = M^-1 R on [low, high), one V-cycle from a zero initial guess
+    // (and its adjoint cycle when npre != npost)
+    void apply(       Array3<double> & Z,
+                const Array3<double> & R,
+                      long64         & flops,
+                      long64         & memrefs );
+
+    int numLevels() const { return static_cast<int>( m_levels.size() ); }
+
+  private:
+
+    struct MGLevel {
+      IntVector              n;          // cells in each direction
+      IntVector              ratio;      // coarsening ratio to the next level
+      std::vector<Stencil7>  A;
+      std::vector<double>    invDiag;
+      std::vector<double>    x, b, r;
+
+      int index( int i, int j, int k ) const { return i + n.x() * ( j + n.y() * k ); }
+      int size() const { return n.x() * n.y() * n.z(); }
+    };
+
+    void coarsen( MGLevel & fine, MGLevel & coarse ) const;
+    void finishLevel( MGLevel & lev ) const;
+
+    void smooth( MGLevel & lev, bool forward, long64 & flops, long64 & memrefs ) const;
+    void residual( MGLevel & lev, long64 & flops, long64 & memrefs ) const;
+    // one V-cycle from level l down, from a zero initial guess on the coarser
+    // levels; the adjoint cycle swaps the pre and post sweep counts
+    void vcycle( int l, bool zeroGuess, bool adjoint, long64 & flops, long64 & memrefs );
+
+    // eliminate copy, assignment and move
+    Stencil7BlockMultigrid( const Stencil7BlockMultigrid & )            = delete;
+    Stencil7BlockMultigrid& operator=( const Stencil7BlockMultigrid & ) = delete;
+    Stencil7BlockMultigrid( Stencil7BlockMultigrid && )                 = delete;
+    Stencil7BlockMultigrid& operator=( Stencil7BlockMultigrid && )      = delete;
+
+    IntVector             m_low;
+    IntVector             m_high;
+    int                   m_npre;
+    int                   m_npost;
+    std::vector<MGLevel>  m_levels;
+  };
+
+} // end namespace Uintah
+
+#endif // Packages_Uintah_CCA_Components_Solvers_Stencil7BlockMultigrid_h
@@ -35,6 +35,7 @@ SRCDIR := CCA/Components/Solvers
 SRCS += \
 	$(SRCDIR)/SolverCommon.cc  \
 	$(SRCDIR)/CGSolver.cc      \
+	$(SRCDIR)/Stencil7BlockMultigrid.cc \
 	$(SRCDIR)/SolverFactory.cc
 
 PSELIBS := \
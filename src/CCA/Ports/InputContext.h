@@ -65,6 +65,10 @@ namespace Uintah {
       int fd;
       const char* filename;
       long cur;
+
+      // If set, the whole file mapped into memory - Variable::read
+      // takes the bytes from here instead of reading fd.
+      const char* mapped {nullptr};
    private:
       InputContext(const InputContext&);
       InputContext& operator=(const InputContext&);
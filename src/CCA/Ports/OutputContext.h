@@ -26,6 +26,7 @@
 #define UINTAH_HOMEBREW_OutputContext_H
 
 #include <Core/ProblemSpec/ProblemSpec.h>
+#include <string>
 
 namespace Uintah {
    /**************************************
@@ -69,6 +70,15 @@ namespace Uintah {
       long cur;
       ProblemSpecP varnode;
       bool outputDoubleAsFloat;
+
+      // If set, Variable::emit appends to this staging buffer instead of
+      // writing to fd (asynchronous output).
+      std::string* buffer {nullptr};
+
+      // Error bounds for lossy compression of floating point grid
+      // variables (0 = off).  Never set for checkpoints.
+      double lossyAbsTolerance {0.0};
+      double lossyRelTolerance {0.0};
    private:
       OutputContext(const OutputContext&);
       OutputContext& operator=(const OutputContext&);
@@ -52,14 +52,20 @@
 
 #include <libxml/xmlreader.h>
 
+#include <atomic>
+#include <exception>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include <iomanip>
 #include <fstream>
 #include <fcntl.h>
 
+#include <sys/mman.h>
 #include <sys/param.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 using namespace std;
@@ -368,10 +374,7 @@ DataArchive::getTimeData( int index )
     // the cache, so don't purge.
     dbg << "timestep_cache_size = "<<timestep_cache_size<<", d_lastNtimesteps.size() = "<<d_lastNtimesteps.size()<<"\n";
     if (timestep_cache_size > 0 && (int)(d_lastNtimesteps.size()) >= timestep_cache_size) {
-      int cacheTimestep = d_lastNtimesteps.back();
-      d_lastNtimesteps.pop_back();
-      dbg << "Making room.  Purging index "<< cacheTimestep <<"\n";
-      d_timeData[cacheTimestep].purgeCache();
+      purgeLeastRecentlyUsed();
     }
   }
   // Finally insert our new candidate at the top of the list.
@@ -379,6 +382,23 @@ DataArchive::getTimeData( int index )
   return td;
 }
 //______________________________________________________________________
+//  Timesteps pinned by a query in another thread are skipped, so the
+//  cache may briefly hold more than timestep_cache_size timesteps.
+bool
+DataArchive::purgeLeastRecentlyUsed()
+{
+  for( list<int>::reverse_iterator iter = d_lastNtimesteps.rbegin(); iter != d_lastNtimesteps.rend(); ++iter ) {
+    int cacheTimestep = *iter;
+    if( d_timeData[cacheTimestep].d_pins == 0 ) {
+      dbg << "Making room.  Purging index "<< cacheTimestep <<"\n";
+      d_lastNtimesteps.erase( std::next( iter ).base() );
+      d_timeData[cacheTimestep].purgeCache();
+      return true;
+    }
+  }
+  return false;
+}
+//______________________________________________________________________
 //
 int
 DataArchive::queryPatchwiseProcessor( const Patch * patch, const int index )
@@ -489,8 +509,6 @@ DataArchive::queryGrid( int index, const ProblemSpecP & ups /* = nullptr */, boo
   d_lock.unlock();
   grid->performConsistencyCheck();
 
-  timedata.d_grid = grid;
-
   dbg << "DataArchive::queryGrid completed in " << timer().seconds()
       << " seconds\n";
 
@@ -995,6 +1013,7 @@ DataArchive::queryPIDXSerial(       Variable     & var,
                            "not finished.  We need to adjust the particle positions to virtual space...", __FILE__, __LINE__ );
     }
 
+    d_lock.lock();
     psetDBType::key_type   key( matlIndex, patch );
     ParticleSubset       * psubset  = 0;
     psetDBType::iterator   psetIter = d_psetDB.find( key );
@@ -1013,6 +1032,7 @@ DataArchive::queryPIDXSerial(       Variable     & var,
       d_psetDB[ key ] = psubset;
     }
     (static_cast<ParticleVariableBase*>(&var))->allocate( psubset );
+    d_lock.unlock();
 //      (dynamic_cast<ParticleVariableBase*>(&var))->allocate(psubset);
   }
   else if (td->getType() == TypeDescription::PerPatch ||
@@ -1059,32 +1079,55 @@ DataArchive::query(       Variable     & var,
   const char* tag = AllocatorSetDefaultTag("QUERY");
 #endif
 
-  d_lock.lock();
+  if( patch && d_fileFormat == PIDX ) {
+#if HAVE_PIDX
+    return queryPIDXSerial( var, name, matlIndex, patch, timeIndex );
+#else
+    throw InternalError( "DataArchive::query() called for PIDX UDA - but PIDX not configured.", __FILE__, __LINE__ );
+#endif
+  }
+
+  // Everything needed from the time data is copied out while holding the
+  // lock: other threads may parse more patches (growing the datafile info)
+  // or purge this timestep from the cache while the variable is read.
+  std::unique_lock<Uintah::MasterLock> guard( d_lock );
+
   TimeData& timedata = getTimeData( timeIndex );
-  d_lock.unlock();
+
+  // When several threads query different timesteps this one may have been
+  // purged from the timestep cache since the caller got its grid, so
+  // rebuild the patch information.  queryGrid() takes the lock itself; the
+  // timestep stays pinned until the lock is held again so that no other
+  // thread can purge it in between.
+  if( patch && timedata.d_grid == nullptr ) {
+    timedata.d_pins++;
+    guard.unlock();
+    try {
+      queryGrid( timeIndex );
+    }
+    catch( ... ) {
+      guard.lock();
+      timedata.d_pins--;
+      throw;
+    }
+    guard.lock();
+    timedata.d_pins--;
+  }
 
   ASSERT( timedata.d_initialized );
 
   // Make sure info for this patch gets parsed from p*****.xml.
-  d_lock.lock();
   timedata.parsePatch( patch );
-  d_lock.unlock();
 
-  VarData & varinfo = timedata.d_varInfo[ name ];
+  VarData   varinfo   = timedata.d_varInfo[ name ];
+  bool      swapBytes = timedata.d_swapBytes;
+  int       nBytes    = timedata.d_nBytes;
   string    data_filename;
   int       patchid;
   VarType   varType = BLANK;
 
   if ( patch ) {
 
-    if( d_fileFormat == PIDX ) {
-#if HAVE_PIDX
-      return queryPIDXSerial( var, name, matlIndex, patch, timeIndex );
-#else
-      throw InternalError( "DataArchive::query() called for PIDX UDA - but PIDX not configured.", __FILE__, __LINE__ );
-#endif
-    }
-
     varType = PATCH_VAR;
     // we need to use the real_patch (in case of periodic boundaries) to get the data, but we need the
     // passed in patch to allocate the patch to the proper virtual region... (see var.allocate below)
@@ -1117,8 +1160,8 @@ DataArchive::query(       Variable     & var,
     // If this is a virtual patch, grab the real patch, but only do that here - in the next query, we want
     // the data to be returned in the virtual coordinate space.
 
-    vector<VarnameMatlPatch>::iterator iter = std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), VarnameMatlPatch(name, matlIndex, patchid ) );
-    if( iter == timedata.d_datafileInfoIndex.end() ) { // Previously used the hashmap lookup( timedata.d_datafileInfo.lookup() )
+    int pos = timedata.findDatafileInfo( VarnameMatlPatch( name, matlIndex, patchid ) );
+    if( pos == -1 ) {
       cerr << "VARIABLE NOT FOUND: " << name 
            << ", material index " << matlIndex 
            << ", Level " << patch->getLevel()->getIndex() 
@@ -1128,10 +1171,12 @@ DataArchive::query(       Variable     & var,
       throw InternalError("DataArchive::query:Variable not found", __FILE__, __LINE__);
     }
     
-    int pos = std::distance( timedata.d_datafileInfoIndex.begin(), iter );
-    dfi = &timedata.d_datafileInfoValue[ pos ];
+    datafileinfo = timedata.d_datafileInfoValue[ pos ];
+    dfi = &datafileinfo;
   }
 
+  guard.unlock();
+
   const TypeDescription* td = var.virtualGetTypeDescription();
   ASSERT( td->getName() == varinfo.type );
 
@@ -1147,6 +1192,7 @@ DataArchive::query(       Variable     & var,
                            "not finished.  We need to adjust the particle positions to virtual space...", __FILE__, __LINE__ );
     }
 
+    guard.lock();
     psetDBType::key_type   key( matlIndex, patch );
     ParticleSubset       * psubset  = 0;
     psetDBType::iterator   psetIter = d_psetDB.find( key );
@@ -1164,6 +1210,7 @@ DataArchive::query(       Variable     & var,
       d_psetDB[ key ] = psubset;
     }
     (static_cast<ParticleVariableBase*>(&var))->allocate( psubset );
+    guard.unlock();
 //      (dynamic_cast<ParticleVariableBase*>(&var))->allocate(psubset);
   }
   else if (td->getType() == TypeDescription::PerPatch ||
@@ -1179,37 +1226,62 @@ DataArchive::query(       Variable     & var,
   //__________________________________
   // open data file Standard Uda Format
   if( d_fileFormat == UDA || varType == GLOBAL_VAR) {
-    int fd = open( data_filename.c_str(), O_RDONLY );
 
-    if(fd == -1) {
-      cerr << "Error opening file: " << data_filename.c_str() << ", errno=" << errno << '\n';
-      throw ErrnoException("DataArchive::query (open call)", errno, __FILE__, __LINE__);
-    }
+    // Read straight out of the memory mapped file if possible.
+    std::shared_ptr<MappedFile> mapped = mapFile( data_filename, dfi->end );
+
+    if( mapped ) {
+      InputContext ic( -1, data_filename.c_str(), dfi->start );
+      ic.mapped = mapped->data;
+
+      // Read ahead hint for the pages of this variable.
+      const long pageSize = sysconf( _SC_PAGESIZE );
+      const long first    = dfi->start - dfi->start % pageSize;
+      madvise( const_cast<char *>( mapped->data ) + first, dfi->end - first, MADV_WILLNEED );
 
-    off_t ls = lseek( fd, dfi->start, SEEK_SET );
+      Timers::Simple read_timer;
+      read_timer.start();
 
-    if( ls == -1 ) {
-      cerr << "Error lseek - file: " << data_filename.c_str() << ", errno=" << errno << '\n';
-      throw ErrnoException("DataArchive::query (lseek call)", errno, __FILE__, __LINE__);
+      var.read( ic, dfi->end, swapBytes, nBytes, varinfo.compression );
+
+      dbg << "DataArchive::query: time to read mapped data: "
+          << read_timer().seconds() << " seconds\n";
+
+      ASSERTEQ( dfi->end, ic.cur );
     }
+    else {
+      int fd = open( data_filename.c_str(), O_RDONLY );
 
-    // read in the variable
-    InputContext ic( fd, data_filename.c_str(), dfi->start );
+      if(fd == -1) {
+        cerr << "Error opening file: " << data_filename.c_str() << ", errno=" << errno << '\n';
+        throw ErrnoException("DataArchive::query (open call)", errno, __FILE__, __LINE__);
+      }
+
+      off_t ls = lseek( fd, dfi->start, SEEK_SET );
+
+      if( ls == -1 ) {
+        cerr << "Error lseek - file: " << data_filename.c_str() << ", errno=" << errno << '\n';
+        throw ErrnoException("DataArchive::query (lseek call)", errno, __FILE__, __LINE__);
+      }
+
+      // read in the variable
+      InputContext ic( fd, data_filename.c_str(), dfi->start );
 
-    Timers::Simple read_timer;
-    timer.start();
+      Timers::Simple read_timer;
+      timer.start();
 
-    var.read( ic, dfi->end, timedata.d_swapBytes, timedata.d_nBytes, varinfo.compression );
+      var.read( ic, dfi->end, swapBytes, nBytes, varinfo.compression );
 
-    dbg << "DataArchive::query: time to read raw data: "
-        << read_timer().seconds() << " seconds\n";
+      dbg << "DataArchive::query: time to read raw data: "
+          << read_timer().seconds() << " seconds\n";
 
-    ASSERTEQ( dfi->end, ic.cur );
+      ASSERTEQ( dfi->end, ic.cur );
 
-    int result = close( fd );
-    if( result == -1 ) {
-      cerr << "Error closing file: " << data_filename.c_str() << ", errno=" << errno << '\n';
-      throw ErrnoException("DataArchive::query (close call)", errno, __FILE__, __LINE__);
+      int result = close( fd );
+      if( result == -1 ) {
+        cerr << "Error closing file: " << data_filename.c_str() << ", errno=" << errno << '\n';
+        throw ErrnoException("DataArchive::query (close call)", errno, __FILE__, __LINE__);
+      }
     }
   }
 
@@ -1223,6 +1295,219 @@ DataArchive::query(       Variable     & var,
 
 } // end query();
 
+//______________________________________________________________________
+//
+DataArchive::MappedFile::~MappedFile()
+{
+  munmap( const_cast<char *>( data ), size );
+  close( fd );
+}
+
+//______________________________________________________________________
+//  Mappings are shared, so evicting one from the cache never unmaps a
+//  file that another query is still reading.
+//
+//  A cached mapping is used as long as it covers 'minSize' bytes.  When
+//  the index refers past its end the file has grown since it was mapped:
+//  the descriptor kept with the mapping is checked with fstat() and the
+//  file mapped again.  If the file is too short, nullptr is returned and
+//  the caller reads the variable with read().
+std::shared_ptr<DataArchive::MappedFile>
+DataArchive::mapFile( const string & filename, size_t minSize )
+{
+  std::lock_guard<Uintah::MasterLock> guard( d_mappedFilesLock );
+
+  if( d_mappedFileCacheSize <= 0 ) {
+    return nullptr;
+  }
+
+  int fd = -1;
+
+  for( list< std::shared_ptr<MappedFile> >::iterator iter = d_mappedFiles.begin(); iter != d_mappedFiles.end(); ++iter ) {
+    if( (*iter)->filename == filename ) {
+      std::shared_ptr<MappedFile> mapped = *iter;
+      d_mappedFiles.erase( iter );
+
+      if( mapped->size >= minSize ) {
+        d_mappedFiles.push_front( mapped );
+        return mapped;
+      }
+
+      // Grown since it was mapped - map it again (through the same descriptor).
+      fd = dup( mapped->fd );
+      break;
+    }
+  }
+
+  if( fd == -1 ) {
+    fd = open( filename.c_str(), O_RDONLY );
+    if( fd == -1 ) {
+      return nullptr;
+    }
+  }
+
+  struct stat st;
+  if( fstat( fd, &st ) != 0 || st.st_size <= 0 || (size_t) st.st_size < minSize ) {
+    close( fd );
+    return nullptr;
+  }
+
+  void * data = mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+  if( data == MAP_FAILED ) {
+    close( fd );
+    return nullptr;
+  }
+
+  std::shared_ptr<MappedFile> mapped = std::make_shared<MappedFile>( filename, fd, st, (const char *) data );
+  d_mappedFiles.push_front( mapped );
+
+  while( (int) d_mappedFiles.size() > d_mappedFileCacheSize ) {
+    d_mappedFiles.pop_back();
+  }
+
+  return mapped;
+}
+
+//______________________________________________________________________
+//
+void
+DataArchive::setMappedFileCacheSize( int new_size )
+{
+  std::lock_guard<Uintah::MasterLock> guard( d_mappedFilesLock );
+
+  d_mappedFileCacheSize = new_size;
+  while( (int) d_mappedFiles.size() > max( d_mappedFileCacheSize, 0 ) ) {
+    d_mappedFiles.pop_back();
+  }
+}
+
+//______________________________________________________________________
+//
+void
+DataArchive::setQueryThreads( int numThreads )
+{
+  d_queryThreads = max( numThreads, 1 );
+}
+
+//______________________________________________________________________
+//  The threads are plain std::threads, independent of how Uintah was
+//  built.  Work is handed out one index at a time, as the timesteps of an
+//  uda can differ a lot in size.
+void
+DataArchive::parallelFor( int n, const std::function<void(int)> & body )
+{
+  int numThreads = min( d_queryThreads, n );
+
+  if( numThreads <= 1 ) {
+    for( int i = 0; i < n; i++ ) {
+      body( i );
+    }
+    return;
+  }
+
+  std::atomic<int>   next( 0 );
+  std::exception_ptr error;
+  Uintah::MasterLock errorLock;
+
+  auto worker = [&]() {
+    try {
+      for( int i = next++; i < n; i = next++ ) {
+        body( i );
+      }
+    }
+    catch( ... ) {
+      std::lock_guard<Uintah::MasterLock> guard( errorLock );
+      if( !error ) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  vector<std::thread> threads;
+  for( int t = 1; t < numThreads; t++ ) {
+    threads.emplace_back( worker );
+  }
+  worker();
+
+  for( size_t t = 0; t < threads.size(); t++ ) {
+    threads[t].join();
+  }
+
+  if( error ) {
+    std::rethrow_exception( error );
+  }
+}
+
+//______________________________________________________________________
+//  Each round, rank r makes the calls [round + r * numThreads, ... +
+//  numThreads), so rank 0 writes its own buffers and then receives
+//  those of ranks 1, 2, ... in turn.
+void
+DataArchive::orderedFor( int n, const std::function<void(int, std::ostream &)> & body, std::ostream & out )
+{
+  MPI_Comm comm   = d_queryComm;
+  int      rank   = 0;
+  int      nRanks = 1;
+  if( comm != MPI_COMM_NULL ) {
+    Uintah::MPI::Comm_rank( comm, &rank );
+    Uintah::MPI::Comm_size( comm, &nRanks );
+  }
+
+  const int perRank  = d_queryThreads;
+  const int perRound = perRank * nRanks;
+
+  // Largest message, the buffers are sent in pieces of at most this size.
+  const size_t maxCount = 1 << 30;
+
+  for( int round = 0; round < n; round += perRound ) {
+    const int first = min( n, round + rank * perRank );
+    const int last  = min( n, first + perRank );
+
+    vector<string> buffers( last - first );
+    parallelFor( last - first, [&]( int j ) {
+      ostringstream buffer;
+      buffer.copyfmt( out );
+      body( first + j, buffer );
+      buffers[j] = buffer.str();
+    } );
+
+    if( rank != 0 ) {
+      for( size_t j = 0; j < buffers.size(); j++ ) {
+        long long size = buffers[j].size();
+        Uintah::MPI::Send( &size, 1, MPI_LONG_LONG, 0, 0, comm );
+        for( size_t pos = 0; pos < buffers[j].size(); pos += maxCount ) {
+          int count = (int) min( maxCount, buffers[j].size() - pos );
+          Uintah::MPI::Send( &buffers[j][pos], count, MPI_BYTE, 0, 1, comm );
+        }
+      }
+      continue;
+    }
+
+    for( size_t j = 0; j < buffers.size(); j++ ) {
+      out << buffers[j];
+    }
+
+    string buffer;
+    for( int r = 1; r < nRanks; r++ ) {
+      const int rFirst = min( n, round + r * perRank );
+      const int rLast  = min( n, rFirst + perRank );
+
+      for( int i = rFirst; i < rLast; i++ ) {
+        long long size;
+        Uintah::MPI::Recv( &size, 1, MPI_LONG_LONG, r, 0, comm, MPI_STATUS_IGNORE );
+        buffer.resize( size );
+        for( size_t pos = 0; pos < buffer.size(); pos += maxCount ) {
+          int count = (int) min( maxCount, buffer.size() - pos );
+          Uintah::MPI::Recv( &buffer[pos], count, MPI_BYTE, r, 1, comm, MPI_STATUS_IGNORE );
+        }
+        out << buffer;
+      }
+    }
+    out.flush();
+  }
+}
+
 //______________________________________________________________________
 //
 
@@ -1962,11 +2247,9 @@ DataArchive::setTimestepCacheSize( int new_size ) {
   int kill_count = current_size - timestep_cache_size;
   dbg << "kill_count = "<<kill_count<<"\n";
   for(int i = 0; i < kill_count; i++) {
-    int cacheTimestep = d_lastNtimesteps.back();
-    dbg << "Making room.  Purging time index "<< cacheTimestep <<"\n";
-
-    d_lastNtimesteps.pop_back();
-    d_timeData[cacheTimestep].purgeCache();
+    if( !purgeLeastRecentlyUsed() ) {
+      break;
+    }
   }
   d_lock.unlock();
 }
@@ -2012,6 +2295,14 @@ DataArchive::TimeData::init()
   d_swapBytes = endianness != string(Uintah::endianness());
   d_nBytes    = numbits / 8;
 
+  // The binary index of all of the timestep's data xml files.
+  map< string, vector<UdaIndexEntry> > indexed;
+  if( UdaIndex::read( d_ts_directory + "timestep.idx", d_ts_path_and_filename, indexed ) ) {
+    for( map< string, vector<UdaIndexEntry> >::iterator iter = indexed.begin(); iter != indexed.end(); ++iter ) {
+      d_indexedFiles[ d_ts_directory + iter->first ].swap( iter->second );
+    }
+  }
+
   bool found = false;
 
   // Based on the timestep path and file name (eg: .../timestep.xml), we need
@@ -2063,6 +2354,16 @@ DataArchive::TimeData::init()
       }
       string proc = attributes["proc"];
 
+      // Aggregated output - this file holds the data of all of 'ranks'.
+      string ranks = attributes["ranks"];
+      if( ranks != "" ) {
+        int fileRank = atoi( proc.c_str() );
+        ConsecutiveRangeSet rankSet( ranks );
+        for( ConsecutiveRangeSet::iterator iter = rankSet.begin(); iter != rankSet.end(); iter++ ) {
+          d_outputFileRank[ *iter ] = fileRank;
+        }
+      }
+
       // WARNING: QWERTY: READ THIS Dav...
 
       /* - Remove this check for restarts.  We need to accurately
@@ -2120,128 +2421,163 @@ DataArchive::TimeData::purgeCache()
 
   d_datafileInfoIndex.clear();
   d_datafileInfoValue.clear();
+  d_datafileInfoLookup.clear();
   
   d_patchInfo.clear();
   d_varInfo.clear();
   d_xmlFilenames.clear();
   d_xmlParsed.clear();
+  d_outputFileRank.clear();
+  d_indexedFiles.clear();
   d_initialized = false;
 }
 
 //______________________________________________________________________
-// This is the function that parses the p*****.xml file for a single processor.
+// Reads the <Variable> entries of a p*****.xml (or global.xml) file.
 void
-DataArchive::TimeData::parseFile( const string & filename, int levelNum, int basePatch )
+DataArchive::TimeData::parseXMLFile( const string & filename, vector<UdaIndexEntry> & entries )
 {
   // Parse the file.
   ProblemSpecP top = ProblemSpecReader().readInputFile( filename );
 
-  // Materials are the same for all patches on a level - only parse them from one file.
-  bool addMaterials = levelNum >= 0 && d_matlInfo[levelNum].size() == 0;
-
   for( ProblemSpecP vnode = top->getFirstChild(); vnode != nullptr; vnode=vnode->getNextSibling() ){
     if(vnode->getNodeName() == "Variable") {
-      string varname;
-      if( !vnode->get("variable", varname) ) {
+      UdaIndexEntry entry;
+
+      if( !vnode->get("variable", entry.variable) ) {
         throw InternalError( "Cannot get variable name", __FILE__, __LINE__ );
       }
 
-      int patchid;
-      if(!vnode->get("patch", patchid) && !vnode->get("region", patchid)) {
+      if(!vnode->get("patch", entry.patch) && !vnode->get("region", entry.patch)) {
         throw InternalError( "Cannot get patch id", __FILE__, __LINE__ );
       }
 
-      int index;
-      if(!vnode->get("index", index)) {
+      if(!vnode->get("index", entry.matl)) {
         throw InternalError( "Cannot get index", __FILE__, __LINE__ );
       }
 
-      if( addMaterials ) {
-        // Record that the material exists.  index+1 to use matl -1
-        if (index+1 >= (int)d_matlInfo[levelNum].size()) {
-          d_matlInfo[ levelNum ].resize( index + 2 );
-        }
-        d_matlInfo[ levelNum ][ index ] = true;
-      }
-
       map<string,string> attributes;
       vnode->getAttributes(attributes);
 
-      string type = attributes["type"];
-      if( type == "" ) {
+      entry.type = attributes["type"];
+      if( entry.type == "" ) {
         throw InternalError( "DataArchive::query:Variable doesn't have a type", __FILE__, __LINE__ );
       }
-      long start;
-      if( !vnode->get("start", start) ) {
+      if( !vnode->get("start", entry.start) ) {
         throw InternalError( "DataArchive::query:Cannot get start", __FILE__, __LINE__ );
       }
-      long end;
-      if( !vnode->get("end", end) ) {
+      if( !vnode->get("end", entry.end) ) {
         throw InternalError( "DataArchive::query:Cannot get end", __FILE__, __LINE__ );
       }
-      string filename;
-      if( !vnode->get("filename", filename) ) {
+      if( !vnode->get("filename", entry.filename) ) {
         throw InternalError( "DataArchive::query:Cannot get filename", __FILE__, __LINE__ );
       }
 
       // Not required
-      string    compressionMode = "";
-      IntVector boundary(0,0,0);
-      int       numParticles = -1;
-
-      vnode->get( "compression", compressionMode );
-      vnode->get( "boundaryLayer", boundary );
-      vnode->get( "numParticles", numParticles );
-
-      if( d_varInfo.find(varname) == d_varInfo.end() ) {
-        VarData& varinfo      = d_varInfo[varname];
-        varinfo.type          = type;
-        varinfo.compression   = compressionMode;
-        varinfo.boundaryLayer = boundary;
-        varinfo.filename      = filename;
-      }
-      else if (compressionMode != "") {
-        // For particles variables of size 0, the uda doesn't say it
-        // has a compressionMode...  (FYI, why is this?  Because it is
-        // ambiguous... if there is no data, is it compressed?)
-        //
-        // To the best of my understanding, we only look at the variables stats
-        // the first time we encounter it... even if there are multiple materials.
-        // So we run into a problem is the variable has 0 data the first time it
-        // is looked at... The problem there is that it doesn't mark it as being
-        // compressed, and therefore the next time we see that variable (eg, in
-        // another material) we (used to) assume it was not compressed... the
-        // following lines compenstate for this problem:
-        VarData& varinfo = d_varInfo[varname];
-        varinfo.compression = compressionMode;
-      }
+      entry.compression   = "";
+      entry.boundaryLayer = IntVector(0,0,0);
+      entry.numParticles  = -1;
 
-      if (levelNum == -1) { // global file (reduction vars)
-        d_globaldata = filename;
-      }
-      else {
-        ASSERTRANGE( patchid-basePatch, 0, (int)d_patchInfo[levelNum].size() );
+      vnode->get( "compression", entry.compression );
+      vnode->get( "boundaryLayer", entry.boundaryLayer );
+      vnode->get( "numParticles", entry.numParticles );
 
-        PatchData& patchinfo = d_patchInfo[levelNum][patchid-basePatch];
-        if (!patchinfo.parsed) {
-          patchinfo.parsed = true;
-          patchinfo.datafilename = filename;
-        }
-      }
-      VarnameMatlPatch vmp(varname, index, patchid);
-      DataFileInfo     dummy;
+      entries.push_back( entry );
+    }
+    else if( vnode->getNodeType() != ProblemSpec::TEXT_NODE ) {
+      cerr << "WARNING: Unknown element in Variables section: " << vnode->getNodeName() << '\n';
+    }
+  }
+}
+
+//______________________________________________________________________
+// Position of 'vmp' in d_datafileInfoIndex/Value, or -1.
+int
+DataArchive::TimeData::findDatafileInfo( const VarnameMatlPatch & vmp ) const
+{
+  unordered_map<VarnameMatlPatch, int, VarnameMatlPatchHash>::const_iterator iter = d_datafileInfoLookup.find( vmp );
+  return ( iter == d_datafileInfoLookup.end() ) ? -1 : iter->second;
+}
+
+//______________________________________________________________________
+// This is the function that parses the p*****.xml file for a single processor.
+// If timestep.idx had the file's entries they are used instead.
+void
+DataArchive::TimeData::parseFile( const string & filename, int levelNum, int basePatch )
+{
+  vector<UdaIndexEntry> entries;
+
+  map< string, vector<UdaIndexEntry> >::iterator indexed = d_indexedFiles.find( filename );
+  if( indexed != d_indexedFiles.end() ) {
+    entries.swap( indexed->second );
+    d_indexedFiles.erase( indexed );
+  }
+  else {
+    parseXMLFile( filename, entries );
+  }
+
+  // Materials are the same for all patches on a level - only parse them from one file.
+  bool addMaterials = levelNum >= 0 && d_matlInfo[levelNum].size() == 0;
 
-      if( std::find( d_datafileInfoIndex.begin(), d_datafileInfoIndex.end(), vmp ) != d_datafileInfoIndex.end() ) {
-        // cerr << "Duplicate variable name: " << name << endl;
+  for( vector<UdaIndexEntry>::const_iterator iter = entries.begin(); iter != entries.end(); ++iter ) {
+    const UdaIndexEntry & entry   = *iter;
+    const string        & varname = entry.variable;
+    const int             index   = entry.matl;
+    const int             patchid = entry.patch;
+
+    if( addMaterials ) {
+      // Record that the material exists.  index+1 to use matl -1
+      if (index+1 >= (int)d_matlInfo[levelNum].size()) {
+        d_matlInfo[ levelNum ].resize( index + 2 );
       }
-      else {
-        DataFileInfo dfi( start, end, numParticles );
-        d_datafileInfoIndex.push_back( vmp );
-        d_datafileInfoValue.push_back( dfi );
+      d_matlInfo[ levelNum ][ index ] = true;
+    }
+
+    if( d_varInfo.find(varname) == d_varInfo.end() ) {
+      VarData& varinfo      = d_varInfo[varname];
+      varinfo.type          = entry.type;
+      varinfo.compression   = entry.compression;
+      varinfo.boundaryLayer = entry.boundaryLayer;
+      varinfo.filename      = entry.filename;
+    }
+    else if (entry.compression != "") {
+      // For particles variables of size 0, the uda doesn't say it
+      // has a compressionMode...  (FYI, why is this?  Because it is
+      // ambiguous... if there is no data, is it compressed?)
+      //
+      // To the best of my understanding, we only look at the variables stats
+      // the first time we encounter it... even if there are multiple materials.
+      // So we run into a problem is the variable has 0 data the first time it
+      // is looked at... The problem there is that it doesn't mark it as being
+      // compressed, and therefore the next time we see that variable (eg, in
+      // another material) we (used to) assume it was not compressed... the
+      // following lines compenstate for this problem:
+      VarData& varinfo = d_varInfo[varname];
+      varinfo.compression = entry.compression;
+    }
+
+    if (levelNum == -1) { // global file (reduction vars)
+      d_globaldata = entry.filename;
+    }
+    else {
+      ASSERTRANGE( patchid-basePatch, 0, (int)d_patchInfo[levelNum].size() );
+
+      PatchData& patchinfo = d_patchInfo[levelNum][patchid-basePatch];
+      if (!patchinfo.parsed) {
+        patchinfo.parsed = true;
+        patchinfo.datafilename = entry.filename;
       }
     }
-    else if( vnode->getNodeType() != ProblemSpec::TEXT_NODE ) {
-      cerr << "WARNING: Unknown element in Variables section: " << vnode->getNodeName() << '\n';
+    VarnameMatlPatch vmp(varname, index, patchid);
+
+    if( findDatafileInfo( vmp ) != -1 ) {
+      // cerr << "Duplicate variable name: " << name << endl;
+    }
+    else {
+      DataFileInfo dfi( entry.start, entry.end, entry.numParticles );
+      d_datafileInfoLookup[ vmp ] = d_datafileInfoIndex.size();
+      d_datafileInfoIndex.push_back( vmp );
+      d_datafileInfoValue.push_back( dfi );
     }
   }
 } // end TimeData::parseFile()
@@ -2281,8 +2617,14 @@ DataArchive::TimeData::parsePatch( const Patch * patch )
   // If this is a newer uda, the patch info in the grid will store the
   // processor where the data is.
   if( patchinfo.proc != -1 ) {
+    int fileRank = patchinfo.proc;
+    map<int, int>::const_iterator aggregated = d_outputFileRank.find( fileRank );
+    if( aggregated != d_outputFileRank.end() ) {
+      fileRank = aggregated->second;
+    }
+
     ostringstream file;
-    file << d_ts_directory << "l" << (int) real_patch->getLevel()->getIndex() << "/p" << setw(5) << setfill('0') << (int) patchinfo.proc << ".xml";
+    file << d_ts_directory << "l" << (int) real_patch->getLevel()->getIndex() << "/p" << setw(5) << setfill('0') << fileRank << ".xml";
     parseFile( file.str(), levelIndex, levelBasePatchID );
 
     // ARS - Commented out because the failure occurs regardless if
@@ -2427,9 +2769,8 @@ DataArchive::queryMaterials( const string & varname,
   for (unsigned i = 0; i < timedata.d_matlInfo[patch->getLevel()->getIndex()].size(); i++) {
     // i-1, since the matlInfo is adjusted to allow -1 as entries
     VarnameMatlPatch vmp( varname, i-1, patch->getRealPatch()->getID() );
-    DataFileInfo dummy;
 
-    if( std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), vmp ) != timedata.d_datafileInfoIndex.end() ) {
+    if( timedata.findDatafileInfo( vmp ) != -1 ) {
       matls.addInOrder(i-1);
     }
   }
@@ -2489,9 +2830,8 @@ DataArchive::exists( const string & varname,
   for( unsigned i = 0; i < timedata.d_matlInfo[levelIndex].size(); i++ ) {
     // i-1, since the matlInfo is adjusted to allow -1 as entries
     VarnameMatlPatch vmp( varname, i-1, patch->getRealPatch()->getID() );
-    DataFileInfo dummy;
 
-    if( std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), vmp ) != timedata.d_datafileInfoIndex.end() ) {
+    if( timedata.findDatafileInfo( vmp ) != -1 ) {
       d_lock.unlock();
       return true;
     }
@@ -26,6 +26,7 @@
  */
 
 #include <Core/Containers/ConsecutiveRangeSet.h>
+#include <Core/DataArchive/UdaIndex.h>
 //#include <Core/Containers/HashTable.h>
 #include <Core/Exceptions/VariableNotFoundInGrid.h>
 #include <Core/Grid/Grid.h>
@@ -49,11 +50,15 @@
 #  include <PIDX.h>
 #endif
 
+#include <functional>
 #include <list>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 namespace Uintah {
@@ -280,6 +285,41 @@ public:
   // corresponding documentation.
   void setTimestepCacheSize(int new_size);
 
+  // Number of .data files kept memory mapped between queries (the least
+  // recently used are unmapped).  0 turns memory mapped reads off.
+  //
+  // A mapped .data file must not be truncated or rewritten in place
+  // while it is mapped: reading a page past the new end of the file
+  // raises SIGBUS.  The DataArchiver writes each .data file once, but a
+  // tool that reads an UDA which a simulation may still overwrite (e.g.
+  // a restart that writes over the same time steps) should turn memory
+  // mapped reads off, so that every variable is read with read().
+  // (Replacing a file, i.e. unlink and create, is harmless: the mapping
+  // keeps reading the old one.)
+  void setMappedFileCacheSize( int new_size );
+
+  // More than one query thread lets the time series queries below read
+  // the timesteps in parallel on that many std::threads (the values are
+  // still returned in time order).
+  void setQueryThreads( int numThreads );
+  int  getQueryThreads() const { return d_queryThreads; }
+
+  // Calls body( i ) for i in [0, n) on up to the number of query threads,
+  // e.g. to query the patches of a timestep.  The first exception thrown
+  // by a call is rethrown once all calls are done.
+  void parallelFor( int n, const std::function<void(int)> & body );
+
+  // The same for loops that print: body( i, out ) prints to a buffer of
+  // its own and the buffers are written to 'out' in the order of i.  With
+  // a query communicator the calls are also spread over its ranks, and
+  // its rank 0 writes everything.  The calls run in rounds of (query
+  // threads x ranks), so only one round of output is held in memory.
+  void orderedFor( int n, const std::function<void(int, std::ostream &)> & body, std::ostream & out );
+
+  // Every rank of 'comm' must then make the same orderedFor() calls
+  // (MPI_COMM_NULL, the default, for this process alone).
+  void setQueryComm( MPI_Comm comm ) { d_queryComm = comm; }
+
   // This is a list of the last n timesteps accessed.  Data from
   // only the last timestep_cache_size timesteps is stored, unless
   // timestep_cache_size is less than or equal to zero then the size
@@ -294,6 +334,34 @@ public:
   // by the number of processors.
   int default_cache_size;
 
+  // A .data file mapped into memory, unmapped (and its descriptor
+  // closed) when the last user lets go.
+  struct MappedFile {
+    MappedFile( const std::string & filename, int fd, const struct stat & st, const char * data ) :
+      filename( filename ), fd( fd ), st( st ), data( data ), size( st.st_size ) {}
+    ~MappedFile();
+
+    std::string  filename;
+    int          fd;
+    struct stat  st;      // of the file when it was mapped
+    const char * data;
+    size_t       size;
+  };
+
+  // Returns the mapping of 'filename' (mapping it if needed), or nullptr
+  // if memory mapped reads are off or the file can not be mapped.  The
+  // file must hold at least 'minSize' bytes, the end of the variable in
+  // the index; a file that is shorter, e.g. one still being written, is
+  // read with read() instead.
+  std::shared_ptr<MappedFile> mapFile( const std::string & filename, size_t minSize );
+
+  std::list< std::shared_ptr<MappedFile> > d_mappedFiles;   // most recently used first
+  int                                      d_mappedFileCacheSize{ 16 };
+  Uintah::MasterLock                       d_mappedFilesLock;
+
+  int      d_queryThreads{ 1 };
+  MPI_Comm d_queryComm{ MPI_COMM_NULL };
+
   // Used as the first byte of the grid.xml file to designate/verify that it is stored in binary format.
   static const unsigned int GRID_MAGIC_NUMBER{ 0xdeadbeef };
 
@@ -351,6 +419,10 @@ private:
     int numParticles;
   };
 
+  struct VarnameMatlPatchHash {
+    size_t operator()( const VarnameMatlPatch & vmp ) const { return vmp.hash_; }
+  };
+
   // store these in separate arrays so we don't have to store nearly as many of them
   struct VarData {
     std::string type;
@@ -388,6 +460,12 @@ private:
     // Parse an individual data file and load appropriate storage.
     void parseFile( const std::string & filename, int levelNum, int basePatch );
 
+    // Reads the entries of a data xml file (when timestep.idx does not have them).
+    void parseXMLFile( const std::string & filename, std::vector<UdaIndexEntry> & entries );
+
+    // Position of the patch-matl-var in d_datafileInfoIndex/Value, or -1.
+    int findDatafileInfo( const VarnameMatlPatch & vmp ) const;
+
     // This would be private data, except we want DataArchive to have access,
     // so we would mark DataArchive as 'friend', but we're already a private
     // nested class of DataArchive...
@@ -398,6 +476,9 @@ private:
     std::vector<VarnameMatlPatch> d_datafileInfoIndex;
     std::vector<DataFileInfo>     d_datafileInfoValue;
 
+    // Position of each patch-matl-var in the two vectors above.
+    std::unordered_map<VarnameMatlPatch, int, VarnameMatlPatchHash> d_datafileInfoLookup;
+
     // Patch info (separate by levels) - proc, whether parsed, datafile, etc.
     // Gets expanded and proc is set during queryGrid.  Other fields are set
     // when parsed
@@ -414,12 +495,21 @@ private:
     std::vector< std::vector<std::string> > d_xmlFilenames;
     std::vector< std::vector<bool> >        d_xmlParsed;
 
+    // The entries of the data xml files read from timestep.idx (keyed
+    // by the xml file name), handed to parseFile() as they are needed.
+    std::map< std::string, std::vector<UdaIndexEntry> > d_indexedFiles;
+
+    // For aggregated output, the rank whose lX/pxxxxx.xml file holds
+    // the data of a given (patch owning) rank.
+    std::map<int, int>                      d_outputFileRank;
+
     std::string   d_globaldata;
 
     ConsecutiveRangeSet d_matls;  // materials available this timestep
 
     GridP         d_grid;
     bool          d_initialized;
+    int           d_pins{ 0 };                    // > 0 while a query needs it, it is then not purged (d_lock)
 
     ProblemSpecP  d_timestep_ps_for_component;    // timestep.xml's xml for components.
     std::string   d_ts_path_and_filename;         // Path to timestep.xml.
@@ -464,6 +554,10 @@ private:
 
   TimeData & getTimeData( int index );
 
+  // Purges the least recently used cached timestep that is not pinned.
+  // Returns false if every cached timestep is pinned.  d_lock must be held.
+  bool purgeLeastRecentlyUsed();
+
   std::string   d_filebase;
   FILE        * d_indexFile; // File pointer to XML index document.
 
@@ -565,21 +659,31 @@ private:
     if( type->getType() != TypeDescription::ParticleVariable ) {
       throw InternalError("Variable type is not ParticleVariable", __FILE__, __LINE__);
     }
-    // find the first timestep
-    int ts = 0;
-    while( (ts < (int)d_ts_times.size()) && (startTime > d_ts_times[ts]) ) {
-      ts++;
+    // find the timesteps in the range
+    std::vector<int> timesteps;
+    for( int ts = 0; (ts < (int)d_ts_times.size()) && (d_ts_times[ts] <= endTime); ts++ ) {
+      if( startTime <= d_ts_times[ts] ) {
+        timesteps.push_back( ts );
+      }
     }
 
-    // Idx needs to be initialized before it is used in findPatchAndIndex.
-    particleIndex idx = 0;
-    for ( ; (ts < (int)d_ts_times.size()) && (d_ts_times[ts] <= endTime); ts++) {
+    // The type descriptions are created on first use - do that before
+    // the timesteps are read in parallel.
+    ParticleVariable<T>::getTypeDescription();
+    ParticleVariable<long64>::getTypeDescription();
+
+    std::vector<T> results( timesteps.size() );
+
+    parallelFor( timesteps.size(), [&]( int i ) {
+      const int ts = timesteps[i];
+
       // figure out what patch contains the cell. As far as I can tell,
       // nothing prevents this from changing between timesteps, so we have to
       // do this every time -- if that can't actually happen we might be able
       // to speed this up.
-      Patch * patch = nullptr;
-      GridP   grid  = queryGrid( ts );
+      Patch *       patch = nullptr;
+      particleIndex idx   = 0;
+      GridP         grid  = queryGrid( ts );
       findPatchAndIndex( grid, patch, idx, particleID, matlIndex, levelIndex, ts );
 
       if( patch == nullptr ) {
@@ -590,8 +694,10 @@ private:
       query( var, name, matlIndex, patch, ts );
       // Now find the index that corresponds to the particleID
       // std::cerr <<" time = "<<t<<",  value = "<<var[idx]<<std::endl;
-      values.push_back(var[idx]);
-    }
+      results[i] = var[idx];
+    } );
+
+    values.insert( values.end(), results.begin(), results.end() );
 
     dbg << "DataArchive::query(values) completed in " << timer().seconds()
         << " seconds\n";
@@ -631,13 +737,29 @@ private:
       throw InternalError( "Unable to determine variable type", __FILE__, __LINE__ );
     }
 
-    // Find the first timestep.
-    int ts = 0;
-    while( (ts < (int)d_ts_times.size()) && (startTime > d_ts_times[ts]) ) {
-      ts++;
+    // Find the timesteps in the range.
+    std::vector<int> timesteps;
+    for( int ts = 0; (ts < (int)d_ts_times.size()) && (d_ts_times[ts] <= endTime); ts++ ) {
+      if( startTime <= d_ts_times[ts] ) {
+        timesteps.push_back( ts );
+      }
     }
 
-    for ( ; (ts < (int)d_ts_times.size()) && (d_ts_times[ts] <= endTime); ts++) {
+    // The type descriptions are created on first use - do that before
+    // the timesteps are read in parallel.
+    CCVariable<T>::getTypeDescription();
+    NCVariable<T>::getTypeDescription();
+    SFCXVariable<T>::getTypeDescription();
+    SFCYVariable<T>::getTypeDescription();
+    SFCZVariable<T>::getTypeDescription();
+
+    // Each timestep fills its own slot, the slots are appended in time order.
+    std::vector<T>    results( timesteps.size() );
+    std::vector<char> found( timesteps.size(), false );
+
+    parallelFor( timesteps.size(), [&]( int i ) {
+      const int ts = timesteps[i];
+
       // figure out what patch contains the cell. As far as I can tell,
       // nothing prevents this from changing between timesteps, so we have to
       // do this every time -- if that can't actually happen we might be able
@@ -721,31 +843,36 @@ private:
       case TypeDescription::CCVariable: {
         CCVariable<T> var;
         query(var, name, matlIndex, patch, ts);
-        values.push_back(var[loc]);
+        results[i] = var[loc];
+        found[i]  = true;
       } break;
 
       case TypeDescription::NCVariable: {
         NCVariable<T> var;
         query(var, name, matlIndex, patch, ts);
-        values.push_back(var[loc]);
+        results[i] = var[loc];
+        found[i]  = true;
       } break;
 
       case TypeDescription::SFCXVariable: {
         SFCXVariable<T> var;
         query(var, name, matlIndex, patch, ts);
-        values.push_back(var[loc]);
+        results[i] = var[loc];
+        found[i]  = true;
       } break;
 
       case TypeDescription::SFCYVariable: {
         SFCYVariable<T> var;
         query(var, name, matlIndex, patch, ts);
-        values.push_back(var[loc]);
+        results[i] = var[loc];
+        found[i]  = true;
       } break;
 
       case TypeDescription::SFCZVariable: {
         SFCZVariable<T> var;
         query(var, name, matlIndex, patch, ts);
-        values.push_back(var[loc]);
+        results[i] = var[loc];
+        found[i]  = true;
       } break;
 
       default:
@@ -753,6 +880,12 @@ private:
         break;
       }
       //std::cerr << "DataArchive::query:data extracted" << std::endl;
+    } );
+
+    for( size_t i = 0; i < timesteps.size(); i++ ) {
+      if( found[i] ) {
+        values.push_back( results[i] );
+      }
     }
 
     dbg << "DataArchive::query(values) completed in " << timer().seconds()
@@ -0,0 +1,359 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/DataArchive/UdaIndex.h>
+
+#include <Core/Exceptions/ErrnoException.h>
+#include <Core/Exceptions/InternalError.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace Uintah {
+
+namespace {
+
+  // timestep.idx layout (native byte order, checked with BYTE_ORDER_MARK):
+  //
+  //   FileHeader - magic and byte order mark.
+  //   Parts      - one per data xml file, until the end of the file:
+  //                PartHeader, the xml file name and that file's index.
+  //
+  // The index of one xml file:
+  //
+  //   Header  - number of records, number of strings and the offset
+  //             of the string table.
+  //   Records - numRecords fixed size Record structs.
+  //   Strings - numStrings times (uint32 length, characters).
+  //
+  // Parts start at arbitrary offsets, so everything is read with memcpy.
+
+  const char     MAGIC[8]        = { 'U', 'D', 'A', 'I', 'D', 'X', '0', '2' };
+  const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+  struct FileHeader {
+    char     magic[8];
+    uint32_t byteOrder;
+    uint32_t pad;
+  };
+
+  struct PartHeader {
+    uint64_t indexSize;
+    uint32_t nameSize;
+    uint32_t pad;
+  };
+
+  struct Header {
+    uint32_t numRecords;
+    uint32_t numStrings;
+    uint64_t stringsOffset;
+  };
+
+  struct Record {
+    uint32_t variable;         // string table indices
+    uint32_t type;
+    uint32_t compression;
+    uint32_t filename;
+    int32_t  matl;
+    int32_t  patch;
+    int32_t  numParticles;
+    int32_t  boundaryLayer[3];
+    int64_t  start;
+    int64_t  end;
+  };
+
+  //______________________________________________________________________
+  //
+  uint32_t
+  stringIndex( const string & s, map<string, uint32_t> & ids, vector<const string *> & strings )
+  {
+    map<string, uint32_t>::iterator iter = ids.find( s );
+    if( iter != ids.end() ) {
+      return iter->second;
+    }
+    uint32_t id = strings.size();
+    iter = ids.insert( make_pair( s, id ) ).first;
+    strings.push_back( &iter->first );
+    return id;
+  }
+
+  //______________________________________________________________________
+  //
+  string
+  serialize( const ProblemSpecP & doc )
+  {
+    map<string, uint32_t>  ids;
+    vector<const string *> strings;
+    vector<Record>         records;
+
+    for( ProblemSpecP vnode = doc->findBlock( "Variable" ); vnode != nullptr; vnode = vnode->findNextBlock( "Variable" ) ) {
+      string    variable;
+      string    type;
+      string    compression;
+      string    datafile;
+      int       matl         = 0;
+      int       patch        = 0;
+      int       numParticles = -1;
+      long      start        = 0;
+      long      end          = 0;
+      IntVector boundary( 0, 0, 0 );
+
+      vnode->get( "variable", variable );
+      vnode->get( "index",    matl );
+      vnode->get( "patch",    patch );
+      vnode->get( "start",    start );
+      vnode->get( "end",      end );
+      vnode->get( "filename", datafile );
+      vnode->get( "compression",   compression );
+      vnode->get( "boundaryLayer", boundary );
+      vnode->get( "numParticles",  numParticles );
+      vnode->getAttribute( "type", type );
+
+      Record record;
+      record.variable         = stringIndex( variable,    ids, strings );
+      record.type             = stringIndex( type,        ids, strings );
+      record.compression      = stringIndex( compression, ids, strings );
+      record.filename         = stringIndex( datafile,    ids, strings );
+      record.matl             = matl;
+      record.patch            = patch;
+      record.numParticles     = numParticles;
+      record.boundaryLayer[0] = boundary.x();
+      record.boundaryLayer[1] = boundary.y();
+      record.boundaryLayer[2] = boundary.z();
+      record.start            = start;
+      record.end              = end;
+      records.push_back( record );
+    }
+
+    Header header;
+    header.numRecords    = records.size();
+    header.numStrings    = strings.size();
+    header.stringsOffset = sizeof(Header) + records.size() * sizeof(Record);
+
+    string buffer( (const char *) &header, sizeof(Header) );
+    buffer.append( (const char *) records.data(), records.size() * sizeof(Record) );
+    for( size_t i = 0; i < strings.size(); i++ ) {
+      uint32_t length = strings[i]->size();
+      buffer.append( (const char *) &length, sizeof(length) );
+      buffer.append( *strings[i] );
+    }
+
+    return buffer;
+  }
+
+  //______________________________________________________________________
+  //
+  bool
+  parse( const char * base, size_t size, vector<UdaIndexEntry> & entries )
+  {
+    Header header;
+    if( size < sizeof(Header) ) {
+      return false;
+    }
+    memcpy( &header, base, sizeof(Header) );
+
+    if( header.stringsOffset != sizeof(Header) + (uint64_t) header.numRecords * sizeof(Record) ||
+        header.stringsOffset > size ) {
+      return false;
+    }
+
+    // String table.
+    vector<string> strings;
+    strings.reserve( header.numStrings );
+    size_t pos = header.stringsOffset;
+    for( uint32_t i = 0; i < header.numStrings; i++ ) {
+      uint32_t length;
+      if( pos + sizeof(length) > size ) {
+        return false;
+      }
+      memcpy( &length, base + pos, sizeof(length) );
+      pos += sizeof(length);
+      if( pos + length > size ) {
+        return false;
+      }
+      strings.push_back( string( base + pos, length ) );
+      pos += length;
+    }
+
+    // Records.
+    entries.resize( header.numRecords );
+    for( uint32_t i = 0; i < header.numRecords; i++ ) {
+      Record record;
+      memcpy( &record, base + sizeof(Header) + i * sizeof(Record), sizeof(Record) );
+      if( record.variable >= strings.size() || record.type >= strings.size() ||
+          record.compression >= strings.size() || record.filename >= strings.size() ) {
+        return false;
+      }
+
+      UdaIndexEntry & entry = entries[i];
+      entry.variable      = strings[ record.variable ];
+      entry.type          = strings[ record.type ];
+      entry.compression   = strings[ record.compression ];
+      entry.filename      = strings[ record.filename ];
+      entry.matl          = record.matl;
+      entry.patch         = record.patch;
+      entry.numParticles  = record.numParticles;
+      entry.boundaryLayer = IntVector( record.boundaryLayer[0], record.boundaryLayer[1], record.boundaryLayer[2] );
+      entry.start         = record.start;
+      entry.end           = record.end;
+    }
+    return true;
+  }
+
+} // end anonymous namespace
+
+//______________________________________________________________________
+//
+string
+UdaIndex::part( const string & xmlName, const ProblemSpecP & doc )
+{
+  string index = serialize( doc );
+
+  PartHeader header;
+  header.indexSize = index.size();
+  header.nameSize  = xmlName.size();
+  header.pad       = 0;
+
+  string buffer( (const char *) &header, sizeof(PartHeader) );
+  buffer.append( xmlName );
+  buffer.append( index );
+  return buffer;
+}
+
+//______________________________________________________________________
+//
+void
+UdaIndex::write( const string & parts, const string & filename )
+{
+  int fd = open( filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666 );
+  if( fd == -1 ) {
+    throw ErrnoException( "UdaIndex::write (open call) " + filename, errno, __FILE__, __LINE__ );
+  }
+
+  FileHeader header;
+  memcpy( header.magic, MAGIC, sizeof(MAGIC) );
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.pad       = 0;
+
+  string buffer( (const char *) &header, sizeof(FileHeader) );
+  buffer.append( parts );
+
+  const char * data = buffer.data();
+  size_t       left = buffer.size();
+  while( left > 0 ) {
+    ssize_t s = ::write( fd, data, left );
+    if( s == -1 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+      int err = errno;
+      close( fd );
+      throw ErrnoException( "UdaIndex::write (write call) " + filename, err, __FILE__, __LINE__ );
+    }
+    data += s;
+    left -= s;
+  }
+
+  if( close( fd ) == -1 ) {
+    throw ErrnoException( "UdaIndex::write (close call) " + filename, errno, __FILE__, __LINE__ );
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+UdaIndex::read( const string                          & filename,
+                const string                          & timestepFilename,
+                map< string, vector<UdaIndexEntry> >  & files )
+{
+  files.clear();
+
+  int fd = open( filename.c_str(), O_RDONLY );
+  if( fd == -1 ) {
+    return false;
+  }
+
+  // An index older than timestep.xml is stale (the timestep was rewritten).
+  struct stat idxStat;
+  struct stat xmlStat;
+  if( fstat( fd, &idxStat ) == -1 || (size_t) idxStat.st_size < sizeof(FileHeader) ||
+      ( stat( timestepFilename.c_str(), &xmlStat ) == 0 && idxStat.st_mtime < xmlStat.st_mtime ) ) {
+    close( fd );
+    return false;
+  }
+
+  const size_t size = idxStat.st_size;
+  void * mapped = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  close( fd );
+  if( mapped == MAP_FAILED ) {
+    return false;
+  }
+
+  const char * base = (const char *) mapped;
+
+  FileHeader header;
+  memcpy( &header, base, sizeof(FileHeader) );
+  bool valid = memcmp( header.magic, MAGIC, sizeof(MAGIC) ) == 0 && header.byteOrder == BYTE_ORDER_MARK;
+
+  size_t pos = sizeof(FileHeader);
+  while( valid && pos < size ) {
+    PartHeader part;
+    if( pos + sizeof(PartHeader) > size ) {
+      valid = false;
+      break;
+    }
+    memcpy( &part, base + pos, sizeof(PartHeader) );
+    pos += sizeof(PartHeader);
+
+    if( part.nameSize > size - pos || part.indexSize > size - pos - part.nameSize ) {
+      valid = false;
+      break;
+    }
+    string name( base + pos, part.nameSize );
+    pos += part.nameSize;
+
+    valid = parse( base + pos, part.indexSize, files[ name ] );
+    pos += part.indexSize;
+  }
+
+  munmap( mapped, size );
+
+  if( !valid ) {
+    files.clear();
+  }
+  return valid;
+}
+
+} // End namespace Uintah
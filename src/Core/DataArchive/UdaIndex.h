@@ -0,0 +1,95 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CORE_DATAARCHIVE_UDAINDEX_H
+#define CORE_DATAARCHIVE_UDAINDEX_H
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/ProblemSpec/ProblemSpecP.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+/**************************************
+
+  CLASS
+    UdaIndex
+
+    Binary index of a UDA data xml file.
+
+  DESCRIPTION
+    Each lX/pxxxxx.xml (and global.xml) file written by the DataArchiver
+    lists, for every (variable, material, patch), where its data lives
+    in the matching .data file.  Parsing these xml files dominates the
+    time it takes to open a timestep of a large UDA, so the same tables
+    are also written, for all the xml files of a timestep, to a single
+    tXXXXX/timestep.idx: per xml file a header, fixed size records and a
+    string table, laid out so that it can be memory mapped and read
+    without any parsing.  Each rank serializes its own files (part());
+    rank 0 gathers the parts and writes the file next to timestep.xml.
+    DataArchive uses timestep.idx when it is present (and not older than
+    timestep.xml) and falls back to the xml files otherwise.
+
+****************************************/
+
+struct UdaIndexEntry {
+  std::string variable;
+  std::string type;
+  std::string compression;
+  std::string filename;
+  int         matl;
+  int         patch;
+  int         numParticles;
+  IntVector   boundaryLayer;
+  long        start;
+  long        end;
+};
+
+class UdaIndex {
+public:
+
+  // The index of the <Variable> entries of an Uintah_Output document,
+  // tagged with its file name relative to the timestep directory
+  // (e.g. l0/p00000.xml).
+  static std::string part( const std::string & xmlName, const ProblemSpecP & doc );
+
+  // Writes the concatenated parts of a timestep as its timestep.idx.
+  static void write( const std::string & parts, const std::string & filename );
+
+  // Reads timestep.idx into one entry list per xml file name.  Returns
+  // false (and no entries) if the file does not exist, is older than
+  // 'timestepFilename', is not a valid index, or was written on a
+  // machine of different byte order.
+  static bool read( const std::string                                       & filename,
+                    const std::string                                       & timestepFilename,
+                    std::map< std::string, std::vector<UdaIndexEntry> >     & files );
+};
+
+} // End namespace Uintah
+
+#endif
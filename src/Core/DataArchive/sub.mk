@@ -32,7 +32,8 @@ include $(SCIRUN_SCRIPTS)/smallso_prologue.mk
 
 SRCDIR   := Core/DataArchive
 
-SRCS += $(SRCDIR)/DataArchive.cc 
+SRCS += $(SRCDIR)/DataArchive.cc \
+        $(SRCDIR)/UdaIndex.cc
 
 PSELIBS := \
 	CCA/Ports    \
@@ -28,8 +28,76 @@
 #include <Core/Malloc/Allocator.h>
 #include <Core/Math/MiscMath.h>
 
+#include <cmath>
+
 using namespace Uintah;
 using namespace std;
+
+namespace {
+
+  //__________________________________
+  //  One dimensional GIMP weights of the nodes i, i+1 and i+nn for a
+  //  particle with half width l at cell position c.  These are the
+  //  branches of findCellAndWeights, written so they can be inlined into
+  //  the batched loops.
+  inline void gimpWeights(double c, int i, int nn, double l,
+                          double& f0, double& f1, double& f2)
+  {
+    const double p0 = c - (i);
+    const double p1 = c - (i+1);
+    const double p2 = c - (i + nn);
+    if(p0 <= l){
+      f0 = 1. - (p0*p0 + (l)*(l))/(2*l);
+      f1 = (1. + l + p1)*(1. + l + p1)/(4*l);
+      f2 = (1. + l - p2)*(1. + l - p2)/(4*l);
+    }
+    else if(p0 <= (1.-l)){
+      f0 = 1. - p0;
+      f1 = 1. + p1;
+      f2 = 0.;
+    }
+    else{
+      f0 = (1. + l - p0)*(1. + l - p0)/(4*l);
+      f1 = 1. - (p1*p1 + (l)*(l))/(2*l);
+      f2 = (1. + l + p2)*(1. + l + p2)/(4*l);
+    }
+  }
+
+  //__________________________________
+  //  As above, with the derivatives of the weights.
+  inline void gimpWeightsAndDerivatives(double c, int i, int nn, double l,
+                                        double& f0, double& f1, double& f2,
+                                        double& df0, double& df1, double& df2)
+  {
+    const double p0 = c - (i);
+    const double p1 = c - (i+1);
+    const double p2 = c - (i + nn);
+    if(p0 <= l){
+      f0  = 1. - (p0*p0 + (l)*(l))/(2.*l);
+      f1  = (1. + l + p1)*(1. + l + p1)/(4.*l);
+      f2  = (1. + l - p2)*(1. + l - p2)/(4.*l);
+      df0 = -p0/l;
+      df1 =  (1. + l + p1)/(2.*l);
+      df2 = -(1. + l - p2)/(2.*l);
+    }
+    else if(p0 <= (1-l)){
+      f0  = 1. - p0;
+      f1  = 1. + p1;
+      f2  = 0.;
+      df0 = -1.;
+      df1 =  1.;
+      df2 =  0.;
+    }
+    else{
+      f0  = (1. + l - p0)*(1. + l - p0)/(4.*l);
+      f1  = 1. - (p1*p1 + (l)*(l))/(2.*l);
+      f2  = (1. + l + p2)*(1. + l + p2)/(4.*l);
+      df0 = -(1. + l - p0)/(2.*l);
+      df1 = -p1/l;
+      df2 = (1. + l + p2)/(2.*l);
+    }
+  }
+}
     
 GIMPInterpolator::GIMPInterpolator()
 {
@@ -949,6 +1017,166 @@ void GIMPInterpolator::findCellAndWeightsAndShapeDerivatives_CFI(
   }
 }
 
+//______________________________________________________________________
+//  Batched evaluation.  The cell index and the 1D weights of BATCH_SIZE
+//  particles are computed first, into separate arrays per node and
+//  direction, then the 27 tensor product weights of each particle are
+//  expanded into the caller's buffers.  As in findCellAndWeights, only
+//  the nodes with a positive weight are kept, in the same order.
+int GIMPInterpolator::findCellsAndWeights(const particleIndex* pidx, int n,
+                                          const constParticleVariable<Point>& px,
+                                          const constParticleVariable<Matrix3>& psize,
+                                          IntVector* ni,
+                                          double* S)
+{
+  const Level* level  = d_patch->getLevel();
+  const Point  anchor = level->getAnchor();
+  const Vector dcell  = level->dCell();
+
+  double cx[BATCH_SIZE], cy[BATCH_SIZE], cz[BATCH_SIZE];
+  double fx[3][BATCH_SIZE], fy[3][BATCH_SIZE], fz[3][BATCH_SIZE];
+  int    ix[BATCH_SIZE], iy[BATCH_SIZE], iz[BATCH_SIZE];
+  int    nnx[BATCH_SIZE], nny[BATCH_SIZE], nnz[BATCH_SIZE];
+
+  for (int j0 = 0; j0 < n; j0 += BATCH_SIZE) {
+    const int nb = Min(n - j0, BATCH_SIZE);
+
+    positionsToIndex(anchor, dcell, pidx + j0, nb, px, cx, cy, cz);
+
+    for (int j = 0; j < nb; j++) {
+      ix[j]  = static_cast<int>(std::floor(cx[j]));
+      iy[j]  = static_cast<int>(std::floor(cy[j]));
+      iz[j]  = static_cast<int>(std::floor(cz[j]));
+      nnx[j] = (cx[j]-(ix[j]) <= .5) ? -1 : 2;
+      nny[j] = (cy[j]-(iy[j]) <= .5) ? -1 : 2;
+      nnz[j] = (cz[j]-(iz[j]) <= .5) ? -1 : 2;
+    }
+
+    for (int j = 0; j < nb; j++) {
+      const Matrix3& size = psize[pidx[j0 + j]];
+      gimpWeights(cx[j], ix[j], nnx[j], size(0,0)/2.,
+                  fx[0][j], fx[1][j], fx[2][j]);
+      gimpWeights(cy[j], iy[j], nny[j], size(1,1)/2.,
+                  fy[0][j], fy[1][j], fy[2][j]);
+      gimpWeights(cz[j], iz[j], nnz[j], size(2,2)/2.,
+                  fz[0][j], fz[1][j], fz[2][j]);
+    }
+
+    for (int j = 0; j < nb; j++) {
+      IntVector* j_ni = ni + 27*(j0 + j);
+      double*    j_S  = S  + 27*(j0 + j);
+      const int ox[3] = { 0, 1, nnx[j] };
+      const int oy[3] = { 0, 1, nny[j] };
+      const int oz[3] = { 0, 1, nnz[j] };
+
+      int count = 0;
+      for (int z = 0; z < 3; z++) {
+        for (int y = 0; y < 3; y++) {
+          for (int x = 0; x < 3; x++) {
+            const double s = fx[x][j]*fy[y][j]*fz[z][j];
+            if (s > 0.0) {
+              j_S[count]  = s;
+              j_ni[count] = IntVector(ix[j]+ox[x], iy[j]+oy[y], iz[j]+oz[z]);
+              count++;
+            }
+          }
+        }
+      }
+
+      const IntVector pad = (count > 0) ? j_ni[0] : IntVector(ix[j], iy[j], iz[j]);
+      for (int k = count; k < 27; k++) {
+        j_S[k]  = 0.0;
+        j_ni[k] = pad;
+      }
+    }
+  }
+  return 27;
+}
+
+//______________________________________________________________________
+//
+int
+GIMPInterpolator::findCellsAndWeightsAndShapeDerivatives(const particleIndex* pidx,
+                                          int n,
+                                          const constParticleVariable<Point>& px,
+                                          const constParticleVariable<Matrix3>& psize,
+                                          IntVector* ni,
+                                          double* S,
+                                          Vector* d_S)
+{
+  const Level* level  = d_patch->getLevel();
+  const Point  anchor = level->getAnchor();
+  const Vector dcell  = level->dCell();
+
+  double cx[BATCH_SIZE], cy[BATCH_SIZE], cz[BATCH_SIZE];
+  double fx[3][BATCH_SIZE],  fy[3][BATCH_SIZE],  fz[3][BATCH_SIZE];
+  double dfx[3][BATCH_SIZE], dfy[3][BATCH_SIZE], dfz[3][BATCH_SIZE];
+  int    ix[BATCH_SIZE], iy[BATCH_SIZE], iz[BATCH_SIZE];
+  int    nnx[BATCH_SIZE], nny[BATCH_SIZE], nnz[BATCH_SIZE];
+
+  for (int j0 = 0; j0 < n; j0 += BATCH_SIZE) {
+    const int nb = Min(n - j0, BATCH_SIZE);
+
+    positionsToIndex(anchor, dcell, pidx + j0, nb, px, cx, cy, cz);
+
+    for (int j = 0; j < nb; j++) {
+      ix[j]  = static_cast<int>(std::floor(cx[j]));
+      iy[j]  = static_cast<int>(std::floor(cy[j]));
+      iz[j]  = static_cast<int>(std::floor(cz[j]));
+      nnx[j] = (cx[j]-(ix[j]) <= .5) ? -1 : 2;
+      nny[j] = (cy[j]-(iy[j]) <= .5) ? -1 : 2;
+      nnz[j] = (cz[j]-(iz[j]) <= .5) ? -1 : 2;
+    }
+
+    for (int j = 0; j < nb; j++) {
+      const Matrix3& size = psize[pidx[j0 + j]];
+      gimpWeightsAndDerivatives(cx[j], ix[j], nnx[j], size(0,0)/2.,
+                                fx[0][j],  fx[1][j],  fx[2][j],
+                                dfx[0][j], dfx[1][j], dfx[2][j]);
+      gimpWeightsAndDerivatives(cy[j], iy[j], nny[j], size(1,1)/2.,
+                                fy[0][j],  fy[1][j],  fy[2][j],
+                                dfy[0][j], dfy[1][j], dfy[2][j]);
+      gimpWeightsAndDerivatives(cz[j], iz[j], nnz[j], size(2,2)/2.,
+                                fz[0][j],  fz[1][j],  fz[2][j],
+                                dfz[0][j], dfz[1][j], dfz[2][j]);
+    }
+
+    for (int j = 0; j < nb; j++) {
+      IntVector* j_ni = ni  + 27*(j0 + j);
+      double*    j_S  = S   + 27*(j0 + j);
+      Vector*    j_dS = d_S + 27*(j0 + j);
+      const int ox[3] = { 0, 1, nnx[j] };
+      const int oy[3] = { 0, 1, nny[j] };
+      const int oz[3] = { 0, 1, nnz[j] };
+
+      int count = 0;
+      for (int z = 0; z < 3; z++) {
+        for (int y = 0; y < 3; y++) {
+          for (int x = 0; x < 3; x++) {
+            const double s = fx[x][j]*fy[y][j]*fz[z][j];
+            if (s > 0.0) {
+              j_S[count]  = s;
+              j_dS[count] = Vector(dfx[x][j]*fy[y][j]*fz[z][j],
+                                   fx[x][j]*dfy[y][j]*fz[z][j],
+                                   fx[x][j]*fy[y][j]*dfz[z][j]);
+              j_ni[count] = IntVector(ix[j]+ox[x], iy[j]+oy[y], iz[j]+oz[z]);
+              count++;
+            }
+          }
+        }
+      }
+
+      const IntVector pad = (count > 0) ? j_ni[0] : IntVector(ix[j], iy[j], iz[j]);
+      for (int k = count; k < 27; k++) {
+        j_S[k]  = 0.0;
+        j_dS[k] = Vector(0.0);
+        j_ni[k] = pad;
+      }
+    }
+  }
+  return 27;
+}
+
 int GIMPInterpolator::size()
 {
   return d_size;
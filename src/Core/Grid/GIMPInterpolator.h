@@ -68,6 +68,20 @@ namespace Uintah {
                                             std::vector<double>& S,
                                             std::vector<Vector>& d_S,
                                             constNCVariable<Stencil7>& zoi);
+
+    virtual int findCellsAndWeights(const particleIndex* pidx, int n,
+                                    const constParticleVariable<Point>& px,
+                                    const constParticleVariable<Matrix3>& psize,
+                                    IntVector* ni,
+                                    double* S);
+
+    virtual int findCellsAndWeightsAndShapeDerivatives(const particleIndex* pidx,
+                                    int n,
+                                    const constParticleVariable<Point>& px,
+                                    const constParticleVariable<Matrix3>& psize,
+                                    IntVector* ni,
+                                    double* S,
+                                    Vector* d_S);
     virtual int size();
     
   private:
@@ -25,6 +25,8 @@
 #include <Core/Grid/LinearInterpolator.h>
 #include <Core/Malloc/Allocator.h>
 
+#include <cmath>
+
 using namespace Uintah;
 using namespace std;
 
@@ -492,6 +494,135 @@ LinearInterpolator::findCellAndWeightsAndShapeDerivatives(const Point& pos,
   return 8;
 }
 
+//______________________________________________________________________
+//  Batched evaluation.  The cell index and fraction of BATCH_SIZE
+//  particles are computed in branch free loops before the weights are
+//  expanded into the caller's buffers, so both stages vectorize.
+int LinearInterpolator::findCellsAndWeights(const particleIndex* pidx, int n,
+                                            const constParticleVariable<Point>& px,
+                                            const constParticleVariable<Matrix3>&,
+                                            IntVector* ni,
+                                            double* S)
+{
+  const Level* level  = d_patch->getLevel();
+  const Point  anchor = level->getAnchor();
+  const Vector dcell  = level->dCell();
+
+  double fx[BATCH_SIZE], fy[BATCH_SIZE], fz[BATCH_SIZE];
+  int    ix[BATCH_SIZE], iy[BATCH_SIZE], iz[BATCH_SIZE];
+
+  for (int j0 = 0; j0 < n; j0 += BATCH_SIZE) {
+    const int nb = Min(n - j0, BATCH_SIZE);
+
+    positionsToIndex(anchor, dcell, pidx + j0, nb, px, fx, fy, fz);
+
+    for (int j = 0; j < nb; j++) {
+      ix[j] = static_cast<int>(std::floor(fx[j]));
+      iy[j] = static_cast<int>(std::floor(fy[j]));
+      iz[j] = static_cast<int>(std::floor(fz[j]));
+      fx[j] -= ix[j];
+      fy[j] -= iy[j];
+      fz[j] -= iz[j];
+    }
+
+    for (int j = 0; j < nb; j++) {
+      IntVector* j_ni = ni + 8*(j0 + j);
+      double*    j_S  = S  + 8*(j0 + j);
+      const double fx1 = 1-fx[j];
+      const double fy1 = 1-fy[j];
+      const double fz1 = 1-fz[j];
+      j_ni[0] = IntVector(ix[j],   iy[j],   iz[j]);
+      j_ni[1] = IntVector(ix[j],   iy[j],   iz[j]+1);
+      j_ni[2] = IntVector(ix[j],   iy[j]+1, iz[j]);
+      j_ni[3] = IntVector(ix[j],   iy[j]+1, iz[j]+1);
+      j_ni[4] = IntVector(ix[j]+1, iy[j],   iz[j]);
+      j_ni[5] = IntVector(ix[j]+1, iy[j],   iz[j]+1);
+      j_ni[6] = IntVector(ix[j]+1, iy[j]+1, iz[j]);
+      j_ni[7] = IntVector(ix[j]+1, iy[j]+1, iz[j]+1);
+      j_S[0] = fx1   * fy1   * fz1;
+      j_S[1] = fx1   * fy1   * fz[j];
+      j_S[2] = fx1   * fy[j] * fz1;
+      j_S[3] = fx1   * fy[j] * fz[j];
+      j_S[4] = fx[j] * fy1   * fz1;
+      j_S[5] = fx[j] * fy1   * fz[j];
+      j_S[6] = fx[j] * fy[j] * fz1;
+      j_S[7] = fx[j] * fy[j] * fz[j];
+    }
+  }
+  return 8;
+}
+
+//______________________________________________________________________
+//
+int
+LinearInterpolator::findCellsAndWeightsAndShapeDerivatives(const particleIndex* pidx,
+                                            int n,
+                                            const constParticleVariable<Point>& px,
+                                            const constParticleVariable<Matrix3>&,
+                                            IntVector* ni,
+                                            double* S,
+                                            Vector* d_S)
+{
+  const Level* level  = d_patch->getLevel();
+  const Point  anchor = level->getAnchor();
+  const Vector dcell  = level->dCell();
+
+  double fx[BATCH_SIZE], fy[BATCH_SIZE], fz[BATCH_SIZE];
+  int    ix[BATCH_SIZE], iy[BATCH_SIZE], iz[BATCH_SIZE];
+
+  for (int j0 = 0; j0 < n; j0 += BATCH_SIZE) {
+    const int nb = Min(n - j0, BATCH_SIZE);
+
+    positionsToIndex(anchor, dcell, pidx + j0, nb, px, fx, fy, fz);
+
+    for (int j = 0; j < nb; j++) {
+      ix[j] = static_cast<int>(std::floor(fx[j]));
+      iy[j] = static_cast<int>(std::floor(fy[j]));
+      iz[j] = static_cast<int>(std::floor(fz[j]));
+      fx[j] -= ix[j];
+      fy[j] -= iy[j];
+      fz[j] -= iz[j];
+    }
+
+    for (int j = 0; j < nb; j++) {
+      IntVector* j_ni = ni  + 8*(j0 + j);
+      double*    j_S  = S   + 8*(j0 + j);
+      Vector*    j_dS = d_S + 8*(j0 + j);
+      const double fx0 = fx[j];
+      const double fy0 = fy[j];
+      const double fz0 = fz[j];
+      const double fx1 = 1-fx0;
+      const double fy1 = 1-fy0;
+      const double fz1 = 1-fz0;
+      j_ni[0] = IntVector(ix[j],   iy[j],   iz[j]);
+      j_ni[1] = IntVector(ix[j],   iy[j],   iz[j]+1);
+      j_ni[2] = IntVector(ix[j],   iy[j]+1, iz[j]);
+      j_ni[3] = IntVector(ix[j],   iy[j]+1, iz[j]+1);
+      j_ni[4] = IntVector(ix[j]+1, iy[j],   iz[j]);
+      j_ni[5] = IntVector(ix[j]+1, iy[j],   iz[j]+1);
+      j_ni[6] = IntVector(ix[j]+1, iy[j]+1, iz[j]);
+      j_ni[7] = IntVector(ix[j]+1, iy[j]+1, iz[j]+1);
+      j_S[0] = fx1 * fy1 * fz1;
+      j_S[1] = fx1 * fy1 * fz0;
+      j_S[2] = fx1 * fy0 * fz1;
+      j_S[3] = fx1 * fy0 * fz0;
+      j_S[4] = fx0 * fy1 * fz1;
+      j_S[5] = fx0 * fy1 * fz0;
+      j_S[6] = fx0 * fy0 * fz1;
+      j_S[7] = fx0 * fy0 * fz0;
+      j_dS[0] = Vector(- fy1 * fz1, -fx1 * fz1, -fx1 * fy1);
+      j_dS[1] = Vector(- fy1 * fz0, -fx1 * fz0,  fx1 * fy1);
+      j_dS[2] = Vector(- fy0 * fz1,  fx1 * fz1, -fx1 * fy0);
+      j_dS[3] = Vector(- fy0 * fz0,  fx1 * fz0,  fx1 * fy0);
+      j_dS[4] = Vector(  fy1 * fz1, -fx0 * fz1, -fx0 * fy1);
+      j_dS[5] = Vector(  fy1 * fz0, -fx0 * fz0,  fx0 * fy1);
+      j_dS[6] = Vector(  fy0 * fz1,  fx0 * fz1, -fx0 * fy0);
+      j_dS[7] = Vector(  fy0 * fz0,  fx0 * fz0,  fx0 * fy0);
+    }
+  }
+  return 8;
+}
+
 int LinearInterpolator::size()
 {
   return d_size;
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include <Core/Grid/Variables/NCVariable.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
 namespace Uintah {
 
   class Patch;
@@ -70,6 +71,71 @@ namespace Uintah {
                                                      std::vector<Vector>& d_S,
                                                      const Matrix3& size) = 0;
 
+   //__________________________________
+   //  Batched versions of findCellAndWeights and
+   //  findCellAndWeightsAndShapeDerivatives.  The particles pidx[0..n)
+   //  are evaluated in one call and the nodes, weights and gradients of
+   //  the j'th one are written to ni[j*size()+k], S[j*size()+k] and
+   //  d_S[j*size()+k], k < size().  The caller owns the buffers, which
+   //  must hold n*size() entries.  Every particle gets size() slots; the
+   //  slots past a particle's node count hold its first node with a
+   //  zero weight and gradient.  Returns size().
+   //
+   //  The defaults loop over the per-particle calls.  Interpolators on
+   //  the hot MPM path override them with loops over BATCH_SIZE particles
+   //  that the compiler can vectorize.
+    static const int BATCH_SIZE = 64;
+
+    virtual int findCellsAndWeights(const particleIndex* pidx, int n,
+                                    const constParticleVariable<Point>& px,
+                                    const constParticleVariable<Matrix3>& psize,
+                                    IntVector* ni,
+                                    double* S)
+    {
+      const int nn = size();
+      std::vector<IntVector> p_ni(nn);
+      std::vector<double> p_S(nn);
+      for (int j = 0; j < n; j++) {
+        const particleIndex idx = pidx[j];
+        const int NN = findCellAndWeights(px[idx], p_ni, p_S, psize[idx]);
+        IntVector* j_ni = ni + j*nn;
+        double*    j_S  = S  + j*nn;
+        for (int k = 0; k < nn; k++) {
+          j_ni[k] = (k < NN) ? p_ni[k] : p_ni[0];
+          j_S[k]  = (k < NN) ? p_S[k]  : 0.0;
+        }
+      }
+      return nn;
+    };
+
+    virtual int findCellsAndWeightsAndShapeDerivatives(const particleIndex* pidx,
+                                    int n,
+                                    const constParticleVariable<Point>& px,
+                                    const constParticleVariable<Matrix3>& psize,
+                                    IntVector* ni,
+                                    double* S,
+                                    Vector* d_S)
+    {
+      const int nn = size();
+      std::vector<IntVector> p_ni(nn);
+      std::vector<double> p_S(nn);
+      std::vector<Vector> p_dS(nn);
+      for (int j = 0; j < n; j++) {
+        const particleIndex idx = pidx[j];
+        const int NN = findCellAndWeightsAndShapeDerivatives(px[idx], p_ni, p_S,
+                                                             p_dS, psize[idx]);
+        IntVector* j_ni = ni  + j*nn;
+        double*    j_S  = S   + j*nn;
+        Vector*    j_dS = d_S + j*nn;
+        for (int k = 0; k < nn; k++) {
+          j_ni[k] = (k < NN) ? p_ni[k] : p_ni[0];
+          j_S[k]  = (k < NN) ? p_S[k]  : 0.0;
+          j_dS[k] = (k < NN) ? p_dS[k] : Vector(0.0);
+        }
+      }
+      return nn;
+    };
+
    //__________________________________
    //  Needed for AMRMPM
     virtual void findCellAndWeights(const Point& p,std::vector<IntVector>& ni,
@@ -93,6 +159,24 @@ namespace Uintah {
                                             std::vector<Vector>& d_S,
                                             constNCVariable<Stencil7>& zoi) {};
     virtual int size() = 0;
+
+  protected:
+
+    //__________________________________
+    //  Level::positionToIndex for the particles pidx[0..n), written as
+    //  separate x, y and z arrays.  Used by the batched overrides.
+    static void positionsToIndex(const Point& anchor, const Vector& dcell,
+                                 const particleIndex* pidx, int n,
+                                 const constParticleVariable<Point>& px,
+                                 double* cx, double* cy, double* cz)
+    {
+      for (int j = 0; j < n; j++) {
+        const Point& p = px[pidx[j]];
+        cx[j] = (p.x() - anchor.x())/dcell.x();
+        cy[j] = (p.y() - anchor.y())/dcell.y();
+        cz[j] = (p.z() - anchor.z())/dcell.z();
+      }
+    };
   };
 }
 
@@ -30,6 +30,7 @@
 #include <Core/Util/Assert.h>
 #include <Core/Util/FancyAssert.h>
 #include <Core/Malloc/Allocator.h>
+#include <Core/Grid/Variables/Array3DataPool.h>
 
 #include <sci_defs/kokkos_defs.h>
 
@@ -37,6 +38,8 @@
 #include <Kokkos_Core.hpp>
 #endif //UINTAH_ENABLE_KOKKOS
 
+#include <new>
+
 namespace Uintah {
 
   /**************************************
@@ -61,6 +64,10 @@ namespace Uintah {
     DESCRIPTION
     Long description...
 
+    When the Array3DataPool is enabled the data and the two pointer tables
+    are carved out of a single 64 byte aligned block that is recycled
+    through the pool instead of being freed.
+
     WARNING
 
    ****************************************/
@@ -122,6 +129,7 @@ using KokkosData = Kokkos::View<T***, Kokkos::LayoutLeft, Kokkos::MemoryTraits<K
       T*    d_data;
       T***  d_data3;
       IntVector d_size;
+      size_t d_pool_bytes{0};   // size of the pooled block, 0 if allocated with new[]
 
       Array3Data& operator=(const Array3Data&);
       Array3Data(const Array3Data&);
@@ -206,9 +214,22 @@ using KokkosData = Kokkos::View<T***, Kokkos::LayoutLeft, Kokkos::MemoryTraits<K
     {
       long s=d_size.x()*d_size.y()*d_size.z();
       if(s){
-        d_data=new T[s];
-        d_data3=new T**[d_size.z()];
-        d_data3[0]=new T*[d_size.z()*d_size.y()];
+        if(Array3DataPool::isEnabled()){
+          // data first (aligned), followed by the z and z*y pointer tables
+          size_t data_bytes=((s*sizeof(T)+sizeof(T*)-1)/sizeof(T*))*sizeof(T*);
+          d_pool_bytes=data_bytes+d_size.z()*sizeof(T**)+d_size.z()*d_size.y()*sizeof(T*);
+          char* block=static_cast<char*>(Array3DataPool::allocate(d_pool_bytes));
+          d_data=reinterpret_cast<T*>(block);
+          for(long i=0;i<s;i++){
+            new (&d_data[i]) T;
+          }
+          d_data3=reinterpret_cast<T***>(block+data_bytes);
+          d_data3[0]=reinterpret_cast<T**>(block+data_bytes+d_size.z()*sizeof(T**));
+        } else {
+          d_data=new T[s];
+          d_data3=new T**[d_size.z()];
+          d_data3[0]=new T*[d_size.z()*d_size.y()];
+        }
         d_data3[0][0]=d_data;
         for(int i=1;i<d_size.z();i++){
           d_data3[i]=d_data3[i-1]+d_size.y();
@@ -225,7 +246,15 @@ using KokkosData = Kokkos::View<T***, Kokkos::LayoutLeft, Kokkos::MemoryTraits<K
   template<class T>
     Array3Data<T>::~Array3Data()
     {
-      if(d_data){
+      if(d_data && d_pool_bytes){
+        long s=d_size.x()*d_size.y()*d_size.z();
+        for(long i=0;i<s;i++){
+          d_data[i].~T();
+        }
+        Array3DataPool::release(d_data, d_pool_bytes);
+        d_data=0;
+        d_data3=0;
+      } else if(d_data){
         delete[] d_data;
         d_data=0;
         delete[] d_data3[0];
@@ -0,0 +1,152 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <Core/Grid/Variables/Array3DataPool.h>
+
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Malloc/AlignedAlloc.h>
+#include <Core/Parallel/MasterLock.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace Uintah;
+
+
+namespace {
+
+  // buffers of one size class released during the current and the previous generation
+  struct FreeList {
+    std::vector<void*> m_current;
+    std::vector<void*> m_previous;
+  };
+
+  MasterLock                                g_pool_mutex{};
+  std::unordered_map<size_t, FreeList>      g_free_lists{};
+
+  unsigned long g_hits{0};
+  unsigned long g_misses{0};
+  unsigned long g_cached_bytes{0};
+
+}
+
+bool Array3DataPool::s_enabled = false;
+
+//______________________________________________________________________
+//
+void *
+Array3DataPool::allocate( size_t bytes )
+{
+  const size_t size = roundUp(bytes);
+
+  {
+    std::lock_guard<MasterLock> pool_lock(g_pool_mutex);
+
+    auto iter = g_free_lists.find(size);
+    if (iter != g_free_lists.end()) {
+      std::vector<void*> & list = iter->second.m_current.empty() ? iter->second.m_previous : iter->second.m_current;
+      if (!list.empty()) {
+        void* buffer = list.back();
+        list.pop_back();
+        ++g_hits;
+        g_cached_bytes -= size;
+        return buffer;
+      }
+    }
+    ++g_misses;
+  }
+
+  void* buffer = alignedMalloc(size, ALIGNMENT);
+  if (buffer == nullptr) {
+    SCI_THROW(InternalError("Array3DataPool: failed to allocate an aligned grid variable buffer", __FILE__, __LINE__));
+  }
+  return buffer;
+}
+
+//______________________________________________________________________
+//
+void
+Array3DataPool::release( void * buffer, size_t bytes )
+{
+  const size_t size = roundUp(bytes);
+
+  std::lock_guard<MasterLock> pool_lock(g_pool_mutex);
+
+  g_free_lists[size].m_current.push_back(buffer);
+  g_cached_bytes += size;
+}
+
+//______________________________________________________________________
+//
+void
+Array3DataPool::newGeneration()
+{
+  std::lock_guard<MasterLock> pool_lock(g_pool_mutex);
+
+  for (auto iter = g_free_lists.begin(); iter != g_free_lists.end(); ++iter) {
+    FreeList & list = iter->second;
+    for (auto buffer : list.m_previous) {
+      alignedFree(buffer);
+    }
+    g_cached_bytes -= list.m_previous.size() * iter->first;
+
+    list.m_previous.clear();
+    list.m_previous.swap(list.m_current);
+  }
+}
+
+//______________________________________________________________________
+//
+void
+Array3DataPool::clear()
+{
+  std::lock_guard<MasterLock> pool_lock(g_pool_mutex);
+
+  for (auto iter = g_free_lists.begin(); iter != g_free_lists.end(); ++iter) {
+    for (auto buffer : iter->second.m_current) {
+      alignedFree(buffer);
+    }
+    for (auto buffer : iter->second.m_previous) {
+      alignedFree(buffer);
+    }
+  }
+  g_free_lists.clear();
+  g_cached_bytes = 0;
+}
+
+//______________________________________________________________________
+//
+void
+Array3DataPool::getStats( unsigned long & hits
+                        , unsigned long & misses
+                        , unsigned long & cached_bytes
+                        )
+{
+  std::lock_guard<MasterLock> pool_lock(g_pool_mutex);
+
+  hits         = g_hits;
+  misses       = g_misses;
+  cached_bytes = g_cached_bytes;
+}
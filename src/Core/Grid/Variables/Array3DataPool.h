@@ -0,0 +1,111 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CORE_GRID_VARIABLES_ARRAY3DATAPOOL_H
+#define CORE_GRID_VARIABLES_ARRAY3DATAPOOL_H
+
+#include <cstddef>
+
+namespace Uintah {
+
+/**************************************
+
+  CLASS
+    Array3DataPool
+
+    Recycles the storage of Array3Data (grid variable) buffers.
+
+  GENERAL INFORMATION
+
+    Array3DataPool.h
+
+    Department of Computer Science
+    University of Utah
+
+  KEYWORDS
+    Array3Data, memory pool
+
+  DESCRIPTION
+    Grid variables of the same type on the same patches have the same size
+    every timestep, so instead of returning a freed Array3Data buffer to the
+    system it is kept in a free list for its (64 byte rounded) size and handed
+    out to the next Array3Data of that size.  All buffers are 64 byte aligned.
+
+    Free lists are aged once per DataWarehouse generation: buffers that were
+    not reused during a whole generation are returned to the system, which
+    bounds the memory held by the pool to what the last two generations
+    released.
+
+    The pool is off by default (see <pool_grid_variables> in the Scheduler
+    block) in which case Array3Data allocates with new[] as before.
+
+  WARNING
+    Each Array3Data remembers where its storage came from, so the pool can
+    be enabled after grid variables were allocated, but not concurrently
+    with allocations.
+
+****************************************/
+
+class Array3DataPool {
+
+  public:
+
+    static constexpr size_t ALIGNMENT = 64;
+
+    static void setEnabled( bool enabled ) { s_enabled = enabled; }
+
+    static bool isEnabled() { return s_enabled; }
+
+    // Returns an ALIGNMENT aligned buffer of at least bytes, reusing a
+    // previously released buffer of the same size class when available.
+    static void * allocate( size_t bytes );
+
+    // Returns a buffer obtained from allocate( bytes ) to the pool.
+    static void release( void * buffer, size_t bytes );
+
+    // Ages the free lists, freeing the buffers not reused since the last call.
+    static void newGeneration();
+
+    // Frees all the buffers held by the pool.
+    static void clear();
+
+    static void getStats( unsigned long & hits
+                        , unsigned long & misses
+                        , unsigned long & cached_bytes
+                        );
+
+    static size_t roundUp( size_t bytes )
+    {
+      return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+  private:
+
+    static bool s_enabled;
+
+};
+
+} // namespace Uintah
+
+#endif // CORE_GRID_VARIABLES_ARRAY3DATAPOOL_H
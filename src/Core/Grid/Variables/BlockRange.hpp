@@ -32,6 +32,7 @@
 #endif //UINTAH_ENABLE_KOKKOS
 
 #include <cstddef>
+#include <vector>
 
 namespace Uintah {
 
@@ -26,7 +26,12 @@
 #define UINTAH_HOMEBREW_PARTICLEDATA_H
 
 #include <Core/Util/RefCounted.h>
+#include <Core/Grid/Variables/ParticleDataBlock.h>
 #include <Core/Grid/Variables/ParticleSubset.h> // For particleIndex
+#include <Core/Malloc/AlignedAlloc.h>
+
+#include <new>
+#include <utility>
 
 namespace Uintah {
 
@@ -52,7 +57,13 @@ KEYWORDS
    ParticleData
 
 DESCRIPTION
-   Long description...
+   Storage of a particle variable.  The data is 64 byte aligned and
+   either owned by the ParticleData or placed in a column of a
+   ParticleDataBlock shared with the other variables of the subset.
+
+   The storage keeps a capacity: shrinking and growing within the
+   capacity is done in place, growing beyond it reallocates with
+   amortized (1.5x) growth and moves the existing particles.
   
 WARNING
   
@@ -62,19 +73,36 @@ WARNING
    public:
       ParticleData();
       ParticleData( particleIndex size );
+      ParticleData( particleIndex size, ParticleDataBlock* block );
       virtual ~ParticleData();
 
       //////////
-      // Insert Documentation Here:
+      // Changes the number of particles, keeping the first min(size, newSize)
       void resize(int newSize) {
-        T* newdata = scinew T[newSize];
-        if(data){
-          int smaller = ((newSize < size ) ? newSize:size);
-          for(int i = 0; i < smaller; i++)
-            newdata[i] = data[i];
-          delete[] data;
+        if(newSize > capacity){
+          particleIndex newCapacity = capacity + capacity/2;
+          if(newCapacity < newSize){
+            newCapacity = newSize;
+          }
+          T* newdata = allocate(newCapacity);
+          for(particleIndex i = 0; i < size; i++){
+            new (&newdata[i]) T(std::move(data[i]));
+          }
+          for(particleIndex i = size; i < newSize; i++){
+            new (&newdata[i]) T;
+          }
+          release();
+          data = newdata;
+          capacity = newCapacity;
+        }
+        else {
+          for(particleIndex i = newSize; i < size; i++){
+            data[i].~T();
+          }
+          for(particleIndex i = size; i < newSize; i++){
+            new (&data[i]) T;
+          }
         }
-        data = newdata;
         size = newSize;
       }
 
@@ -82,31 +110,73 @@ WARNING
       ParticleData(const ParticleData<T>&);
       ParticleData<T>& operator=(const ParticleData<T>&);
       friend class ParticleVariable<T>;
+
+      static T* allocate(particleIndex n) {
+        void* mem = alignedMalloc((n > 0 ? n : 1) * sizeof(T), ParticleDataBlock::ALIGNMENT);
+        if(!mem){
+          throw std::bad_alloc();
+        }
+        return static_cast<T*>(mem);
+      }
+
+      // destroys the particles and gives back the storage
+      void release() {
+        if(data){
+          for(particleIndex i = 0; i < size; i++){
+            data[i].~T();
+          }
+          if(block){
+            if(block->removeReference()){
+              delete block;
+            }
+            block = 0;
+          }
+          else {
+            alignedFree(data);
+          }
+          data = 0;
+        }
+      }
       
       //////////
       // Insert Documentation Here:
       T* data;
       particleIndex size;
+      particleIndex capacity;
+      ParticleDataBlock* block;
    };
    
    template<class T>
       ParticleData<T>::ParticleData()
+      : data(0), size(0), capacity(0), block(0)
       {
-        data=0;
       }
    
    template<class T>
      ParticleData<T>::ParticleData(particleIndex size)
-     : size(size)
+     : size(size), capacity(size), block(0)
       {
-        data = scinew T[size];
+        data = allocate(size);
+        for(particleIndex i = 0; i < size; i++){
+          new (&data[i]) T;
+        }
+      }
+
+   template<class T>
+     ParticleData<T>::ParticleData(particleIndex size, ParticleDataBlock* block)
+     : size(size), capacity(size), block(block)
+      {
+        data = static_cast<T*>(block->getColumn(size, sizeof(T)));
+        block->addReference();
+        for(particleIndex i = 0; i < size; i++){
+          new (&data[i]) T;
+        }
       }
       
    template<class T>
       ParticleData<T>::~ParticleData()
       {
-        if(data)
-          delete[] data;
+        release();
       }
 
    template<class T>
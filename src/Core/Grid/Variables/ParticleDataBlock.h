@@ -0,0 +1,118 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CORE_GRID_VARIABLES_PARTICLEDATABLOCK_H
+#define CORE_GRID_VARIABLES_PARTICLEDATABLOCK_H
+
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Malloc/AlignedAlloc.h>
+#include <Core/Util/RefCounted.h>
+
+#include <cstddef>
+
+namespace Uintah {
+
+/**************************************
+
+  CLASS
+    ParticleDataBlock
+
+    One allocation holding the data of several particle variables.
+
+  GENERAL INFORMATION
+
+    ParticleDataBlock.h
+
+    Department of Computer Science
+    University of Utah
+
+  KEYWORDS
+    ParticleData, ParticleVariable
+
+  DESCRIPTION
+    Structure of arrays storage for the particle variables of a particle
+    subset: every variable gets a 64 byte aligned column of the block.
+    The block is reference counted by the ParticleData placed in it and is
+    freed with the last of them.  A column that needs to grow beyond its
+    size is moved out of the block by its ParticleData.
+
+    Used by the relocation so that the particle variables of a patch are
+    gathered into one allocation instead of one allocation per variable.
+
+  WARNING
+
+****************************************/
+
+class ParticleDataBlock : public RefCounted {
+
+  public:
+
+    static constexpr size_t ALIGNMENT = 64;
+
+    // Bytes of the (aligned) column of num_particles elements of elem_size bytes.
+    static size_t columnBytes( size_t num_particles, size_t elem_size )
+    {
+      return (num_particles * elem_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    ParticleDataBlock( size_t bytes )
+      : m_size{bytes}
+    {
+      m_buffer = static_cast<char*>(alignedMalloc(bytes > 0 ? bytes : ALIGNMENT, ALIGNMENT));
+      if (m_buffer == nullptr) {
+        SCI_THROW(InternalError("ParticleDataBlock: out of memory", __FILE__, __LINE__));
+      }
+    }
+
+    ~ParticleDataBlock()
+    {
+      alignedFree(m_buffer);
+    }
+
+    // Hands out the next column of the block.
+    void * getColumn( size_t num_particles, size_t elem_size )
+    {
+      const size_t bytes = columnBytes(num_particles, elem_size);
+      if (m_used + bytes > m_size) {
+        SCI_THROW(InternalError("ParticleDataBlock: block is full", __FILE__, __LINE__));
+      }
+      void * column = m_buffer + m_used;
+      m_used += bytes;
+      return column;
+    }
+
+  private:
+
+    ParticleDataBlock( const ParticleDataBlock & )            = delete;
+    ParticleDataBlock& operator=( const ParticleDataBlock & ) = delete;
+
+    char   * m_buffer{nullptr};
+    size_t   m_size{0};
+    size_t   m_used{0};
+
+};
+
+} // namespace Uintah
+
+#endif // CORE_GRID_VARIABLES_PARTICLEDATABLOCK_H
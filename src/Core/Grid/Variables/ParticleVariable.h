@@ -191,6 +191,10 @@ public:
     return getParticleSubset()->numParticles() * sizeof(T);
   }
 
+  virtual size_t getElementSize() const {
+    return sizeof(T);
+  }
+
   virtual bool copyOut(void* dst) const {
     void* src = (void*)this->getBasePointer();
     size_t numBytes = getDataSize();
@@ -406,7 +410,12 @@ template<class T>
       delete d_pset;
     d_pset = pset;
     pset->addReference();
-    d_pdata=scinew ParticleData<T>(pset->numParticles());
+    if(d_storage_block){
+      d_pdata=scinew ParticleData<T>(pset->numParticles(), d_storage_block);
+      d_storage_block=nullptr;
+    } else {
+      d_pdata=scinew ParticleData<T>(pset->numParticles());
+    }
     d_pdata->addReference();
     ASSERTEQ(subsets.size(), srcs.size());
     ParticleSubset::iterator dstiter = pset->begin();
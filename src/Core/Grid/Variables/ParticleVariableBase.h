@@ -38,6 +38,7 @@
 namespace Uintah {
   class BufferInfo;
   class OutputContext;
+  class ParticleDataBlock;
   class ParticleSubset;
   class Patch;
   class ProcessorGroup;
@@ -124,6 +125,15 @@ WARNING
 
       virtual size_t getDataSize() const = 0;
 
+      // Size of one particle's value in bytes.
+      virtual size_t getElementSize() const = 0;
+
+      // The next gather places the data in a column of block (shared with
+      // other variables of the same subset) rather than allocating it.
+      void setStorageBlock(ParticleDataBlock* block) {
+        d_storage_block = block;
+      }
+
       virtual bool copyOut(void* dst) const = 0;
 
       //////////
@@ -145,6 +155,7 @@ WARNING
       ParticleVariableBase& operator=(const ParticleVariableBase&);
       
       ParticleSubset*  d_pset;
+      ParticleDataBlock* d_storage_block{nullptr};
 
    private:
    };
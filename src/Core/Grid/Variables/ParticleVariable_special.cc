@@ -86,7 +86,12 @@ using namespace std;
     d_pset = pset;
     pset->addReference();
     
-    d_pdata = scinew ParticleData<Point>(pset->numParticles());
+    if(d_storage_block){
+      d_pdata = scinew ParticleData<Point>(pset->numParticles(), d_storage_block);
+      d_storage_block = nullptr;
+    } else {
+      d_pdata = scinew ParticleData<Point>(pset->numParticles());
+    }
     d_pdata->addReference();
     
     ASSERTEQ(subsets.size(), srcs.size());
@@ -31,6 +31,7 @@
 #include <Core/Exceptions/InvalidCompressionMode.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Malloc/Allocator.h>
+#include <Core/Util/Compression.h>
 #include <Core/Util/Endian.h>
 #include <Core/Util/FancyAssert.h>
 #include <Core/Util/SizeTypeConvert.h>
@@ -52,6 +53,22 @@
 using namespace Uintah;
 
 
+namespace {
+
+  // Read only stream buffer over memory owned by someone else, used to
+  // hand the (possibly memory mapped) bytes to readNormal() without
+  // first copying them into an istringstream.
+  class MemoryStreamBuffer : public std::streambuf {
+  public:
+    MemoryStreamBuffer( const char * data, size_t size )
+    {
+      char * begin = const_cast<char *>( data );
+      setg( begin, begin, begin + size );
+    }
+  };
+
+} // end anonymous namespace
+
 //______________________________________________________________________
 //
 Variable::Variable()
@@ -85,16 +102,19 @@ Variable::emit(       OutputContext & oc
 {
   bool use_gzip = false;
   bool used_gzip = false;
+  bool use_block = isBlockCompressionMode(compressionModeHint);
   if (compressionModeHint == "gzip") {
     use_gzip = true;
   }
-  else if (compressionModeHint != "" && compressionModeHint != "none") {
+  else if (!use_block && compressionModeHint != "" && compressionModeHint != "none") {
     std::cout << "Invalid Compression Mode - throwing exception...\n";
     SCI_THROW(InvalidCompressionMode(compressionModeHint, "", __FILE__, __LINE__));
   }
 
   used_gzip = use_gzip;
 
+  bool use_lossy = (oc.lossyAbsTolerance > 0.0 || oc.lossyRelTolerance > 0.0) && isLossyCompressible();
+
   std::ostringstream outstream;
   emitNormal(outstream, l, h, oc.varnode, oc.outputDoubleAsFloat);
 
@@ -102,17 +122,39 @@ Variable::emit(       OutputContext & oc
   std::string buffer;  // trying to avoid copying the strings back and forth
   std::string* writeoutString = &preGzip;
 
-  if (use_gzip) {
+  if (use_lossy) {
+    const IntVector size = h - l;
+    const int dims[3] = { size.x(), size.y(), size.z() };
+    use_lossy = lossyCompress(preGzip, elementSize(oc.outputDoubleAsFloat), dims,
+                              oc.lossyAbsTolerance, oc.lossyRelTolerance, buffer);
+  }
+
+  if (use_lossy) {
+    writeoutString = &buffer;
+  }
+  else if (use_gzip) {
     writeoutString = gzipCompress(&preGzip, &buffer);
     if (writeoutString != &buffer) {
       used_gzip = false;  // gzip wasn't better, so it wasn't used
     }
   }
+  else if (use_block) {
+    if (blockCompress(compressionModeHint, preGzip, elementSize(oc.outputDoubleAsFloat), buffer)) {
+      writeoutString = &buffer;
+    }
+    else {
+      use_block = false;  // compression wasn't better, so it wasn't used
+    }
+  }
 
   errno = -1;
   const char* writebuffer = (*writeoutString).c_str();
   size_t writebufferSize = (*writeoutString).size();
-  if (writebufferSize > 0) {
+  if (writebufferSize > 0 && oc.buffer) {
+    oc.buffer->append(writebuffer, writebufferSize);
+    oc.cur += writebufferSize;
+  }
+  else if (writebufferSize > 0) {
     ssize_t s = ::write(oc.fd, writebuffer, writebufferSize);
 
     if (s != (long)writebufferSize) {
@@ -126,7 +168,13 @@ Variable::emit(       OutputContext & oc
   }
 
   std::string compressionMode = compressionModeHint;
-  if (used_gzip != use_gzip) {
+  if (use_lossy) {
+    compressionMode = "lossy";
+  }
+  else if (isBlockCompressionMode(compressionModeHint) && !use_block) {
+    compressionMode = "";
+  }
+  else if (used_gzip != use_gzip) {
     // compression mode string changes
     if (used_gzip) {
       compressionMode = "gzip";
@@ -179,6 +227,67 @@ Variable::emitPIDX(       PIDXOutputContext & /* oc */
 }
 #endif
 
+//______________________________________________________________________
+//  Size in bytes of the elements written by emitNormal() - used to
+//  shuffle the bytes of floating point data before compression.
+size_t
+Variable::elementSize( bool outputDoubleAsFloat ) const
+{
+  const TypeDescription* td = virtualGetTypeDescription();
+  const TypeDescription* sub = td->getSubType() ? td->getSubType() : td;
+
+  switch (sub->getType()) {
+    case TypeDescription::double_type :
+    case TypeDescription::Point :
+    case TypeDescription::Vector :
+    case TypeDescription::Matrix3 :
+    case TypeDescription::Stencil4 :
+    case TypeDescription::Stencil7 :
+      return outputDoubleAsFloat ? sizeof(float) : sizeof(double);
+    case TypeDescription::float_type :
+    case TypeDescription::int_type :
+    case TypeDescription::IntVector :
+      return 4;
+    case TypeDescription::long_type :
+    case TypeDescription::long64_type :
+      return 8;
+    case TypeDescription::short_int_type :
+      return 2;
+    default :
+      return 1;
+  }
+}
+
+//______________________________________________________________________
+//  Lossy compression is only applied to grid variables of floating
+//  point data.
+bool
+Variable::isLossyCompressible() const
+{
+  const TypeDescription* td = virtualGetTypeDescription();
+
+  switch (td->getType()) {
+    case TypeDescription::CCVariable :
+    case TypeDescription::NCVariable :
+    case TypeDescription::SFCXVariable :
+    case TypeDescription::SFCYVariable :
+    case TypeDescription::SFCZVariable :
+      break;
+    default :
+      return false;
+  }
+
+  switch (td->getSubType()->getType()) {
+    case TypeDescription::double_type :
+    case TypeDescription::float_type :
+    case TypeDescription::Vector :
+    case TypeDescription::Matrix3 :
+      return true;
+    default :
+      return false;
+  }
+}
+
 //______________________________________________________________________
 //
 std::string*
@@ -227,11 +336,13 @@ Variable::read(       InputContext & ic
               )
 {
   bool use_gzip = false;
+  bool use_block = isBlockCompressionMode(compressionMode);
+  bool use_lossy = (compressionMode == "lossy");
 
   if (compressionMode == "gzip") {
     use_gzip = true;
   }
-  else if (compressionMode != "" && compressionMode != "none") {
+  else if (!use_block && !use_lossy && compressionMode != "" && compressionMode != "none") {
     SCI_THROW(InvalidCompressionMode(compressionMode, "", __FILE__, __LINE__));
   }
 
@@ -247,26 +358,34 @@ Variable::read(       InputContext & ic
   if (datasize > 0) {
     std::string data;
     std::string bufferStr;
-    std::string* uncompressedData = &data;
+    const char* rawData = nullptr;
 
-    data.resize(datasize);
-    ssize_t s = ::read(ic.fd, const_cast<char*>(data.c_str()), datasize);
+    if (ic.mapped) {
+      rawData = ic.mapped + ic.cur;
+    }
+    else {
+      data.resize(datasize);
+      ssize_t s = ::read(ic.fd, const_cast<char*>(data.c_str()), datasize);
 
-    if (s != datasize) {
-      std::cerr << "Error reading file: " << ic.filename << ", errno=" << errno << '\n';
-      SCI_THROW(ErrnoException("Variable::read (read call)", errno, __FILE__, __LINE__));
+      if (s != datasize) {
+        std::cerr << "Error reading file: " << ic.filename << ", errno=" << errno << '\n';
+        SCI_THROW(ErrnoException("Variable::read (read call)", errno, __FILE__, __LINE__));
+      }
+      rawData = data.c_str();
     }
 
     ic.cur += datasize;
 
+    const char* uncompressedData = rawData;
+    long        uncompressedSize = datasize;
+
     //__________________________________
     // gzip compression
     if (use_gzip) {
 
       // first read the uncompressed data size
-      std::istringstream compressedStream(data);
-      uint64_t uncompressed_size_64;
-      compressedStream.read((char*)&uncompressed_size_64, nByteMode);
+      uint64_t uncompressed_size_64 = 0;
+      memcpy(&uncompressed_size_64, rawData, nByteMode);
 
       unsigned long uncompressed_size = convertSizeType(&uncompressed_size_64, swapBytes, nByteMode);
       if (uncompressed_size > 1000000000) {
@@ -281,7 +400,7 @@ Variable::read(       InputContext & ic
         std::cout << "\n\n";
       }
 
-      const char* compressed_data = data.c_str() + nByteMode;
+      const char* compressed_data = rawData + nByteMode;
       long compressed_datasize = datasize - (long)(nByteMode);
 
       // casting from const char* below to char* -- use caution
@@ -293,13 +412,27 @@ Variable::read(       InputContext & ic
         printf("Uncompress error result is %d\n", result);
         throw InternalError("uncompress failed in Uintah::Variable::read", __FILE__, __LINE__);
       }
+    }
+    //__________________________________
+    // block compression (lz, shuffle-lz, shuffle-gzip)
+    else if (use_block) {
+      blockDecompress(compressionMode, rawData, datasize, bufferStr);
+    }
+    //__________________________________
+    // error bounded lossy compression
+    else if (use_lossy) {
+      lossyDecompress(rawData, datasize, bufferStr);
+    }
 
-      uncompressedData = &bufferStr;
+    if (use_gzip || use_block || use_lossy) {
+      uncompressedData = bufferStr.c_str();
+      uncompressedSize = bufferStr.size();
     }
 
     //__________________________________
-    // uncompressed
-    std::istringstream instream(*uncompressedData);
+    // uncompressed - read straight out of the buffer (no extra copy)
+    MemoryStreamBuffer streamBuffer(uncompressedData, uncompressedSize);
+    std::istream instream(&streamBuffer);
     readNormal(instream, swapBytes);
     ASSERT(instream.fail() == 0);
 
@@ -164,6 +164,13 @@ private:
                            , std::string* pBuffer
                            );
 
+  // Size in bytes of the elements written by emitNormal() (used by the
+  // byte shuffle of the block compression modes).
+  size_t elementSize( bool outputDoubleAsFloat ) const;
+
+  // True for grid variables of floating point data (lossy compression).
+  bool isLossyCompressible() const;
+
   // states that the variable is from another node - these variables (ghost cells, slabs, corners) are communicated via MPI
   bool d_foreign {false};
 
@@ -31,6 +31,7 @@
 SRCDIR := Core/Grid/Variables
 
 SRCS += \
+        $(SRCDIR)/Array3DataPool.cc             \
         $(SRCDIR)/Iterator.cc                   \
         $(SRCDIR)/CellIterator.cc               \
         $(SRCDIR)/NodeIterator.cc               \
@@ -28,9 +28,176 @@
 #include <Core/Malloc/Allocator.h>
 #include <Core/Math/MiscMath.h>
 #include <iostream>
+#include <cmath>
 
 using namespace Uintah;
 using namespace std;
+
+namespace {
+
+  //__________________________________
+  //  Positions of the eight particle domain corners relative to the
+  //  particle center, scaled so that no corner lies farther than lcrit
+  //  from the center.  This is the corner setup of findCellAndWeights,
+  //  shared with the batched versions.  dsize returns the (scaled)
+  //  particle size the corners were computed from.
+  void cpdiCorners(const Matrix3& size, double lcrit,
+                   Vector relative_node_location[8], Matrix3& dsize)
+  {
+    dsize=size;
+
+    relative_node_location[4]=Vector(-dsize(0,0)-dsize(0,1)+dsize(0,2),
+                                     -dsize(1,0)-dsize(1,1)+dsize(1,2),
+                                     -dsize(2,0)-dsize(2,1)+dsize(2,2))*0.5;
+    relative_node_location[5]=Vector( dsize(0,0)-dsize(0,1)+dsize(0,2),
+                                      dsize(1,0)-dsize(1,1)+dsize(1,2),
+                                      dsize(2,0)-dsize(2,1)+dsize(2,2))*0.5;
+    relative_node_location[6]=Vector( dsize(0,0)+dsize(0,1)+dsize(0,2),
+                                      dsize(1,0)+dsize(1,1)+dsize(1,2),
+                                      dsize(2,0)+dsize(2,1)+dsize(2,2))*0.5;
+    relative_node_location[7]=Vector(-dsize(0,0)+dsize(0,1)+dsize(0,2),
+                                     -dsize(1,0)+dsize(1,1)+dsize(1,2),
+                                     -dsize(2,0)+dsize(2,1)+dsize(2,2))*0.5;
+
+    double lcritsq = lcrit*lcrit;
+    Vector la = relative_node_location[6];
+    Vector lb = relative_node_location[5];
+    Vector lc = relative_node_location[7];
+    Vector ld = relative_node_location[4];
+
+    // Check to see if particles need to be scaled to stay within a
+    // circumscribing sphere of radius lcrit.  la, lb, lc, and ld
+    // are the distances from the particle center to the particle corners
+    // For example, for a 1 PPC case, the lN are sqrt(.5*.5+.5*.5+.5*.5)=.866
+    // All measurements are normalized to cell width.
+
+    // This scaling was implemented to prevent the need for arbitrary number
+    // of ghost nodes in parallel calculations, but its use may also improve
+    // accuracy.
+
+    int scale_flag = 0;
+    if(la.length2()>lcritsq){
+      la = la*(lcrit/la.length());
+      scale_flag = 1;
+    }
+    if(lb.length2()>lcritsq){
+      lb = lb*(lcrit/lb.length());
+      scale_flag = 1;
+    }
+    if(lc.length2()>lcritsq){
+      lc = lc*(lcrit/lc.length());
+      scale_flag = 1;
+    }
+    if(ld.length2()>lcritsq){
+      ld = ld*(lcrit/ld.length());
+      scale_flag = 1;
+    }
+
+    if(scale_flag==1){  // Don't do these calcs if the particle isn't needing to be rescaled
+      dsize(0,0)=.5*(la.x()+lb.x()-lc.x()-ld.x());
+      dsize(1,0)=.5*(la.y()+lb.y()-lc.y()-ld.y());
+      dsize(2,0)=.5*(la.z()+lb.z()-lc.z()-ld.z());
+
+      dsize(0,1)=.5*(la.x()-lb.x()+lc.x()-ld.x());
+      dsize(1,1)=.5*(la.y()-lb.y()+lc.y()-ld.y());
+      dsize(2,1)=.5*(la.z()-lb.z()+lc.z()-ld.z());
+
+      dsize(0,2)=.5*(la.x()+lb.x()+lc.x()+ld.x());
+      dsize(1,2)=.5*(la.y()+lb.y()+lc.y()+ld.y());
+      dsize(2,2)=.5*(la.z()+lb.z()+lc.z()+ld.z());
+
+
+      relative_node_location[0]=Vector(-dsize(0,0)-dsize(0,1)-dsize(0,2),
+                                       -dsize(1,0)-dsize(1,1)-dsize(1,2),
+                                       -dsize(2,0)-dsize(2,1)-dsize(2,2))*0.5;
+      relative_node_location[1]=Vector( dsize(0,0)-dsize(0,1)-dsize(0,2),
+                                        dsize(1,0)-dsize(1,1)-dsize(1,2),
+                                        dsize(2,0)-dsize(2,1)-dsize(2,2))*0.5;
+      relative_node_location[2]=Vector( dsize(0,0)+dsize(0,1)-dsize(0,2),
+                                        dsize(1,0)+dsize(1,1)-dsize(1,2),
+                                        dsize(2,0)+dsize(2,1)-dsize(2,2))*0.5;
+      relative_node_location[3]=Vector(-dsize(0,0)+dsize(0,1)-dsize(0,2),
+                                       -dsize(1,0)+dsize(1,1)-dsize(1,2),
+                                       -dsize(2,0)+dsize(2,1)-dsize(2,2))*0.5;
+      relative_node_location[4]=Vector(-dsize(0,0)-dsize(0,1)+dsize(0,2),
+                                       -dsize(1,0)-dsize(1,1)+dsize(1,2),
+                                       -dsize(2,0)-dsize(2,1)+dsize(2,2))*0.5;
+      relative_node_location[5]=Vector( dsize(0,0)-dsize(0,1)+dsize(0,2),
+                                        dsize(1,0)-dsize(1,1)+dsize(1,2),
+                                        dsize(2,0)-dsize(2,1)+dsize(2,2))*0.5;
+      relative_node_location[6]=Vector( dsize(0,0)+dsize(0,1)+dsize(0,2),
+                                        dsize(1,0)+dsize(1,1)+dsize(1,2),
+                                        dsize(2,0)+dsize(2,1)+dsize(2,2))*0.5;
+      relative_node_location[7]=Vector(-dsize(0,0)+dsize(0,1)+dsize(0,2),
+                                       -dsize(1,0)+dsize(1,1)+dsize(1,2),
+                                       -dsize(2,0)+dsize(2,1)+dsize(2,2))*0.5;
+    }else{ // Particle wasn't scaled, need to compute the RLN for the first 4 nodes
+      relative_node_location[0]=Vector(-dsize(0,0)-dsize(0,1)-dsize(0,2),
+                                       -dsize(1,0)-dsize(1,1)-dsize(1,2),
+                                       -dsize(2,0)-dsize(2,1)-dsize(2,2))*0.5;
+      relative_node_location[1]=Vector( dsize(0,0)-dsize(0,1)-dsize(0,2),
+                                        dsize(1,0)-dsize(1,1)-dsize(1,2),
+                                        dsize(2,0)-dsize(2,1)-dsize(2,2))*0.5;
+      relative_node_location[2]=Vector( dsize(0,0)+dsize(0,1)-dsize(0,2),
+                                        dsize(1,0)+dsize(1,1)-dsize(1,2),
+                                        dsize(2,0)+dsize(2,1)-dsize(2,2))*0.5;
+      relative_node_location[3]=Vector(-dsize(0,0)+dsize(0,1)-dsize(0,2),
+                                       -dsize(1,0)+dsize(1,1)-dsize(1,2),
+                                       -dsize(2,0)+dsize(2,1)-dsize(2,2))*0.5;
+    }
+  }
+
+  void cpdiCorners(const Matrix3& size, double lcrit,
+                   Vector relative_node_location[8])
+  {
+    Matrix3 dsize;
+    cpdiCorners(size, lcrit, relative_node_location, dsize);
+  }
+
+  //__________________________________
+  //  Gradient vectors of the eight corners, from the (scaled) particle
+  //  size.  Same as in findCellAndWeightsAndShapeDerivatives.
+  void cpdiGradientVectors(const Matrix3& dsize, Vector alpha[8])
+  {
+    Vector r1=Vector(dsize(0,0),dsize(1,0),dsize(2,0));
+    Vector r2=Vector(dsize(0,1),dsize(1,1),dsize(2,1));
+    Vector r3=Vector(dsize(0,2),dsize(1,2),dsize(2,2));
+    double volume = dsize.Determinant();
+    double one_over_4V = 1.0/(4.0*volume);
+
+    alpha[0][0]   =  one_over_4V* (-r2[1]*r3[2]+r2[2]*r3[1]+r1[1]*r3[2]-r1[2]*r3[1]-r1[1]*r2[2]+r1[2]*r2[1]);
+    alpha[0][1]   =  one_over_4V*(r2[0]*r3[2]-r2[2]*r3[0]-r1[0]*r3[2]+r1[2]*r3[0]+r1[0]*r2[2]-r1[2]*r2[0]);
+    alpha[0][2]   =  one_over_4V* (-r2[0]*r3[1]+r2[1]*r3[0]+r1[0]*r3[1]-r1[1]*r3[0]-r1[0]*r2[1]+r1[1]*r2[0]);
+
+    alpha[1][0]   =  one_over_4V*(r2[1]*r3[2]-r2[2]*r3[1]+r1[1]*r3[2]-r1[2]*r3[1]-r1[1]*r2[2]+r1[2]*r2[1]);
+    alpha[1][1]   =  one_over_4V*(-r2[0]*r3[2]+r2[2]*r3[0]-r1[0]*r3[2]+r1[2]*r3[0]+r1[0]*r2[2]-r1[2]*r2[0]);
+    alpha[1][2]   =  one_over_4V*(r2[0]*r3[1]-r2[1]*r3[0]+r1[0]*r3[1]-r1[1]*r3[0]-r1[0]*r2[1]+r1[1]*r2[0]);
+
+    alpha[2][0]   =  one_over_4V*(r2[1]*r3[2]-r2[2]*r3[1]-r1[1]*r3[2]+r1[2]*r3[1]-r1[1]*r2[2]+r1[2]*r2[1]);
+    alpha[2][1]   =  one_over_4V*(-r2[0]*r3[2]+r2[2]*r3[0]+r1[0]*r3[2]-r1[2]*r3[0]+r1[0]*r2[2]-r1[2]*r2[0]);
+    alpha[2][2]   =  one_over_4V*(r2[0]*r3[1]-r2[1]*r3[0]-r1[0]*r3[1]+r1[1]*r3[0]-r1[0]*r2[1]+r1[1]*r2[0]);
+
+    alpha[3][0]   =  one_over_4V*(-r2[1]*r3[2]+r2[2]*r3[1]-r1[1]*r3[2]+r1[2]*r3[1]-r1[1]*r2[2]+r1[2]*r2[1]);
+    alpha[3][1]   =  one_over_4V*(r2[0]*r3[2]-r2[2]*r3[0]+r1[0]*r3[2]-r1[2]*r3[0]+r1[0]*r2[2]-r1[2]*r2[0]);
+    alpha[3][2]   =  one_over_4V*(-r2[0]*r3[1]+r2[1]*r3[0]-r1[0]*r3[1]+r1[1]*r3[0]-r1[0]*r2[1]+r1[1]*r2[0]);
+
+    alpha[4][0]   =  one_over_4V*(-r2[1]*r3[2]+r2[2]*r3[1]+r1[1]*r3[2]-r1[2]*r3[1]+r1[1]*r2[2]-r1[2]*r2[1]);
+    alpha[4][1]   =  one_over_4V*(r2[0]*r3[2]-r2[2]*r3[0]-r1[0]*r3[2]+r1[2]*r3[0]-r1[0]*r2[2]+r1[2]*r2[0]);
+    alpha[4][2]   =  one_over_4V*(-r2[0]*r3[1]+r2[1]*r3[0]+r1[0]*r3[1]-r1[1]*r3[0]+r1[0]*r2[1]-r1[1]*r2[0]);
+
+    alpha[5][0]   =  one_over_4V*(r2[1]*r3[2]-r2[2]*r3[1]+r1[1]*r3[2]-r1[2]*r3[1]+r1[1]*r2[2]-r1[2]*r2[1]);
+    alpha[5][1]   =  one_over_4V*(-r2[0]*r3[2]+r2[2]*r3[0]-r1[0]*r3[2]+r1[2]*r3[0]-r1[0]*r2[2]+r1[2]*r2[0]);
+    alpha[5][2]   =  one_over_4V*(r2[0]*r3[1]-r2[1]*r3[0]+r1[0]*r3[1]-r1[1]*r3[0]+r1[0]*r2[1]-r1[1]*r2[0]);
+
+    alpha[6][0]   =  one_over_4V* (r2[1]*r3[2]-r2[2]*r3[1]-r1[1]*r3[2]+r1[2]*r3[1]+r1[1]*r2[2]-r1[2]*r2[1]);
+    alpha[6][1]   =  one_over_4V* (-r2[0]*r3[2]+r2[2]*r3[0]+r1[0]*r3[2]-r1[2]*r3[0]-r1[0]*r2[2]+r1[2]*r2[0]);
+    alpha[6][2]   =  one_over_4V* (r2[0]*r3[1]-r2[1]*r3[0]-r1[0]*r3[1]+r1[1]*r3[0]+r1[0]*r2[1]-r1[1]*r2[0]);
+
+    alpha[7][0]   =  one_over_4V*(-r2[1]*r3[2]+r2[2]*r3[1]-r1[1]*r3[2]+r1[2]*r3[1]+r1[1]*r2[2]-r1[2]*r2[1]);
+    alpha[7][1]   =  one_over_4V*(r2[0]*r3[2]-r2[2]*r3[0]+r1[0]*r3[2]-r1[2]*r3[0]-r1[0]*r2[2]+r1[2]*r2[0]);
+    alpha[7][2]   =  one_over_4V*(-r2[0]*r3[1]+r2[1]*r3[0]-r1[0]*r3[1]+r1[1]*r3[0]+r1[0]*r2[1]-r1[1]*r2[0]);
+  }
+}
     
 cpdiInterpolator::cpdiInterpolator()
 {
@@ -69,109 +236,8 @@ int cpdiInterpolator::findCellAndWeights(const Point& pos,
 {
   Point cellpos = d_patch->getLevel()->positionToIndex(Point(pos));
 
-  Matrix3 dsize=size;
   Vector relative_node_location[8];
-
-  relative_node_location[4]=Vector(-dsize(0,0)-dsize(0,1)+dsize(0,2),
-                                   -dsize(1,0)-dsize(1,1)+dsize(1,2),
-                                   -dsize(2,0)-dsize(2,1)+dsize(2,2))*0.5;
-  relative_node_location[5]=Vector( dsize(0,0)-dsize(0,1)+dsize(0,2),
-                                    dsize(1,0)-dsize(1,1)+dsize(1,2),
-                                    dsize(2,0)-dsize(2,1)+dsize(2,2))*0.5;
-  relative_node_location[6]=Vector( dsize(0,0)+dsize(0,1)+dsize(0,2),
-                                    dsize(1,0)+dsize(1,1)+dsize(1,2),
-                                    dsize(2,0)+dsize(2,1)+dsize(2,2))*0.5;
-  relative_node_location[7]=Vector(-dsize(0,0)+dsize(0,1)+dsize(0,2),
-                                   -dsize(1,0)+dsize(1,1)+dsize(1,2),
-                                   -dsize(2,0)+dsize(2,1)+dsize(2,2))*0.5;
-
-  double lcrit = d_lcrit;
-  double lcritsq = lcrit*lcrit;
-  Vector la = relative_node_location[6];
-  Vector lb = relative_node_location[5];
-  Vector lc = relative_node_location[7];
-  Vector ld = relative_node_location[4];
-
-// Check to see if particles need to be scaled to stay within a
-// circumscribing sphere of radius d_lcrit.  la, lb, lc, and ld
-// are the distances from the particle center to the particle corners
-// For example, for a 1 PPC case, the lN are sqrt(.5*.5+.5*.5+.5*.5)=.866
-// All measurements are normalized to cell width.
-
-// This scaling was implemented to prevent the need for arbitrary number
-// of ghost nodes in parallel calculations, but its use may also improve
-// accuracy.
-
-  int scale_flag = 0;
-  if(la.length2()>lcritsq){
-    la = la*(lcrit/la.length());
-    scale_flag = 1;
-  }
-  if(lb.length2()>lcritsq){
-    lb = lb*(lcrit/lb.length());
-    scale_flag = 1;
-  }
-  if(lc.length2()>lcritsq){
-    lc = lc*(lcrit/lc.length());
-    scale_flag = 1;
-  }
-  if(ld.length2()>lcritsq){
-    ld = ld*(lcrit/ld.length());
-    scale_flag = 1;
-  }
-
-  if(scale_flag==1){  // Don't do these calcs if the particle isn't needing to be rescaled
-    dsize(0,0)=.5*(la.x()+lb.x()-lc.x()-ld.x());
-    dsize(1,0)=.5*(la.y()+lb.y()-lc.y()-ld.y());
-    dsize(2,0)=.5*(la.z()+lb.z()-lc.z()-ld.z());
-
-    dsize(0,1)=.5*(la.x()-lb.x()+lc.x()-ld.x());
-    dsize(1,1)=.5*(la.y()-lb.y()+lc.y()-ld.y());
-    dsize(2,1)=.5*(la.z()-lb.z()+lc.z()-ld.z());
-
-    dsize(0,2)=.5*(la.x()+lb.x()+lc.x()+ld.x());
-    dsize(1,2)=.5*(la.y()+lb.y()+lc.y()+ld.y());
-    dsize(2,2)=.5*(la.z()+lb.z()+lc.z()+ld.z());
-
-
-    relative_node_location[0]=Vector(-dsize(0,0)-dsize(0,1)-dsize(0,2),
-                                     -dsize(1,0)-dsize(1,1)-dsize(1,2),
-                                     -dsize(2,0)-dsize(2,1)-dsize(2,2))*0.5;
-    relative_node_location[1]=Vector( dsize(0,0)-dsize(0,1)-dsize(0,2),
-                                      dsize(1,0)-dsize(1,1)-dsize(1,2),
-                                      dsize(2,0)-dsize(2,1)-dsize(2,2))*0.5;
-    relative_node_location[2]=Vector( dsize(0,0)+dsize(0,1)-dsize(0,2),
-                                      dsize(1,0)+dsize(1,1)-dsize(1,2),
-                                      dsize(2,0)+dsize(2,1)-dsize(2,2))*0.5;
-    relative_node_location[3]=Vector(-dsize(0,0)+dsize(0,1)-dsize(0,2),
-                                     -dsize(1,0)+dsize(1,1)-dsize(1,2),
-                                     -dsize(2,0)+dsize(2,1)-dsize(2,2))*0.5;
-    relative_node_location[4]=Vector(-dsize(0,0)-dsize(0,1)+dsize(0,2),
-                                     -dsize(1,0)-dsize(1,1)+dsize(1,2),
-                                     -dsize(2,0)-dsize(2,1)+dsize(2,2))*0.5;
-    relative_node_location[5]=Vector( dsize(0,0)-dsize(0,1)+dsize(0,2),
-                                      dsize(1,0)-dsize(1,1)+dsize(1,2),
-                                      dsize(2,0)-dsize(2,1)+dsize(2,2))*0.5;
-    relative_node_location[6]=Vector( dsize(0,0)+dsize(0,1)+dsize(0,2),
-                                      dsize(1,0)+dsize(1,1)+dsize(1,2),
-                                      dsize(2,0)+dsize(2,1)+dsize(2,2))*0.5;
-    relative_node_location[7]=Vector(-dsize(0,0)+dsize(0,1)+dsize(0,2),
-                                     -dsize(1,0)+dsize(1,1)+dsize(1,2),
-                                     -dsize(2,0)+dsize(2,1)+dsize(2,2))*0.5;
-  }else{ // Particle wasn't scaled, need to compute the RLN for the first 4 nodes
-    relative_node_location[0]=Vector(-dsize(0,0)-dsize(0,1)-dsize(0,2),
-                                     -dsize(1,0)-dsize(1,1)-dsize(1,2),
-                                     -dsize(2,0)-dsize(2,1)-dsize(2,2))*0.5;
-    relative_node_location[1]=Vector( dsize(0,0)-dsize(0,1)-dsize(0,2),
-                                      dsize(1,0)-dsize(1,1)-dsize(1,2),
-                                      dsize(2,0)-dsize(2,1)-dsize(2,2))*0.5;
-    relative_node_location[2]=Vector( dsize(0,0)+dsize(0,1)-dsize(0,2),
-                                      dsize(1,0)+dsize(1,1)-dsize(1,2),
-                                      dsize(2,0)+dsize(2,1)-dsize(2,2))*0.5;
-    relative_node_location[3]=Vector(-dsize(0,0)+dsize(0,1)-dsize(0,2),
-                                     -dsize(1,0)+dsize(1,1)-dsize(1,2),
-                                     -dsize(2,0)+dsize(2,1)-dsize(2,2))*0.5;
-  }
+  cpdiCorners(size, d_lcrit, relative_node_location);
 
   Vector current_corner_pos;
   double fx;
@@ -701,6 +767,164 @@ int cpdiInterpolator::findCellAndWeightsAndShapeDerivatives(const Point& pos,
   return 64;
 }
 
+//______________________________________________________________________
+//  Batched evaluation.  The corners of BATCH_SIZE particles are stored
+//  per corner in separate x, y and z arrays, then for each corner the
+//  cell index and the eight trilinear weights are computed across the
+//  whole batch in one vectorizable loop.
+int cpdiInterpolator::findCellsAndWeights(const particleIndex* pidx, int n,
+                                          const constParticleVariable<Point>& px,
+                                          const constParticleVariable<Matrix3>& psize,
+                                          IntVector* ni,
+                                          double* S)
+{
+  const Level* level  = d_patch->getLevel();
+  const Point  anchor = level->getAnchor();
+  const Vector dcell  = level->dCell();
+  const double one_over_8 = .125;
+
+  double cx[BATCH_SIZE], cy[BATCH_SIZE], cz[BATCH_SIZE];
+  double kx[8][BATCH_SIZE], ky[8][BATCH_SIZE], kz[8][BATCH_SIZE];
+
+  for (int j0 = 0; j0 < n; j0 += BATCH_SIZE) {
+    const int nb = Min(n - j0, BATCH_SIZE);
+
+    positionsToIndex(anchor, dcell, pidx + j0, nb, px, cx, cy, cz);
+
+    for (int j = 0; j < nb; j++) {
+      Vector relative_node_location[8];
+      cpdiCorners(psize[pidx[j0 + j]], d_lcrit, relative_node_location);
+      for (int i = 0; i < 8; i++) {
+        kx[i][j] = cx[j] + relative_node_location[i].x();
+        ky[i][j] = cy[j] + relative_node_location[i].y();
+        kz[i][j] = cz[j] + relative_node_location[i].z();
+      }
+    }
+
+    for (int i = 0; i < 8; i++) {
+      for (int j = 0; j < nb; j++) {
+        IntVector* j_ni = ni + 64*(j0 + j) + 8*i;
+        double*    j_S  = S  + 64*(j0 + j) + 8*i;
+
+        const int ix = static_cast<int>(std::floor(kx[i][j]));
+        const int iy = static_cast<int>(std::floor(ky[i][j]));
+        const int iz = static_cast<int>(std::floor(kz[i][j]));
+        const double fx  = kx[i][j]-ix;
+        const double fy  = ky[i][j]-iy;
+        const double fz  = kz[i][j]-iz;
+        const double fx1 = 1-fx;
+        const double fy1 = 1-fy;
+        const double fz1 = 1-fz;
+
+        j_ni[0] = IntVector(ix  , iy  , iz  );
+        j_ni[1] = IntVector(ix+1, iy  , iz  );
+        j_ni[2] = IntVector(ix+1, iy+1, iz  );
+        j_ni[3] = IntVector(ix  , iy+1, iz  );
+        j_ni[4] = IntVector(ix  , iy  , iz+1);
+        j_ni[5] = IntVector(ix+1, iy  , iz+1);
+        j_ni[6] = IntVector(ix+1, iy+1, iz+1);
+        j_ni[7] = IntVector(ix  , iy+1, iz+1);
+
+        j_S[0] = one_over_8*(fx1*fy1*fz1);
+        j_S[1] = one_over_8*(fx *fy1*fz1);
+        j_S[2] = one_over_8*(fx *fy *fz1);
+        j_S[3] = one_over_8*(fx1*fy *fz1);
+        j_S[4] = one_over_8*(fx1*fy1*fz );
+        j_S[5] = one_over_8*(fx *fy1*fz );
+        j_S[6] = one_over_8*(fx *fy *fz );
+        j_S[7] = one_over_8*(fx1*fy *fz );
+      }
+    }
+  }
+  return 64;
+}
+
+//______________________________________________________________________
+//  As findCellsAndWeights, with the gradient vectors of each particle's
+//  corners kept in per-corner arrays next to the corner positions.
+int cpdiInterpolator::findCellsAndWeightsAndShapeDerivatives(const particleIndex* pidx,
+                                          int n,
+                                          const constParticleVariable<Point>& px,
+                                          const constParticleVariable<Matrix3>& psize,
+                                          IntVector* ni,
+                                          double* S,
+                                          Vector* d_S)
+{
+  const Level* level  = d_patch->getLevel();
+  const Point  anchor = level->getAnchor();
+  const Vector dcell  = level->dCell();
+  const double one_over_8 = .125;
+
+  double cx[BATCH_SIZE], cy[BATCH_SIZE], cz[BATCH_SIZE];
+  double kx[8][BATCH_SIZE], ky[8][BATCH_SIZE], kz[8][BATCH_SIZE];
+  double ax[8][BATCH_SIZE], ay[8][BATCH_SIZE], az[8][BATCH_SIZE];
+
+  for (int j0 = 0; j0 < n; j0 += BATCH_SIZE) {
+    const int nb = Min(n - j0, BATCH_SIZE);
+
+    positionsToIndex(anchor, dcell, pidx + j0, nb, px, cx, cy, cz);
+
+    for (int j = 0; j < nb; j++) {
+      Vector  relative_node_location[8];
+      Vector  alpha[8];
+      Matrix3 dsize;
+      cpdiCorners(psize[pidx[j0 + j]], d_lcrit, relative_node_location, dsize);
+      cpdiGradientVectors(dsize, alpha);
+      for (int i = 0; i < 8; i++) {
+        kx[i][j] = cx[j] + relative_node_location[i].x();
+        ky[i][j] = cy[j] + relative_node_location[i].y();
+        kz[i][j] = cz[j] + relative_node_location[i].z();
+        ax[i][j] = alpha[i][0];
+        ay[i][j] = alpha[i][1];
+        az[i][j] = alpha[i][2];
+      }
+    }
+
+    for (int i = 0; i < 8; i++) {
+      for (int j = 0; j < nb; j++) {
+        IntVector* j_ni = ni  + 64*(j0 + j) + 8*i;
+        double*    j_S  = S   + 64*(j0 + j) + 8*i;
+        Vector*    j_dS = d_S + 64*(j0 + j) + 8*i;
+
+        const int ix = static_cast<int>(std::floor(kx[i][j]));
+        const int iy = static_cast<int>(std::floor(ky[i][j]));
+        const int iz = static_cast<int>(std::floor(kz[i][j]));
+        const double fx  = kx[i][j]-ix;
+        const double fy  = ky[i][j]-iy;
+        const double fz  = kz[i][j]-iz;
+        const double fx1 = 1-fx;
+        const double fy1 = 1-fy;
+        const double fz1 = 1-fz;
+
+        double phi[8];
+        phi[0] = fx1*fy1*fz1;
+        phi[1] = fx *fy1*fz1;
+        phi[2] = fx *fy *fz1;
+        phi[3] = fx1*fy *fz1;
+        phi[4] = fx1*fy1*fz;
+        phi[5] = fx *fy1*fz;
+        phi[6] = fx *fy *fz;
+        phi[7] = fx1*fy *fz;
+
+        j_ni[0] = IntVector(ix  , iy  , iz  );
+        j_ni[1] = IntVector(ix+1, iy  , iz  );
+        j_ni[2] = IntVector(ix+1, iy+1, iz  );
+        j_ni[3] = IntVector(ix  , iy+1, iz  );
+        j_ni[4] = IntVector(ix  , iy  , iz+1);
+        j_ni[5] = IntVector(ix+1, iy  , iz+1);
+        j_ni[6] = IntVector(ix+1, iy+1, iz+1);
+        j_ni[7] = IntVector(ix  , iy+1, iz+1);
+
+        for (int k = 0; k < 8; k++) {
+          j_S[k]  = one_over_8*phi[k];
+          j_dS[k] = Vector(ax[i][j]*phi[k], ay[i][j]*phi[k], az[i][j]*phi[k]);
+        }
+      }
+    }
+  }
+  return 64;
+}
+
 int cpdiInterpolator::size()
 {
   return d_size;
@@ -74,6 +74,20 @@ namespace Uintah {
                                                      std::vector<Vector>& d_S,
                                                      const Matrix3& size);
 
+    virtual int findCellsAndWeights(const particleIndex* pidx, int n,
+                                    const constParticleVariable<Point>& px,
+                                    const constParticleVariable<Matrix3>& psize,
+                                    IntVector* ni,
+                                    double* S);
+
+    virtual int findCellsAndWeightsAndShapeDerivatives(const particleIndex* pidx,
+                                    int n,
+                                    const constParticleVariable<Point>& px,
+                                    const constParticleVariable<Matrix3>& psize,
+                                    IntVector* ni,
+                                    double* S,
+                                    Vector* d_S);
+
     virtual int size();
 
     virtual void setLcrit(double lcrit){
@@ -0,0 +1,61 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CORE_MALLOC_ALIGNEDALLOC_H
+#define CORE_MALLOC_ALIGNEDALLOC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace Uintah {
+
+// Aligned allocation on top of malloc/free (rather than posix_memalign) so that it
+// also works when malloc/free are replaced by the SCI allocator. The pointer
+// returned by malloc is stored just in front of the aligned block.
+// alignment must be a power of two.
+
+inline void * alignedMalloc( size_t bytes, size_t alignment )
+{
+  void * raw = std::malloc(bytes + alignment + sizeof(void*));
+  if (raw == nullptr) {
+    return nullptr;
+  }
+
+  uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  reinterpret_cast<void**>(aligned)[-1] = raw;
+
+  return reinterpret_cast<void*>(aligned);
+}
+
+inline void alignedFree( void * ptr )
+{
+  if (ptr) {
+    std::free(reinterpret_cast<void**>(ptr)[-1]);
+  }
+}
+
+} // namespace Uintah
+
+#endif // CORE_MALLOC_ALIGNEDALLOC_H
@@ -0,0 +1,199 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+// PhiloxRand.h
+// Counter based random number generator (Philox4x32-10)
+//
+// Reference
+// J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, "Parallel Random
+// Numbers: As Easy as 1, 2, 3", Proceedings of the International Conference
+// for High Performance Computing, Networking, Storage and Analysis (SC11), 2011.
+//
+// Unlike MTRand there is no generator state that has to be carried from one
+// draw to the next.  Every random number is a pure function of a 64 bit key
+// and a 128 bit counter.  The counter is set from a cell index, a sample
+// (e.g. ray) index and a stream id with setStream(), so the numbers a sample
+// receives do not depend on the order in which the samples are computed, or
+// on which thread, patch or rank computes them.
+//
+// The counter and key are laid out so that no two numbers share an input:
+// the counter is (cell.x, cell.y, cell.z, sample), the first key word is the
+// key given to the constructor, and the second key word is the stream id in
+// its upper 8 bits and the index of the block of 4 numbers within the
+// sequence in its lower 24.  Philox is a bijection of the counter for each
+// key, and the outputs of distinct (counter, key) pairs pass BigCrush as
+// independent streams (see the reference), whether the pairs differ in the
+// counter or in the key.  So two sequences are independent as long as no
+// two draws use the same counter and key, which holds for the first 2^24
+// blocks (2^26 numbers) of each sequence; after that the block index wraps
+// and the sequence repeats.  Folding the block index into the key rather
+// than the counter leaves the whole counter to the cell and sample.
+//
+// The access functions mirror those of MTRand so the two generators can be
+// used interchangeably in templated code.
+
+#ifndef CORE_MATH_PHILOXRAND_H
+#define CORE_MATH_PHILOXRAND_H
+
+#include <Core/Geometry/IntVector.h>
+
+#include <cstdint>
+
+namespace Uintah {
+
+class PhiloxRand {
+
+public:
+  typedef uint32_t uint32;
+
+  // key: e.g. the timestep, so that each timestep receives new samples
+  PhiloxRand( const uint32 key = 0 )
+    : m_key( key )
+  {
+    setStream( IntVector( 0, 0, 0 ), 0, 0 );
+  }
+
+  //__________________________________
+  //  Position the generator at the first number of the sequence
+  //  belonging to (cell, sample, stream).  stream < 256.
+  void setStream( const IntVector & cell,
+                  const uint32      sample,
+                  const uint32      stream )
+  {
+    m_ctr[0] = (uint32) cell.x();
+    m_ctr[1] = (uint32) cell.y();
+    m_ctr[2] = (uint32) cell.z();
+    m_ctr[3] = sample;
+    m_stream = (stream & 0xFF) << 24;
+    m_block  = 0;
+    m_left   = 0;
+  }
+
+  // The sequence is fully determined by setStream(); seeding is a no-op
+  void seed( const uint32 ) {}
+
+  uint32 randInt()                                   // integer in [0,2^32-1]
+  {
+    if( m_left == 0 ){
+      generate();
+    }
+    return m_out[ 4 - m_left-- ];
+  }
+
+  uint32 randInt( const uint32 & n )                 // integer in [0,n] for n < 2^32
+  {
+    // same rejection scheme as MTRand::randInt( n )
+    uint32 used = n;
+    used |= used >> 1;
+    used |= used >> 2;
+    used |= used >> 4;
+    used |= used >> 8;
+    used |= used >> 16;
+
+    uint32 i;
+    do{
+      i = randInt() & used;
+    } while( i > n );
+    return i;
+  }
+
+  double rand()                                      // real number in [0,1]
+  { return double( randInt() ) * ( 1.0/4294967295.0 ); }
+
+  double rand( const double & n )                    // real number in [0,n]
+  { return rand() * n; }
+
+  double randExc()                                   // real number in [0,1)
+  { return double( randInt() ) * ( 1.0/4294967296.0 ); }
+
+  double randDblExc()                                // real number in (0,1)
+  { return ( double( randInt() ) + 0.5 ) * ( 1.0/4294967296.0 ); }
+
+  //__________________________________
+  //  The Philox4x32-10 bijection of ctr under key
+  static void philox( const uint32 ctr[4],
+                      const uint32 key[2],
+                      uint32       out[4] )
+  {
+    const uint32 M0 = 0xD2511F53;
+    const uint32 M1 = 0xCD9E8D57;
+    const uint32 W0 = 0x9E3779B9;
+    const uint32 W1 = 0xBB67AE85;
+
+    uint32 c0 = ctr[0];
+    uint32 c1 = ctr[1];
+    uint32 c2 = ctr[2];
+    uint32 c3 = ctr[3];
+    uint32 k0 = key[0];
+    uint32 k1 = key[1];
+
+    for( int r = 0; r < 10; r++ ){
+      if( r > 0 ){
+        k0 += W0;
+        k1 += W1;
+      }
+      const uint64_t p0 = (uint64_t) M0 * c0;
+      const uint64_t p1 = (uint64_t) M1 * c2;
+
+      const uint32 hi0 = (uint32)( p0 >> 32 );
+      const uint32 lo0 = (uint32)  p0;
+      const uint32 hi1 = (uint32)( p1 >> 32 );
+      const uint32 lo1 = (uint32)  p1;
+
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+  }
+
+private:
+
+  //__________________________________
+  //  Fill m_out with the next block of 4 numbers
+  void generate()
+  {
+    const uint32 key[2] = { m_key, m_stream | ( m_block & 0xFFFFFF ) };
+    philox( m_ctr, key, m_out );
+
+    m_block++;
+    m_left = 4;
+  }
+
+  uint32 m_key;
+  uint32 m_stream;              // stream id, upper 8 bits of the second key word
+  uint32 m_block;               // block of 4 numbers within a sequence
+  uint32 m_ctr[4];
+  uint32 m_out[4];
+  int    m_left;                // numbers left in m_out
+};
+
+} // End namespace Uintah
+
+#endif
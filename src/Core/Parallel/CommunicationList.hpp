@@ -160,16 +160,22 @@ public:
     return const_cast<MPI_Request*>(&m_request);
   }
 
+  // The status of the completed request, set by test() and wait()
+  MPI_Status& status() const
+  {
+    return m_status;
+  }
+
   bool test() const
   {
     int flag;
-    Uintah::MPI::Test(request(), &flag, MPI_STATUS_IGNORE);
+    Uintah::MPI::Test(request(), &flag, &m_status);
     return flag;
   }
 
   bool wait() const
   {
-    Uintah::MPI::Wait(request(), MPI_STATUS_IGNORE);
+    Uintah::MPI::Wait(request(), &m_status);
     return true;
   }
 
@@ -186,6 +192,7 @@ public:
 private:
 
   mutable MPI_Request          m_request{};
+  mutable MPI_Status           m_status{};
   std::unique_ptr<CommHandle>  m_handle{};
 
 };
@@ -26,6 +26,7 @@
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Parallel/Parallel.h>
+#include <Core/Parallel/SharedMemoryExchange.h>
 #include <Core/Util/Assert.h>
 #include <Core/Util/RefCounted.h>
 
@@ -60,16 +61,45 @@ PackBufferInfo::get_type( void         *& out_buf
 {
   ASSERT(count() > 0);
   if (!m_have_datatype) {
-    int packed_size;
-    int total_packed_size = 0;
-    for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
-      if (m_counts[i] > 0) {
-        Uintah::MPI::Pack_size(m_counts[i], m_datatypes[i], comm, &packed_size);
-        total_packed_size += packed_size;
+    int total_packed_size = packedSize(comm);
+
+    m_packed_buffer = scinew PackedBuffer(total_packed_size);
+    m_packed_buffer->addReference();
+
+    m_datatype = MPI_PACKED;
+    m_count = total_packed_size;
+    m_buffer = m_packed_buffer->getBuffer();
+    m_have_datatype = true;
+  }
+
+  out_buf = m_buffer;
+  out_count = m_count;
+  out_datatype = m_datatype;
+}
+
+//_____________________________________________________________________________
+//
+void
+PackBufferInfo::get_type( void         *& out_buf
+                        , int&            out_count
+                        , MPI_Datatype  & out_datatype
+                        , MPI_Comm        comm
+                        , PackedBuffer *& buffer
+                        )
+{
+  ASSERT(count() > 0);
+  if (!m_have_datatype) {
+    int total_packed_size = packedSize(comm);
+
+    if (buffer == nullptr || buffer->getBufSize() < total_packed_size) {
+      if (buffer && buffer->removeReference()) {
+        delete buffer;
       }
+      buffer = scinew PackedBuffer(total_packed_size);
+      buffer->addReference();
     }
 
-    m_packed_buffer = scinew PackedBuffer(total_packed_size);
+    m_packed_buffer = buffer;
     m_packed_buffer->addReference();
 
     m_datatype = MPI_PACKED;
@@ -83,6 +113,22 @@ PackBufferInfo::get_type( void         *& out_buf
   out_datatype = m_datatype;
 }
 
+//_____________________________________________________________________________
+//
+int
+PackBufferInfo::packedSize( MPI_Comm comm )
+{
+  int packed_size;
+  int total_packed_size = 0;
+  for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
+    if (m_counts[i] > 0) {
+      Uintah::MPI::Pack_size(m_counts[i], m_datatypes[i], comm, &packed_size);
+      total_packed_size += packed_size;
+    }
+  }
+  return total_packed_size;
+}
+
 //_____________________________________________________________________________
 //
 void
@@ -120,6 +166,59 @@ PackBufferInfo::pack( MPI_Comm comm, int & out_count )
   addSendlist(m_packed_buffer);
 }
 
+//_____________________________________________________________________________
+//
+bool
+PackBufferInfo::packShared( void         *& out_buf
+                          , int&            out_count
+                          , MPI_Datatype  & out_datatype
+                          , MPI_Comm        comm
+                          )
+{
+  ASSERT(count() > 0);
+  ASSERT(!m_have_datatype);
+
+  int total_packed_size = packedSize(comm);
+  if (total_packed_size < static_cast<int>(SharedMemoryExchange::s_min_message_bytes)) {
+    return false;
+  }
+
+  SharedMemoryExchange::Message message;
+  char* data = SharedMemoryExchange::allocate(total_packed_size, message);
+  if (data == nullptr) {
+    return false;
+  }
+
+  int position = 0;
+  for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
+    if (m_counts[i] > 0) {
+      Uintah::MPI::Pack(m_start_bufs[i], m_counts[i], m_datatypes[i], data, total_packed_size, &position, comm);
+    }
+  }
+  message.m_size = position;
+  SharedMemoryExchange::publish();
+
+  // Only the Message goes through MPI
+  m_packed_buffer = scinew PackedBuffer(sizeof(message));
+  m_packed_buffer->addReference();
+  memcpy(m_packed_buffer->getBuffer(), &message, sizeof(message));
+
+  m_datatype = MPI_PACKED;
+  m_count = sizeof(message);
+  m_buffer = m_packed_buffer->getBuffer();
+  m_have_datatype = true;
+
+  // The data is already copied, so the variables need not be kept around until it is sent.
+  delete m_send_list;
+  m_send_list = nullptr;
+  addSendlist(m_packed_buffer);
+
+  out_buf = m_buffer;
+  out_count = m_count;
+  out_datatype = m_datatype;
+  return true;
+}
+
 //_____________________________________________________________________________
 //
 void
@@ -127,13 +226,26 @@ PackBufferInfo::unpack( MPI_Comm comm, MPI_Status & status )
 {
   ASSERT(m_have_datatype);
 
+  void* buffer = m_buffer;
   unsigned long bufsize = m_packed_buffer->getBufSize();
 
+  // A same node sender may have left the data in its SharedMemoryExchange segment
+  SharedMemoryExchange::Message message;
+  bool shared = SharedMemoryExchange::isMessage(comm, status, m_buffer, m_count, message);
+  if (shared) {
+    buffer = const_cast<char*>(SharedMemoryExchange::peerData(status.MPI_SOURCE, message));
+    bufsize = message.m_size;
+  }
+
   int position = 0;
   for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
     if (m_counts[i] > 0) {
-      Uintah::MPI::Unpack(m_buffer, bufsize, &position, m_start_bufs[i], m_counts[i], m_datatypes[i], comm);
+      Uintah::MPI::Unpack(buffer, bufsize, &position, m_start_bufs[i], m_counts[i], m_datatypes[i], comm);
     }
   }
+
+  if (shared) {
+    SharedMemoryExchange::release(status.MPI_SOURCE, message);
+  }
 }
 
@@ -69,6 +69,15 @@ class PackBufferInfo : public BufferInfo {
                  , MPI_Comm        comm
                  );
 
+    // Same as above, but packs into (or receives into) the caller owned buffer, which
+    // is (re)allocated when it is too small. Used for persistent MPI requests.
+    void get_type( void         *& out_buf
+                 , int&            out_count
+                 , MPI_Datatype  & out_datatype
+                 , MPI_Comm        comm
+                 , PackedBuffer *& buffer
+                 );
+
     void get_type( void         *&
                  , int           &
                  , MPI_Datatype  &
@@ -76,6 +85,15 @@ class PackBufferInfo : public BufferInfo {
 
     void pack( MPI_Comm comm, int & out_count );
 
+    // Packs into this rank's SharedMemoryExchange segment instead of a private buffer,
+    // and returns the SharedMemoryExchange::Message to send in place of the data.
+    // Returns false (and does nothing) if the data is too small or the segment is full.
+    bool packShared( void         *& out_buf
+                   , int&            out_count
+                   , MPI_Datatype  & out_datatype
+                   , MPI_Comm        comm
+                   );
+
     void unpack( MPI_Comm comm, MPI_Status & status );
 
     // PackBufferInfo is to be an AfterCommuncationHandler object for the
@@ -89,6 +107,8 @@ class PackBufferInfo : public BufferInfo {
 
   private:
 
+    int packedSize( MPI_Comm comm );
+
     // disable copy and assignment
     PackedBuffer * m_packed_buffer{nullptr};
 
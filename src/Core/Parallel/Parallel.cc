@@ -27,6 +27,7 @@
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Parallel/ProcessorGroup.h>
+#include <Core/Parallel/SharedMemoryExchange.h>
 #include <Core/Parallel/UintahMPI.h>
 
 #include <sci_defs/kokkos_defs.h>
@@ -414,6 +415,8 @@ Parallel::finalizeManager( Circumstances circumstances /* = NormalShutdown */ )
     Uintah::MPI::Abort(Uintah::worldComm_, errorcode);
   }
   else {
+    SharedMemoryExchange::finalize();
+
     int status;
     if ((status = Uintah::MPI::Finalize()) != MPI_SUCCESS) {
       MpiError(const_cast<char*>("Uintah::MPI::Finalize"), status);
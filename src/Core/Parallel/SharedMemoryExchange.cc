@@ -0,0 +1,314 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Parallel/SharedMemoryExchange.h>
+#include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Util/Assert.h>
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace Uintah;
+
+namespace {
+
+  // Precedes the data of each slot.  Written by the sender when the slot is
+  // handed out and set by the receiver once it has read the data.
+  struct alignas(SharedMemoryExchange::SlotRing::s_align) SlotHeader {
+    std::atomic<int> m_released{0};
+  };
+
+  const uint64_t g_message_magic = 0x55534d454d584348ull;  // "USMEMXCH"
+
+  bool                 g_active{false};
+  MPI_Comm             g_comm{MPI_COMM_NULL};
+  MPI_Comm             g_node_comm{MPI_COMM_NULL};
+  MPI_Win              g_window{MPI_WIN_NULL};
+  char               * g_segment{nullptr};
+  size_t               g_segment_bytes{0};
+
+  // start of the segment of each rank of g_comm, nullptr when off node
+  std::vector<char*>   g_peer_segments;
+
+  SharedMemoryExchange::SlotRing g_slots;
+  Uintah::MasterLock             g_slots_lock{};
+
+  SlotHeader * slotHeader( char * segment, size_t offset )
+  {
+    return reinterpret_cast<SlotHeader*>(segment + offset);
+  }
+}
+
+//_____________________________________________________________________________
+//
+void
+SharedMemoryExchange::initialize( MPI_Comm comm, size_t segmentBytes )
+{
+  if (g_active || segmentBytes == 0) {
+    return;
+  }
+
+  int rank;
+  int nRanks;
+  Uintah::MPI::Comm_rank(comm, &rank);
+  Uintah::MPI::Comm_size(comm, &nRanks);
+
+  MPI_Comm nodeComm = MPI_COMM_NULL;
+  int      ok       = MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm) == MPI_SUCCESS;
+  Uintah::MPI::Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+  if (!ok) {
+    if (nodeComm != MPI_COMM_NULL) {
+      Uintah::MPI::Comm_free(&nodeComm);
+    }
+    proc0cout << "WARNING: MPI_Comm_split_type failed, sending all task graph messages through MPI\n";
+    return;
+  }
+
+  int nodeSize;
+  Uintah::MPI::Comm_size(nodeComm, &nodeSize);
+  if (nodeSize == 1) {
+    Uintah::MPI::Comm_free(&nodeComm);
+    return;
+  }
+
+  segmentBytes = (segmentBytes + sizeof(SlotHeader) - 1) / sizeof(SlotHeader) * sizeof(SlotHeader);
+
+  // Let each segment be placed near its owner rather than in one block.
+  MPI_Info info;
+  Uintah::MPI::Info_create(&info);
+  Uintah::MPI::Info_set(info, const_cast<char*>("alloc_shared_noncontig"), const_cast<char*>("true"));
+  char    * segment = nullptr;
+  MPI_Win   window  = MPI_WIN_NULL;
+  ok = MPI_Win_allocate_shared(segmentBytes, 1, info, nodeComm, &segment, &window) == MPI_SUCCESS && segment != nullptr;
+  Uintah::MPI::Info_free(&info);
+
+  // Every rank of the node has to have its segment, or none of them uses the window.
+  Uintah::MPI::Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, nodeComm);
+  if (!ok) {
+    if (window != MPI_WIN_NULL) {
+      MPI_Win_free(&window);
+    }
+    Uintah::MPI::Comm_free(&nodeComm);
+    proc0cout << "WARNING: MPI_Win_allocate_shared failed, sending all task graph messages through MPI\n";
+    return;
+  }
+
+  g_segment = segment;
+  g_window  = window;
+
+  // One passive target epoch for the whole run, the slots are synchronized
+  // with MPI_Win_sync and the Messages.
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, g_window);
+
+  std::vector<int> nodeRanks(nodeSize);
+  Uintah::MPI::Allgather(&rank, 1, MPI_INT, &nodeRanks[0], 1, MPI_INT, nodeComm);
+
+  g_peer_segments.assign(nRanks, nullptr);
+  for (int i = 0; i < nodeSize; i++) {
+    MPI_Aint size;
+    int      dispUnit;
+    char   * base;
+    MPI_Win_shared_query(g_window, i, &size, &dispUnit, &base);
+    g_peer_segments[nodeRanks[i]] = base;
+  }
+
+  g_comm          = comm;
+  g_node_comm     = nodeComm;
+  g_segment_bytes = segmentBytes;
+  g_active        = true;
+  g_slots.reset(g_segment, g_segment_bytes);
+}
+
+//_____________________________________________________________________________
+//
+void
+SharedMemoryExchange::finalize()
+{
+  if (!g_active) {
+    return;
+  }
+
+  g_active = false;
+  g_slots.reset(nullptr, 0);
+  g_peer_segments.clear();
+
+  MPI_Win_unlock_all(g_window);
+  MPI_Win_free(&g_window);
+  Uintah::MPI::Comm_free(&g_node_comm);
+
+  g_segment = nullptr;
+  g_comm    = MPI_COMM_NULL;
+}
+
+//_____________________________________________________________________________
+//
+bool
+SharedMemoryExchange::onNode( MPI_Comm comm, int rank )
+{
+  return g_active && comm == g_comm && g_peer_segments[rank] != nullptr;
+}
+
+//_____________________________________________________________________________
+//
+char *
+SharedMemoryExchange::allocate( size_t bytes, Message & message )
+{
+  ASSERT(g_active);
+
+  size_t offset;
+  char * data;
+  {
+    std::lock_guard<Uintah::MasterLock> slots_lock(g_slots_lock);
+    data = g_slots.allocate(bytes, offset);
+  }
+
+  if (data != nullptr) {
+    message.m_magic  = g_message_magic;
+    message.m_offset = offset;
+    message.m_size   = bytes;
+  }
+
+  return data;
+}
+
+//_____________________________________________________________________________
+//
+void
+SharedMemoryExchange::publish()
+{
+  MPI_Win_sync(g_window);
+}
+
+//_____________________________________________________________________________
+//
+bool
+SharedMemoryExchange::isMessage( MPI_Comm           comm
+                               , const MPI_Status & status
+                               , const void       * buffer
+                               , size_t             expectedBytes
+                               , Message          & message
+                               )
+{
+  // The data is never sent this way when it would not be told apart from a Message.
+  if (!g_active || comm != g_comm || expectedBytes < s_min_message_bytes) {
+    return false;
+  }
+
+  MPI_Status received = status;
+  int        bytes;
+  Uintah::MPI::Get_count(&received, MPI_PACKED, &bytes);
+  if (bytes != static_cast<int>(sizeof(Message))) {
+    return false;
+  }
+
+  std::memcpy(&message, buffer, sizeof(Message));
+  return message.m_magic == g_message_magic && g_peer_segments[status.MPI_SOURCE] != nullptr;
+}
+
+//_____________________________________________________________________________
+//
+const char *
+SharedMemoryExchange::peerData( int rank, const Message & message )
+{
+  ASSERT(g_active && g_peer_segments[rank] != nullptr);
+
+  // pairs with the sender's publish()
+  MPI_Win_sync(g_window);
+
+  return g_peer_segments[rank] + message.m_offset + sizeof(SlotHeader);
+}
+
+//_____________________________________________________________________________
+//
+void
+SharedMemoryExchange::release( int rank, const Message & message )
+{
+  SlotRing::release(g_peer_segments[rank], message.m_offset);
+}
+
+//_____________________________________________________________________________
+//
+void
+SharedMemoryExchange::SlotRing::reset( char * segment, size_t bytes )
+{
+  m_segment = segment;
+  m_bytes   = bytes;
+  m_slots.clear();
+}
+
+//_____________________________________________________________________________
+//
+char *
+SharedMemoryExchange::SlotRing::allocate( size_t bytes, size_t & offset )
+{
+  const size_t slotBytes = (sizeof(SlotHeader) + bytes + sizeof(SlotHeader) - 1) / sizeof(SlotHeader) * sizeof(SlotHeader);
+
+  // reclaim the oldest slots the receivers are done with
+  while (!m_slots.empty() && slotHeader(m_segment, m_slots.front().first)->m_released.load(std::memory_order_acquire)) {
+    m_slots.pop_front();
+  }
+
+  if (m_slots.empty()) {
+    if (slotBytes > m_bytes) {
+      return nullptr;
+    }
+    offset = 0;
+  }
+  else {
+    const size_t head = m_slots.front().first;
+    const size_t tail = m_slots.back().first + m_slots.back().second;
+
+    if (tail > head && tail + slotBytes <= m_bytes) {
+      offset = tail;
+    }
+    else if (tail > head && slotBytes <= head) {
+      offset = 0;                                    // wrap around
+    }
+    else if (tail <= head && tail + slotBytes <= head) {
+      offset = tail;
+    }
+    else {
+      return nullptr;                                // full
+    }
+  }
+
+  m_slots.emplace_back(offset, slotBytes);
+  new (m_segment + offset) SlotHeader();
+
+  return m_segment + offset + sizeof(SlotHeader);
+}
+
+//_____________________________________________________________________________
+//
+void
+SharedMemoryExchange::SlotRing::release( char * segment, size_t offset )
+{
+  slotHeader(segment, offset)->m_released.store(1, std::memory_order_release);
+}
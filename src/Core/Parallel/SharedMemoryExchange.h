@@ -0,0 +1,156 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CORE_PARALLEL_SHAREDMEMORYEXCHANGE_H
+#define CORE_PARALLEL_SHAREDMEMORYEXCHANGE_H
+
+#include <Core/Parallel/UintahMPI.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   SharedMemoryExchange
+
+DESCRIPTION
+   Intra-node transport for task graph messages.
+
+   Every rank owns a segment of an MPI-3 shared memory window that spans
+   the ranks of its node.  A message to a rank on the same node is packed
+   straight into a slot of the sender's segment, and only a small Message
+   (the slot's offset and size) travels through MPI, in place of the data
+   and with the same tag.  The receiver unpacks directly from the sender's
+   segment and then releases the slot, so the data is copied once instead
+   of going through the MPI library's own buffers.
+
+   The slots are handed out in order, like a ring buffer, and are reused
+   once they have been released.  When a segment is full (or the message
+   is small) the sender simply sends the data through MPI as usual, which
+   the receiver tells apart by the size of what it got.
+
+****************************************/
+
+class SharedMemoryExchange {
+
+  public:
+
+    // Sent through MPI in place of the data of a message that is in the
+    // sender's segment.
+    struct Message {
+      uint64_t m_magic;
+      uint64_t m_offset;
+      uint64_t m_size;
+    };
+
+    // Messages smaller than this are not worth a slot.
+    static const size_t s_min_message_bytes = 4096;
+
+    // The slots of one segment.  Each slot starts with a header, s_align
+    // bytes long, that the receiver sets in release(), and a slot is only
+    // reclaimed once it and every slot handed out before it are released.
+    // Not thread safe.
+    class SlotRing {
+
+      public:
+
+        static const size_t s_align = 64;
+
+        // Hands out slots of the 'bytes' of 'segment' from its start.
+        void reset( char * segment, size_t bytes );
+
+        // Returns where to write 'bytes' of data and sets 'offset' to the
+        // slot's offset in the segment, or returns nullptr if it is full.
+        char * allocate( size_t bytes, size_t & offset );
+
+        // Marks the slot at 'offset' of 'segment' as read.
+        static void release( char * segment, size_t offset );
+
+      private:
+
+        char                                   * m_segment{nullptr};
+        size_t                                   m_bytes{0};
+        std::deque< std::pair<size_t, size_t> >  m_slots;  // (offset, bytes), oldest first
+    };
+
+    //////////
+    // Allocates the node shared window, 'segmentBytes' per rank.  Collective
+    // over 'comm'.  Does nothing if already initialized, or on a node with a
+    // single rank, and leaves every message to MPI if the window can not be
+    // allocated.
+    static void initialize( MPI_Comm comm, size_t segmentBytes );
+
+    //////////
+    // Frees the window.  Collective over the ranks that initialized it.
+    static void finalize();
+
+    //////////
+    // Returns true if messages to 'rank' of 'comm' can go through the segment.
+    static bool onNode( MPI_Comm comm, int rank );
+
+    //////////
+    // Reserves a slot of 'bytes' in this rank's segment and returns where to
+    // write the data, or nullptr if the segment is full.  'message' is set to
+    // the Message for the slot.
+    static char * allocate( size_t bytes, Message & message );
+
+    //////////
+    // Makes the data written to this rank's segment visible to the other
+    // ranks of the node.  Call before sending the Message.
+    static void publish();
+
+    //////////
+    // Returns true (and sets 'message') if the receive of 'status' into
+    // 'buffer', which was posted for 'expectedBytes', got a Message instead
+    // of the data.
+    static bool isMessage( MPI_Comm           comm
+                         , const MPI_Status & status
+                         , const void       * buffer
+                         , size_t             expectedBytes
+                         , Message          & message
+                         );
+
+    //////////
+    // Returns the data of 'message' in the segment of 'rank'.
+    static const char * peerData( int rank, const Message & message );
+
+    //////////
+    // Hands the slot of 'message' back to 'rank' once the data has been read.
+    static void release( int rank, const Message & message );
+
+  private:
+
+    SharedMemoryExchange();
+
+}; // SharedMemoryExchange
+
+} // end namespace Uintah
+
+#endif // CORE_PARALLEL_SHAREDMEMORYEXCHANGE_H
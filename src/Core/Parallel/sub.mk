@@ -37,6 +37,7 @@ SRCS     += \
 	$(SRCDIR)/PackBufferInfo.cc          \
 	$(SRCDIR)/Parallel.cc                \
 	$(SRCDIR)/ProcessorGroup.cc          \
+	$(SRCDIR)/SharedMemoryExchange.cc    \
 	$(SRCDIR)/UintahParallelComponent.cc \
 	$(SRCDIR)/UintahParallelPort.cc
 
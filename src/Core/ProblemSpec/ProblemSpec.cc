@@ -1653,6 +1653,24 @@ ProblemSpec::output( const char * filename ) const
   }
 }
 
+//______________________________________________________________________
+//
+string
+ProblemSpec::outputToString() const 
+{
+  xmlKeepBlanksDefault(0);
+  xmlChar * mem  = nullptr;
+  int       size = 0;
+  xmlDocDumpFormatMemoryEnc( d_node->doc, &mem, &size, "UTF-8", 1 );
+
+  if( mem == nullptr ) {
+    throw InternalError( "ProblemSpec::outputToString failed", __FILE__, __LINE__ );
+  }
+  string result( (const char *) mem, size );
+  xmlFree( mem );
+  return result;
+}
+
 //______________________________________________________________________
 //
 void
@@ -405,6 +405,10 @@ public:
   // Output the DOMTree.  
   void output( const char * filename ) const;
 
+  //////////
+  // Output the DOMTree to a string, formatted as output() formats a file.
+  std::string outputToString() const;
+
   inline bool operator == (const ProblemSpec& a) const { return a.d_node == d_node; }
   inline bool operator != (const ProblemSpec& a) const { return a.d_node != d_node; }
   inline bool operator == (int a) const {
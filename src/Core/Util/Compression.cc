@@ -0,0 +1,873 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* Compression.cc */
+
+#include <Core/Util/Compression.h>
+
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Parallel/MasterLock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+using namespace std;
+
+namespace Uintah {
+
+namespace {
+
+  enum Codec { LZ, GZIP };
+
+  // Uncompressed bytes per block.
+  const size_t BLOCK_SIZE = 256 * 1024;
+
+  // Header: uncompressed size (8 bytes), element size, block size and
+  // number of blocks (4 bytes each), then the compressed size of each block.
+  const size_t HEADER_SIZE = 8 + 3 * 4;
+
+  // LZ codec parameters.
+  const size_t MIN_MATCH  = 4;
+  const size_t MAX_OFFSET = 65535;
+  const int    HASH_BITS  = 14;
+
+  std::atomic<int> g_compression_threads( 1 );
+
+  //______________________________________________________________________
+  //
+  void
+  parseMode( const string & mode, Codec & codec, bool & shuffled )
+  {
+    if( mode == "lz" ) {
+      codec = LZ;    shuffled = false;
+    }
+    else if( mode == "shuffle-lz" ) {
+      codec = LZ;    shuffled = true;
+    }
+    else if( mode == "shuffle-gzip" ) {
+      codec = GZIP;  shuffled = true;
+    }
+    else {
+      throw InternalError( "Unknown block compression mode: " + mode, __FILE__, __LINE__ );
+    }
+  }
+
+  //______________________________________________________________________
+  // Little endian header fields.
+  void
+  putUInt( unsigned char * p, uint64_t value, int nBytes )
+  {
+    for( int i = 0; i < nBytes; i++ ) {
+      p[i] = (unsigned char) ( ( value >> ( 8 * i ) ) & 0xff );
+    }
+  }
+
+  uint64_t
+  getUInt( const unsigned char * p, int nBytes )
+  {
+    uint64_t value = 0;
+    for( int i = 0; i < nBytes; i++ ) {
+      value |= (uint64_t) p[i] << ( 8 * i );
+    }
+    return value;
+  }
+
+  void
+  corrupt()
+  {
+    throw InternalError( "blockDecompress: corrupt compressed data", __FILE__, __LINE__ );
+  }
+
+  //______________________________________________________________________
+  // Byte shuffle: byte b of element e goes to b * count + e.
+  void
+  shuffle( const unsigned char * in, size_t n, size_t stride, unsigned char * out )
+  {
+    size_t count = n / stride;
+    for( size_t b = 0; b < stride; b++ ) {
+      for( size_t e = 0; e < count; e++ ) {
+        out[ b * count + e ] = in[ e * stride + b ];
+      }
+    }
+    memcpy( out + count * stride, in + count * stride, n - count * stride );
+  }
+
+  void
+  unshuffle( const unsigned char * in, size_t n, size_t stride, unsigned char * out )
+  {
+    size_t count = n / stride;
+    for( size_t b = 0; b < stride; b++ ) {
+      for( size_t e = 0; e < count; e++ ) {
+        out[ e * stride + b ] = in[ b * count + e ];
+      }
+    }
+    memcpy( out + count * stride, in + count * stride, n - count * stride );
+  }
+
+  //______________________________________________________________________
+  // LZ codec: a sequence of
+  //
+  //   token (literal length << 4 | match length - MIN_MATCH),
+  //   [literal length - 15 in 255 runs], literals,
+  //   offset (2 bytes), [match length - MIN_MATCH - 15 in 255 runs]
+  //
+  // where the last sequence only has literals.
+  inline uint32_t
+  read32( const unsigned char * p )
+  {
+    uint32_t value;
+    memcpy( &value, p, 4 );
+    return value;
+  }
+
+  inline void
+  putLength( unsigned char *& op, size_t length )
+  {
+    while( length >= 255 ) {
+      *op++ = 255;
+      length -= 255;
+    }
+    *op++ = (unsigned char) length;
+  }
+
+  size_t
+  lzBound( size_t n )
+  {
+    return n + n / 255 + 16;
+  }
+
+  size_t
+  lzCompress( const unsigned char * src, size_t n, unsigned char * dst )
+  {
+    vector<uint32_t> table( 1 << HASH_BITS, 0 );  // position + 1 (0 == empty)
+
+    unsigned char * op     = dst;
+    size_t          anchor = 0;
+    size_t          i      = 0;
+    size_t          misses = 0;
+
+    while( i + MIN_MATCH < n ) {
+      uint32_t seq  = read32( src + i );
+      uint32_t hash = ( seq * 2654435761u ) >> ( 32 - HASH_BITS );
+      size_t   cand = table[ hash ];
+      table[ hash ] = (uint32_t) ( i + 1 );
+
+      if( cand == 0 || i - ( cand - 1 ) > MAX_OFFSET || read32( src + cand - 1 ) != seq ) {
+        // Step faster through incompressible data.
+        i += 1 + ( misses++ >> 6 );
+        continue;
+      }
+
+      size_t ref    = cand - 1;
+      size_t length = MIN_MATCH;
+      while( i + length < n && src[ ref + length ] == src[ i + length ] ) {
+        ++length;
+      }
+
+      size_t literals = i - anchor;
+      size_t extra    = length - MIN_MATCH;
+      unsigned char * token = op++;
+      *token = (unsigned char) ( ( min( literals, (size_t) 15 ) << 4 ) | min( extra, (size_t) 15 ) );
+
+      if( literals >= 15 ) {
+        putLength( op, literals - 15 );
+      }
+      memcpy( op, src + anchor, literals );
+      op += literals;
+
+      size_t offset = i - ref;
+      *op++ = (unsigned char) ( offset & 0xff );
+      *op++ = (unsigned char) ( offset >> 8 );
+
+      if( extra >= 15 ) {
+        putLength( op, extra - 15 );
+      }
+
+      i += length;
+      anchor = i;
+      misses = 0;
+    }
+
+    // Last literals.
+    size_t literals = n - anchor;
+    *op++ = (unsigned char) ( min( literals, (size_t) 15 ) << 4 );
+    if( literals >= 15 ) {
+      putLength( op, literals - 15 );
+    }
+    memcpy( op, src + anchor, literals );
+    op += literals;
+
+    return op - dst;
+  }
+
+  void
+  lzDecompress( const unsigned char * src, size_t n, unsigned char * dst, size_t outSize )
+  {
+    const unsigned char * ip   = src;
+    const unsigned char * iend = src + n;
+    unsigned char       * op   = dst;
+    unsigned char       * oend = dst + outSize;
+
+    while( ip < iend ) {
+      unsigned int token    = *ip++;
+      size_t       literals = token >> 4;
+
+      if( literals == 15 ) {
+        unsigned char b;
+        do {
+          if( ip >= iend ) {
+            corrupt();
+          }
+          b = *ip++;
+          literals += b;
+        } while( b == 255 );
+      }
+
+      if( literals > (size_t) ( iend - ip ) || literals > (size_t) ( oend - op ) ) {
+        corrupt();
+      }
+      memcpy( op, ip, literals );
+      op += literals;
+      ip += literals;
+
+      if( ip == iend ) {
+        break;
+      }
+
+      if( iend - ip < 2 ) {
+        corrupt();
+      }
+      size_t offset = ip[0] | ( (size_t) ip[1] << 8 );
+      ip += 2;
+
+      size_t length = token & 15;
+      if( length == 15 ) {
+        unsigned char b;
+        do {
+          if( ip >= iend ) {
+            corrupt();
+          }
+          b = *ip++;
+          length += b;
+        } while( b == 255 );
+      }
+      length += MIN_MATCH;
+
+      if( offset == 0 || offset > (size_t) ( op - dst ) || length > (size_t) ( oend - op ) ) {
+        corrupt();
+      }
+
+      const unsigned char * ref = op - offset;
+      if( offset >= length ) {
+        memcpy( op, ref, length );
+      }
+      else {
+        // Overlapping copy (repeated pattern).
+        for( size_t k = 0; k < length; k++ ) {
+          op[k] = ref[k];
+        }
+      }
+      op += length;
+    }
+
+    if( op != oend ) {
+      corrupt();
+    }
+  }
+
+  //______________________________________________________________________
+  // Runs f(block) for every block.  The blocks are split into up to
+  // g_compression_threads contiguous chunks, each run on its own
+  // std::thread (the first on the calling thread).  An exception thrown
+  // for any block is rethrown here once all of the chunks are done.
+  template< typename F >
+  void
+  forEachBlock( size_t numBlocks, F f )
+  {
+    const int numChunks = (int) min( (size_t) max( getCompressionThreads(), 1 ), numBlocks );
+
+    if( numChunks <= 1 ) {
+      for( size_t b = 0; b < numBlocks; b++ ) {
+        f( b );
+      }
+      return;
+    }
+
+    std::exception_ptr  error;
+    Uintah::MasterLock  errorLock;
+
+    auto chunk = [&]( int c ) {
+      try {
+        const size_t bbegin = ( c * numBlocks ) / numChunks;
+        const size_t bend   = ( ( c + 1 ) * numBlocks ) / numChunks;
+        for( size_t b = bbegin; b < bend; b++ ) {
+          f( b );
+        }
+      }
+      catch( ... ) {
+        std::lock_guard<Uintah::MasterLock> guard( errorLock );
+        if( !error ) {
+          error = std::current_exception();
+        }
+      }
+    };
+
+    vector<std::thread> threads;
+    for( int c = 1; c < numChunks; c++ ) {
+      threads.emplace_back( chunk, c );
+    }
+    chunk( 0 );
+    for( size_t t = 0; t < threads.size(); t++ ) {
+      threads[t].join();
+    }
+
+    if( error ) {
+      std::rethrow_exception( error );
+    }
+  }
+
+  //______________________________________________________________________
+  // Lossy codec.  Header: number of values (8 bytes), value size, flags,
+  // nx, ny, nz, components (4 bytes each), the error bound (8 bytes) and
+  // the size of the compressed quantization codes (8 bytes).
+  const size_t LOSSY_HEADER_SIZE = 8 + 6 * 4 + 8 + 8;
+
+  const unsigned int LOSSY_BIG_ENDIAN = 1;   // written on a big endian machine
+  const unsigned int LOSSY_RAW_CODES  = 2;   // codes are not compressed
+
+  // Code of the values that could not be quantized, these are stored exactly.
+  const uint32_t ESCAPE    = 0xffffffff;
+  const double   MAX_QUANT = 1 << 30;
+
+  bool
+  bigEndian()
+  {
+    const uint32_t one = 1;
+    return *(const unsigned char *) &one == 0;
+  }
+
+  void
+  swapValue( unsigned char * p, size_t size )
+  {
+    std::reverse( p, p + size );
+  }
+
+  struct LossyLayout {
+    size_t nx, ny, nz, comps;
+  };
+
+  //______________________________________________________________________
+  // Lorenzo predictor: the value at (x,y,z) predicted from the already
+  // reconstructed values of the 7 neighbors with lower indices.  Missing
+  // neighbors count as 0, which reduces to the 2D/1D predictor on faces
+  // and edges.
+  template<class T>
+  inline double
+  predict( const T * r, size_t i, size_t x, size_t y, size_t z, const LossyLayout & d )
+  {
+    const size_t sx = d.comps;
+    const size_t sy = d.nx * sx;
+    const size_t sz = d.ny * sy;
+
+    double p = 0.0;
+    if( x )           p += r[ i - sx ];
+    if( y )           p += r[ i - sy ];
+    if( z )           p += r[ i - sz ];
+    if( x && y )      p -= r[ i - sx - sy ];
+    if( x && z )      p -= r[ i - sx - sz ];
+    if( y && z )      p -= r[ i - sy - sz ];
+    if( x && y && z ) p += r[ i - sx - sy - sz ];
+
+    return std::isfinite( p ) ? p : 0.0;
+  }
+
+  //______________________________________________________________________
+  // The reconstructed value, p + step * k.  The encoder and the decoder
+  // (possibly another build on another machine) must round it identically,
+  // so the product is forced through memory: a fused multiply-add, which
+  // the compiler may otherwise emit in one of the two, rounds only once.
+  template<class T>
+  inline T
+  reconstruct( double p, double step, int64_t k )
+  {
+    volatile double delta = step * k;
+    return (T) ( p + delta );
+  }
+
+  //______________________________________________________________________
+  //
+  template<class T>
+  void
+  lossyEncode( const T * v, const LossyLayout & d, double eps,
+               vector<uint32_t> & codes, vector<T> & exact )
+  {
+    const size_t n    = d.nx * d.ny * d.nz * d.comps;
+    const double step = 2.0 * eps;
+
+    vector<T> r( n );
+    codes.resize( n );
+
+    size_t i = 0;
+    for( size_t z = 0; z < d.nz; z++ ) {
+      for( size_t y = 0; y < d.ny; y++ ) {
+        for( size_t x = 0; x < d.nx; x++ ) {
+          for( size_t c = 0; c < d.comps; c++, i++ ) {
+            const double p = predict( &r[0], i, x, y, z, d );
+            const double q = ( (double) v[i] - p ) / step;
+
+            if( std::isfinite( (double) v[i] ) && std::fabs( q ) < MAX_QUANT ) {
+              const int64_t k   = std::llround( q );
+              const T       rec = reconstruct<T>( p, step, k );
+              if( std::fabs( (double) rec - (double) v[i] ) <= eps ) {
+                codes[i] = (uint32_t) ( ( (uint64_t) k << 1 ) ^ (uint64_t) ( k >> 63 ) );   // zigzag
+                r[i]     = rec;
+                continue;
+              }
+            }
+            codes[i] = ESCAPE;
+            r[i]     = v[i];
+            exact.push_back( v[i] );
+          }
+        }
+      }
+    }
+  }
+
+  //______________________________________________________________________
+  //
+  template<class T>
+  void
+  lossyDecode( const uint32_t * codes, const unsigned char * exact, size_t numExact,
+               bool swapped, const LossyLayout & d, double eps, T * r )
+  {
+    const double step = 2.0 * eps;
+    size_t       e    = 0;
+
+    size_t i = 0;
+    for( size_t z = 0; z < d.nz; z++ ) {
+      for( size_t y = 0; y < d.ny; y++ ) {
+        for( size_t x = 0; x < d.nx; x++ ) {
+          for( size_t c = 0; c < d.comps; c++, i++ ) {
+            if( codes[i] == ESCAPE ) {
+              if( e == numExact ) {
+                corrupt();
+              }
+              unsigned char bytes[ sizeof(T) ];
+              memcpy( bytes, exact + e * sizeof(T), sizeof(T) );
+              if( swapped ) {
+                swapValue( bytes, sizeof(T) );
+              }
+              memcpy( &r[i], bytes, sizeof(T) );
+              e++;
+            }
+            else {
+              const int64_t k = (int64_t) ( codes[i] >> 1 ) ^ -(int64_t) ( codes[i] & 1 );
+              r[i] = reconstruct<T>( predict( r, i, x, y, z, d ), step, k );
+            }
+          }
+        }
+      }
+    }
+
+    if( e != numExact ) {
+      corrupt();
+    }
+  }
+
+  //______________________________________________________________________
+  //
+  template<class T>
+  bool
+  errorBound( const T * v, size_t n, double absTolerance, double relTolerance, double & eps )
+  {
+    eps = ( absTolerance > 0.0 ) ? absTolerance : HUGE_VAL;
+
+    if( relTolerance > 0.0 ) {
+      double lo = HUGE_VAL;
+      double hi = -HUGE_VAL;
+      for( size_t i = 0; i < n; i++ ) {
+        if( std::isfinite( (double) v[i] ) ) {
+          lo = min( lo, (double) v[i] );
+          hi = max( hi, (double) v[i] );
+        }
+      }
+      if( hi > lo ) {
+        eps = min( eps, relTolerance * ( hi - lo ) );
+      }
+      else if( absTolerance <= 0.0 ) {
+        eps = relTolerance * std::fabs( hi );   // constant field
+      }
+    }
+
+    return eps > 0.0 && std::isfinite( eps );
+  }
+
+} // end anonymous namespace
+
+//______________________________________________________________________
+//
+bool
+isBlockCompressionMode( const string & mode )
+{
+  return mode == "lz" || mode == "shuffle-lz" || mode == "shuffle-gzip";
+}
+
+//______________________________________________________________________
+//
+void
+setCompressionThreads( int numThreads )
+{
+  g_compression_threads = max( numThreads, 1 );
+}
+
+int
+getCompressionThreads()
+{
+  return g_compression_threads;
+}
+
+//______________________________________________________________________
+//
+bool
+blockCompress( const string & mode,
+               const string & in,
+                     size_t   elementSize,
+                     string & out )
+{
+  Codec codec;
+  bool  shuffled;
+  parseMode( mode, codec, shuffled );
+
+  const size_t n         = in.size();
+  const size_t stride    = shuffled ? max( elementSize, (size_t) 1 ) : 1;
+  const size_t blockSize = stride * max( BLOCK_SIZE / stride, (size_t) 1 );
+  const size_t numBlocks = ( n + blockSize - 1 ) / blockSize;
+
+  const unsigned char * src = (const unsigned char *) in.data();
+
+  vector<string> blocks( numBlocks );
+
+  forEachBlock( numBlocks, [&]( size_t b ) {
+    size_t                begin  = b * blockSize;
+    size_t                length = min( blockSize, n - begin );
+    const unsigned char * data   = src + begin;
+
+    string shuffledData;
+    if( shuffled ) {
+      shuffledData.resize( length );
+      shuffle( data, length, stride, (unsigned char *) &shuffledData[0] );
+      data = (const unsigned char *) shuffledData.data();
+    }
+
+    string & block = blocks[b];
+
+    if( codec == LZ ) {
+      block.resize( lzBound( length ) );
+      block.resize( lzCompress( data, length, (unsigned char *) &block[0] ) );
+    }
+    else {
+      uLongf size = compressBound( length );
+      block.resize( size );
+      if( compress2( (Bytef *) &block[0], &size, (const Bytef *) data, length, Z_BEST_SPEED ) != Z_OK ) {
+        size = length;   // store raw
+      }
+      block.resize( size );
+    }
+
+    // Incompressible blocks are stored raw (compressed size == length).
+    if( block.size() >= length ) {
+      block.assign( (const char *) src + begin, length );
+    }
+  } );
+
+  size_t total = HEADER_SIZE + 4 * numBlocks;
+  for( size_t b = 0; b < numBlocks; b++ ) {
+    total += blocks[b].size();
+  }
+
+  if( total >= n ) {
+    out.clear();
+    return false;
+  }
+
+  out.resize( HEADER_SIZE + 4 * numBlocks );
+  unsigned char * header = (unsigned char *) &out[0];
+  putUInt( header,      n,         8 );
+  putUInt( header + 8,  stride,    4 );
+  putUInt( header + 12, blockSize, 4 );
+  putUInt( header + 16, numBlocks, 4 );
+  for( size_t b = 0; b < numBlocks; b++ ) {
+    putUInt( header + HEADER_SIZE + 4 * b, blocks[b].size(), 4 );
+  }
+
+  out.reserve( total );
+  for( size_t b = 0; b < numBlocks; b++ ) {
+    out.append( blocks[b] );
+    string().swap( blocks[b] );
+  }
+  return true;
+}
+
+//______________________________________________________________________
+//
+void
+blockDecompress( const string & mode,
+                 const char   * in,
+                       size_t   inSize,
+                       string & out )
+{
+  Codec codec;
+  bool  shuffled;
+  parseMode( mode, codec, shuffled );
+
+  const unsigned char * header = (const unsigned char *) in;
+  if( inSize < HEADER_SIZE ) {
+    corrupt();
+  }
+
+  const size_t n         = getUInt( header,      8 );
+  const size_t stride    = getUInt( header + 8,  4 );
+  const size_t blockSize = getUInt( header + 12, 4 );
+  const size_t numBlocks = getUInt( header + 16, 4 );
+
+  if( stride == 0 || blockSize == 0 || numBlocks != ( n + blockSize - 1 ) / blockSize ||
+      inSize < HEADER_SIZE + 4 * numBlocks ) {
+    corrupt();
+  }
+
+  // Offset of each compressed block.
+  vector<size_t> offsets( numBlocks + 1 );
+  offsets[0] = HEADER_SIZE + 4 * numBlocks;
+  for( size_t b = 0; b < numBlocks; b++ ) {
+    offsets[b + 1] = offsets[b] + getUInt( header + HEADER_SIZE + 4 * b, 4 );
+  }
+  if( offsets[ numBlocks ] != inSize ) {
+    corrupt();
+  }
+
+  out.resize( n );
+  unsigned char * dst = (unsigned char *) &out[0];
+
+  forEachBlock( numBlocks, [&]( size_t b ) {
+    size_t                begin  = b * blockSize;
+    size_t                length = min( blockSize, n - begin );
+    const unsigned char * src    = header + offsets[b];
+    size_t                size   = offsets[b + 1] - offsets[b];
+
+    if( size == length ) {
+      memcpy( dst + begin, src, length );   // stored raw
+      return;
+    }
+
+    string          shuffledData;
+    unsigned char * target = dst + begin;
+    if( shuffled ) {
+      shuffledData.resize( length );
+      target = (unsigned char *) &shuffledData[0];
+    }
+
+    if( codec == LZ ) {
+      lzDecompress( src, size, target, length );
+    }
+    else {
+      uLongf destLength = length;
+      if( uncompress( (Bytef *) target, &destLength, (const Bytef *) src, size ) != Z_OK || destLength != length ) {
+        corrupt();
+      }
+    }
+
+    if( shuffled ) {
+      unshuffle( target, length, stride, dst + begin );
+    }
+  } );
+}
+
+//______________________________________________________________________
+//
+bool
+lossyCompress( const string & in,
+                     size_t   valueSize,
+               const int      dims[3],
+                     double   absTolerance,
+                     double   relTolerance,
+                     string & out )
+{
+  out.clear();
+
+  const size_t cells = (size_t) dims[0] * dims[1] * dims[2];
+  if( ( valueSize != sizeof(float) && valueSize != sizeof(double) ) || cells == 0 ||
+      in.size() % ( cells * valueSize ) != 0 || in.empty() ) {
+    return false;
+  }
+
+  LossyLayout layout = { (size_t) dims[0], (size_t) dims[1], (size_t) dims[2],
+                         in.size() / ( cells * valueSize ) };
+  const size_t n = cells * layout.comps;
+
+  double           eps;
+  vector<uint32_t> codes;
+  string           exactBytes;
+
+  if( valueSize == sizeof(double) ) {
+    const double * v = (const double *) in.data();
+    vector<double> exact;
+    if( !errorBound( v, n, absTolerance, relTolerance, eps ) ) {
+      return false;
+    }
+    lossyEncode( v, layout, eps, codes, exact );
+    exactBytes.assign( (const char *) exact.data(), exact.size() * sizeof(double) );
+  }
+  else {
+    const float * v = (const float *) in.data();
+    vector<float> exact;
+    if( !errorBound( v, n, absTolerance, relTolerance, eps ) ) {
+      return false;
+    }
+    lossyEncode( v, layout, eps, codes, exact );
+    exactBytes.assign( (const char *) exact.data(), exact.size() * sizeof(float) );
+  }
+
+  // The codes are mostly small integers - little endian plus the byte
+  // shuffle leaves long runs of zero bytes.
+  string codeBytes( 4 * n, '\0' );
+  for( size_t i = 0; i < n; i++ ) {
+    putUInt( (unsigned char *) &codeBytes[ 4 * i ], codes[i], 4 );
+  }
+  vector<uint32_t>().swap( codes );
+
+  unsigned int flags = bigEndian() ? LOSSY_BIG_ENDIAN : 0;
+  string       compressedCodes;
+  if( !blockCompress( "shuffle-gzip", codeBytes, 4, compressedCodes ) ) {
+    compressedCodes.swap( codeBytes );
+    flags |= LOSSY_RAW_CODES;
+  }
+
+  const size_t total = LOSSY_HEADER_SIZE + compressedCodes.size() + exactBytes.size();
+  if( total >= in.size() ) {
+    return false;
+  }
+
+  uint64_t epsBits;
+  memcpy( &epsBits, &eps, sizeof(eps) );
+
+  out.resize( LOSSY_HEADER_SIZE );
+  unsigned char * header = (unsigned char *) &out[0];
+  putUInt( header,      n,                      8 );
+  putUInt( header + 8,  valueSize,              4 );
+  putUInt( header + 12, flags,                  4 );
+  putUInt( header + 16, layout.nx,              4 );
+  putUInt( header + 20, layout.ny,              4 );
+  putUInt( header + 24, layout.nz,              4 );
+  putUInt( header + 28, layout.comps,           4 );
+  putUInt( header + 32, epsBits,                8 );
+  putUInt( header + 40, compressedCodes.size(), 8 );
+
+  out.reserve( total );
+  out.append( compressedCodes );
+  out.append( exactBytes );
+  return true;
+}
+
+//______________________________________________________________________
+//
+void
+lossyDecompress( const char   * in,
+                       size_t   inSize,
+                       string & out )
+{
+  const unsigned char * header = (const unsigned char *) in;
+  if( inSize < LOSSY_HEADER_SIZE ) {
+    corrupt();
+  }
+
+  const size_t       n         = getUInt( header,      8 );
+  const size_t       valueSize = getUInt( header + 8,  4 );
+  const unsigned int flags     = getUInt( header + 12, 4 );
+  LossyLayout layout = { getUInt( header + 16, 4 ), getUInt( header + 20, 4 ),
+                         getUInt( header + 24, 4 ), getUInt( header + 28, 4 ) };
+  const uint64_t     epsBits   = getUInt( header + 32, 8 );
+  const size_t       codesSize = getUInt( header + 40, 8 );
+
+  double eps;
+  memcpy( &eps, &epsBits, sizeof(eps) );
+
+  if( ( valueSize != sizeof(float) && valueSize != sizeof(double) ) ||
+      n != layout.nx * layout.ny * layout.nz * layout.comps ||
+      codesSize > inSize - LOSSY_HEADER_SIZE ) {
+    corrupt();
+  }
+
+  const char * codesData = in + LOSSY_HEADER_SIZE;
+  string       codeBytes;
+  if( flags & LOSSY_RAW_CODES ) {
+    codeBytes.assign( codesData, codesSize );
+  }
+  else {
+    blockDecompress( "shuffle-gzip", codesData, codesSize, codeBytes );
+  }
+  if( codeBytes.size() != 4 * n ) {
+    corrupt();
+  }
+
+  vector<uint32_t> codes( n );
+  for( size_t i = 0; i < n; i++ ) {
+    codes[i] = (uint32_t) getUInt( (const unsigned char *) &codeBytes[ 4 * i ], 4 );
+  }
+  string().swap( codeBytes );
+
+  const unsigned char * exact     = header + LOSSY_HEADER_SIZE + codesSize;
+  const size_t          exactSize = inSize - LOSSY_HEADER_SIZE - codesSize;
+  if( exactSize % valueSize != 0 ) {
+    corrupt();
+  }
+
+  // Reconstruct in native byte order, then hand back the bytes in the
+  // byte order of the writer (the caller swaps them if needed).
+  const bool swapped = ( ( flags & LOSSY_BIG_ENDIAN ) != 0 ) != bigEndian();
+
+  out.resize( n * valueSize );
+  if( valueSize == sizeof(double) ) {
+    lossyDecode( codes.data(), exact, exactSize / valueSize, swapped, layout, eps, (double *) &out[0] );
+  }
+  else {
+    lossyDecode( codes.data(), exact, exactSize / valueSize, swapped, layout, eps, (float *) &out[0] );
+  }
+
+  if( swapped ) {
+    for( size_t i = 0; i < n; i++ ) {
+      swapValue( (unsigned char *) &out[ i * valueSize ], valueSize );
+    }
+  }
+}
+
+} // End namespace Uintah
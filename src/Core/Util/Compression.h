@@ -0,0 +1,105 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ *  Compression.h: block compression codecs for UDA variables
+ *
+ *  The data is cut into fixed size blocks that are compressed (and
+ *  decompressed) independently.  When more than one compression thread
+ *  is set the blocks are split into that many chunks, which run in
+ *  parallel on their own threads.  The modes are:
+ *
+ *    "lz"           - a fast byte oriented LZ77 codec
+ *    "shuffle-lz"   - "lz" after a byte shuffle
+ *    "shuffle-gzip" - zlib (fastest level) after a byte shuffle
+ *
+ *  The byte shuffle regroups the bytes of each element (e.g. the 8
+ *  bytes of a double) so that the slowly varying sign and exponent
+ *  bytes of floating point fields end up next to each other.
+ *
+ *  lossyCompress() is an error bounded lossy codec for floating point
+ *  grid data: each value is predicted from its already reconstructed
+ *  neighbors and the prediction error is quantized to the tolerance.
+ *
+ *  The compressed stream is self describing (sizes, element size and
+ *  block layout are stored little endian in a small header).
+ */
+
+#ifndef CORE_UTIL_COMPRESSION_H
+#define CORE_UTIL_COMPRESSION_H
+
+#include <string>
+
+namespace Uintah {
+
+//////////
+// Returns true if 'mode' is one of the block compression modes above.
+bool isBlockCompressionMode( const std::string & mode );
+
+//////////
+// Compresses 'in' into 'out' using 'mode'.  'elementSize' is the size
+// in bytes of the elements of 'in' (used by the shuffle).  Returns
+// false (and leaves 'out' empty) if compression did not reduce the size.
+bool blockCompress( const std::string & mode,
+                    const std::string & in,
+                          size_t        elementSize,
+                          std::string & out );
+
+//////////
+// Reverses blockCompress().  Throws an InternalError if the data is corrupt.
+void blockDecompress( const std::string & mode,
+                      const char        * in,
+                            size_t        inSize,
+                            std::string & out );
+
+//////////
+// Error bounded lossy compression of a block of floating point values
+// ('valueSize' 4 or 8) laid out x fastest over 'dims' cells, possibly with
+// several components per cell.  Every value is reconstructed to within
+// the smaller of 'absTolerance' and 'relTolerance' times the value range
+// (a tolerance <= 0 is ignored).  Returns false (and leaves 'out' empty)
+// if the data can not be compressed this way.
+bool lossyCompress( const std::string & in,
+                          size_t        valueSize,
+                    const int           dims[3],
+                          double        absTolerance,
+                          double        relTolerance,
+                          std::string & out );
+
+//////////
+// Reverses lossyCompress().  The values are returned in the byte order of
+// the machine that compressed them.  Throws an InternalError if the data is
+// corrupt.
+void lossyDecompress( const char        * in,
+                            size_t        inSize,
+                            std::string & out );
+
+//////////
+// Number of chunks the blocks of one variable are (de)compressed in.
+void setCompressionThreads( int numThreads );
+int  getCompressionThreads();
+
+} // End namespace Uintah
+
+#endif
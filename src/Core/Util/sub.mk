@@ -30,6 +30,7 @@ include $(SCIRUN_SCRIPTS)/smallso_prologue.mk
 SRCDIR := Core/Util
 
 SRCS += \
+        $(SRCDIR)/Compression.cc        \
         $(SRCDIR)/DOUT.cpp              \
         $(SRCDIR)/DebugStream.cc        \
         $(SRCDIR)/Endian.cc             \
@@ -103,6 +103,7 @@ usage( const std::string & badarg, const std::string & progname )
   cerr << "  -pad,        --pad:         (print zero values for cell locations not currently in the specified level)\n";
   cerr << "  -cellCoords:                (prints the cell centered coordinates on that level)\n";
   cerr << "  -nodeCoords:                (prints the node centered coordinates on that level)\n";
+  cerr << "  -nt,       --threads:       [int] (number of threads reading the patches) [defaults to 1]\n";
   cerr << "  --cellIndexFile:            <filename> (file that contains a list of cell indices)\n";
   cerr << "                                   [int 100, 43, 0]\n";
   cerr << "                                   [int 101, 43, 0]\n";
@@ -222,10 +223,10 @@ printData(       DataArchive             * archive,
           exit(1);
         }
 
-        // query all the data up front
+        // query all the data up front, the patches are read in parallel
         vector<Variable*> vars(patches.size());
-        for (unsigned int p = 0; p < patches.size(); p++) {
-          if (patches[p]->isVirtual()) continue;
+        archive->parallelFor( patches.size(), [&]( int p ) {
+          if (patches[p]->isVirtual()) return;
           switch (variable_type->getType()) {
           case Uintah::TypeDescription::CCVariable:
             vars[p] = scinew CCVariable<T>;
@@ -256,7 +257,7 @@ printData(       DataArchive             * archive,
             cerr << "Unknown variable type: " << variable_type->getName() << endl;
           }
           
-        }
+        } );
 
 
         for (CellIterator ci(var_start, var_end + IntVector(1,1,1)); !ci.done(); ci++) {
@@ -515,10 +516,11 @@ printData_PV(       DataArchive             * archive,
         exit(1);
       }
 
-      // query all the data and compute the average up front
+      // query all the data and compute the average up front, the patches
+      // are read in parallel
       vector<Variable*> vars(patches.size());
       vector<Variable*> ave(patches.size());
-      for (unsigned int p = 0; p < patches.size(); p++) {
+      archive->parallelFor( patches.size(), [&]( int p ) {
         vars[p] = scinew ParticleVariable<T>;
         ave[p]  = scinew CCVariable<T>;
 
@@ -533,7 +535,7 @@ printData_PV(       DataArchive             * archive,
                        *(CCVariable<T>*)ave[p],
                        *(ParticleVariable<Point>*)pos,
                        patches[p]);
-      }
+      } );
       
       //__________________________________
       // User input starting and ending indicies    
@@ -708,6 +710,7 @@ main( int argc, char** argv )
   string            variable_name;
 
   int               material = 0;
+  int               numThreads = 1;
   
   //__________________________________
   // Parse arguments
@@ -780,6 +783,15 @@ main( int argc, char** argv )
       d_printCell_coords = true;
     } else if (s == "--nodeCoords" || s == "-nodeCoords" ) {
       d_printNode_coords = true;
+    } else if (s == "-nt" || s == "--threads") {
+      if( i + 1 >= argc ) {
+        usage( s, argv[0] );
+      }
+      numThreads = atoi(argv[++i]);
+      if( numThreads < 1 ) {
+        cerr << "The number of threads must be at least 1\n";
+        usage( s, argv[0] );
+      }
     }else {
       usage( s, argv[0] );
     }
@@ -796,6 +808,7 @@ main( int argc, char** argv )
 
   try {
     DataArchive* archive = scinew DataArchive(input_uda_name);
+    archive->setQueryThreads( numThreads );
     
     vector<string> vars;
     vector<int> num_matls;
@@ -88,14 +88,14 @@ void printParticleVariables(DataArchive* da, int mat,
                             unsigned long time_step_upper,
                             unsigned long time_step_inc,
                             bool include_position_output);
-void computeEquivStress(const Matrix3& sig, double& sigeqv);
-void computePressure(const Matrix3& sig, double& press);
-void computeEquivStrain(const Matrix3& F, double& epseqv);
-void computeTrueStrain(const Matrix3& F, Vector& strain);
-void computeGreenLagrangeStrain(const Matrix3& F, Matrix3& E);
-void computeGreenAlmansiStrain(const Matrix3& F, Matrix3& e);
-void computeStretchRotation(const Matrix3& F, Matrix3& R, Matrix3& U);
-void printCauchyStress(const Matrix3& stress);
+void computeEquivStress(const Matrix3& sig, double& sigeqv, ostream& out);
+void computePressure(const Matrix3& sig, double& press, ostream& out);
+void computeEquivStrain(const Matrix3& F, double& epseqv, ostream& out);
+void computeTrueStrain(const Matrix3& F, Vector& strain, ostream& out);
+void computeGreenLagrangeStrain(const Matrix3& F, Matrix3& E, ostream& out);
+void computeGreenAlmansiStrain(const Matrix3& F, Matrix3& e, ostream& out);
+void computeStretchRotation(const Matrix3& F, Matrix3& R, Matrix3& U, ostream& out);
+void printCauchyStress(const Matrix3& stress, ostream& out);
 
 int
 main( int argc, char** argv )
@@ -128,6 +128,8 @@ main( int argc, char** argv )
   string filebase;
   vector<string> particleVariable;
   long64 particleID = 0;
+  int numThreads = 1;
+  bool useMPI = false;
 
   // set defaults for cout
   cout.setf(ios::scientific,ios::floatfield);
@@ -191,6 +193,17 @@ main( int argc, char** argv )
       time_step_inc = strtoul(argv[++i],(char**)nullptr,10);
     } else if (s == "-include_position_output") {
       include_position_output = true;
+    } else if (s == "-nt" || s == "--threads") {
+      if( i + 1 >= argc ) {
+        usage( s, argv[0] );
+      }
+      numThreads = atoi(argv[++i]);
+      if( numThreads < 1 ) {
+        cerr << "The number of threads must be at least 1\n";
+        usage( s, argv[0] );
+      }
+    } else if (s == "-mpi") {
+      useMPI = true;
     } 
   }
   filebase = argv[argc-1];
@@ -202,6 +215,10 @@ main( int argc, char** argv )
 
   try {
     DataArchive* da = scinew DataArchive(filebase);
+    da->setQueryThreads( numThreads );
+    if( useMPI ) {
+      da->setQueryComm( Uintah::Parallel::getRootProcessorGroup()->getComm() );
+    }
  
     // Recover time data
     vector<int> index;
@@ -224,7 +241,7 @@ main( int argc, char** argv )
     // Get the particle stresses
     if (do_part_stress) {
       if (do_av_part_stress) {
-        cout << "\t Volume average stress = " << endl;
+        proc0cout << "\t Volume average stress = " << endl;
         getParticleStresses(da, mat, particleID,"avg",  time_step_lower, time_step_upper,
                             include_position_output);
       } else if (do_equiv_part_stress) {
@@ -242,7 +259,7 @@ main( int argc, char** argv )
     // Get the particle strains
     if (do_part_strain) {
       if (do_av_part_strain) {
-        cout << "\t Volume average strain = " << endl;
+        proc0cout << "\t Volume average strain = " << endl;
         getParticleStrains(da,mat, particleID,"avg",     time_step_lower,time_step_upper);
       } else if (do_true_part_strain) {
         getParticleStrains(da,mat, particleID,"true",    time_step_lower,time_step_upper);
@@ -270,6 +287,10 @@ main( int argc, char** argv )
     cerr << "Caught unknown exception\n";
     abort();
   }
+
+  if( useMPI ) {
+    Uintah::Parallel::finalizeManager();
+  }
 }
 
 void usage(const std::string& badarg, const std::string& progname)
@@ -287,6 +308,8 @@ void usage(const std::string& badarg, const std::string& progname)
   cerr << "  -timesteplow [int] (only outputs timestep from int)\n";
   cerr << "  -timestephigh [int] (only outputs timesteps upto int)\n";
   cerr << "  -include_position_output (add particle position before other data output)\n";
+  cerr << "  -nt [int] (number of threads reading the timesteps) [defaults to 1]\n";
+  cerr << "  -mpi (also spread the timesteps over the MPI ranks, run with mpirun)\n";
   cerr << "USAGE IS NOT FINISHED\n\n";
   exit(1);
 }
@@ -349,7 +372,12 @@ getParticleStrains(DataArchive* da, int mat, long64 particleID, string flag,
 //  cerr << "There are " << index.size() << " timesteps:\n";
       
   // Loop thru all time steps and store the volume and variable (stress/strain)
-  for(unsigned long t=time_step_lower;t<=time_step_upper;t++){
+  // The time steps are read in parallel and printed in order.
+  const int numTimesteps = max( (long) time_step_upper - (long) time_step_lower + 1, 0L );
+
+  da->orderedFor( numTimesteps, [&]( int i, ostream & out ) {
+    const unsigned long t = time_step_lower + i;
+
     double time = times[t];
     //cerr << "Time = " << time << endl;
     GridP grid = da->queryGrid(t);
@@ -441,8 +469,8 @@ getParticleStrains(DataArchive* da, int mat, long64 particleID, string flag,
                       deformGrad.polarDecomposition(stretch, rotation, 
                                                     1.0e-10, true);
 
-                      cout.setf(ios::scientific,ios::floatfield);
-                      cout.precision(6);
+                      out.setf(ios::scientific,ios::floatfield);
+                      out.precision(6);
 
                       deformVector.push_back(stretch);
                     } 
@@ -467,26 +495,26 @@ getParticleStrains(DataArchive* da, int mat, long64 particleID, string flag,
 
                       // Get the deformation gradient
                       Matrix3 F = value[idx];
-                      cout.setf(ios::scientific,ios::floatfield);
-                      cout.precision(6);
+                      out.setf(ios::scientific,ios::floatfield);
+                      out.precision(6);
 
-                      cout << time << " " << pid[idx] << " " << patchIndex 
-                           << " " << matl ;
+                      out << time << " " << pid[idx] << " " << patchIndex 
+                          << " " << matl ;
                       if (doTrue) {
                         Vector trueStrain(0.0);
-                        computeTrueStrain(F, trueStrain);
+                        computeTrueStrain(F, trueStrain, out);
                       } else if (doEquiv) {
                         double equiv_strain = 0.0;
-                        computeEquivStrain(F, equiv_strain);
+                        computeEquivStrain(F, equiv_strain, out);
                       } else if (doLagrange) {
                         Matrix3 E(0.0);
-                        computeGreenLagrangeStrain(F,E);
+                        computeGreenLagrangeStrain(F,E, out);
                       } else if (doEuler) {
                         Matrix3 e(0.0);
-                        computeGreenAlmansiStrain(F,e);
+                        computeGreenAlmansiStrain(F,e, out);
                       } else {
                         Matrix3 U(0.0), R(0.0);
-                        computeStretchRotation(F,R,U);
+                        computeStretchRotation(F,R,U, out);
                       }
                     }
                   } else {
@@ -497,26 +525,26 @@ getParticleStrains(DataArchive* da, int mat, long64 particleID, string flag,
 
                       // Get the deformation gradient
                       Matrix3 F = value[idx];
-                      cout.setf(ios::scientific,ios::floatfield);
-                      cout.precision(6);
+                      out.setf(ios::scientific,ios::floatfield);
+                      out.precision(6);
 
-                      cout << time << " " << pid[idx] << " " << patchIndex 
-                           << " " << matl ;
+                      out << time << " " << pid[idx] << " " << patchIndex 
+                          << " " << matl ;
                       if (doTrue) {
                         Vector trueStrain(0.0);
-                        computeTrueStrain(F, trueStrain);
+                        computeTrueStrain(F, trueStrain, out);
                       } else if (doEquiv) {
                         double equiv_strain = 0.0;
-                        computeEquivStrain(F, equiv_strain);
+                        computeEquivStrain(F, equiv_strain, out);
                       } else if (doLagrange) {
                         Matrix3 E(0.0);
-                        computeGreenLagrangeStrain(F,E);
+                        computeGreenLagrangeStrain(F,E, out);
                       } else if (doEuler) {
                         Matrix3 e(0.0);
-                        computeGreenAlmansiStrain(F,e);
+                        computeGreenAlmansiStrain(F,e, out);
                       } else {
                         Matrix3 U(0.0), R(0.0);
-                        computeStretchRotation(F,R,U);
+                        computeStretchRotation(F,R,U, out);
                       }
                       break;
                     } // end of pset iter loop
@@ -539,12 +567,12 @@ getParticleStrains(DataArchive* da, int mat, long64 particleID, string flag,
       }
       for (int ii = 0; ii < 3; ++ii) {
         for (int jj = 0; jj < 3; ++jj) {
-          cout << avVar(ii,jj) << "  " ;
+          out << avVar(ii,jj) << "  " ;
         }
-        cout << endl;
+        out << endl;
       }
     }
-  } // end of time step loop
+  }, cout ); // end of time step loop
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -606,7 +634,12 @@ getParticleStresses(DataArchive* da, int mat, long64 particleID, string flag,
   //cout << "There are " << index.size() << " timesteps:\n";
       
   // Loop thru all time steps and store the volume and variable (stress/strain)
-  for(unsigned long t=time_step_lower;t<=time_step_upper;t++){
+  // The time steps are read in parallel and printed in order.
+  const int numTimesteps = max( (long) time_step_upper - (long) time_step_lower + 1, 0L );
+
+  da->orderedFor( numTimesteps, [&]( int i, ostream & out ) {
+    const unsigned long t = time_step_lower + i;
+
     double time = times[t];
     //cout << "Time = " << time << endl;
     GridP grid = da->queryGrid(t);
@@ -712,50 +745,50 @@ getParticleStresses(DataArchive* da, int mat, long64 particleID, string flag,
                     if (particleID == 0) {
                       Matrix3 stress = value[*iter];
 
-                      cout.setf(ios::scientific,ios::floatfield);
-                      cout.precision(6);
+                      out.setf(ios::scientific,ios::floatfield);
+                      out.precision(6);
 
-                      cout << time << " " << pid[*iter] << " " << patchIndex 
-                           << " " << matl ;
+                      out << time << " " << pid[*iter] << " " << patchIndex 
+                          << " " << matl ;
                       if(include_position_output){
-                        cout << " " << value_pos[*iter].x()
-                             << " " << value_pos[*iter].y()
-                             << " " << value_pos[*iter].z() ;
+                        out << " " << value_pos[*iter].x()
+                            << " " << value_pos[*iter].y()
+                            << " " << value_pos[*iter].z() ;
                       }
 
                       if (doEquiv) {
                         double sigeff = 0.0;
-                        computeEquivStress(stress, sigeff);
+                        computeEquivStress(stress, sigeff, out);
                       } else if(doPress) {
                         double press = 0.0;
-                        computePressure(stress, press);
+                        computePressure(stress, press, out);
                       } else {
-                        printCauchyStress(stress);
+                        printCauchyStress(stress, out);
                       }
                     } else {
                       Matrix3 stress = value[*iter];
 
                       if (particleID != pid[*iter]) continue;
 
-                      cout.setf(ios::scientific,ios::floatfield);
-                      cout.precision(6);
+                      out.setf(ios::scientific,ios::floatfield);
+                      out.precision(6);
 
-                      cout << time << " " << pid[*iter] << " " << patchIndex 
-                           << " " << matl ;
+                      out << time << " " << pid[*iter] << " " << patchIndex 
+                          << " " << matl ;
                       if(include_position_output){
-                        cout << " " << value_pos[*iter].x()
-                             << " " << value_pos[*iter].y()
-                             << " " << value_pos[*iter].z() ;
+                        out << " " << value_pos[*iter].x()
+                            << " " << value_pos[*iter].y()
+                            << " " << value_pos[*iter].z() ;
                       }
 
                       if (doEquiv) {
                         double sigeff = 0.0;
-                        computeEquivStress(stress, sigeff);
+                        computeEquivStress(stress, sigeff, out);
                       } else if(doPress) {
                         double press = 0.0;
-                        computePressure(stress, press);
+                        computePressure(stress, press, out);
                       } else {
-                        printCauchyStress(stress);
+                        printCauchyStress(stress, out);
                       }
                       break;
                     }
@@ -778,12 +811,12 @@ getParticleStresses(DataArchive* da, int mat, long64 particleID, string flag,
       }
       for (int ii = 0; ii < 3; ++ii) {
         for (int jj = 0; jj < 3; ++jj) {
-          cout << avVar(ii,jj) << "  " ;
+          out << avVar(ii,jj) << "  " ;
         }
-        cout << endl;
+        out << endl;
       }
     }
-  } // end of time step loop
+  }, cout ); // end of time step loop
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -838,17 +871,17 @@ void printParticleVariables(DataArchive* da,
 
   // Print out a header line
   if(have_partIDs){
-    cout << "% Time patchIndex material particleID";
+    proc0cout << "% Time patchIndex material particleID";
   } else {
-    cout << "% Time patchIndex material";
+    proc0cout << "% Time patchIndex material";
   }
   if(include_position_output){
-    cout << " position";
+    proc0cout << " position";
   }
   for(unsigned int pv=0;pv<particleVariable.size();pv++){
-    cout << " " << particleVariable[pv];
+    proc0cout << " " << particleVariable[pv];
   }
-  cout << endl;
+  proc0cout << endl;
 
   // Now that the variables have been found, get the data for all 
   // available time steps from the data archive
@@ -861,7 +894,12 @@ void printParticleVariables(DataArchive* da,
   int matl = mat;
       
   // Loop thru all time steps and store the volume and variable (stress/strain)
-  for(unsigned long t=time_step_lower;t<=time_step_upper;t+=time_step_inc){
+  // The time steps are read in parallel and printed in order.
+  const int numTimesteps = max( ( (long) time_step_upper - (long) time_step_lower ) / (long) time_step_inc + 1, 0L );
+
+  da->orderedFor( numTimesteps, [&]( int i, ostream & out ) {
+    const unsigned long t = time_step_lower + i * time_step_inc;
+
     double time = times[t];
     //cout << "Time = " << time << endl;
     GridP grid = da->queryGrid(t);
@@ -889,14 +927,14 @@ void printParticleVariables(DataArchive* da,
          ParticleSubset::iterator iter = pset->begin();
           for(;iter != pset->end(); iter++){
             if (particleID == 0 || particleID == pid[*iter]) {
-              cout << time << " " << patchIndex << " " << matl; 
+              out << time << " " << patchIndex << " " << matl; 
               if(have_partIDs){
-                cout << " " << pid[*iter];
+                out << " " << pid[*iter];
               }
               if(include_position_output){
-                cout << " " << pos[*iter].x()
-                     << " " << pos[*iter].y()
-                     << " " << pos[*iter].z() ;
+                out << " " << pos[*iter].x()
+                    << " " << pos[*iter].y()
+                    << " " << pos[*iter].z() ;
               }
               // Loop over all the requested particle variables
               for(unsigned int pv=0;pv<particleVariable.size();pv++){
@@ -912,39 +950,39 @@ void printParticleVariables(DataArchive* da,
                         {
                           ParticleVariable<double> value;
                           da->query(value, var, matl, patch, t);
-                          cout << " " << value[*iter]; 
+                          out << " " << value[*iter]; 
                         }
                       break;
                       case Uintah::TypeDescription::float_type:
                         {
                           ParticleVariable<float> value;
                           da->query(value, var, matl, patch, t);
-                          cout << " " << value[*iter]; 
+                          out << " " << value[*iter]; 
                         }
                       break;
                       case Uintah::TypeDescription::int_type:
                         {
                           ParticleVariable<int> value;
                           da->query(value, var, matl, patch, t);
-                          cout << " " << value[*iter]; 
+                          out << " " << value[*iter]; 
                         }
                       break;
                       case Uintah::TypeDescription::Point:
                         {
                           ParticleVariable<Point> value;
                           ParticleSubset::iterator iter = pset->begin();
-                              cout << " " << value[*iter](0) 
-                                   << " " << value[*iter](1)
-                                   << " " << value[*iter](2) << " ";
+                              out << " " << value[*iter](0) 
+                                  << " " << value[*iter](1)
+                                  << " " << value[*iter](2) << " ";
                         }
                       break;
                       case Uintah::TypeDescription::Vector:
                        {
                          ParticleVariable<Vector> value;
                          da->query(value, var, matl, patch, t);
-                         cout << " " << value[*iter][0] 
-                              << " " << value[*iter][1]
-                              << " " << value[*iter][2] << " ";
+                         out << " " << value[*iter][0] 
+                             << " " << value[*iter][1]
+                             << " " << value[*iter][2] << " ";
                        }
                       break;
                       case Uintah::TypeDescription::Matrix3:
@@ -953,17 +991,17 @@ void printParticleVariables(DataArchive* da,
                          da->query(value, var, matl, patch, t);
                          for (int ii = 0; ii < 3; ++ii) {
                            for (int jj = 0; jj < 3; ++jj) {
-                             cout << " " << value[*iter](ii,jj) ;
+                             out << " " << value[*iter](ii,jj) ;
                            }
                          }
-                         cout << " ";
+                         out << " ";
                        }
                       break;
                       case Uintah::TypeDescription::long64_type:
                        {
                          ParticleVariable<long64> value;
                          da->query(value, var, matl, patch, t);
-                         cout << " " << value[*iter] << " ";
+                         out << " " << value[*iter] << " ";
                        }
                       break;
                       default:
@@ -975,50 +1013,50 @@ void printParticleVariables(DataArchive* da,
                 } // end of variable loop
               } // end of loop over particleVariables
             } // if all particleIDs or this particular particleID
-            cout << endl;
+            out << endl;
           } // end of loop over particles
         } // if pset not empty
       } // end of patch loop
     } // end of level loop
-  } // end of time step loop
+  }, cout ); // end of time step loop
 }
 
-void computeEquivStress(const Matrix3& stress, double& sigeff)
+void computeEquivStress(const Matrix3& stress, double& sigeff, ostream& out)
 {
   Matrix3 I; I.Identity();
   Matrix3 s = stress - I*stress.Trace()/3.0;
   sigeff = sqrt(1.5*s.NormSquared());
 
-  cout.setf(ios::scientific,ios::floatfield);
-  cout.precision(6);
+  out.setf(ios::scientific,ios::floatfield);
+  out.precision(6);
 
-  cout << " " << sigeff << endl;
+  out << " " << sigeff << endl;
 }
 
-void computePressure(const Matrix3& stress, double& press)
+void computePressure(const Matrix3& stress, double& press, ostream& out)
 {
   press = (-1./3.)*stress.Trace();
 
-  cout.setf(ios::scientific,ios::floatfield);
-  cout.precision(6);
+  out.setf(ios::scientific,ios::floatfield);
+  out.precision(6);
 
-  cout << " " << press << endl;
+  out << " " << press << endl;
 }
 
-void computeEquivStrain(const Matrix3& F, double& equiv_strain)
+void computeEquivStrain(const Matrix3& F, double& equiv_strain, ostream& out)
 {
   Matrix3 I; I.Identity();
   Matrix3 E = (F.Transpose()*F-I)*0.5;
   equiv_strain = sqrt(E.NormSquared()/1.5);
 
-  cout.setf(ios::scientific,ios::floatfield);
-  cout.precision(6);
+  out.setf(ios::scientific,ios::floatfield);
+  out.precision(6);
 
-  cout << " " << equiv_strain ;
-  cout << endl;
+  out << " " << equiv_strain ;
+  out << endl;
 }
 
-void computeTrueStrain(const Matrix3& F, Vector& strain)
+void computeTrueStrain(const Matrix3& F, Vector& strain, ostream& out)
 {
   // Compute the left Cauchy-Green tensor
   Matrix3 C = F.Transpose()*F;
@@ -1034,73 +1072,73 @@ void computeTrueStrain(const Matrix3& F, Vector& strain)
     strain[ii] = log(lambda[ii]);
   }
 
-  cout.setf(ios::scientific,ios::floatfield);
-  cout.precision(6);
+  out.setf(ios::scientific,ios::floatfield);
+  out.precision(6);
 
   for (int ii = 0; ii < 3; ++ii) {
-    cout << " " << strain[ii] ;
+    out << " " << strain[ii] ;
   }
-  cout << endl;
+  out << endl;
 }
 
-void computeGreenLagrangeStrain(const Matrix3& F, Matrix3& E)
+void computeGreenLagrangeStrain(const Matrix3& F, Matrix3& E, ostream& out)
 {
   Matrix3 I; I.Identity();
   Matrix3 C = F.Transpose()*F;
   E = (C - I)*0.5;
 
-  cout.setf(ios::scientific,ios::floatfield);
-  cout.precision(6);
+  out.setf(ios::scientific,ios::floatfield);
+  out.precision(6);
 
-  for (int ii = 0; ii < 3; ++ii) cout << " " << E(ii,ii);
-  cout << " " << E(1,2); cout << " " << E(2,0);
-  cout << " " << E(0,1);
-  cout << endl;
+  for (int ii = 0; ii < 3; ++ii) out << " " << E(ii,ii);
+  out << " " << E(1,2); out << " " << E(2,0);
+  out << " " << E(0,1);
+  out << endl;
 }
 
 // Calculate the Almansi-Hamel strain tensor
-void computeGreenAlmansiStrain(const Matrix3& F, Matrix3& e)
+void computeGreenAlmansiStrain(const Matrix3& F, Matrix3& e, ostream& out)
 {
   Matrix3 I; I.Identity();
   Matrix3 b = F*F.Transpose();
   Matrix3 binv = b.Inverse();
   e = (I - binv)*0.5;
 
-  cout.setf(ios::scientific,ios::floatfield);
-  cout.precision(6);
+  out.setf(ios::scientific,ios::floatfield);
+  out.precision(6);
 
-  for (int ii = 0; ii < 3; ++ii) cout << " " << e(ii,ii);
-  cout << " " << e(1,2); cout << " " << e(2,0);
-  cout << " " << e(0,1);
-  cout << endl;
+  for (int ii = 0; ii < 3; ++ii) out << " " << e(ii,ii);
+  out << " " << e(1,2); out << " " << e(2,0);
+  out << " " << e(0,1);
+  out << endl;
 }
 
-void computeStretchRotation(const Matrix3& F, Matrix3& R, Matrix3& U)
+void computeStretchRotation(const Matrix3& F, Matrix3& R, Matrix3& U, ostream& out)
 {
   F.polarDecomposition(U, R, 1.0e-10, true);
 
-  cout.setf(ios::scientific,ios::floatfield);
-  cout.precision(6);
+  out.setf(ios::scientific,ios::floatfield);
+  out.precision(6);
 
   for (int ii = 0; ii < 3; ++ii) {
     for (int jj = 0; jj < 3; ++jj) {
-      cout << " " << F(ii,jj);
+      out << " " << F(ii,jj);
     }
   }
   for (int ii = 0; ii < 3; ++ii) {
     for (int jj = 0; jj < 3; ++jj) {
-      cout << " " << U(ii,jj);
+      out << " " << U(ii,jj);
     }
   }
   for (int ii = 0; ii < 3; ++ii) {
     for (int jj = 0; jj < 3; ++jj) {
-      cout << " " << R(ii,jj);
+      out << " " << R(ii,jj);
     }
   }
-  cout << endl;
+  out << endl;
 }
 
-void printCauchyStress(const Matrix3& stress)
+void printCauchyStress(const Matrix3& stress, ostream& out)
 {
   double sig11 = stress(0,0);
   double sig12 = stress(0,1);
@@ -1109,10 +1147,10 @@ void printCauchyStress(const Matrix3& stress)
   double sig23 = stress(1,2);
   double sig33 = stress(2,2);
 
-  cout.setf(ios::scientific,ios::floatfield);
-  cout.precision(6);
+  out.setf(ios::scientific,ios::floatfield);
+  out.precision(6);
 
-  cout << " " << sig11 << " " << sig22 << " " << sig33 
+  out << " " << sig11 << " " << sig22 << " " << sig33 
        << " " << sig23 << " " << sig13 << " " << sig12 
        << endl;
 }
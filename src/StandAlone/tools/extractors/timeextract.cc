@@ -89,6 +89,7 @@ usage(const std::string& badarg, const std::string& progname)
     cerr << "  -vv,     --verbose           (prints status of output)\n";
     cerr << "  -q,      --quiet             (only print data values)\n";
     cerr << "  -noxml,  --xml-cache-off (turn off XML caching in DataArchive)\n";
+    cerr << "  -nt,     --threads           [int] (number of threads reading the timesteps) [defaults to 1]\n";
     exit(1);
 }
 
@@ -187,6 +188,8 @@ main(int argc, char** argv)
   // Some datasets run out of memory storing the XML data.  This turns
   // off storing that data.
   bool storeXML = true;
+
+  int numThreads = 1;
   
   /*
    * Parse arguments
@@ -238,6 +241,15 @@ main(int argc, char** argv)
 //      do_binary=true;
     } else if(s == "-noxml" || s == "--xml-cache-off") {
       storeXML = false;
+    } else if(s == "-nt" || s == "--threads") {
+      if( i + 1 >= argc ) {
+        usage( s, argv[0] );
+      }
+      numThreads = atoi(argv[++i]);
+      if( numThreads < 1 ) {
+        cerr << "The number of threads must be at least 1\n";
+        usage( s, argv[0] );
+      }
     } else {
       usage(s, argv[0]);
     }
@@ -254,6 +266,7 @@ main(int argc, char** argv)
     if (!storeXML){
       archive->turnOffXMLCaching();
     }
+    archive->setQueryThreads( numThreads );
     
     vector<string> vars;
     vector<int> num_matls;
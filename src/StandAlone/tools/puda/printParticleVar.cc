@@ -68,10 +68,14 @@ Uintah::printParticleVariable( DataArchive      * da,
 
   findTimestep_loopLimits( clf.tslow_set, clf.tsup_set, times, clf.time_step_lower, clf.time_step_upper);
   
-  bool useParticleID = true;
+  // Loop thru all time steps and store the volume and variable (stress/strain).
+  // The time steps are read in parallel and printed in order.
+  const int numTimesteps = max( (long) clf.time_step_upper - (long) clf.time_step_lower + 1, 0L );
+
+  da->orderedFor( numTimesteps, [&]( int i, ostream & out ) {
+    const unsigned long t = clf.time_step_lower + i;
+    bool useParticleID = true;
 
-  // Loop thru all time steps and store the volume and variable (stress/strain)
-  for(unsigned long t=clf.time_step_lower;t<=clf.time_step_upper;t++){
     double time = times[t];
     //cout << "Time = " << time << "\n";
     GridP grid = da->queryGrid(t);
@@ -124,11 +128,11 @@ Uintah::printParticleVariable( DataArchive      * da,
                     if(pset->numParticles() > 0){
                       ParticleSubset::iterator iter = pset->begin();
                       for(;iter != pset->end(); iter++){
-                        cout << time << " " << patchIndex << " " << matl;
+                        out << time << " " << patchIndex << " " << matl;
                         if( useParticleID ) {
-                          cout << " " << pid[*iter];
+                          out << " " << pid[*iter];
                         }
-                        cout << " " << value[*iter] << "\n";
+                        out << " " << value[*iter] << "\n";
                       }
                     }
                   }
@@ -151,11 +155,11 @@ Uintah::printParticleVariable( DataArchive      * da,
                     if(pset->numParticles() > 0){
                       ParticleSubset::iterator iter = pset->begin();
                       for(;iter != pset->end(); iter++){
-                        cout << time << " " << patchIndex << " " << matl ;
+                        out << time << " " << patchIndex << " " << matl ;
                         if( useParticleID ) {
-                          cout << " " << pid[*iter];
+                          out << " " << pid[*iter];
                         }
-                        cout << " " << value[*iter] << "\n";
+                        out << " " << value[*iter] << "\n";
                       }
                     }
                   }
@@ -178,11 +182,11 @@ Uintah::printParticleVariable( DataArchive      * da,
                     if(pset->numParticles() > 0){
                       ParticleSubset::iterator iter = pset->begin();
                       for(;iter != pset->end(); iter++){
-                        cout << time << " " << patchIndex << " " << matl;
+                        out << time << " " << patchIndex << " " << matl;
                         if( useParticleID ) {
-                          cout << " " << pid[*iter];
+                          out << " " << pid[*iter];
                         }
-                        cout << " " << value[*iter] << "\n";
+                        out << " " << value[*iter] << "\n";
                       }
                     }
                   }
@@ -205,13 +209,13 @@ Uintah::printParticleVariable( DataArchive      * da,
                     if(pset->numParticles() > 0){
                       ParticleSubset::iterator iter = pset->begin();
                       for(;iter != pset->end(); iter++){
-                        cout << time << " " << patchIndex << " " << matl ;
+                        out << time << " " << patchIndex << " " << matl ;
                         if( useParticleID ) {
-                          cout << " " << pid[*iter];
+                          out << " " << pid[*iter];
                         }
-                        cout << " " << value[*iter](0)
-                             << " " << value[*iter](1)
-                             << " " << value[*iter](2) << "\n";
+                        out << " " << value[*iter](0)
+                            << " " << value[*iter](1)
+                            << " " << value[*iter](2) << "\n";
                       }
                     }
                   }
@@ -235,12 +239,12 @@ Uintah::printParticleVariable( DataArchive      * da,
                       ParticleSubset::iterator iter = pset->begin();
                       for(;iter != pset->end(); iter++){
                         if( useParticleID ) {
-                          cout << time << " " << patchIndex << " " << matl ;
+                          out << time << " " << patchIndex << " " << matl ;
                         }
-                        cout << " " << pid[*iter];
-                        cout << " " << value[*iter][0]
-                             << " " << value[*iter][1]
-                             << " " << value[*iter][2] << "\n";
+                        out << " " << pid[*iter];
+                        out << " " << value[*iter][0]
+                            << " " << value[*iter][1]
+                            << " " << value[*iter][2] << "\n";
                       }
                     }
                   }
@@ -263,16 +267,16 @@ Uintah::printParticleVariable( DataArchive      * da,
                     if(pset->numParticles() > 0){
                       ParticleSubset::iterator iter = pset->begin();
                       for(;iter != pset->end(); iter++){
-                        cout << time << " " << patchIndex << " " << matl ;
+                        out << time << " " << patchIndex << " " << matl ;
                         if( useParticleID ) {
-                          cout << " " << pid[*iter];
+                          out << " " << pid[*iter];
                         }
                         for (int ii = 0; ii < 3; ++ii) {
                           for (int jj = 0; jj < 3; ++jj) {
-                            cout << " " << value[*iter](ii,jj) ;
+                            out << " " << value[*iter](ii,jj) ;
                           }
                         }
-                        cout << "\n";
+                        out << "\n";
                       }
                     }
                   }
@@ -285,8 +289,8 @@ Uintah::printParticleVariable( DataArchive      * da,
                     if( pset->numParticles() > 0 ){
                       ParticleSubset::iterator iter = pset->begin();
                       for(;iter != pset->end(); iter++){
-                        cout << time << " " << patchIndex << " " << matl;
-                        cout << " " << value[*iter] << "\n";
+                        out << time << " " << patchIndex << " " << matl;
+                        out << " " << value[*iter] << "\n";
                       }
                     }
                   }
@@ -302,5 +306,5 @@ Uintah::printParticleVariable( DataArchive      * da,
         } // end of variable loop
       } // end of patch loop
     } // end of level loop
-  } // end of time step loop
+  }, cout ); // end of time step loop
 } // end printParticleVariable()
@@ -106,6 +106,9 @@ usage( const std::string& badarg, const std::string& progname )
   cerr << "  -timesteplow  <int>  (only outputs timestep from int)\n";
   cerr << "  -timestephigh <int>  (only outputs timesteps upto int)\n";
   cerr << "  -matl         <int>  (only outputs data for matl)\n";
+  cerr << "  -nt           <int>  (number of threads -varsummary and -partvar read the timesteps on)\n";
+  cerr << "  -mpi                 (also spread the timesteps of -varsummary and -partvar over the\n";
+  cerr << "                        MPI ranks, run with mpirun)\n";
   cerr << "  -pic                 (prints particle ids of all particles  in cell\n";
   cerr << "                        <i> <j> <k> [ints] on the specified timesteps)\n";
   cerr << "  -pol                 (prints out average of all particles in a cell over an\n";
@@ -298,6 +301,19 @@ main( int argc, char *argv[] )
     else if (s == "-verbose") {
       clf.do_verbose = true;
     } 
+    else if (s == "-nt" || s == "--threads") {
+      if(i+1 >= argc){
+        usage("-nt", argv[0]);
+      }
+      clf.num_threads = atoi(argv[++i]);
+      if( clf.num_threads < 1 ) {
+        cerr << "The number of threads must be at least 1\n";
+        usage("-nt", argv[0]);
+      }
+    } 
+    else if (s == "-mpi") {
+      clf.use_mpi = true;
+    } 
     else if (s == "-timesteplow" ||
              s == "-timeStepLow" ||
              s == "-timestep_low") {
@@ -341,11 +357,34 @@ main( int argc, char *argv[] )
     cerr << "No archive file specified\n";
     usage("", argv[0]);
   }
+
+  // With -mpi the other ranks only take part in the timesteps of
+  // -varsummary and -partvar, all of the output comes from rank 0.
+  if( clf.use_mpi && Uintah::Parallel::getMPIRank() != 0 ) {
+    CommandLineFlags helper;
+    helper.be_brief         = clf.be_brief;
+    helper.do_varsummary    = clf.do_varsummary;
+    helper.do_partvar       = clf.do_partvar && !clf.do_POL;
+    helper.use_extra_cells  = clf.use_extra_cells;
+    helper.time_step_lower  = clf.time_step_lower;
+    helper.time_step_upper  = clf.time_step_upper;
+    helper.tslow_set        = clf.tslow_set;
+    helper.tsup_set         = clf.tsup_set;
+    helper.num_threads      = clf.num_threads;
+    helper.use_mpi          = clf.use_mpi;
+    helper.filebase         = clf.filebase;
+    helper.particleVariable = clf.particleVariable;
+    clf = helper;
+  }
   
   //______________________________________________________________________
   //
   try {
     DataArchive* da = scinew DataArchive( clf.filebase );
+    da->setQueryThreads( clf.num_threads );
+    if( clf.use_mpi ) {
+      da->setQueryComm( Uintah::Parallel::getRootProcessorGroup()->getComm() );
+    }
     
     //__________________________________
     //  LIST TIMESTEPS
@@ -462,6 +501,9 @@ main( int argc, char *argv[] )
     abort();
   }
 
+  if( clf.use_mpi ) {
+    Uintah::Parallel::finalizeManager();
+  }
   return 0;
 
 } // end main()
@@ -65,6 +65,8 @@ namespace Uintah {
     int tskip;
     int matl;
     int dir;
+    int num_threads;   // -varsummary and -partvar read the time steps on this many threads...
+    bool use_mpi;      // ...and MPI ranks
 
     std::string filebase;
     std::string particleVariable;
@@ -103,6 +105,8 @@ namespace Uintah {
       tsup_set = false;
       tskip = 1;
       matl  = 0;
+      num_threads = 1;
+      use_mpi = false;
     }
   };
 
@@ -77,7 +77,7 @@ public:
 
   // Prints out the min/max values for each level.
   virtual ~MinMaxInfoBase() {};
-  virtual void display() = 0;
+  virtual void display( ostream & out ) = 0;
 
 };
 
@@ -104,7 +104,7 @@ public:
   // Updates the stored min_/max_ values based on the passed in min/max.
   void updateMinMax( int levelIndex, T & min, T & max );
 
-  virtual void display();
+  virtual void display( ostream & out );
 
 private:
   vector<T> min_, max_; // One per level of the variable.  
@@ -115,20 +115,20 @@ private:
 
 template<class Type>
 void
-MinMaxInfo<Type>::display()
+MinMaxInfo<Type>::display( ostream & out )
 {
-  cout << "\n";
+  out << "\n";
   for( unsigned int level = 0; level < min_.size(); level++ ) {
-    cout << "   Level " << level << ": Min/Max: " << min_[level] << ", " << max_[level] << "\n";
+    out << "   Level " << level << ": Min/Max: " << min_[level] << ", " << max_[level] << "\n";
   }
 }
 
 template<>
 void
-MinMaxInfo<Matrix3>::display()
+MinMaxInfo<Matrix3>::display( ostream & out )
 {
   for( unsigned int level = 0; level < min_.size(); level++ ) {
-    cout << "Level " << level << ": Min/Max: " << min_[0].Norm() << ", " << max_[0].Norm() << "\n";
+    out << "Level " << level << ": Min/Max: " << min_[0].Norm() << ", " << max_[0].Norm() << "\n";
   }
 }
 
@@ -197,29 +197,36 @@ MinMaxInfo<Type>::initializeMinMax( int startingIndex )
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 //
-// This variable is used to store the global min/max values.
+// One time step's summary: the stream it is printed to and the global
+// min/max values of the time step.  Time steps are summarized in
+// parallel, each with its own TimestepSummary.
 //
 //  * Map of string ("variable_name malt#") to min/max info
 //
-map< string, MinMaxInfoBase * > globalMinMax;
+struct TimestepSummary {
+  TimestepSummary( ostream & out ) : out( out ) {}
+
+  ostream                       & out;
+  map< string, MinMaxInfoBase * > globalMinMax;
+};
 
 static
 void
-displayGlobalMinMax()
+displayGlobalMinMax( TimestepSummary & ts )
 {
-  cout << "Global Min/Max are:\n\n";
+  ts.out << "Global Min/Max are:\n\n";
 
-  for( map< string, MinMaxInfoBase * >::iterator iter = globalMinMax.begin(); iter != globalMinMax.end(); iter++ ) {
+  for( map< string, MinMaxInfoBase * >::iterator iter = ts.globalMinMax.begin(); iter != ts.globalMinMax.end(); iter++ ) {
 
-    cout << iter->first << ": ";
-    iter->second->display();
+    ts.out << iter->first << ": ";
+    iter->second->display( ts.out );
 
     delete iter->second;  // Free up memory
   }
 
-  cout << "\n";
+  ts.out << "\n";
 
-  globalMinMax.clear(); // Reset so we can find the global min/max for the next time step.
+  ts.globalMinMax.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -227,6 +234,7 @@ displayGlobalMinMax()
 template <class Type>
 void
 printMinMax( CommandLineFlags & clf,
+             TimestepSummary  & ts,
              const string     & var,
              int                matl,
              const Patch      * patch,
@@ -241,12 +249,12 @@ printMinMax( CommandLineFlags & clf,
   stringstream ss;
   ss << var << " (matl: " << matl << ")";
 
-  MinMaxInfoBase   * mmBase = globalMinMax[ ss.str() ];
+  MinMaxInfoBase   * mmBase = ts.globalMinMax[ ss.str() ];
   MinMaxInfo<Type> * mmInfo = dynamic_cast< MinMaxInfo<Type> *>( mmBase );
   if( mmInfo == nullptr ) {
     // cout << "Creating new data store for " << var << ", malt: " << matl << " for Type: " << td->getName() << "\n";
     mmInfo = new MinMaxInfo<Type>();
-    globalMinMax[ ss.str() ] = mmInfo;
+    ts.globalMinMax[ ss.str() ] = mmInfo;
 
   }
   mmInfo->verifyNumberOfLevels( patch->getLevel()->getIndex() );
@@ -258,15 +266,15 @@ printMinMax( CommandLineFlags & clf,
   // what they really are.
 
   if( !clf.be_brief ) {
-    cout << "\t\t\t\tmin value: " << *min << "\n";
-    cout << "\t\t\t\tmax value: " << *max << "\n";
+    ts.out << "\t\t\t\tmin value: " << *min << "\n";
+    ts.out << "\t\t\t\tmax value: " << *max << "\n";
   }
   mmInfo->updateMinMax( patch->getLevel()->getIndex(), *min, *max );
   if( c_min != nullptr && !clf.be_brief ) {
-    cout << "\t\t\t\tmin location: " << *c_min << " (Occurrences: ~" << minCnt << ")\n";
+    ts.out << "\t\t\t\tmin location: " << *c_min << " (Occurrences: ~" << minCnt << ")\n";
   }
   if( c_max != nullptr && !clf.be_brief ) {
-    cout << "\t\t\t\tmax location: " << *c_max << " (Occurrences: ~" << maxCnt << ")\n";
+    ts.out << "\t\t\t\tmax location: " << *c_max << " (Occurrences: ~" << maxCnt << ")\n";
   }
 
 } // end printMinMax()
@@ -274,6 +282,7 @@ printMinMax( CommandLineFlags & clf,
 template <>
 void
 printMinMax<Matrix3>( CommandLineFlags & clf,
+             TimestepSummary  & ts,
              const string     & var,
              int                matl,
              const Patch      * patch,
@@ -288,12 +297,12 @@ printMinMax<Matrix3>( CommandLineFlags & clf,
   stringstream ss;
   ss << var << " (matl: " << matl << ")";
 
-  MinMaxInfoBase   * mmBase = globalMinMax[ ss.str() ];
+  MinMaxInfoBase   * mmBase = ts.globalMinMax[ ss.str() ];
   MinMaxInfo<Matrix3> * mmInfo = dynamic_cast< MinMaxInfo<Matrix3> *>( mmBase );
   if( mmInfo == nullptr ) {
     // cout << "Creating new data store for " << var << ", malt: " << matl << " for Type: " << td->getName() << "\n";
     mmInfo = new MinMaxInfo<Matrix3>();
-    globalMinMax[ ss.str() ] = mmInfo;
+    ts.globalMinMax[ ss.str() ] = mmInfo;
 
   }
   mmInfo->verifyNumberOfLevels( patch->getLevel()->getIndex() );
@@ -308,8 +317,8 @@ printMinMax<Matrix3>( CommandLineFlags & clf,
   double patchMax = max->Norm();
 
   if( !clf.be_brief ) {
-    cout << "\t\t\t\tMin Norm: " << patchMin << "\n";
-    cout << "\t\t\t\tMax Norm: " << patchMax << "\n";
+    ts.out << "\t\t\t\tMin Norm: " << patchMin << "\n";
+    ts.out << "\t\t\t\tMax Norm: " << patchMax << "\n";
   }
 
   // Have to cast to 'what it already is' so that compiler won't
@@ -324,6 +333,7 @@ printMinMax<Matrix3>( CommandLineFlags & clf,
 template <>
 void
 printMinMax<Vector>( CommandLineFlags & clf,
+             TimestepSummary  & ts,
              const string     & var,
              int                matl,
              const Patch      * patch,
@@ -338,12 +348,12 @@ printMinMax<Vector>( CommandLineFlags & clf,
   stringstream ss;
   ss << var << " (matl: " << matl << ")";
 
-  MinMaxInfoBase   * mmBase = globalMinMax[ ss.str() ];
+  MinMaxInfoBase   * mmBase = ts.globalMinMax[ ss.str() ];
   MinMaxInfo<Vector> * mmInfo = dynamic_cast< MinMaxInfo<Vector> *>( mmBase );
   if( mmInfo == nullptr ) {
     // cout << "Creating new data store for " << var << ", malt: " << matl << " for Type: " << td->getName() << "\n";
     mmInfo = new MinMaxInfo<Vector>();
-    globalMinMax[ ss.str() ] = mmInfo;
+    ts.globalMinMax[ ss.str() ] = mmInfo;
 
   }
   mmInfo->verifyNumberOfLevels( patch->getLevel()->getIndex() );
@@ -374,12 +384,12 @@ printMinMax<Vector>( CommandLineFlags & clf,
   ((MinMaxInfo<Vector>*) mmInfo)->updateMinMax( patch->getLevel()->getIndex(), *min, *max );
 
   if( !clf.be_brief ) {
-    cout << "\t\t\t\tmin magnitude: " << minMagnitude << "\n";
-    cout << "\t\t\t\tmax magnitude: " << maxMagnitude << "\n";
+    ts.out << "\t\t\t\tmin magnitude: " << minMagnitude << "\n";
+    ts.out << "\t\t\t\tmax magnitude: " << maxMagnitude << "\n";
     
     if( c_min != nullptr && c_max != nullptr ){
-      cout << "\t\t\t\tmin location: " << *c_min << " (Occurrences: ~" << minCnt << ")\n";
-      cout << "\t\t\t\tmax location: " << *c_max << " (Occurrences: ~" << maxCnt << ")\n";
+      ts.out << "\t\t\t\tmin location: " << *c_min << " (Occurrences: ~" << minCnt << ")\n";
+      ts.out << "\t\t\t\tmax location: " << *c_max << " (Occurrences: ~" << maxCnt << ")\n";
     }
   }
 } // end printMinMax()
@@ -416,7 +426,8 @@ findMinMax( DataArchive         * da,
             int                   matl,
             const Patch         * patch,
             int                   timestep,
-            CommandLineFlags    & clf )
+            CommandLineFlags    & clf,
+            TimestepSummary     & ts )
 {
   Tvar var;
 
@@ -429,13 +440,13 @@ findMinMax( DataArchive         * da,
     bool found = da->query( var, var_name, matl, patch, timestep );
 
     if( !found ) {
-      cout << "\t\t\t\tVar not found...\n";
+      ts.out << "\t\t\t\tVar not found...\n";
       return;
     }
 
     if( !clf.be_brief ) {
-      cout << "\t\t\t\t" << td->getName() << " over " << iter.begin() << " (inclusive) to " 
-           << iter.end() << " (exclusive)\n";
+      ts.out << "\t\t\t\t" << td->getName() << " over " << iter.begin() << " (inclusive) to " 
+             << iter.end() << " (exclusive)\n";
     }
 
     Ttype min, max;
@@ -476,7 +487,7 @@ findMinMax( DataArchive         * da,
       max = Max(max, val);
     }
 
-    printMinMax<Ttype>( clf, var_name, matl, patch, td->getSubType(), &min, &max, &c_min, &c_max, minCnt, maxCnt );
+    printMinMax<Ttype>( clf, ts, var_name, matl, patch, td->getSubType(), &min, &max, &c_min, &c_max, minCnt, maxCnt );
 
   } // end if( dx dy dz )
 
@@ -490,7 +501,8 @@ findMinMaxPP( DataArchive         * da,
 	      int                   matl,
 	      const Patch         * patch,
 	      int                   timestep,
-	      CommandLineFlags    & clf )
+	      CommandLineFlags    & clf,
+	      TimestepSummary     & ts )
 {
   Tvar value;
 
@@ -499,7 +511,7 @@ findMinMaxPP( DataArchive         * da,
   da->query(value, var, matl, patch, timestep);
 
   if( !clf.be_brief ) {
-      cout << "\t\t\t\t" << td->getName() << "\n";
+      ts.out << "\t\t\t\t" << td->getName() << "\n";
   }
 
   Ttype min, max;
@@ -514,7 +526,7 @@ findMinMaxPP( DataArchive         * da,
   // c_max = patch->getID();
   // c_min = c_max;
   
-  printMinMax<Ttype>( clf, var, matl, patch, td->getSubType(), &min, &max, &c_min, &c_max, minCnt, maxCnt );
+  printMinMax<Ttype>( clf, ts, var, matl, patch, td->getSubType(), &min, &max, &c_min, &c_max, minCnt, maxCnt );
 
 } // end findMinMax()
 
@@ -529,7 +541,8 @@ findMinMaxPV( DataArchive      * da,
               int                matl,
               const Patch      * patch,
               int                timestep,
-              CommandLineFlags & clf ){
+              CommandLineFlags & clf,
+              TimestepSummary  & ts ){
   Tvar value;
 
   const Uintah::TypeDescription * td = value.getTypeDescription();
@@ -537,7 +550,7 @@ findMinMaxPV( DataArchive      * da,
   da->query( value, var, matl, patch, timestep );
   ParticleSubset* pset = value.getParticleSubset();
   if( !clf.be_brief ) {
-    cout << "\t\t\t\t" << td->getName() << " over " << pset->numParticles() << " particles\n";
+    ts.out << "\t\t\t\t" << td->getName() << " over " << pset->numParticles() << " particles\n";
   }
   if( pset->numParticles() > 0 ) {
     Ttype min, max;
@@ -551,7 +564,7 @@ findMinMaxPV( DataArchive      * da,
     }
     //IntVector c_min, c_max;
     //int       minCnt = -1, maxCnt = -1;
-    printMinMax<Ttype>( clf, var, matl, patch, td->getSubType(), &min, &max );
+    printMinMax<Ttype>( clf, ts, var, matl, patch, td->getSubType(), &min, &max );
   }
 }
 
@@ -571,33 +584,39 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
   da->queryVariables( vars, num_matls, types );
   ASSERTEQ( vars.size(), types.size() );
 
-  cout << "There are " << vars.size() << " variables:\n";
+  proc0cout << "There are " << vars.size() << " variables:\n";
   for(int i=0;i<(int)vars.size();i++) {
-    cout << "  " << vars[i] << ": " << types[i]->getName() << "\n";
+    proc0cout << "  " << vars[i] << ": " << types[i]->getName() << "\n";
   }
-  cout << "\n";
+  proc0cout << "\n";
 
   vector<int> index;
   vector<double> times;
   da->queryTimesteps(index, times);
   ASSERTEQ(index.size(), times.size());
 
-  cout << "There are " << index.size() << " timesteps:\n";
+  proc0cout << "There are " << index.size() << " timesteps:\n";
 
   for( int i = 0; i < (int)index.size(); i++ ) {
-    cout << "  " << index[i] << ": " << times[i] << "\n";
+    proc0cout << "  " << index[i] << ": " << times[i] << "\n";
   }
 
-  cout << "\n";
+  proc0cout << "\n";
       
   findTimestep_loopLimits( clf.tslow_set, clf.tsup_set, times, clf.time_step_lower, clf.time_step_upper);
       
-  for( unsigned long t = clf.time_step_lower; t <= clf.time_step_upper; t++ ) {
+  // The time steps are summarized in parallel and printed in order.
+  const int numTimesteps = max( (long) clf.time_step_upper - (long) clf.time_step_lower + 1, 0L );
+
+  da->orderedFor( numTimesteps, [&]( int i, ostream & out ) {
+    const unsigned long t = clf.time_step_lower + i;
+    TimestepSummary ts( out );
+
     double time = times[t];
 
-    cout << "----------------------------------------------------------------------\n";
-    cout << "Time = " << time << "\n";
-    cout << "\n";
+    out << "----------------------------------------------------------------------\n";
+    out << "Time = " << time << "\n";
+    out << "\n";
     GridP grid = da->queryGrid( t );
 
     // Variable Loop:
@@ -606,7 +625,7 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
       const Uintah::TypeDescription* td = types[v];
       const Uintah::TypeDescription* subtype = td->getSubType();
       if( !clf.be_brief ) {
-        cout << "\tVariable: " << var << ", type " << td->getName() << "\n";
+        out << "\tVariable: " << var << ", type " << td->getName() << "\n";
       }
 
       // Level Loop:
@@ -614,14 +633,14 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
 
         LevelP level = grid->getLevel(l);
         if( !clf.be_brief ) {
-          cout << "\t    Level: " << level->getIndex() << ", id " << level->getID() << "\n";
+          out << "\t    Level: " << level->getIndex() << ", id " << level->getID() << "\n";
         }
 
         // Patch Loop:
         for( Level::const_patch_iterator iter = level->patchesBegin(); iter != level->patchesEnd(); iter++ ){
           const Patch* patch = *iter;
           if( !clf.be_brief ) {
-            cout << "\t\tPatch: " << patch->getID() << "\n";
+            out << "\t\tPatch: " << patch->getID() << "\n";
           }
           
           ConsecutiveRangeSet matls = da->queryMaterials( var, patch, t );
@@ -633,7 +652,7 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               continue;
             }
             if( !clf.be_brief ) {
-              cout << "\t\t\tMaterial: " << matl << "\n";
+              out << "\t\t\tMaterial: " << matl << "\n";
             }
             switch( td->getType() ){
               //__________________________________
@@ -642,37 +661,37 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               switch(subtype->getType()){
               case Uintah::TypeDescription::double_type:
                 {
-                  findMinMaxPV<ParticleVariable<double>,double>( da, var, matl, patch, t, clf );
+                  findMinMaxPV<ParticleVariable<double>,double>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::float_type:
                 {
-                  findMinMaxPV<ParticleVariable<float>,float>( da, var, matl, patch, t, clf );
+                  findMinMaxPV<ParticleVariable<float>,float>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::int_type:
                 {
-                  findMinMaxPV<ParticleVariable<int>,int>( da, var, matl, patch, t, clf );
+                  findMinMaxPV<ParticleVariable<int>,int>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Point:
                 {
-                  findMinMaxPV<ParticleVariable<Point>,Point>( da, var, matl, patch, t, clf );
+                  findMinMaxPV<ParticleVariable<Point>,Point>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Vector:
                 {
-                  findMinMaxPV<ParticleVariable<Vector>,Vector>( da, var, matl, patch, t, clf );
+                  findMinMaxPV<ParticleVariable<Vector>,Vector>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Matrix3:
                 {
-                  findMinMaxPV<ParticleVariable<Matrix3>,Matrix3>( da, var, matl, patch, t, clf );
+                  findMinMaxPV<ParticleVariable<Matrix3>,Matrix3>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::long64_type:
                 {
-                  findMinMaxPV<ParticleVariable<long64>,long64>( da, var, matl, patch, t, clf );
+                  findMinMaxPV<ParticleVariable<long64>,long64>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               default:
@@ -686,12 +705,12 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               switch(subtype->getType()){
               case Uintah::TypeDescription::double_type:
                 {
-                  findMinMax<NCVariable<double>,double>( da, var, matl, patch, t, clf );
+                  findMinMax<NCVariable<double>,double>( da, var, matl, patch, t, clf, ts );
                 }
               break;
               case Uintah::TypeDescription::float_type:
                 {
-                  findMinMax<NCVariable<float>,float>( da, var, matl, patch, t, clf );
+                  findMinMax<NCVariable<float>,float>( da, var, matl, patch, t, clf, ts );
                 }
               break;
               case Uintah::TypeDescription::Point:
@@ -705,12 +724,12 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               break;
               case Uintah::TypeDescription::Vector:
                 {
-                  findMinMax<NCVariable<Vector>,Vector>( da, var, matl, patch, t, clf );
+                  findMinMax<NCVariable<Vector>,Vector>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Matrix3:
                 {
-                  findMinMax<NCVariable<Matrix3>,Matrix3>( da, var, matl, patch, t, clf );
+                  findMinMax<NCVariable<Matrix3>,Matrix3>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               default:
@@ -724,17 +743,17 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               switch(subtype->getType()){
               case Uintah::TypeDescription::int_type:
                 {
-                  findMinMax<CCVariable<int>,int>( da, var, matl, patch, t, clf );
+                  findMinMax<CCVariable<int>,int>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::double_type:
                 {
-                  findMinMax<CCVariable<double>,double>( da, var, matl, patch, t, clf);
+                  findMinMax<CCVariable<double>,double>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::float_type:
                 {
-                  findMinMax<CCVariable<float>,float>( da, var, matl, patch, t, clf );
+                  findMinMax<CCVariable<float>,float>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Point:
@@ -743,17 +762,17 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
                   cout << "puda was handling them correctly if they do... If we need them, we will need to\n";
                   cout << "figure out how to deal with them properly\n";
                   exit( 1 );
-                  //findMinMax<NCVariable<Point>,Point>( da, var, matl, patch, t, clf );
+                  //findMinMax<NCVariable<Point>,Point>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Vector:
                 {
-                  findMinMax<CCVariable<Vector>,Vector>( da, var, matl, patch, t, clf );
+                  findMinMax<CCVariable<Vector>,Vector>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Matrix3:
                 {
-                  findMinMax<CCVariable<Matrix3>,Matrix3>( da, var, matl, patch, t, clf );
+                  findMinMax<CCVariable<Matrix3>,Matrix3>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               break;
@@ -768,17 +787,17 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               switch(subtype->getType()){
               case Uintah::TypeDescription::double_type:
                 {
-                  findMinMax<SFCXVariable<double>,double>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCXVariable<double>,double>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::float_type:
                 {
-                  findMinMax<SFCXVariable<float>,float>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCXVariable<float>,float>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Vector:
                 {
-                  findMinMax<SFCXVariable<Vector>,Vector>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCXVariable<Vector>,Vector>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               default:
@@ -792,17 +811,17 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               switch(subtype->getType()){
               case Uintah::TypeDescription::double_type:
                 {
-                  findMinMax<SFCYVariable<double>,double>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCYVariable<double>,double>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::float_type:
                 {
-                  findMinMax<SFCYVariable<float>,float>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCYVariable<float>,float>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Vector:
                 {
-                  findMinMax<SFCYVariable<Vector>,Vector>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCYVariable<Vector>,Vector>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               default:
@@ -816,17 +835,17 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               switch(subtype->getType()){
               case Uintah::TypeDescription::double_type:
                 {
-                  findMinMax<SFCZVariable<double>,double>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCZVariable<double>,double>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::float_type:
                 {
-                  findMinMax<SFCZVariable<float>,float>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCZVariable<float>,float>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::Vector:
                 {
-                  findMinMax<SFCZVariable<Vector>,Vector>( da, var, matl, patch, t, clf );
+                  findMinMax<SFCZVariable<Vector>,Vector>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               default:
@@ -840,12 +859,12 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
               switch(subtype->getType()){
               case Uintah::TypeDescription::double_type:
                 {
-                  findMinMaxPP<PerPatch<double>,double>( da, var, matl, patch, t, clf );
+                  findMinMaxPP<PerPatch<double>,double>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               case Uintah::TypeDescription::int_type:
                 {
-                  findMinMaxPP<PerPatch<int>,int>( da, var, matl, patch, t, clf );
+                  findMinMaxPP<PerPatch<int>,int>( da, var, matl, patch, t, clf, ts );
                   break;
                 }
               default:
@@ -866,7 +885,7 @@ Uintah::varsummary( DataArchive* da, CommandLineFlags & clf, int material_of_int
     } // end for( v )
 
     // Display the global min/max for this timestep.
-    displayGlobalMinMax();
+    displayGlobalMinMax( ts );
 
-  } // end for( t )
+  }, cout ); // end for( t )
 } // end varsummary()
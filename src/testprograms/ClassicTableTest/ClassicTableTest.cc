@@ -0,0 +1,337 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/Arches/ChemMixV2/ClassicTable.h>
+#include <CCA/Components/Arches/ChemMixV2/ClassicTableUtility.h>
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Patch.h>
+#include <Core/Grid/Variables/CCVariable.h>
+#include <Core/Parallel/Parallel.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace Uintah;
+
+namespace {
+
+  const int NUM_DEP_VARS = 3;
+
+  double random01()
+  {
+    return rand() / static_cast<double>(RAND_MAX);
+  }
+
+  // n points from lo to hi, evenly spaced or stretched towards lo
+  std::vector<double> makeAxis( int n, double lo, double hi, bool uniform )
+  {
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++) {
+      double t = i / static_cast<double>(n - 1);
+      x[i] = lo + (hi - lo) * (uniform ? t : t*t);
+    }
+    return x;
+  }
+
+  // Builds a table with the given axis sizes and compares getState with
+  // find_val on every cell of the patch.  Returns the number of mismatches.
+  int compareTable( const std::vector<int> & sizes
+                  ,       bool               uniform
+                  , const Patch            * patch
+                  )
+  {
+    const int nDim = sizes.size();
+
+    // The Interp_class takes ownership of these
+    std::vector<int>*                  indepVarNo = new std::vector<int>(sizes);
+    std::vector<std::vector<double> >* indep      = new std::vector<std::vector<double> >();
+    std::vector<std::vector<double> >* ind_1      = new std::vector<std::vector<double> >();
+
+    for (int d = 1; d < nDim; d++) {
+      indep->push_back( makeAxis(sizes[d], 0.0, 1.0, uniform || d % 2 == 0) );
+    }
+    // one row of the first IV for each value of the last one
+    const int nRows = (nDim == 1) ? 1 : sizes[nDim-1];
+    for (int r = 0; r < nRows; r++) {
+      ind_1->push_back( makeAxis(sizes[0], 0.1*r, 1.0 + 0.2*r, uniform) );
+    }
+
+    size_t tableSize = 1;
+    for (int d = 0; d < nDim; d++) {
+      tableSize *= sizes[d];
+    }
+
+    tempTableContainer* table = new tempTableContainer(NUM_DEP_VARS, tableSize);
+    for (int v = 0; v < NUM_DEP_VARS; v++) {
+      for (size_t i = 0; i < tableSize; i++) {
+        (*table)[v][i] = 1000.0*v + std::sin(0.37*i) + 0.01*i;
+      }
+    }
+
+    std::vector<std::string> indepNames(nDim, "iv");
+    std::vector<std::string> depNames(NUM_DEP_VARS, "dv");
+    std::vector<std::string> units(NUM_DEP_VARS, "none");
+    std::map<std::string, double> constants;
+    ClassicTableInfo info(*indep, *indepVarNo, indepNames, depNames, units, constants);
+
+    Interp_class interp(*table, *indepVarNo, *indep, *ind_1, info);
+
+    // Independent variables: random within and beyond the table, and on nodes
+    const IntVector lo = patch->getCellLowIndex();
+    const IntVector hi = patch->getCellHighIndex();
+
+    std::vector<CCVariable<double> > ivs(nDim);
+    for (int d = 0; d < nDim; d++) {
+      ivs[d].allocate(lo, hi);
+    }
+
+    int cell = 0;
+    for (int k = lo.z(); k < hi.z(); k++) {
+      for (int j = lo.y(); j < hi.y(); j++) {
+        for (int i = lo.x(); i < hi.x(); i++, cell++) {
+          for (int d = 0; d < nDim; d++) {
+            const std::vector<double>& axis = (d == 0) ? (*ind_1)[0] : (*indep)[d-1];
+            double v = -0.2 + 1.6*random01();
+            if (cell % 5 == 0) {
+              v = axis[cell % axis.size()];   // on a node
+            }
+            if (cell % 11 == 0) {
+              v = axis.back();                // on the last node
+            }
+            ivs[d](i,j,k) = v;
+          }
+        }
+      }
+    }
+
+    std::vector<CCVariable<double> > batched(NUM_DEP_VARS);
+    std::vector<int> depVarIndexes;
+    for (int v = 0; v < NUM_DEP_VARS; v++) {
+      batched[v].allocate(lo, hi);
+      depVarIndexes.push_back(NUM_DEP_VARS - 1 - v);   // not in table order
+    }
+
+    interp.getState(ivs, batched, indepNames, patch, depVarIndexes);
+
+    int errors = 0;
+    std::vector<double> iv(nDim);
+    for (int k = lo.z(); k < hi.z(); k++) {
+      for (int j = lo.y(); j < hi.y(); j++) {
+        for (int i = lo.x(); i < hi.x(); i++) {
+          for (int d = 0; d < nDim; d++) {
+            iv[d] = ivs[d](i,j,k);
+          }
+          std::vector<double> scalar = interp.find_val(iv, depVarIndexes);
+          for (int v = 0; v < NUM_DEP_VARS; v++) {
+            if (batched[v](i,j,k) != scalar[v]) {
+              if (errors < 10) {
+                std::cout << nDim << "D " << (uniform ? "uniform" : "non uniform")
+                          << " table, cell " << IntVector(i,j,k) << ", variable " << v
+                          << ": getState " << batched[v](i,j,k) << ", find_val " << scalar[v] << "\n";
+              }
+              errors++;
+            }
+          }
+        }
+      }
+    }
+    return errors;
+  }
+
+  bool binaryUsable( const std::string & binaryFileName, const std::string & tableFileName )
+  {
+    FILE* fp = fopen( binaryFileName.c_str(), "rb" );
+    ClassicTableBinaryPrelude prelude;
+    std::string               problem;
+    bool usable = fp != nullptr && checkClassicTableBinary( fp, tableFileName, prelude, problem );
+    if ( fp != nullptr ) {
+      fclose( fp );
+    }
+    return usable;
+  }
+
+  void overwrite( const std::string & fileName, long offset, const void * data, size_t bytes )
+  {
+    FILE* fp = fopen( fileName.c_str(), "r+b" );
+    fseek( fp, offset, SEEK_SET );
+    fwrite( data, bytes, 1, fp );
+    fclose( fp );
+  }
+
+  // Writes the binary form of a table and reads it back, then checks that
+  // a changed text table, another byte order, a bad header size and a
+  // truncated file are refused.  Returns the number of errors.
+  int binaryRoundTrip()
+  {
+    const std::string tableFileName  = "ClassicTableTest.tbl";
+    const std::string binaryFileName = "ClassicTableTest.bin";
+
+    FILE* fp = fopen( tableFileName.c_str(), "wb" );
+    fputs( "not really a table\n", fp );
+    fclose( fp );
+
+    ClassicTableHeader header;
+    header.indepNames   = { "mixture_fraction", "heat_loss" };
+    header.indepNum     = { 4, 3 };
+    header.depNames     = { "temperature", "density" };
+    header.depUnits     = { "K", "kg/m^3" };
+    header.constants    = { { "H_air", -1.2e5 }, { "H_fuel", 3.4e6 } };
+    header.indepHeaders = { makeAxis( 3, -1.0, 1.0, true ) };
+    header.ind1         = { makeAxis( 4, 0.0, 1.0, true ), makeAxis( 4, 0.0, 1.0, false ), makeAxis( 4, 0.1, 0.9, true ) };
+
+    const int    nVars = header.depNames.size();
+    const size_t size  = header.tableSize();
+    std::vector<double> values( nVars*size );
+    for (int v = 0; v < nVars; v++) {
+      for (size_t i = 0; i < size; i++) {
+        values[ classicTableOffset( v, i, nVars, size ) ] = 300.0*v + 0.5*i;
+      }
+    }
+
+    int errors = 0;
+    auto check = [&]( bool ok, const char * what ) {
+      if ( !ok ) {
+        std::cout << "binary table: " << what << "\n";
+        errors++;
+      }
+    };
+
+    writeClassicTableBinary( binaryFileName, tableFileName, header, &values[0] );
+
+    fp = fopen( binaryFileName.c_str(), "rb" );
+    check( fp != nullptr, "not written" );
+    if ( fp == nullptr ) {
+      return errors;
+    }
+    ClassicTableHeader read;
+    size_t             dataOffset;
+    readClassicTableBinaryHeader( fp, binaryFileName, tableFileName, read, dataOffset );
+    check( read.indepNames   == header.indepNames &&
+           read.indepNum     == header.indepNum &&
+           read.depNames     == header.depNames &&
+           read.depUnits     == header.depUnits &&
+           read.constants    == header.constants &&
+           read.indepHeaders == header.indepHeaders &&
+           read.ind1         == header.ind1, "header differs" );
+
+    std::vector<double> data( nVars*size );
+    fseek( fp, dataOffset, SEEK_SET );
+    check( fread( &data[0], sizeof(double), data.size(), fp ) == data.size(), "data missing" );
+    fclose( fp );
+    for (int v = 0; v < nVars; v++) {
+      for (size_t i = 0; i < size; i++) {
+        check( data[ v*size + i ] == values[ classicTableOffset( v, i, nVars, size ) ], "data differs" );
+      }
+    }
+
+    // a text table of another size
+    fp = fopen( tableFileName.c_str(), "ab" );
+    fputs( "changed\n", fp );
+    fclose( fp );
+    check( !binaryUsable( binaryFileName, tableFileName ), "used with a changed text table" );
+    writeClassicTableBinary( binaryFileName, tableFileName, header, &values[0] );
+    check( binaryUsable( binaryFileName, tableFileName ), "not usable once written again" );
+
+    // written on a machine of the other byte order
+    const uint32_t swapped = 0x04030201;
+    overwrite( binaryFileName, offsetof( ClassicTableBinaryPrelude, byteOrder ), &swapped, sizeof(swapped) );
+    check( !binaryUsable( binaryFileName, tableFileName ), "used with another byte order" );
+    bool thrown = false;
+    try {
+      fp = fopen( binaryFileName.c_str(), "rb" );
+      readClassicTableBinaryHeader( fp, binaryFileName, tableFileName, read, dataOffset );
+    }
+    catch ( ProblemSetupException & ) {
+      thrown = true;
+    }
+    fclose( fp );
+    check( thrown, "header read with another byte order" );
+
+    // a header size that is not allocated
+    writeClassicTableBinary( binaryFileName, tableFileName, header, &values[0] );
+    const uint64_t huge = 0x0000400000000000ull;
+    overwrite( binaryFileName, offsetof( ClassicTableBinaryPrelude, headerBytes ), &huge, sizeof(huge) );
+    check( !binaryUsable( binaryFileName, tableFileName ), "used with a bad header size" );
+
+    // truncated in the data
+    writeClassicTableBinary( binaryFileName, tableFileName, header, &values[0] );
+    check( truncate( binaryFileName.c_str(), dataOffset + 8 ) == 0, "not truncated" );
+    thrown = false;
+    try {
+      fp = fopen( binaryFileName.c_str(), "rb" );
+      readClassicTableBinaryHeader( fp, binaryFileName, tableFileName, read, dataOffset );
+    }
+    catch ( ProblemSetupException & ) {
+      thrown = true;
+    }
+    fclose( fp );
+    check( thrown, "truncated table read" );
+
+    remove( binaryFileName.c_str() );
+    remove( tableFileName.c_str() );
+    return errors;
+  }
+
+} // end anonymous namespace
+
+int main( int argc, char** argv )
+{
+  Parallel::initializeManager(argc, argv);
+
+  // rows of 37 cells: two full batches and a partial one
+  GridP grid = scinew Grid();
+  Level* level = grid->addLevel(Point(0, 0, 0), Vector(0.1, 0.1, 0.1));
+  Patch* patch = level->addPatch(IntVector(0, 0, 0), IntVector(37, 4, 3),
+                                 IntVector(0, 0, 0), IntVector(37, 4, 3), grid.get_rep());
+  level->finalizeLevel();
+
+  srand(5);
+
+  int errors = 0;
+  for (bool uniform : { true, false }) {
+    errors += compareTable({ 7 },           uniform, patch);
+    errors += compareTable({ 7, 5 },        uniform, patch);
+    errors += compareTable({ 6, 4, 3 },     uniform, patch);
+    errors += compareTable({ 5, 3, 4, 2 },  uniform, patch);
+    errors += compareTable({ 2, 2, 2 },     uniform, patch);
+  }
+  errors += binaryRoundTrip();
+
+  Parallel::finalizeManager();
+
+  if (errors == 0) {
+    std::cout << "ClassicTableTest passed\n";
+  }
+  return (errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,297 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Exceptions/Exception.h>
+#include <Core/Util/Compression.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace Uintah;
+
+namespace {
+
+  const size_t BLOCK_SIZE = 256 * 1024;   // must match Compression.cc
+
+  std::string randomBytes( size_t size )
+  {
+    std::string s( size, '\0' );
+    for( size_t i = 0; i < size; i++ ) {
+      s[i] = static_cast<char>( rand() & 0xff );
+    }
+    return s;
+  }
+
+  std::string repeatedBytes( size_t size )
+  {
+    const std::string pattern = "Uintah!";
+    std::string s( size, '\0' );
+    for( size_t i = 0; i < size; i++ ) {
+      s[i] = pattern[ i % pattern.size() ];
+    }
+    return s;
+  }
+
+  // A smooth field of doubles, the case the byte shuffle is meant for.
+  std::string smoothDoubles( size_t size )
+  {
+    std::string s( size, '\0' );
+    for( size_t i = 0; i + sizeof(double) <= size; i += sizeof(double) ) {
+      double v = 300.0 + 1e-3 * ( i / sizeof(double) );
+      s.replace( i, sizeof(double), reinterpret_cast<const char*>( &v ), sizeof(double) );
+    }
+    return s;
+  }
+
+  // Compresses and decompresses one input; returns the number of errors.
+  int roundTrip( const std::string & mode
+               , const std::string & name
+               , const std::string & in
+               ,       size_t        elementSize
+               )
+  {
+    std::string compressed;
+    std::string out;
+
+    try {
+      if( !blockCompress( mode, in, elementSize, compressed ) ) {
+        if( !compressed.empty() ) {
+          std::cout << mode << " " << name << ": output not empty after a failed compression\n";
+          return 1;
+        }
+        // stored uncompressed by the caller; nothing more to check
+        return 0;
+      }
+      if( compressed.size() >= in.size() ) {
+        std::cout << mode << " " << name << ": compressed " << in.size() << " bytes to " << compressed.size() << "\n";
+        return 1;
+      }
+      blockDecompress( mode, compressed.data(), compressed.size(), out );
+    }
+    catch( const Exception & e ) {
+      std::cout << mode << " " << name << ": " << e.message() << "\n";
+      return 1;
+    }
+
+    if( out != in ) {
+      std::cout << mode << " " << name << ": round trip of " << in.size() << " bytes does not match\n";
+      return 1;
+    }
+    return 0;
+  }
+
+  //______________________________________________________________________
+  // A smooth 3D field with some noise, x fastest, 'comps' values per cell.
+  template<class T>
+  std::vector<T> smoothField( const int dims[3], int comps )
+  {
+    std::vector<T> v;
+    for( int z = 0; z < dims[2]; z++ ) {
+      for( int y = 0; y < dims[1]; y++ ) {
+        for( int x = 0; x < dims[0]; x++ ) {
+          for( int c = 0; c < comps; c++ ) {
+            double noise = 1e-4 * ( rand() / static_cast<double>( RAND_MAX ) );
+            v.push_back( (T) ( 300.0 * ( c + 1 ) + 10.0 * std::sin( 0.3 * x ) * std::cos( 0.2 * y ) + 0.5 * z + noise ) );
+          }
+        }
+      }
+    }
+    return v;
+  }
+
+  //______________________________________________________________________
+  // Lossy round trip of one field.  'bound' is the error the values must
+  // stay within; NaN and Inf must come back unchanged.  If 'mustCompress'
+  // is false the codec may decline the field.  Returns the number of errors.
+  template<class T>
+  int lossyRoundTrip( const std::string    & name
+                    , const std::vector<T> & v
+                    , const int              dims[3]
+                    ,       double           absTolerance
+                    ,       double           relTolerance
+                    ,       double           bound
+                    ,       bool             mustCompress
+                    )
+  {
+    const std::string in( reinterpret_cast<const char*>( v.data() ), v.size() * sizeof(T) );
+    std::string compressed;
+    std::string out;
+
+    try {
+      if( !lossyCompress( in, sizeof(T), dims, absTolerance, relTolerance, compressed ) ) {
+        if( mustCompress ) {
+          std::cout << name << ": lossyCompress declined the field\n";
+          return 1;
+        }
+        if( !compressed.empty() ) {
+          std::cout << name << ": output not empty after a failed compression\n";
+          return 1;
+        }
+        return 0;
+      }
+      lossyDecompress( compressed.data(), compressed.size(), out );
+    }
+    catch( const Exception & e ) {
+      std::cout << name << ": " << e.message() << "\n";
+      return 1;
+    }
+
+    if( out.size() != in.size() ) {
+      std::cout << name << ": decompressed " << out.size() << " bytes, expected " << in.size() << "\n";
+      return 1;
+    }
+
+    const T * r = reinterpret_cast<const T*>( out.data() );
+    for( size_t i = 0; i < v.size(); i++ ) {
+      bool ok;
+      if( std::isnan( v[i] ) ) {
+        ok = std::isnan( r[i] );
+      }
+      else if( std::isinf( v[i] ) ) {
+        ok = ( r[i] == v[i] );
+      }
+      else {
+        ok = std::fabs( (double) r[i] - (double) v[i] ) <= bound;
+      }
+      if( !ok ) {
+        std::cout << name << ": value " << i << " is " << r[i] << ", expected " << v[i] << " within " << bound << "\n";
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  //______________________________________________________________________
+  //
+  template<class T>
+  int lossyTests( const std::string & type )
+  {
+    const int dimsList[][3] = { { 16, 16, 16 }, { 7, 5, 3 }, { 1, 1, 1000 }, { 33, 1, 9 } };
+
+    int errors = 0;
+
+    for( const auto & dims : dimsList ) {
+      for( int comps : { 1, 3 } ) {
+        const std::string suffix = " " + type + " " + std::to_string( dims[0] ) + "x" + std::to_string( dims[1] ) + "x" +
+                                   std::to_string( dims[2] ) + "x" + std::to_string( comps );
+
+        std::vector<T> v = smoothField<T>( dims, comps );
+        const double   range = *std::max_element( v.begin(), v.end() ) - *std::min_element( v.begin(), v.end() );
+
+        errors += lossyRoundTrip( "abs"      + suffix, v, dims, 1e-2, 0,    1e-2,                          false );
+        errors += lossyRoundTrip( "rel"      + suffix, v, dims, 0,    1e-3, 1e-3 * range,                  false );
+        errors += lossyRoundTrip( "abs+rel"  + suffix, v, dims, 1e-1, 1e-4, std::min( 1e-1, 1e-4 * range ), false );
+
+        // NaN and Inf scattered through the field are stored exactly and
+        // do not disturb their neighbors.
+        std::vector<T> special = v;
+        for( size_t i = 0; i < special.size(); i += 17 ) {
+          special[i] = ( i % 3 == 0 ) ? std::numeric_limits<T>::quiet_NaN() :
+                       ( i % 3 == 1 ) ? std::numeric_limits<T>::infinity()  :
+                                       -std::numeric_limits<T>::infinity();
+        }
+        errors += lossyRoundTrip( "NaN/Inf abs" + suffix, special, dims, 1e-2, 0,    1e-2,         false );
+        errors += lossyRoundTrip( "NaN/Inf rel" + suffix, special, dims, 0,    1e-3, 1e-3 * range, false );
+
+        // Constant fields
+        std::vector<T> constant( v.size(), (T) 42.5 );
+        errors += lossyRoundTrip( "constant abs" + suffix, constant, dims, 1e-3, 0,    1e-3,        false );
+        errors += lossyRoundTrip( "constant rel" + suffix, constant, dims, 0,    1e-3, 1e-3 * 42.5, false );
+
+        std::vector<T> zero( v.size(), (T) 0 );
+        errors += lossyRoundTrip( "zero rel" + suffix, zero, dims, 0, 1e-3, 0, false );
+      }
+    }
+
+    // A large smooth field must actually compress.
+    const int dims[3] = { 32, 32, 32 };
+    errors += lossyRoundTrip( "large " + type, smoothField<T>( dims, 1 ), dims, 1e-2, 0, 1e-2, true );
+
+    return errors;
+  }
+
+} // end anonymous namespace
+
+int
+main()
+{
+  const char * modes[] = { "lz", "shuffle-lz", "shuffle-gzip" };
+
+  // Odd sizes around the block boundaries.
+  const size_t sizes[] = { 0, 1, 7, 4093,
+                           BLOCK_SIZE - 1, BLOCK_SIZE, BLOCK_SIZE + 1,
+                           3 * BLOCK_SIZE - 5, 3 * BLOCK_SIZE + 13 };
+
+  int errors = 0;
+
+  for( int threads : { 1, 4 } ) {
+    setCompressionThreads( threads );
+
+    for( const char * mode : modes ) {
+      for( size_t size : sizes ) {
+        const std::string suffix = " (" + std::to_string( size ) + " bytes, " + std::to_string( threads ) + " threads)";
+
+        errors += roundTrip( mode, "random"   + suffix, randomBytes( size ),   1 );
+        errors += roundTrip( mode, "repeated" + suffix, repeatedBytes( size ), 1 );
+        errors += roundTrip( mode, "repeated" + suffix, repeatedBytes( size ), 8 );
+        errors += roundTrip( mode, "doubles"  + suffix, smoothDoubles( size ), 8 );
+      }
+
+      // Highly repetitive data must actually compress.
+      std::string compressed;
+      if( !blockCompress( mode, repeatedBytes( 2 * BLOCK_SIZE + 3 ), 1, compressed ) ) {
+        std::cout << mode << ": repetitive data did not compress\n";
+        errors++;
+      }
+    }
+  }
+
+  // Corrupt data must be reported, not crash.
+  std::string compressed;
+  std::string out;
+  if( blockCompress( "lz", repeatedBytes( BLOCK_SIZE + 1 ), 1, compressed ) ) {
+    compressed.resize( compressed.size() / 2 );
+    try {
+      blockDecompress( "lz", compressed.data(), compressed.size(), out );
+      std::cout << "lz: truncated data was not detected\n";
+      errors++;
+    }
+    catch( const Exception & ) {
+    }
+  }
+
+  errors += lossyTests<double>( "double" );
+  errors += lossyTests<float>( "float" );
+
+  if( errors == 0 ) {
+    std::cout << "CompressionTest passed\n";
+  }
+  return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
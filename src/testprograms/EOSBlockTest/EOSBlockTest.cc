@@ -0,0 +1,170 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/ICE/EOS/EquationOfState.h>
+#include <CCA/Components/ICE/EOS/Gruneisen.h>
+#include <CCA/Components/ICE/EOS/IdealGas.h>
+#include <CCA/Components/ICE/EOS/JWL.h>
+#include <CCA/Components/ICE/EOS/JWLC.h>
+#include <CCA/Components/ICE/EOS/Murnaghan.h>
+#include <Core/Malloc/Allocator.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Uintah;
+
+namespace {
+
+  double random( double lo, double hi )
+  {
+    return lo + (hi - lo) * (rand() / static_cast<double>(RAND_MAX));
+  }
+
+  int compare( const std::string & name, const std::string & what, int cell,
+               double block, double perCell )
+  {
+    if (block == perCell) {
+      return 0;
+    }
+    std::cout << name << " " << what << ", cell " << cell << ": block "
+              << block << ", per cell " << perCell << "\n";
+    return 1;
+  }
+
+  // Compares the block and per cell versions on n cells with densities
+  // between rhoLo and rhoHi and pressures between pLo and pHi
+  int compareEOS( const std::string & name, EquationOfState* eos, int n,
+                  double rhoLo, double rhoHi, double pLo, double pHi )
+  {
+    std::vector<double> rhoM(n), gamma(n), cv(n), Temp(n), press(n);
+    for (int i = 0; i < n; i++) {
+      rhoM[i]  = random(rhoLo, rhoHi);
+      gamma[i] = random(1.3, 1.7);
+      cv[i]    = random(500.0, 1500.0);
+      Temp[i]  = random(250.0, 3000.0);
+      press[i] = random(pLo, pHi);
+    }
+
+    int errors = 0;
+
+    // pressure
+    std::vector<double> p(n), dp_drho(n), dp_de(n);
+    eos->computePressEOSBlock(n, &rhoM[0], &gamma[0], &cv[0], &Temp[0],
+                              &p[0], &dp_drho[0], &dp_de[0]);
+
+    for (int i = 0; i < n; i++) {
+      double p1, dp_drho1, dp_de1;
+      eos->computePressEOS(rhoM[i], gamma[i], cv[i], Temp[i], p1, dp_drho1, dp_de1);
+      errors += compare(name, "press",   i, p[i],       p1);
+      errors += compare(name, "dp_drho", i, dp_drho[i], dp_drho1);
+      errors += compare(name, "dp_de",   i, dp_de[i],   dp_de1);
+    }
+
+    // micro density, with rhoM both separate from and the same as rho_guess
+    std::vector<double> rho(n), rhoInPlace(rhoM);
+    eos->computeRhoMicroBlock(n, &press[0], &gamma[0], &cv[0], &Temp[0],
+                              &rhoM[0], &rho[0]);
+    eos->computeRhoMicroBlock(n, &press[0], &gamma[0], &cv[0], &Temp[0],
+                              &rhoInPlace[0], &rhoInPlace[0]);
+
+    for (int i = 0; i < n; i++) {
+      double rho1 = eos->computeRhoMicro(press[i], gamma[i], cv[i], Temp[i], rhoM[i]);
+      errors += compare(name, "rho_micro",          i, rho[i],        rho1);
+      errors += compare(name, "rho_micro in place", i, rhoInPlace[i], rho1);
+    }
+    return errors;
+  }
+
+  EquationOfState* makeEOS( const std::string & type, const std::string & params )
+  {
+    ProblemSpecP ps = scinew ProblemSpec("<EOS type=\"" + type + "\">" + params + "</EOS>");
+
+    if (type == "IdealGas") {
+      return scinew IdealGas(ps);
+    }
+    else if (type == "JWL") {
+      return scinew JWL(ps);
+    }
+    else if (type == "JWLC") {
+      return scinew JWLC(ps);
+    }
+    else if (type == "Murnaghan") {
+      return scinew Murnaghan(ps);
+    }
+    return scinew Gruneisen(ps);
+  }
+
+} // end anonymous namespace
+
+int main()
+{
+  srand(7);
+
+  const std::string jwl = "<A>1668.9e9</A> <B>59.69e9</B> <C>6.43e8</C>"
+                          "<R1>5.9</R1> <R2>2.1</R2> <om>0.45</om> <rho0>1832</rho0>";
+  const std::string jwlc = "<A>8.580805e11</A> <B>7.546e9</B> <C>7.8127e8</C>"
+                           "<R1>4.306</R1> <R2>0.80</R2> <om>0.30</om> <rho0>1894.0</rho0>";
+  const std::string murnaghan = "<n>7.0</n> <K>1.02e-9</K> <rho0>1260.0</rho0> <P0>101325.0</P0>";
+  const std::string gruneisen = "<A>1.3338e9</A> <B>7.027e5</B> <rho0>1823.3</rho0>"
+                                "<P0>101325.0</P0> <T0>317.4</T0>";
+
+  int errors = 0;
+
+  // a single cell, one block and a partial last block
+  const int sizes[] = { 1, 16, 45 };
+
+  for (int n : sizes) {
+    EquationOfState* eos;
+
+    eos = makeEOS("IdealGas", "");
+    errors += compareEOS("IdealGas", eos, n, 0.1, 10.0, 1.e4, 1.e7);
+    delete eos;
+
+    eos = makeEOS("JWL", jwl);
+    errors += compareEOS("JWL", eos, n, 1.0, 2000.0, 1.e5, 1.e10);
+    delete eos;
+
+    eos = makeEOS("JWLC", jwlc);
+    errors += compareEOS("JWLC", eos, n, 1.0, 2000.0, 1.e5, 1.e10);
+    delete eos;
+
+    eos = makeEOS("Murnaghan", murnaghan);
+    errors += compareEOS("Murnaghan", eos, n, 1000.0, 1500.0, 1.e5, 1.e8);
+    delete eos;
+
+    eos = makeEOS("Gruneisen", gruneisen);
+    errors += compareEOS("Gruneisen", eos, n, 1700.0, 1900.0, 1.e5, 1.e8);
+    delete eos;
+  }
+
+  if (errors == 0) {
+    std::cout << "EOSBlockTest passed\n";
+  }
+  return (errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,181 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Patch.h>
+#include <Core/Grid/GIMPInterpolator.h>
+#include <Core/Grid/LinearInterpolator.h>
+#include <Core/Grid/cpdiInterpolator.h>
+#include <Core/Grid/Variables/ParticleSubset.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
+#include <Core/Parallel/Parallel.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Uintah;
+
+namespace {
+
+  const int NUM_PARTICLES = 1000;  // spans several BATCH_SIZE batches plus a partial one
+
+  double random01()
+  {
+    return rand() / static_cast<double>(RAND_MAX);
+  }
+
+  // Compares the batched calls of one interpolator with its per-particle calls.
+  int compareInterpolator( const std::string                    & name
+                         ,       ParticleInterpolator           * interp
+                         ,       ParticleSubset                 * pset
+                         , const constParticleVariable<Point>   & px
+                         , const constParticleVariable<Matrix3> & psize
+                         )
+  {
+    const int n  = pset->numParticles();
+    const int nn = interp->size();
+
+    std::vector<IntVector> b_ni(n*nn),  b_ni_d(n*nn);
+    std::vector<double>    b_S(n*nn),   b_S_d(n*nn);
+    std::vector<Vector>    b_dS(n*nn);
+
+    int errors = 0;
+
+    if (interp->findCellsAndWeights(pset->getPointer(), n, px, psize, &b_ni[0], &b_S[0]) != nn) {
+      std::cout << name << ": findCellsAndWeights did not return size()\n";
+      errors++;
+    }
+    if (interp->findCellsAndWeightsAndShapeDerivatives(pset->getPointer(), n, px, psize,
+                                                       &b_ni_d[0], &b_S_d[0], &b_dS[0]) != nn) {
+      std::cout << name << ": findCellsAndWeightsAndShapeDerivatives did not return size()\n";
+      errors++;
+    }
+
+    std::vector<IntVector> ni(nn);
+    std::vector<double>    S(nn);
+    std::vector<Vector>    dS(nn);
+
+    for (int j = 0; j < n; j++) {
+      const particleIndex idx = pset->getPointer()[j];
+
+      int NN = interp->findCellAndWeights(px[idx], ni, S, psize[idx]);
+      for (int k = 0; k < nn; k++) {
+        const IntVector e_ni = (k < NN) ? ni[k] : ni[0];
+        const double    e_S  = (k < NN) ? S[k]  : 0.0;
+        if (b_ni[j*nn + k] != e_ni || b_S[j*nn + k] != e_S) {
+          if (errors < 10) {
+            std::cout << name << ": weights of particle " << idx << " node " << k << " differ: "
+                      << b_ni[j*nn + k] << " " << b_S[j*nn + k] << " vs " << e_ni << " " << e_S << "\n";
+          }
+          errors++;
+        }
+      }
+
+      NN = interp->findCellAndWeightsAndShapeDerivatives(px[idx], ni, S, dS, psize[idx]);
+      for (int k = 0; k < nn; k++) {
+        const IntVector e_ni = (k < NN) ? ni[k] : ni[0];
+        const double    e_S  = (k < NN) ? S[k]  : 0.0;
+        const Vector    e_dS = (k < NN) ? dS[k] : Vector(0.0);
+        if (b_ni_d[j*nn + k] != e_ni || b_S_d[j*nn + k] != e_S || b_dS[j*nn + k] != e_dS) {
+          if (errors < 10) {
+            std::cout << name << ": gradients of particle " << idx << " node " << k << " differ: "
+                      << b_dS[j*nn + k] << " vs " << e_dS << "\n";
+          }
+          errors++;
+        }
+      }
+    }
+
+    std::cout << name << ": " << (errors ? "FAILED" : "passed") << " (" << n << " particles, "
+              << nn << " nodes)\n";
+    return errors;
+  }
+
+}
+
+int main( int argc, char** argv )
+{
+  Parallel::initializeManager(argc, argv);
+
+  // a single patch with a non-unit, anisotropic cell size and an offset anchor
+  GridP grid = scinew Grid();
+  Level* level = grid->addLevel(Point(-0.3, 0.1, 0.2), Vector(0.1, 0.05, 0.2));
+  Patch* patch = level->addPatch(IntVector(-1, -1, -1), IntVector(21, 21, 21),
+                                 IntVector(0, 0, 0), IntVector(20, 20, 20), grid.get_rep());
+  level->finalizeLevel();
+
+  ParticleSubset* pset = scinew ParticleSubset(NUM_PARTICLES, 0, patch);
+  pset->addReference();
+
+  ParticleVariable<Point>   pxvar;
+  ParticleVariable<Matrix3> psizevar;
+  pxvar.allocate(pset);
+  psizevar.allocate(pset);
+
+  srand(3);
+  for (int i = 0; i < NUM_PARTICLES; i++) {
+    pxvar[i] = Point(-0.3 + 0.1  * (1 + 18*random01()),
+                      0.1 + 0.05 * (1 + 18*random01()),
+                      0.2 + 0.2  * (1 + 18*random01()));
+    psizevar[i] = Matrix3(0.2 + 0.6*random01(), 0.3*random01() - 0.15, 0.1*random01(),
+                          0.1*random01(),       0.2 + 0.6*random01(), 0.0,
+                          0.0,                  0.05,                 0.2 + 0.6*random01());
+
+    if (i % 10 == 0) {   // on cell faces
+      pxvar[i] = Point(-0.3 + 0.1*5, 0.1 + 0.05*5.5, 0.2 + 0.2*7.25);
+    }
+    if (i % 7 == 0) {    // undeformed
+      psizevar[i] = Matrix3(0.5, 0, 0, 0, 0.5, 0, 0, 0, 0.5);
+    }
+    if (i % 13 == 0) {   // large enough for the CPDI corners to be scaled to lcrit
+      psizevar[i] = Matrix3(2.5, 1, 0, 0, 2.5, 0, 0, 0, 2.5);
+    }
+  }
+
+  constParticleVariable<Point>   px;
+  constParticleVariable<Matrix3> psize;
+  px    = pxvar;
+  psize = psizevar;
+
+  LinearInterpolator linear(patch);
+  GIMPInterpolator   gimp(patch);
+  cpdiInterpolator   cpdi(patch, 0.8);
+
+  int errors = 0;
+  errors += compareInterpolator("LinearInterpolator", &linear, pset, px, psize);
+  errors += compareInterpolator("GIMPInterpolator",   &gimp,   pset, px, psize);
+  errors += compareInterpolator("cpdiInterpolator",   &cpdi,   pset, px, psize);
+
+  if (pset->removeReference()) {
+    delete pset;
+  }
+
+  Parallel::finalizeManager();
+
+  return (errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,99 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Math/PhiloxRand.h>
+
+#include <cstdlib>
+#include <iostream>
+
+using Uintah::IntVector;
+using Uintah::PhiloxRand;
+
+namespace {
+
+  typedef PhiloxRand::uint32 uint32;
+
+  // Known answers of Philox4x32-10 from the Random123 distribution (kat_vectors)
+  struct KnownAnswer {
+    uint32 ctr[4];
+    uint32 key[2];
+    uint32 out[4];
+  };
+
+  const KnownAnswer knownAnswers[] = {
+    { { 0x00000000, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000000, 0x00000000 },
+      { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+    { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff },
+      { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+    { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 },
+      { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }
+  };
+
+  int errors = 0;
+
+  void compare( const char * what, const uint32 out[4], const uint32 expected[4] )
+  {
+    for( int i = 0; i < 4; i++ ) {
+      if( out[i] != expected[i] ) {
+        std::cout << what << ": word " << i << " is " << std::hex << out[i]
+                  << ", expected " << expected[i] << std::dec << "\n";
+        errors++;
+      }
+    }
+  }
+}
+
+int main()
+{
+  for( const KnownAnswer & ka : knownAnswers ) {
+    uint32 out[4];
+    PhiloxRand::philox( ka.ctr, ka.key, out );
+    compare( "philox", out, ka.out );
+  }
+
+  // The generator draws block b of (cell, sample, stream) with the counter
+  // (cell, sample) and the key (key, stream << 24 | b)
+  for( const KnownAnswer & ka : knownAnswers ) {
+    const uint32 stream = ka.key[1] >> 24;
+    const uint32 block  = ka.key[1] & 0xFFFFFF;
+
+    PhiloxRand rng( ka.key[0] );
+    rng.setStream( IntVector( (int) ka.ctr[0], (int) ka.ctr[1], (int) ka.ctr[2] ), ka.ctr[3], stream );
+    for( uint32 b = 0; b < block; b++ ) {
+      for( int i = 0; i < 4; i++ ) {
+        rng.randInt();
+      }
+    }
+
+    uint32 out[4];
+    for( int i = 0; i < 4; i++ ) {
+      out[i] = rng.randInt();
+    }
+    compare( "randInt", out, ka.out );
+  }
+
+  std::cout << ( errors == 0 ? "PhiloxTest passed" : "PhiloxTest FAILED" ) << std::endl;
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,85 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Parallel/SharedMemoryExchange.h>
+
+#include <cstdlib>
+#include <iostream>
+
+using Uintah::SharedMemoryExchange;
+
+namespace {
+
+  bool passed = true;
+
+  void check( bool ok, const char * what )
+  {
+    if( !ok ) {
+      std::cout << "FAILED: " << what << std::endl;
+      passed = false;
+    }
+  }
+}
+
+int main()
+{
+  // 16 slots of 64 bytes, a slot for 100 bytes of data takes 3 of them
+  alignas(SharedMemoryExchange::SlotRing::s_align) static char segment[1024];
+
+  SharedMemoryExchange::SlotRing ring;
+  ring.reset( segment, sizeof(segment) );
+
+  size_t offset;
+  size_t offsets[5];
+  for( int i = 0; i < 5; i++ ) {
+    char * data = ring.allocate( 100, offsets[i] );
+    check( offsets[i] == static_cast<size_t>(192 * i), "slots are handed out in order" );
+    check( data == segment + offsets[i] + 64, "the data follows the slot header" );
+  }
+  check( ring.allocate( 100, offset ) == nullptr, "a full segment has no slot" );
+
+  // Only the oldest slots are reclaimed
+  SharedMemoryExchange::SlotRing::release( segment, offsets[1] );
+  check( ring.allocate( 100, offset ) == nullptr, "a slot behind an unreleased one is not reclaimed" );
+
+  SharedMemoryExchange::SlotRing::release( segment, offsets[0] );
+  check( ring.allocate( 100, offset ) != nullptr && offset == 0, "wraps around to the start once the head is released" );
+  check( ring.allocate( 100, offset ) != nullptr && offset == 192, "fills in up to the head" );
+  check( ring.allocate( 0, offset ) == nullptr, "does not run over the head" );
+
+  // An empty ring has the whole segment
+  SharedMemoryExchange::SlotRing::release( segment, 0 );
+  SharedMemoryExchange::SlotRing::release( segment, 192 );
+  for( int i = 2; i < 5; i++ ) {
+    SharedMemoryExchange::SlotRing::release( segment, offsets[i] );
+  }
+  check( ring.allocate( sizeof(segment) - 64, offset ) != nullptr && offset == 0, "an empty segment takes a slot of its whole size" );
+
+  SharedMemoryExchange::SlotRing::release( segment, 0 );
+  check( ring.allocate( sizeof(segment) - 63, offset ) == nullptr, "a message larger than the segment goes through MPI" );
+
+  std::cout << ( passed ? "SharedMemoryExchangeTest passed" : "SharedMemoryExchangeTest FAILED" ) << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -41,7 +41,19 @@ SUBDIRS := \
         $(SRCDIR)/RegionTest              \
         $(SRCDIR)/CubeRootTest            \
         $(SRCDIR)/SFCTest                 \
-        $(SRCDIR)/PatchBVH
+        $(SRCDIR)/PatchBVH                \
+        $(SRCDIR)/InterpolatorTest        \
+        $(SRCDIR)/CompressionTest         \
+        $(SRCDIR)/SharedMemoryExchangeTest \
+        $(SRCDIR)/PhiloxTest
+
+ifeq ($(BUILD_ICE),yes)
+  SUBDIRS += $(SRCDIR)/EOSBlockTest
+endif
+
+ifeq ($(BUILD_ARCHES),yes)
+  SUBDIRS += $(SRCDIR)/ClassicTableTest
+endif
 
 include $(SCIRUN_SCRIPTS)/recurse.mk
 